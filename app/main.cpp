@@ -133,7 +133,9 @@ int main(int argc, char* argv[])
 {
 	qtwebapp::LoggerWithFile *logger = new qtwebapp::LoggerWithFile(qApp);
     logger->installMsgHandler();
+    logger->setAsync(true); // DSP threads must not wait for the console or log file
 	int res = runQtApplication(argc, argv, logger);
 	qWarning("SDRangel quit.");
+	logger->setAsync(false); // write pending messages
 	return res;
 }
@@ -57,6 +57,12 @@ DevicePlutoSDRBox* DevicePlutoSDR::getDeviceFromSerial(const std::string& serial
 {
     const std::string *uri = m_scan.getURIFromSerial(serial);
 
+    if (!uri) // device enumeration may come from the cache with no scan done yet
+    {
+        m_scan.scan();
+        uri = m_scan.getURIFromSerial(serial);
+    }
+
     if (uri) {
         return new DevicePlutoSDRBox(*uri);
     } else {
@@ -0,0 +1,322 @@
+/**
+  @file
+  @author f4exb
+*/
+
+#include "httpeventhandler.h"
+#include "httpresponse.h"
+
+using namespace qtwebapp;
+
+HttpEventConnection::HttpEventConnection(HttpEventHandler* handler, QTcpSocket* socket)
+    : QObject()
+{
+    this->handler = handler;
+    this->socket = socket;
+    socket->setParent(this);
+    currentRequest = 0;
+    closing = false;
+    readPaused = false;
+
+    connect(socket, SIGNAL(readyRead()), SLOT(read()));
+    connect(socket, SIGNAL(bytesWritten(qint64)), SLOT(bytesWritten(qint64)));
+    connect(socket, SIGNAL(disconnected()), SLOT(disconnected()));
+    connect(&readTimer, SIGNAL(timeout()), SLOT(readTimeout()));
+    connect(&closeTimer, SIGNAL(timeout()), SLOT(closeTimeout()));
+    readTimer.setSingleShot(true);
+    closeTimer.setSingleShot(true);
+    readTimer.start(handler->getReadTimeout());
+}
+
+HttpEventConnection::~HttpEventConnection()
+{
+    readTimer.stop();
+    closeTimer.stop();
+    delete currentRequest;
+}
+
+void HttpEventConnection::close()
+{
+    // pending output is sent before the socket is actually closed
+    closing = true;
+    readTimer.stop();
+    socket->disconnectFromHost();
+
+    // a client that does not take the pending output would keep the connection forever
+    if (socket->state() != QAbstractSocket::UnconnectedState) {
+        closeTimer.start(handler->getReadTimeout());
+    }
+}
+
+void HttpEventConnection::closeTimeout()
+{
+    qDebug("HttpEventConnection (%p): close timeout occurred", this);
+    socket->abort();
+    emit closed(); // in case the aborted socket did not signal the disconnection
+}
+
+void HttpEventConnection::bytesWritten(qint64 bytes)
+{
+    Q_UNUSED(bytes)
+
+    if (readPaused && !closing)
+    {
+        readTimer.start(handler->getReadTimeout()); // the client is still taking the output
+
+        if (socket->bytesToWrite() <= maxBytesToWrite)
+        {
+            readPaused = false;
+            read();
+        }
+    }
+}
+
+void HttpEventConnection::readTimeout()
+{
+    qDebug("HttpEventConnection (%p): read timeout occurred", this);
+    close();
+}
+
+void HttpEventConnection::disconnected()
+{
+#ifdef SUPERVERBOSE
+    qDebug("HttpEventConnection (%p): disconnected", this);
+#endif
+    closing = true;
+    readTimer.stop();
+    closeTimer.stop();
+    emit closed();
+}
+
+void HttpEventConnection::read()
+{
+    // The loop adds support for HTTP pipelining
+    while (!closing && socket->bytesAvailable())
+    {
+        // Do not process more requests while the client does not take the responses already written.
+        // Processing resumes when the output is sent.
+        if (socket->bytesToWrite() > maxBytesToWrite)
+        {
+            readPaused = true;
+            return;
+        }
+
+        // Create new HttpRequest object if necessary
+        if (!currentRequest) {
+            currentRequest = handler->newRequest();
+        }
+
+        // Collect data for the request object
+        while (socket->bytesAvailable() && currentRequest->getStatus()!=HttpRequest::complete && currentRequest->getStatus()!=HttpRequest::abort)
+        {
+            currentRequest->readFromSocket(socket);
+
+            if (currentRequest->getStatus()==HttpRequest::waitForBody)
+            {
+                // Restart timer for read timeout, otherwise it would
+                // expire during large file uploads.
+                readTimer.start(handler->getReadTimeout());
+            }
+        }
+
+        // If the request is aborted, return error message and close the connection
+        if (currentRequest->getStatus()==HttpRequest::abort)
+        {
+            socket->write("HTTP/1.1 413 entity too large\r\nConnection: close\r\n\r\n413 Entity too large\r\n");
+            delete currentRequest;
+            currentRequest=0;
+            close();
+            return;
+        }
+
+        // If the request is complete, let the request handler process it
+        if (currentRequest->getStatus()==HttpRequest::complete)
+        {
+            readTimer.stop();
+            bool closeConnection = processRequest();
+            delete currentRequest;
+            currentRequest=0;
+
+            // Close the connection or prepare for the next request on the same connection.
+            if (closeConnection)
+            {
+                close();
+                return;
+            }
+            else
+            {
+                readTimer.start(handler->getReadTimeout());
+            }
+        }
+    }
+}
+
+bool HttpEventConnection::processRequest()
+{
+#ifdef SUPERVERBOSE
+    qDebug("HttpEventConnection (%p): received request from %s (%s) %s",
+            this,
+            qPrintable(currentRequest->getPeerAddress().toString()),
+            currentRequest->getMethod().toStdString().c_str(),
+            currentRequest->getPath().toStdString().c_str());
+#endif
+
+    // Copy the Connection:close header to the response
+    HttpResponse response(socket, false);
+    bool closeConnection=QString::compare(currentRequest->getHeader("Connection"),"close",Qt::CaseInsensitive)==0;
+
+    if (closeConnection)
+    {
+        response.setHeader("Connection","close");
+    }
+    // In case of HTTP 1.0 protocol add the Connection:close header.
+    // This ensures that the HttpResponse does not activate chunked mode, which is not spported by HTTP 1.0.
+    else
+    {
+        bool http1_0=QString::compare(currentRequest->getVersion(),"HTTP/1.0",Qt::CaseInsensitive)==0;
+
+        if (http1_0)
+        {
+            closeConnection=true;
+            response.setHeader("Connection","close");
+        }
+    }
+
+    // Call the request mapper
+    try
+    {
+        handler->getRequestHandler()->service(*currentRequest, response);
+    }
+    catch (...)
+    {
+        qCritical("HttpEventConnection (%p): An uncatched exception occurred in the request handler",this);
+    }
+
+    // Finalize sending the response if not already done
+    if (!response.hasSentLastPart()) {
+        response.write(QByteArray(),true);
+    }
+
+    // Find out whether the connection must be closed
+    if (!closeConnection)
+    {
+        // Maybe the request handler or mapper added a Connection:close header in the meantime
+        bool closeResponse=QString::compare(response.getHeaders().value("Connection"),"close",Qt::CaseInsensitive)==0;
+
+        if (closeResponse)
+        {
+            closeConnection=true;
+        }
+        else
+        {
+            // If we have no Content-Length header and did not use chunked mode, then we have to close the
+            // connection to tell the HTTP client that the end of the response has been reached.
+            bool hasContentLength=response.getHeaders().contains("Content-Length");
+            bool hasChunkedMode=QString::compare(response.getHeaders().value("Transfer-Encoding"),"chunked",Qt::CaseInsensitive)==0;
+
+            if (!hasContentLength && !hasChunkedMode) {
+                closeConnection=true;
+            }
+        }
+    }
+
+    return closeConnection;
+}
+
+HttpEventHandler::HttpEventHandler(QSettings* settings, HttpRequestHandler* requestHandler)
+    : QThread(), useQtSettings(true)
+{
+    Q_ASSERT(settings != 0);
+    Q_ASSERT(requestHandler != 0);
+    this->settings = settings;
+    this->listenerSettings = 0;
+    this->requestHandler = requestHandler;
+
+    // execute signals in my own thread
+    moveToThread(this);
+
+    qDebug("HttpEventHandler (%p): constructed", this);
+    this->start();
+}
+
+HttpEventHandler::HttpEventHandler(const HttpListenerSettings* settings, HttpRequestHandler* requestHandler)
+    : QThread(), useQtSettings(false)
+{
+    Q_ASSERT(settings != 0);
+    Q_ASSERT(requestHandler != 0);
+    this->settings = 0;
+    this->listenerSettings = settings;
+    this->requestHandler = requestHandler;
+
+    // execute signals in my own thread
+    moveToThread(this);
+
+    qDebug("HttpEventHandler (%p): constructed", this);
+    this->start();
+}
+
+HttpEventHandler::~HttpEventHandler()
+{
+    quit();
+    wait();
+    qDebug("HttpEventHandler (%p): destroyed", this);
+}
+
+void HttpEventHandler::run()
+{
+    try
+    {
+        exec();
+    }
+    catch (...)
+    {
+        qCritical("HttpEventHandler (%p): an uncatched exception occurred in the thread",this);
+    }
+
+    // connections live in this thread and are deleted here
+    qDeleteAll(connections);
+    connections.clear();
+    nbConnections.store(0);
+}
+
+int HttpEventHandler::getReadTimeout() const
+{
+    return useQtSettings ? settings->value("readTimeout",10000).toInt() : listenerSettings->readTimeout;
+}
+
+HttpRequest* HttpEventHandler::newRequest() const
+{
+    if (useQtSettings) {
+        return new HttpRequest(settings);
+    } else {
+        return new HttpRequest(listenerSettings);
+    }
+}
+
+void HttpEventHandler::handleConnection(tSocketDescriptor socketDescriptor)
+{
+    QTcpSocket* socket=new QTcpSocket();
+
+    if (!socket->setSocketDescriptor(socketDescriptor))
+    {
+        qCritical("HttpEventHandler (%p): cannot initialize socket: %s", this, qPrintable(socket->errorString()));
+        delete socket;
+        nbConnections.deref();
+        return;
+    }
+
+    HttpEventConnection* connection=new HttpEventConnection(this, socket);
+    connect(connection, SIGNAL(closed()), SLOT(connectionClosed()));
+    connections.insert(connection);
+}
+
+void HttpEventHandler::connectionClosed()
+{
+    HttpEventConnection* connection=qobject_cast<HttpEventConnection*>(sender());
+
+    if (connection && connections.remove(connection))
+    {
+        nbConnections.deref();
+        connection->deleteLater();
+    }
+}
@@ -0,0 +1,191 @@
+/**
+  @file
+  @author f4exb
+*/
+
+#ifndef HTTPEVENTHANDLER_H
+#define HTTPEVENTHANDLER_H
+
+#include <QTcpSocket>
+#include <QSettings>
+#include <QTimer>
+#include <QThread>
+#include <QAtomicInt>
+#include <QSet>
+#include "httpglobal.h"
+#include "httpconnectionhandler.h"
+#include "httprequest.h"
+#include "httprequesthandler.h"
+#include "httplistenersettings.h"
+
+#include "export.h"
+
+namespace qtwebapp {
+
+class HttpEventHandler;
+
+/**
+  One connection served by an event driven handler. It lives in the thread of its handler and
+  reacts to the signals of its socket only, so a single thread can serve many connections.
+  Requests of a persistent connection are processed in order, including pipelined requests.
+*/
+class HTTPSERVER_API HttpEventConnection : public QObject {
+    Q_OBJECT
+    Q_DISABLE_COPY(HttpEventConnection)
+
+public:
+
+    /**
+      Constructor.
+      @param handler Handler serving this connection. Must live in the current thread.
+      @param socket Connected socket. The connection takes ownership.
+    */
+    HttpEventConnection(HttpEventHandler* handler, QTcpSocket* socket);
+
+    /** Destructor */
+    virtual ~HttpEventConnection();
+
+private:
+
+    /** Handler serving this connection */
+    HttpEventHandler* handler;
+
+    /** TCP socket of the connection */
+    QTcpSocket* socket;
+
+    /** Time for read timeout detection */
+    QTimer readTimer;
+
+    /** Time for detection of a client that does not take the output pending at close */
+    QTimer closeTimer;
+
+    /** Storage for the current incoming HTTP request */
+    HttpRequest* currentRequest;
+
+    /** Set when the connection is closing. Further requests are ignored. */
+    bool closing;
+
+    /** Set when requests are not processed until the client takes the output already written */
+    bool readPaused;
+
+    /** Output pending in the socket above which requests are not processed */
+    static const qint64 maxBytesToWrite = 16384;
+
+    /** Process a complete request. Returns true if the connection must be closed. */
+    bool processRequest();
+
+    /** Close the connection after the pending output is sent or abort it after the read timeout */
+    void close();
+
+signals:
+
+    /** Sent when the connection has been closed */
+    void closed();
+
+private slots:
+
+    /** Received from the socket when incoming data can be read */
+    void read();
+
+    /** Received from the timer when a read-timeout occurred */
+    void readTimeout();
+
+    /** Received from the socket when output has been sent */
+    void bytesWritten(qint64 bytes);
+
+    /** Received from the timer when the pending output was not sent in time at close */
+    void closeTimeout();
+
+    /** Received from the socket when a connection has been closed */
+    void disconnected();
+};
+
+/**
+  Event driven connection handler. Unlike HttpConnectionHandler that serves a single connection
+  in its own thread, it serves any number of connections in one thread using the event loop
+  of the thread to wait for data on all sockets (epoll on Linux).
+  A small fixed number of these handlers is used by HttpEventHandlerPool.
+  <p>
+  SSL is not supported in this mode.
+  @see HttpConnectionHandler for description of the readTimeout
+  @see HttpRequest for description of config settings maxRequestSize and maxMultiPartSize
+*/
+class HTTPSERVER_API HttpEventHandler : public QThread {
+    Q_OBJECT
+    Q_DISABLE_COPY(HttpEventHandler)
+
+public:
+
+    /**
+      Constructor.
+      @param settings Configuration settings of the HTTP webserver as Qt settings
+      @param requestHandler Handler that will process each incoming HTTP request
+    */
+    HttpEventHandler(QSettings* settings, HttpRequestHandler* requestHandler);
+
+    /**
+      Constructor.
+      @param settings Configuration settings of the HTTP webserver as a structure
+      @param requestHandler Handler that will process each incoming HTTP request
+    */
+    HttpEventHandler(const HttpListenerSettings* settings, HttpRequestHandler* requestHandler);
+
+    /** Destructor */
+    virtual ~HttpEventHandler();
+
+    /** Number of connections served or about to be served. Can be called from any thread. */
+    int getNbConnections() const { return nbConnections.load(); }
+
+    /** Count a connection before it is passed to handleConnection(). Can be called from any thread. */
+    void reserveConnection() { nbConnections.ref(); }
+
+    /** Read timeout in ms */
+    int getReadTimeout() const;
+
+    /** Create a new request object with the configured size limits */
+    HttpRequest* newRequest() const;
+
+    /** Handler of the requests */
+    HttpRequestHandler* getRequestHandler() const { return requestHandler; }
+
+private:
+
+    /** Configuration settings */
+    QSettings* settings;
+
+    /** Configuration settings */
+    const HttpListenerSettings* listenerSettings;
+
+    /** Dispatches received requests to services */
+    HttpRequestHandler* requestHandler;
+
+    /** Connections served. Accessed in the handler thread only. */
+    QSet<HttpEventConnection*> connections;
+
+    /** Number of connections served including the ones passed and not yet handled */
+    QAtomicInt nbConnections;
+
+    /** Settings flag */
+    bool useQtSettings;
+
+    /** Executes the threads own event loop */
+    void run();
+
+public slots:
+
+    /**
+      Received from the listener, when the handler shall start serving a new connection.
+      reserveConnection() must have been called before.
+      @param socketDescriptor references the accepted connection.
+    */
+    void handleConnection(tSocketDescriptor socketDescriptor);
+
+private slots:
+
+    /** Received from a connection when it has been closed */
+    void connectionClosed();
+};
+
+} // end of namespace
+
+#endif // HTTPEVENTHANDLER_H
@@ -0,0 +1,67 @@
+/**
+  @file
+  @author f4exb
+*/
+
+#include "httpeventhandlerpool.h"
+
+using namespace qtwebapp;
+
+HttpEventHandlerPool::HttpEventHandlerPool(QSettings* settings, HttpRequestHandler* requestHandler)
+{
+    Q_ASSERT(settings != 0);
+    int workerThreads = settings->value("workerThreads",2).toInt();
+    maxConnections = settings->value("maxConnections",1000).toInt();
+
+    for (int i = 0; i < (workerThreads < 1 ? 1 : workerThreads); i++) {
+        pool.append(new HttpEventHandler(settings, requestHandler));
+    }
+}
+
+HttpEventHandlerPool::HttpEventHandlerPool(const HttpListenerSettings* settings, HttpRequestHandler* requestHandler)
+{
+    Q_ASSERT(settings != 0);
+    maxConnections = settings->maxConnections;
+
+    for (int i = 0; i < (settings->workerThreads < 1 ? 1 : settings->workerThreads); i++) {
+        pool.append(new HttpEventHandler(settings, requestHandler));
+    }
+}
+
+HttpEventHandlerPool::~HttpEventHandlerPool()
+{
+    // delete all handlers and wait until their threads are closed
+    foreach(HttpEventHandler* handler, pool)
+    {
+       delete handler;
+    }
+
+    qDebug("HttpEventHandlerPool (%p): destroyed", this);
+}
+
+HttpEventHandler* HttpEventHandlerPool::getConnectionHandler()
+{
+    // Only the listener thread adds connections so counts can only decrease meanwhile
+    HttpEventHandler* freeHandler=0;
+    int nbConnections=0;
+    int minConnections=0;
+
+    foreach(HttpEventHandler* handler, pool)
+    {
+        int handlerConnections=handler->getNbConnections();
+        nbConnections+=handlerConnections;
+
+        if (!freeHandler || (handlerConnections < minConnections))
+        {
+            freeHandler=handler;
+            minConnections=handlerConnections;
+        }
+    }
+
+    if (nbConnections >= maxConnections) {
+        return 0;
+    }
+
+    freeHandler->reserveConnection();
+    return freeHandler;
+}
@@ -0,0 +1,75 @@
+/**
+  @file
+  @author f4exb
+*/
+
+#ifndef HTTPEVENTHANDLERPOOL_H
+#define HTTPEVENTHANDLERPOOL_H
+
+#include <QList>
+#include <QSettings>
+#include "httpglobal.h"
+#include "httpeventhandler.h"
+#include "httplistenersettings.h"
+
+#include "export.h"
+
+namespace qtwebapp {
+
+/**
+  Fixed pool of event driven connection handlers. Each handler is a thread serving many
+  connections so that the number of threads does not grow with the number of clients.
+  <p>
+  Example for the required configuration settings:
+  <code><pre>
+  eventDriven=true
+  workerThreads=2
+  maxConnections=1000
+  readTimeout=60000
+  maxRequestSize=16000
+  maxMultiPartSize=1000000
+  </pre></code>
+  All handlers are started with the pool. A new connection is given to the handler
+  serving the least connections. Connections above maxConnections are rejected.
+  @see HttpEventHandler
+*/
+class HTTPSERVER_API HttpEventHandlerPool {
+    Q_DISABLE_COPY(HttpEventHandlerPool)
+
+public:
+
+    /**
+      Constructor.
+      @param settings Configuration settings for the HTTP server. Must not be 0.
+      @param requestHandler The handler that will process each received HTTP request.
+    */
+    HttpEventHandlerPool(QSettings* settings, HttpRequestHandler* requestHandler);
+
+    /**
+      Constructor.
+      @param settings Configuration settings for the HTTP server as structure
+      @param requestHandler The handler that will process each received HTTP request.
+    */
+    HttpEventHandlerPool(const HttpListenerSettings* settings, HttpRequestHandler* requestHandler);
+
+    /** Destructor. Closes all connections and waits until the threads are stopped. */
+    virtual ~HttpEventHandlerPool();
+
+    /**
+      Get the handler to serve a new connection with the connection already counted
+      by the handler, or 0 if the maximum number of connections is reached.
+    */
+    HttpEventHandler* getConnectionHandler();
+
+private:
+
+    /** Maximum number of connections served by all handlers */
+    int maxConnections;
+
+    /** Pool of handlers */
+    QList<HttpEventHandler*> pool;
+};
+
+} // end of namespace
+
+#endif // HTTPEVENTHANDLERPOOL_H
@@ -17,6 +17,7 @@ HttpListener::HttpListener(QSettings* settings, HttpRequestHandler* requestHandl
     Q_ASSERT(settings != 0);
     Q_ASSERT(requestHandler != 0);
     pool = 0;
+    eventPool = 0;
     this->settings = settings;
     this->requestHandler = requestHandler;
     // Reqister type of socketDescriptor for signal/slot handling
@@ -30,6 +31,7 @@ HttpListener::HttpListener(const HttpListenerSettings& settings, HttpRequestHand
 {
     Q_ASSERT(requestHandler != 0);
     pool = 0;
+    eventPool = 0;
     this->settings = 0;
     listenerSettings = settings;
     this->requestHandler = requestHandler;
@@ -49,7 +51,18 @@ HttpListener::~HttpListener()
 
 void HttpListener::listen()
 {
-    if (!pool)
+    if (isEventDriven())
+    {
+        if (!eventPool)
+        {
+            if (useQtSettings) {
+                eventPool = new HttpEventHandlerPool(settings, requestHandler);
+            } else {
+                eventPool = new HttpEventHandlerPool(&listenerSettings, requestHandler);
+            }
+        }
+    }
+    else if (!pool)
     {
         if (useQtSettings) {
             pool = new HttpConnectionHandlerPool(settings, requestHandler);
@@ -77,6 +90,30 @@ void HttpListener::close() {
         delete pool;
         pool=NULL;
     }
+    if (eventPool) {
+        delete eventPool;
+        eventPool=NULL;
+    }
+}
+
+bool HttpListener::isEventDriven() const
+{
+    bool eventDriven = useQtSettings ? settings->value("eventDriven",false).toBool() : listenerSettings.eventDriven;
+
+    if (!eventDriven) {
+        return false;
+    }
+
+    QString sslKeyFile = useQtSettings ? settings->value("sslKeyFile","").toString() : listenerSettings.sslKeyFile;
+    QString sslCertFile = useQtSettings ? settings->value("sslCertFile","").toString() : listenerSettings.sslCertFile;
+
+    if (!sslKeyFile.isEmpty() && !sslCertFile.isEmpty())
+    {
+        qWarning("HttpListener: SSL is not supported in event driven mode. Using a thread per connection");
+        return false;
+    }
+
+    return true;
 }
 
 void HttpListener::incomingConnection(tSocketDescriptor socketDescriptor) {
@@ -85,13 +122,23 @@ void HttpListener::incomingConnection(tSocketDescriptor socketDescriptor) {
 #endif
 
     HttpConnectionHandler* freeHandler=NULL;
-    if (pool)
+    HttpEventHandler* eventHandler=NULL;
+    if (eventPool)
+    {
+        eventHandler=eventPool->getConnectionHandler();
+    }
+    else if (pool)
     {
         freeHandler=pool->getConnectionHandler();
     }
 
     // Let the handler process the new connection.
-    if (freeHandler)
+    if (eventHandler)
+    {
+        // The descriptor is passed via event queue because the handler lives in another thread
+        QMetaObject::invokeMethod(eventHandler, "handleConnection", Qt::QueuedConnection, Q_ARG(tSocketDescriptor, socketDescriptor));
+    }
+    else if (freeHandler)
     {
         // The descriptor is passed via event queue because the handler lives in another thread
         QMetaObject::invokeMethod(freeHandler, "handleConnection", Qt::QueuedConnection, Q_ARG(tSocketDescriptor, socketDescriptor));
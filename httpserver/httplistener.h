@@ -12,6 +12,7 @@
 #include "httpglobal.h"
 #include "httpconnectionhandler.h"
 #include "httpconnectionhandlerpool.h"
+#include "httpeventhandlerpool.h"
 #include "httprequesthandler.h"
 #include "httplistenersettings.h"
 
@@ -35,10 +36,17 @@ namespace qtwebapp {
   ;sslCertFile=ssl/my.cert
   maxRequestSize=16000
   maxMultiPartSize=1000000
+  ;eventDriven=true
+  ;workerThreads=2
+  ;maxConnections=1000
   </pre></code>
   The optional host parameter binds the listener to one network interface.
   The listener handles all network interfaces if no host is configured.
   The port number specifies the incoming TCP port that this listener listens to.
+  <p>
+  By default each connection is served by its own thread. With eventDriven the connections
+  are served by a fixed number of threads (workerThreads) each serving many connections.
+  SSL is not supported in this mode so the listener falls back to a thread per connection if SSL is configured.
   @see HttpConnectionHandlerPool for description of config settings minThreads, maxThreads, cleanupInterval and ssl settings
   @see HttpConnectionHandler for description of the readTimeout
   @see HttpRequest for description of config settings maxRequestSize and maxMultiPartSize
@@ -114,6 +122,12 @@ private:
     /** Pool of connection handlers */
     HttpConnectionHandlerPool* pool;
 
+    /** Pool of event driven connection handlers */
+    HttpEventHandlerPool* eventPool;
+
+    /** True if the event driven mode is configured and possible */
+    bool isEventDriven() const;
+
     /** Settings flag */
     bool useQtSettings;
 
@@ -23,6 +23,9 @@ public:
     QString sslCertFile;
     int maxRequestSize;
     int maxMultiPartSize;
+    bool eventDriven;
+    int workerThreads;
+    int maxConnections;
 
     HttpListenerSettings() {
         resetToDefaults();
@@ -40,6 +43,9 @@ public:
         sslCertFile = "";
         maxRequestSize = 16000;
         maxMultiPartSize = 1000000;
+        eventDriven = false;
+        workerThreads = 2;
+        maxConnections = 1000;
     }
 };
 
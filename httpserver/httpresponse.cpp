@@ -7,9 +7,10 @@
 
 using namespace qtwebapp;
 
-HttpResponse::HttpResponse(QTcpSocket* socket)
+HttpResponse::HttpResponse(QTcpSocket* socket, bool blockingWrite)
 {
     this->socket=socket;
+    this->blockingWrite=blockingWrite;
     statusCode=200;
     statusText="OK";
     sentHeaders=false;
@@ -79,7 +80,7 @@ bool HttpResponse::writeToSocket(QByteArray data)
     while (socket->isOpen() && remaining>0)
     {
         // If the output buffer has become large, then wait until it has been sent.
-        if (socket->bytesToWrite()>16384)
+        if (blockingWrite && socket->bytesToWrite()>16384)
         {
             socket->waitForBytesWritten(-1);
         }
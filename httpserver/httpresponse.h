@@ -42,8 +42,10 @@ public:
     /**
       Constructor.
       @param socket used to write the response
+      @param blockingWrite wait until the output buffer is sent when it becomes large. Event driven
+      handlers serve many connections in one thread and let the socket buffer the whole response instead.
     */
-    HttpResponse(QTcpSocket* socket);
+    HttpResponse(QTcpSocket* socket, bool blockingWrite=true);
 
     /**
       Set a HTTP response header.
@@ -130,6 +132,9 @@ private:
     /** Socket for writing output */
     QTcpSocket* socket;
 
+    /** Wait for the output buffer to be sent when it becomes large */
+    bool blockingWrite;
+
     /** HTTP status code*/
     int statusCode;
 
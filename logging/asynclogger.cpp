@@ -0,0 +1,206 @@
+/**
+  @file
+  @author f4exb
+*/
+
+#include "asynclogger.h"
+#include "logger.h"
+
+using namespace qtwebapp;
+
+AsyncLogger::AsyncLogger(Logger* target, int queueSize, int maxPerSecond)
+    : QThread(),
+    target(target),
+    dequeuePos(0),
+    stopRequest(0),
+    maxPerSecond(maxPerSecond),
+    nbQueueDropped(0),
+    nbQueueDroppedLogged(0),
+    nbRateDropped(0)
+{
+    Q_ASSERT(target != 0);
+    quint32 size = 2;
+
+    while ((int) size < queueSize) {
+        size <<= 1;
+    }
+
+    cells = new Cell[size];
+    mask = size - 1;
+
+    // a free cell holds its position
+    for (quint32 i = 0; i < size; i++)
+    {
+        cells[i].sequence.store(i);
+        cells[i].logMessage = 0;
+    }
+
+    enqueuePos.store(0);
+    clock.start();
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    stopWriter();
+    writePending();
+    delete[] cells;
+}
+
+void AsyncLogger::startWriter()
+{
+    stopRequest.store(0);
+    start();
+}
+
+void AsyncLogger::stopWriter()
+{
+    if (isRunning())
+    {
+        stopRequest.storeRelease(1);
+        wait();
+    }
+}
+
+void AsyncLogger::post(const QtMsgType type, const QString& message, QHash<QString,QString>* logVars, const QString &file, const QString &function, const int line)
+{
+    if (maxPerSecond > 0)
+    {
+        if (!callSites.hasLocalData()) {
+            callSites.setLocalData(new QHash<QString,CallSite>());
+        }
+
+        QString key;
+
+        if (line > 0)
+        {
+            key = file + ":" + QString::number(line);
+        }
+        else
+        {
+            int space = message.indexOf(' ');
+            key = message.left(space < 0 || space > 64 ? 64 : space);
+
+            if (key.endsWith(':')) {
+                key.chop(1);
+            }
+        }
+
+        CallSite& callSite = (*callSites.localData())[key];
+        qint64 now = clock.elapsed();
+
+        if (now - callSite.windowStart >= 1000)
+        {
+            if (callSite.dropped > 0)
+            {
+                push(new LogMessage(QtWarningMsg, QString("AsyncLogger: %1 messages from %2 dropped").arg(callSite.dropped).arg(key),
+                    logVars, file, function, line));
+            }
+
+            callSite.windowStart = now;
+            callSite.count = 0;
+            callSite.dropped = 0;
+        }
+
+        if (callSite.count >= maxPerSecond)
+        {
+            callSite.dropped++;
+            nbRateDropped.ref();
+            return;
+        }
+
+        callSite.count++;
+    }
+
+    push(new LogMessage(type, message, logVars, file, function, line));
+}
+
+void AsyncLogger::push(LogMessage* logMessage)
+{
+    quint32 pos = enqueuePos.load();
+
+    while (true)
+    {
+        Cell& cell = cells[pos & mask];
+        qint32 diff = (qint32) (cell.sequence.loadAcquire() - pos);
+
+        if (diff == 0) // cell is free for this position: claim it
+        {
+            if (enqueuePos.testAndSetRelaxed(pos, pos + 1, pos))
+            {
+                cell.logMessage = logMessage;
+                cell.sequence.storeRelease(pos + 1); // publish
+                return;
+            }
+        }
+        else if (diff < 0) // cell still holds the message of the previous lap: full
+        {
+            delete logMessage;
+            nbQueueDropped.ref();
+            return;
+        }
+        else // another producer claimed this position
+        {
+            pos = enqueuePos.load();
+        }
+    }
+}
+
+LogMessage* AsyncLogger::pop()
+{
+    Cell& cell = cells[dequeuePos & mask];
+
+    if ((qint32) (cell.sequence.loadAcquire() - (dequeuePos + 1)) < 0) {
+        return 0; // not published yet
+    }
+
+    LogMessage* logMessage = cell.logMessage;
+    cell.logMessage = 0;
+    cell.sequence.storeRelease(dequeuePos + mask + 1); // free for the next lap
+    dequeuePos++;
+
+    return logMessage;
+}
+
+int AsyncLogger::writePending()
+{
+    QMutexLocker mutexLocker(&writeMutex);
+    LogMessage* logMessage;
+    int count = 0;
+
+    while ((logMessage = pop()) != 0)
+    {
+        target->writeMessage(logMessage);
+        delete logMessage;
+        count++;
+    }
+
+    quint32 nbDropped = nbQueueDropped.load();
+
+    if (nbDropped != nbQueueDroppedLogged)
+    {
+        LogMessage droppedMessage(QtWarningMsg, QString("AsyncLogger: %1 messages dropped as the queue was full")
+            .arg(nbDropped - nbQueueDroppedLogged), 0, "", "", 0);
+        target->writeMessage(&droppedMessage);
+        nbQueueDroppedLogged = nbDropped;
+    }
+
+    return count;
+}
+
+void AsyncLogger::flush()
+{
+    writePending();
+}
+
+void AsyncLogger::run()
+{
+    while (stopRequest.loadAcquire() == 0)
+    {
+        // poll so that posting never has to wake up the writer
+        if (writePending() == 0) {
+            msleep(10);
+        }
+    }
+
+    writePending();
+}
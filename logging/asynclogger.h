@@ -0,0 +1,159 @@
+/**
+  @file
+  @author f4exb
+*/
+
+#ifndef ASYNCLOGGER_H
+#define ASYNCLOGGER_H
+
+#include <QtGlobal>
+#include <QThread>
+#include <QThreadStorage>
+#include <QHash>
+#include <QMutex>
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include "logglobal.h"
+#include "logmessage.h"
+
+#include "export.h"
+
+namespace qtwebapp {
+
+class Logger;
+
+/**
+  Asynchronous backend of a logger. Logging threads post their messages in a bounded lock-free
+  queue and a single writer thread writes them to the target logger, so that a logging thread
+  (e.g. a DSP thread) never waits for the console or the log file.
+  <p>
+  Posting never blocks: if the queue is full the message is dropped and counted. The number
+  of messages dropped this way is logged by the writer when it can.
+  <p>
+  Each call site may post at most maxPerSecond messages per second in each thread. A call site
+  is identified by its file and line when available (debug builds) else by the first word of
+  the message, usually the "Class::method:" prefix. The excess is dropped and counted and the
+  number of dropped messages is logged with the next message of the call site.
+  <p>
+  Messages keep the time and thread of their creation. The backtrace buffer of the target
+  logger is not used.
+*/
+class LOGGING_API AsyncLogger : public QThread {
+    Q_OBJECT
+    Q_DISABLE_COPY(AsyncLogger)
+public:
+
+    /**
+      Constructor. The writer thread is not started.
+      @param target Logger writing the messages
+      @param queueSize Size of the queue rounded up to a power of 2
+      @param maxPerSecond Maximum messages per second for each call site and thread. 0=unlimited.
+    */
+    AsyncLogger(Logger* target, int queueSize=4096, int maxPerSecond=50);
+
+    /** Destructor. Stops the writer thread after the pending messages are written. */
+    virtual ~AsyncLogger();
+
+    /**
+      Queue a message for the writer thread. This method is thread safe and does not block.
+      @param type Message type (level)
+      @param message Message text
+      @param logVars Logger variables of the calling thread, 0 is allowed
+      @param file Name of the source file where the message was generated
+      @param function Name of the function where the message was generated
+      @param line Line Number of the source file, where the message was generated
+    */
+    void post(const QtMsgType type, const QString& message, QHash<QString,QString>* logVars, const QString &file, const QString &function, const int line);
+
+    /**
+      Write the pending messages in the calling thread. Blocks while the writer thread is writing.
+      Used before a message that must be written synchronously (e.g. fatal).
+    */
+    void flush();
+
+    /** Start the writer thread */
+    void startWriter();
+
+    /** Stop the writer thread after the pending messages are written */
+    void stopWriter();
+
+    /** Number of messages dropped because the queue was full */
+    quint32 getNbQueueDropped() const { return nbQueueDropped.load(); }
+
+    /** Number of messages dropped by the call site rate limit */
+    quint32 getNbRateDropped() const { return nbRateDropped.load(); }
+
+private:
+
+    /** Queue cell. The sequence tells whether the cell is free for a position or holds the message of a position. */
+    struct Cell
+    {
+        QAtomicInteger<quint32> sequence;
+        LogMessage* logMessage;
+    };
+
+    /** Rate limit state of a call site */
+    struct CallSite
+    {
+        qint64 windowStart; //!< start of the current one second window in ms
+        int count;          //!< messages posted in the window
+        int dropped;        //!< messages dropped in the window
+
+        CallSite() : windowStart(0), count(0), dropped(0) {}
+    };
+
+    /** Logger writing the messages */
+    Logger* target;
+
+    /** Queue storage */
+    Cell* cells;
+
+    /** Queue size minus one */
+    quint32 mask;
+
+    /** Next position to fill. Updated by producers. */
+    QAtomicInteger<quint32> enqueuePos;
+
+    /** Next position to read. Updated by the consumer holding writeMutex only. */
+    quint32 dequeuePos;
+
+    /** Serializes the consumer side: writer thread and flush() */
+    QMutex writeMutex;
+
+    /** Set to stop the writer thread */
+    QAtomicInt stopRequest;
+
+    /** Maximum messages per second for each call site and thread */
+    int maxPerSecond;
+
+    /** Time reference of the rate limit windows */
+    QElapsedTimer clock;
+
+    /** Thread local rate limit state by call site */
+    QThreadStorage<QHash<QString,CallSite>*> callSites;
+
+    /** Messages dropped because the queue was full */
+    QAtomicInteger<quint32> nbQueueDropped;
+
+    /** Value of nbQueueDropped last logged */
+    quint32 nbQueueDroppedLogged;
+
+    /** Messages dropped by the rate limit */
+    QAtomicInteger<quint32> nbRateDropped;
+
+    /** Queue a message or drop it if the queue is full. Takes ownership of the message. */
+    void push(LogMessage* logMessage);
+
+    /** Next message or 0 if the queue is empty. Caller must hold writeMutex. */
+    LogMessage* pop();
+
+    /** Write all pending messages. Returns the number of messages written. */
+    int writePending();
+
+    /** Writer thread loop */
+    void run();
+};
+
+} // end of namespace
+
+#endif // ASYNCLOGGER_H
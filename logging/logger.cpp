@@ -46,6 +46,14 @@ void Logger::msgHandler(const QtMsgType type, const QString &message, const QStr
     static QMutex recursiveMutex(QMutex::Recursive);
     static QMutex nonRecursiveMutex(QMutex::NonRecursive);
 
+    // An asynchronous logger only queues the message so calls need not be serialized.
+    // Fatal messages are written synchronously before the program aborts.
+    if (defaultLogger && defaultLogger->isAsync() && (type!=QtFatalMsg))
+    {
+        defaultLogger->log(type, message, file, function, line);
+        return;
+    }
+
     // Prevent multiple threads from calling this method simultaneoulsy.
     // But allow recursive calls, which is required to prevent a deadlock
     // if the logger itself produces an error message.
@@ -108,6 +116,17 @@ void Logger::write(const LogMessage* logMessage)
 }
 
 
+void Logger::writeMessage(const LogMessage* logMessage)
+{
+    mutex.lock();
+    if (logMessage->getType()>=minLevel)
+    {
+        write(logMessage);
+    }
+    mutex.unlock();
+}
+
+
 void Logger::installMsgHandler()
 {
     defaultLogger=this;
@@ -88,6 +88,19 @@ public:
     */
     virtual void log(const QtMsgType type, const QString& message, const QString &file="", const QString &function="", const int line=0);
 
+    /**
+      Write a message already created, if its type>=minLevel. The backtrace buffer is not used.
+      This method is thread safe.
+      @param logMessage Message with its decoration data
+    */
+    virtual void writeMessage(const LogMessage* logMessage);
+
+    /**
+      True if log() only queues the message and is thread safe without locking,
+      so that the global message handler does not need to serialize calls.
+    */
+    virtual bool isAsync() const { return false; }
+
     /**
       Installs this logger as the default message handler, so it
       can be used through the global static logging functions (e.g. qDebug()).
@@ -147,6 +160,9 @@ protected:
     */
     virtual void write(const LogMessage* logMessage);
 
+    /** Thread local variables to be used in log messages */
+    static QThreadStorage<QHash<QString,QString>*> logVars;
+
 private:
 
     /** Pointer to the default logger, used by msgHandler() */
@@ -191,9 +207,6 @@ private:
 
 #endif
 
-    /** Thread local variables to be used in log messages */
-    static QThreadStorage<QHash<QString,QString>*> logVars;
-
     /** Thread local backtrace buffers */
     QThreadStorage<QList<LogMessage*>*> buffers;
 
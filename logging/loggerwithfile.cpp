@@ -10,17 +10,47 @@
 using namespace qtwebapp;
 
 LoggerWithFile::LoggerWithFile(QObject* parent)
-    :Logger(parent), fileLogger(0), useFileFlogger(false)
+    :Logger(parent), fileLogger(0), useFileFlogger(false), asyncLogger(0), async(0)
 {
      consoleLogger = new Logger(this);
 }
 
 LoggerWithFile::~LoggerWithFile()
 {
+    setAsync(false);
+    delete asyncLogger;
     destroyFileLogger();
     delete consoleLogger;
 }
 
+void LoggerWithFile::setAsync(bool async)
+{
+    if (async)
+    {
+        if (!asyncLogger) {
+            asyncLogger = new AsyncLogger(this);
+        }
+
+        if (!asyncLogger->isRunning()) {
+            asyncLogger->startWriter();
+        }
+
+        this->async.store(1);
+    }
+    else if (asyncLogger)
+    {
+        this->async.store(0);
+        asyncLogger->stopWriter();
+        asyncLogger->flush();
+    }
+}
+
+void LoggerWithFile::getDroppedMessages(quint32& queueFull, quint32& rateLimited) const
+{
+    queueFull = asyncLogger ? asyncLogger->getNbQueueDropped() : 0;
+    rateLimited = asyncLogger ? asyncLogger->getNbRateDropped() : 0;
+}
+
 void LoggerWithFile::createOrSetFileLogger(const FileLoggerSettings& settings, const int refreshInterval)
 {
     if (!fileLogger) {
@@ -41,6 +71,34 @@ void LoggerWithFile::destroyFileLogger()
 
 void LoggerWithFile::log(const QtMsgType type, const QString& message, const QString &file, const QString &function, const int line)
 {
+    if (async.load())
+    {
+        // do not queue what would not be written anyway
+        QtMsgType minLevel = consoleLogger->getMinMessageLevel();
+
+        if (fileLogger && useFileFlogger && (fileLogger->getMinMessageLevel() < minLevel)) {
+            minLevel = fileLogger->getMinMessageLevel();
+        }
+
+        if ((type < minLevel) && (type != QtFatalMsg)) { // QtInfoMsg comes after QtFatalMsg in the enum
+            return;
+        }
+
+        if (type == QtFatalMsg)
+        {
+            // the program aborts next: write everything now
+            asyncLogger->flush();
+            LogMessage logMessage(type,message,logVars.localData(),file,function,line);
+            writeMessage(&logMessage);
+        }
+        else
+        {
+            asyncLogger->post(type,message,logVars.localData(),file,function,line);
+        }
+
+        return;
+    }
+
     consoleLogger->log(type,message,file,function,line);
 
     if (fileLogger && useFileFlogger) {
@@ -48,6 +106,15 @@ void LoggerWithFile::log(const QtMsgType type, const QString& message, const QSt
     }
 }
 
+void LoggerWithFile::writeMessage(const LogMessage* logMessage)
+{
+    consoleLogger->writeMessage(logMessage);
+
+    if (fileLogger && useFileFlogger) {
+        fileLogger->writeMessage(logMessage);
+    }
+}
+
 void LoggerWithFile::logToFile(const QtMsgType type, const QString& message, const QString &file, const QString &function, const int line)
 {
     if (fileLogger && useFileFlogger) {
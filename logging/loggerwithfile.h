@@ -11,6 +11,7 @@
 #include <QtGlobal>
 #include "logger.h"
 #include "filelogger.h"
+#include "asynclogger.h"
 
 #include "export.h"
 
@@ -45,6 +46,20 @@ public:
     */
     virtual void log(const QtMsgType type, const QString& message, const QString &file="", const QString &function="", const int line=0);
 
+    /**
+      Write a message already created to the console and file loggers.
+      This method is thread safe.
+    */
+    virtual void writeMessage(const LogMessage* logMessage);
+
+    /**
+      Switch between synchronous logging and asynchronous logging where messages are written by a
+      writer thread (see AsyncLogger). Switching off writes the pending messages.
+      Call from the main thread, e.g. after installMsgHandler() and before the program exits.
+    */
+    void setAsync(bool async);
+    virtual bool isAsync() const { return async.load() != 0; }
+
     /**
       Clear the thread-local data of the current thread.
       This method is thread safe.
@@ -76,6 +91,9 @@ public:
     void getFileMinMessageLevelStr(QString& levelStr);
     void getLogFileName(QString& fileName);
 
+    /** Messages dropped in asynchronous mode because the queue was full or by the call site rate limit */
+    void getDroppedMessages(quint32& queueFull, quint32& rateLimited) const;
+
     /** This will log to file only */
     void logToFile(const QtMsgType type, const QString& message, const QString &file="", const QString &function="", const int line=0);
 
@@ -88,6 +106,12 @@ private:
 
     /** Use file logger indicator */
     bool useFileFlogger;
+
+    /** Asynchronous backend, kept once created so that a thread posting while switching to synchronous is safe */
+    AsyncLogger* asyncLogger;
+
+    /** Asynchronous mode indicator */
+    QAtomicInt async;
 };
 
 } // end of namespace
@@ -67,9 +67,9 @@ QString LogMessage::toString(const QString& msgFormat, const QString& timestampF
     decorated.replace("{function}",function);
     decorated.replace("{line}",QString::number(line));
 
-    QString threadId;
-    threadId.setNum((std::size_t)QThread::currentThreadId());
-    decorated.replace("{thread}",threadId);
+    QString threadIdStr;
+    threadIdStr.setNum((std::size_t)threadId);
+    decorated.replace("{thread}",threadIdStr);
 
     // Fill in variables
     if (decorated.contains("{") && !logVars.isEmpty())
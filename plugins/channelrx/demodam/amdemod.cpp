@@ -278,7 +278,7 @@ void AMDemod::processOneSample(Complex &ci)
     m_audioBuffer[m_audioBufferFill].r = sample;
     ++m_audioBufferFill;
 
-    if (m_audioBufferFill >= m_audioBuffer.size())
+    if (m_audioBufferFill >= m_audioFifo.getWriteBlockSize(m_audioBuffer.size()))
     {
         uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
@@ -743,6 +743,10 @@ void AMDemod::webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response)
     response.getAmDemodReport()->setSquelch(m_squelchOpen ? 1 : 0);
     response.getAmDemodReport()->setAudioSampleRate(m_audioSampleRate);
     response.getAmDemodReport()->setChannelSampleRate(m_inputSampleRate);
+    response.getAmDemodReport()->setAudioFifoFillMin(m_audioFifo.getFillMin());
+    response.getAmDemodReport()->setAudioFifoFillMax(m_audioFifo.getFillMax());
+    response.getAmDemodReport()->setAudioFifoUnderruns(m_audioFifo.getUnderrunCount());
+    response.getAmDemodReport()->setAudioFifoOverruns(m_audioFifo.getOverrunCount());
 }
 
 void AMDemod::webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const AMDemodSettings& settings, bool force)
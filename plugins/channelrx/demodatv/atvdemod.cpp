@@ -20,6 +20,11 @@
 #include <QDebug>
 #include <stdio.h>
 #include <complex.h>
+#include <algorithm>
+
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
 
 #include "audio/audiooutput.h"
 #include "dsp/dspengine.h"
@@ -60,6 +65,10 @@ ATVDemod::ATVDemod(DeviceAPI *deviceAPI) :
         m_intRowIndex(0),
         m_intLineIndex(0),
         m_objAvgColIndex(3),
+        m_videoRawIndex(0),
+        m_lineRow(-1),
+        m_lineColStart(0),
+        m_lineNbPixels(0),
         m_bfoPLL(200/1000000, 100/1000000, 0.01),
         m_bfoFilter(200.0, 1000000.0, 0.9),
         m_interpolatorDistance(1.0f),
@@ -81,6 +90,11 @@ ATVDemod::ATVDemod(DeviceAPI *deviceAPI) :
     m_DSBFilterBuffer = new Complex[m_ssbFftLen];
     memset(m_DSBFilterBuffer, 0, sizeof(Complex)*(m_ssbFftLen));
 
+    m_videoRaw.resize(m_videoBlockSize);
+    m_videoLuma.resize(m_videoBlockSize);
+    m_videoGray.resize(m_videoBlockSize);
+    m_lineBuffer.resize(TVScreen::TV_COLS);
+
     memset((void*)m_fltBufferI,0,6*sizeof(float));
     memset((void*)m_fltBufferQ,0,6*sizeof(float));
 
@@ -219,16 +233,26 @@ void ATVDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
         {
             if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
             {
-                demod(ci);
+                m_videoRaw[m_videoRawIndex++] = demod(ci);
                 m_interpolatorDistanceRemain += m_interpolatorDistance;
             }
         }
         else
         {
-            demod(c);
+            m_videoRaw[m_videoRawIndex++] = demod(c);
+        }
+
+        if (m_videoRawIndex == m_videoBlockSize) {
+            processVideo();
         }
     }
 
+    processVideo();
+
+    if (m_registeredTVScreen) {
+        flushLine();
+    }
+
     if ((m_running.m_intVideoTabIndex == 1) && (m_scopeSink != 0)) // do only if scope tab is selected and scope is available
     {
         m_scopeSink->feed(m_scopeSampleBuffer.begin(), m_scopeSampleBuffer.end(), false); // m_ssb = positive only
@@ -245,14 +269,12 @@ void ATVDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
     m_objSettingsMutex.unlock();
 }
 
-void ATVDemod::demod(Complex& c)
+float ATVDemod::demod(Complex& c)
 {
-    float fltDivSynchroBlack = 1.0f - m_running.m_fltVoltLevelSynchroBlack;
     float fltNormI;
     float fltNormQ;
     float fltNorm;
     float fltVal;
-    int intVal;
 
     //********** FFT filtering **********
 
@@ -340,22 +362,6 @@ void ATVDemod::demod(Complex& c)
         m_objMagSqAverage(magSq);
         fltNorm = sqrt(magSq);
         fltVal = fltNorm / SDR_RX_SCALEF;
-
-        //********** Mini and Maxi Amplitude tracking **********
-
-        if(fltVal<m_fltEffMin)
-        {
-            m_fltEffMin=fltVal;
-        }
-
-        if(fltVal>m_fltEffMax)
-        {
-            m_fltEffMax=fltVal;
-        }
-
-        //Normalisation
-        fltVal -= m_fltAmpMin;
-        fltVal /=m_fltAmpDelta;
     }
     else if ((m_rfRunning.m_enmModulation == ATV_USB) || (m_rfRunning.m_enmModulation == ATV_LSB))
     {
@@ -377,22 +383,6 @@ void ATVDemod::demod(Complex& c)
         } else {
             fltVal = (mixI - mixQ);
         }
-
-        //********** Mini and Maxi Amplitude tracking **********
-
-        if(fltVal<m_fltEffMin)
-        {
-            m_fltEffMin=fltVal;
-        }
-
-        if(fltVal>m_fltEffMax)
-        {
-            m_fltEffMax=fltVal;
-        }
-
-        //Normalisation
-        fltVal -= m_fltAmpMin;
-        fltVal /=m_fltAmpDelta;
     }
     else if (m_rfRunning.m_enmModulation == ATV_FM3)
     {
@@ -410,37 +400,272 @@ void ATVDemod::demod(Complex& c)
         fltVal = 0.0f;
     }
 
-    fltVal = m_running.m_blnInvertVideo ? 1.0f - fltVal : fltVal;
-    fltVal = (fltVal < -1.0f) ? -1.0f : (fltVal > 1.0f) ? 1.0f : fltVal;
+    return fltVal;
+}
+
+void ATVDemod::processVideo()
+{
+    int index = 0;
+
+    while (index < m_videoRawIndex)
+    {
+        // normalization may change on a new line only so process up to and including the next new line sample
+        int end = index + std::min(m_videoRawIndex - index, samplesToNewLine());
+        normalizeVideo(index, end);
 
-    if ((m_running.m_intVideoTabIndex == 1) && (m_scopeSink != 0)) { // feed scope buffer only if scope is present and visible
-        m_scopeSampleBuffer.push_back(Sample(fltVal*SDR_RX_SCALEF, 0.0f));
+        if (m_registeredTVScreen) // can process only if the screen is available (set via the GUI)
+        {
+            int i = index;
+
+            while (i < end)
+            {
+                // go through stretches without sync events at once
+                int nbQuiet = m_running.m_enmATVStandard == ATVStdHSkip ? processHSkipQuiet(i, end) : processClassicQuiet(i, end);
+
+                if (nbQuiet > 0)
+                {
+                    i += nbQuiet;
+                }
+                else
+                {
+                    if (m_running.m_enmATVStandard == ATVStdHSkip) {
+                        processHSkip(m_videoLuma[i], m_videoGray[i]);
+                    } else {
+                        processClassic(m_videoLuma[i], m_videoGray[i]);
+                    }
+
+                    i++;
+                }
+            }
+        }
+
+        index = end;
     }
 
-    m_fltAmpLineAverage += fltVal;
+    m_videoRawIndex = 0;
+}
 
-    //********** gray level **********
-    //-0.3 -> 0.7
-    intVal = (int) 255.0*(fltVal - m_running.m_fltVoltLevelSynchroBlack) / fltDivSynchroBlack;
+void ATVDemod::normalizeVideo(int begin, int end)
+{
+    float fltBlack = m_running.m_fltVoltLevelSynchroBlack;
+    float fltDivSynchroBlack = 1.0f - fltBlack;
+    float fltOffset = 0.0f;
+    float fltDelta = 1.0f;
 
-    //0 -> 255
-    if(intVal<0)
+    if ((m_rfRunning.m_enmModulation == ATV_AM)
+        || (m_rfRunning.m_enmModulation == ATV_USB)
+        || (m_rfRunning.m_enmModulation == ATV_LSB))
     {
-        intVal=0;
+        //********** Mini and Maxi Amplitude tracking **********
+
+        for (int i = begin; i < end; i++)
+        {
+            m_fltEffMin = m_videoRaw[i] < m_fltEffMin ? m_videoRaw[i] : m_fltEffMin;
+            m_fltEffMax = m_videoRaw[i] > m_fltEffMax ? m_videoRaw[i] : m_fltEffMax;
+        }
+
+        fltOffset = m_fltAmpMin;
+        fltDelta = m_fltAmpDelta;
     }
-    else if(intVal>255)
+
+    // branchless so that it vectorizes
+    float fltInvertOffset = m_running.m_blnInvertVideo ? 1.0f : 0.0f;
+    float fltInvertSign = m_running.m_blnInvertVideo ? -1.0f : 1.0f;
+    const float *raw = m_videoRaw.data();
+    float *luma = m_videoLuma.data();
+    unsigned char *gray = m_videoGray.data();
+
+    for (int i = begin; i < end; i++)
     {
-        intVal=255;
+        //Normalisation
+        float fltVal = fltInvertOffset + fltInvertSign * ((raw[i] - fltOffset) / fltDelta);
+        fltVal = fltVal < -1.0f ? -1.0f : fltVal;
+        fltVal = fltVal > 1.0f ? 1.0f : fltVal;
+        luma[i] = fltVal;
+
+        //********** gray level **********
+        //-0.3 -> 0.7
+        int intVal = (int) (255.0f*(fltVal - fltBlack) / fltDivSynchroBlack);
+        //0 -> 255
+        intVal = intVal < 0 ? 0 : intVal;
+        gray[i] = intVal > 255 ? 255 : intVal;
     }
 
-    //********** process video sample **********
+    if ((m_running.m_intVideoTabIndex == 1) && (m_scopeSink != 0)) // feed scope buffer only if scope is present and visible
+    {
+        for (int i = begin; i < end; i++) {
+            m_scopeSampleBuffer.push_back(Sample(luma[i]*SDR_RX_SCALEF, 0.0f));
+        }
+    }
+}
+
+int ATVDemod::samplesToNewLine() const
+{
+    int intLineEnd;
+
+    if (m_running.m_enmATVStandard == ATVStdHSkip) {
+        intLineEnd = m_runningPrivate.m_intNumberSamplePerLine + m_intNumberSamplePerTop - 1;
+    } else if (m_running.m_blnHSync) {
+        intLineEnd = m_runningPrivate.m_intNumberSamplePerLine + m_intNumberSamplePerTop;
+    } else {
+        intLineEnd = m_runningPrivate.m_intNumberSamplePerLine;
+    }
+
+    return (m_intColIndex < intLineEnd ? intLineEnd - m_intColIndex : 0) + 1;
+}
+
+int ATVDemod::scanSynchroTop(int begin, int nbSamples) const
+{
+    const float *luma = &m_videoLuma[begin];
+    float fltTop = m_running.m_fltVoltLevelSynchroTop;
+    int i = 0;
+
+#if defined(USE_SSE2)
+    __m128 top = _mm_set1_ps(fltTop);
 
-    if (m_registeredTVScreen) // can process only if the screen is available (set via the GUI)
+    for (; i + 4 <= nbSamples; i += 4)
     {
-        if (m_running.m_enmATVStandard == ATVStdHSkip) {
-            processHSkip(fltVal, intVal);
-        } else {
-            processClassic(fltVal, intVal);
+        int mask = _mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(&luma[i]), top));
+
+        if (mask)
+        {
+            for (; !(mask & 1); mask >>= 1, i++);
+            return i;
+        }
+    }
+#endif
+
+    for (; i < nbSamples; i++)
+    {
+        if (luma[i] < fltTop) {
+            return i;
+        }
+    }
+
+    return nbSamples;
+}
+
+int ATVDemod::processClassicQuiet(int begin, int end)
+{
+    // While no synchro pulse is in progress only a sample below top level may start one
+    if (m_intSynchroPoints != 0) {
+        return 0;
+    }
+
+    bool blnVSyncCheck = (m_running.m_blnVSync) && (m_intLineIndex < m_intNumberOfLines);
+
+    if (!blnVSyncCheck && (m_intLineIndex >= m_intNumberOfLines/2)) { // arbitrary image start
+        return 0;
+    }
+
+    int nbSamples = std::min(end - begin, samplesToNewLine() - 1); // stop before the new line sample
+
+    if (nbSamples <= 0) {
+        return 0;
+    }
+
+    nbSamples = scanSynchroTop(begin, nbSamples);
+    const float *luma = &m_videoLuma[begin];
+    int i = 0;
+
+    if (blnVSyncCheck)
+    {
+        // stop at the vertical synchro start in the synchro check part of the line
+        int intSynchroTimeSamples = (3 * m_runningPrivate.m_intNumberSamplePerLine)/4;
+        float fltSynchroTrameLevel =  0.5f*((float)intSynchroTimeSamples) * m_running.m_fltVoltLevelSynchroBlack;
+        int nbNoCheck = intSynchroTimeSamples - 1 - m_intColIndex;
+        nbNoCheck = nbNoCheck < 0 ? 0 : nbNoCheck > nbSamples ? nbSamples : nbNoCheck;
+
+        for (; i < nbNoCheck; i++) {
+            m_fltAmpLineAverage += luma[i];
+        }
+
+        for (; i < nbSamples; i++)
+        {
+            float fltAmpLineAverage = m_fltAmpLineAverage + luma[i];
+
+            if (fltAmpLineAverage > fltSynchroTrameLevel)
+            {
+                m_blnVerticalSynchroDetected = false;
+                m_fltAmpLineAverage = fltAmpLineAverage;
+            }
+            else if (m_blnVerticalSynchroDetected) // already detected
+            {
+                m_fltAmpLineAverage = 0.0f;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        nbSamples = i;
+    }
+    else
+    {
+        for (; i < nbSamples; i++) {
+            m_fltAmpLineAverage += luma[i];
+        }
+    }
+
+    setPixels(m_intColIndex - m_intNumberSaplesPerHSync + m_intNumberSamplePerTop + 4, &m_videoGray[begin], nbSamples);
+    m_intColIndex += nbSamples;
+    m_intSampleIndex += nbSamples;
+
+    return nbSamples;
+}
+
+int ATVDemod::processHSkipQuiet(int begin, int end)
+{
+    // While no synchro pulse is in progress only a sample below top level may start one
+    if (m_intSynchroPoints != 0) {
+        return 0;
+    }
+
+    int nbSamples = std::min(end - begin, samplesToNewLine() - 1); // stop before the new line sample
+
+    if (nbSamples <= 0) {
+        return 0;
+    }
+
+    nbSamples = scanSynchroTop(begin, nbSamples);
+    setPixels(m_intColIndex - m_intNumberSaplesPerHSync + m_intNumberSamplePerTop, &m_videoGray[begin], nbSamples);
+    m_intColIndex += nbSamples;
+    m_intSampleIndex += nbSamples;
+
+    return nbSamples;
+}
+
+void ATVDemod::flushLine()
+{
+    if (m_lineNbPixels > 0)
+    {
+        m_registeredTVScreen->setDataLine(m_lineRow, m_lineColStart, m_lineBuffer.data(), m_lineNbPixels);
+        m_lineNbPixels = 0;
+    }
+}
+
+void ATVDemod::setPixels(int intCol, const unsigned char *grays, int nbPixels)
+{
+    if ((m_lineNbPixels > 0) && (intCol != m_lineColStart + m_lineNbPixels)) {
+        flushLine();
+    }
+
+    while (nbPixels > 0)
+    {
+        if (m_lineNbPixels == 0) {
+            m_lineColStart = intCol;
+        }
+
+        int nbCopy = std::min(nbPixels, (int) m_lineBuffer.size() - m_lineNbPixels);
+        std::copy(grays, grays + nbCopy, m_lineBuffer.begin() + m_lineNbPixels);
+        m_lineNbPixels += nbCopy;
+        intCol += nbCopy;
+        grays += nbCopy;
+        nbPixels -= nbCopy;
+
+        if (m_lineNbPixels == (int) m_lineBuffer.size()) {
+            flushLine();
         }
     }
 }
@@ -630,6 +855,13 @@ void ATVDemod::applySettings()
         m_intColIndex=0;
         m_intRowIndex=0;
 
+        if (m_registeredTVScreen) {
+            flushLine();
+        }
+
+        m_lineNbPixels = 0;
+        m_lineBuffer.resize(std::max(m_configPrivate.m_intNumberSamplePerLine + m_intNumberSamplePerTop, (int) TVScreen::TV_COLS));
+
         m_objSettingsMutex.unlock();
     }
 
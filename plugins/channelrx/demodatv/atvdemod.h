@@ -467,6 +467,18 @@ private:
 
     SampleVector m_sampleBuffer;
 
+    //*************** LINE BUFFERS  ***************
+
+    static const int m_videoBlockSize = 4096;
+    std::vector<float> m_videoRaw;           //!< demodulated samples before normalization
+    std::vector<float> m_videoLuma;          //!< normalized video
+    std::vector<unsigned char> m_videoGray;  //!< gray levels
+    int m_videoRawIndex;
+    std::vector<unsigned char> m_lineBuffer; //!< pixels of the selected row not yet handed to the screen
+    int m_lineRow;                           //!< selected row (-1 for none)
+    int m_lineColStart;                      //!< column of the first pixel in the line buffer
+    int m_lineNbPixels;                      //!< pixels in the line buffer
+
     //*************** RF  ***************
 
     MovingAverageUtil<double, double, 32> m_objMagSqAverage;
@@ -504,12 +516,47 @@ private:
 
     void applySettings();
     void applyStandard();
-    void demod(Complex& c);
+    float demod(Complex& c); //!< returns the video sample before normalization
+    void processVideo();
+    void normalizeVideo(int begin, int end);
+    int samplesToNewLine() const;
+    int scanSynchroTop(int begin, int nbSamples) const;
+    int processClassicQuiet(int begin, int end);
+    int processHSkipQuiet(int begin, int end);
+    void flushLine();
+    void setPixels(int intCol, const unsigned char *grays, int nbPixels);
     static float getRFBandwidthDivisor(ATVModulation modulation);
 
-    inline void processHSkip(float& fltVal, int& intVal)
+    inline void selectRow(int intRow)
+    {
+        flushLine();
+        m_lineRow = intRow;
+    }
+
+    inline void setPixel(int intCol, int intVal)
+    {
+        if ((m_lineNbPixels > 0)
+            && ((intCol != m_lineColStart + m_lineNbPixels) || (m_lineNbPixels == (int) m_lineBuffer.size())))
+        {
+            flushLine();
+        }
+
+        if (m_lineNbPixels == 0) {
+            m_lineColStart = intCol;
+        }
+
+        m_lineBuffer[m_lineNbPixels++] = intVal;
+    }
+
+    inline void renderImage()
     {
-        m_registeredTVScreen->setDataColor(m_intColIndex - m_intNumberSaplesPerHSync + m_intNumberSamplePerTop, intVal, intVal, intVal);
+        flushLine();
+        m_registeredTVScreen->renderImage(0);
+    }
+
+    inline void processHSkip(float fltVal, int intVal)
+    {
+        setPixel(m_intColIndex - m_intNumberSaplesPerHSync + m_intNumberSamplePerTop, intVal);
 
         // Horizontal Synchro detection
 
@@ -534,7 +581,7 @@ private:
             {
                 //qDebug("VSync: %d %d %d", m_intColIndex, m_intSampleIndex, m_intLineIndex);
                 m_intAvgColIndex = m_intColIndex;
-                m_registeredTVScreen->renderImage(0);
+                renderImage();
 
                 m_intImageIndex++;
                 m_intLineIndex = 0;
@@ -582,17 +629,19 @@ private:
                 m_fltEffMax = -2000000.0f;
             }
 
-            m_registeredTVScreen->selectRow(m_intRowIndex);
+            selectRow(m_intRowIndex);
             m_intLineIndex++;
             m_intRowIndex++;
         }
     }
 
-    inline void processClassic(float& fltVal, int& intVal)
+    inline void processClassic(float fltVal, int intVal)
     {
         int intSynchroTimeSamples= (3 * m_runningPrivate.m_intNumberSamplePerLine)/4;
         float fltSynchroTrameLevel =  0.5f*((float)intSynchroTimeSamples) * m_running.m_fltVoltLevelSynchroBlack;
 
+        m_fltAmpLineAverage += fltVal;
+
         // Horizontal Synchro detection
 
         // Floor Detection 0
@@ -670,7 +719,7 @@ private:
 
             if (m_intRowIndex < m_intNumberOfLines)
             {
-                m_registeredTVScreen->selectRow(m_intRowIndex - m_intNumberOfSyncLines);
+                selectRow(m_intRowIndex - m_intNumberOfSyncLines);
             }
 
             m_intLineIndex++;
@@ -679,7 +728,7 @@ private:
         // Filling pixels
 
         // +4 is to compensate shift due to hsync amortizing factor of 1/4
-        m_registeredTVScreen->setDataColor(m_intColIndex - m_intNumberSaplesPerHSync + m_intNumberSamplePerTop + 4, intVal, intVal, intVal);
+        setPixel(m_intColIndex - m_intNumberSaplesPerHSync + m_intNumberSamplePerTop + 4, intVal);
         m_intColIndex++;
 
         // Vertical sync and image rendering
@@ -698,7 +747,7 @@ private:
 
                         if ((m_intLineIndex % 2 == 0) || !m_interleaved) // even => odd image
                         {
-                            m_registeredTVScreen->renderImage(0);
+                            renderImage();
                             m_intRowIndex = 1;
                         }
                         else
@@ -706,7 +755,7 @@ private:
                             m_intRowIndex = 0;
                         }
 
-                        m_registeredTVScreen->selectRow(m_intRowIndex - m_intNumberOfSyncLines);
+                        selectRow(m_intRowIndex - m_intNumberOfSyncLines);
                         m_intLineIndex = 0;
                         m_intImageIndex++;
                     }
@@ -723,7 +772,7 @@ private:
             {
                 if (m_intImageIndex % 2 == 1) // odd image
                 {
-                    m_registeredTVScreen->renderImage(0);
+                    renderImage();
 
                     if (m_rfRunning.m_enmModulation == ATV_AM)
                     {
@@ -748,7 +797,7 @@ private:
                     m_intRowIndex = 0;
                 }
 
-                m_registeredTVScreen->selectRow(m_intRowIndex - m_intNumberOfSyncLines);
+                selectRow(m_intRowIndex - m_intNumberOfSyncLines);
                 m_intLineIndex = 0;
                 m_intImageIndex++;
             }
@@ -22,6 +22,7 @@
 #include "leansdr/dvbs2.h"
 
 #include <QTime>
+#include <QThread>
 #include <QDebug>
 #include <stdio.h>
 #include <complex.h>
@@ -46,7 +47,6 @@ DATVDemod::DATVDemod(DeviceAPI *deviceAPI) :
     m_objRegisteredTVScreen(0),
     m_objRegisteredVideoRender(0),
     m_objVideoStream(nullptr),
-    m_udpStream(leansdr::tspacket::SIZE),
     m_objRenderThread(nullptr),
     m_audioFifo(48000),
     m_blnRenderingVideo(false),
@@ -54,6 +54,7 @@ DATVDemod::DATVDemod(DeviceAPI *deviceAPI) :
     m_cstlnSetByModcod(false),
     m_modcodModulation(-1),
     m_modcodCodeRate(-1),
+    m_nbDroppedRawIQ(0),
     m_enmModulation(DATVDemodSettings::BPSK /*DATV_FM1*/),
     m_sampleRate(1024000),
     m_objSettingsMutex(QMutex::NonRecursive)
@@ -84,7 +85,7 @@ DATVDemod::~DATVDemod()
     if(m_objVideoStream!=nullptr)
     {
         //Immediately exit from DATVideoStream if waiting for data before killing thread
-        m_objVideoStream->ThreadTimeOut=0;
+        m_objVideoStream->setThreadTimeout(0);
     }
 
     DSPEngine::instance()->getAudioDeviceManager()->removeAudioSink(&m_audioFifo);
@@ -194,8 +195,7 @@ bool DATVDemod::PlayVideo(bool blnStartStop)
     if (m_objVideoStream->bytesAvailable() > 0)
     {
         m_objRenderThread->setStreamAndRenderer(m_objRegisteredVideoRender, m_objVideoStream);
-        m_objVideoStream->MultiThreaded = true;
-        m_objVideoStream->ThreadTimeOut = 5000; //5000 ms
+        m_objVideoStream->setThreadTimeout(5000); //5000 ms
         m_objRenderThread->start();
     }
 
@@ -405,7 +405,11 @@ void DATVDemod::CleanUpDATVFramework(bool blnRelease)
 
         if(p_fecframes != nullptr)
         {
-            delete (leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> >*) p_fecframes;
+            if (m_softLDPCFramework) {
+                delete (leansdr::pipebuf< leansdr::fecframe<leansdr::llr_sb> >*) p_fecframes;
+            } else {
+                delete (leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> >*) p_fecframes;
+            }
         }
 
         if(p_bbframes != nullptr)
@@ -415,12 +419,20 @@ void DATVDemod::CleanUpDATVFramework(bool blnRelease)
 
         if(p_s2_deinterleaver != nullptr)
         {
-            delete (leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::hard_sb>*) p_s2_deinterleaver;
+            if (m_softLDPCFramework) {
+                delete (leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::llr_sb>*) p_s2_deinterleaver;
+            } else {
+                delete (leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::hard_sb>*) p_s2_deinterleaver;
+            }
         }
 
         if(r_fecdec != nullptr)
         {
-            delete (leansdr::s2_fecdec<bool, leansdr::hard_sb>*) r_fecdec;
+            if (m_softLDPCFramework) {
+                delete (leansdr::s2_fecdec<leansdr::llr_t, leansdr::llr_sb>*) r_fecdec;
+            } else {
+                delete (leansdr::s2_fecdec<bool, leansdr::hard_sb>*) r_fecdec;
+            }
         }
 
         if(p_deframer != nullptr)
@@ -535,6 +547,7 @@ void DATVDemod::CleanUpDATVFramework(bool blnRelease)
     p_s2_deinterleaver = nullptr;
     r_fecdec = nullptr;
     p_deframer = nullptr;
+    m_softLDPCFramework = false;
     r_scope_symbols_dvbs2 = nullptr;
 }
 
@@ -862,6 +875,20 @@ void DATVDemod::InitDATVFramework()
     // OUTPUT
     r_videoplayer = new leansdr::datvvideoplayer<leansdr::tspacket>(m_objScheduler, *p_tspackets, m_objVideoStream, &m_udpStream);
 
+    if (m_settings.m_multiThreaded)
+    {
+        // Front end stays in group 0. Decoder and TS output each get a thread.
+        m_objScheduler->end_construction();
+        m_objScheduler->set_group(r, 1);
+        m_objScheduler->set_group(r_deconv, 1);
+        m_objScheduler->set_group(r_sync_mpeg, 1);
+        m_objScheduler->set_group(r_deinter, 1);
+        m_objScheduler->set_group(r_rsdec, 1);
+        m_objScheduler->set_group(r_derand, 2);
+        m_objScheduler->set_group(r_videoplayer, 2);
+        m_objScheduler->start_threads();
+    }
+
     m_blnDVBInitialized = true;
 }
 
@@ -1100,31 +1127,61 @@ void DATVDemod::InitDATVS2Framework()
         r_scope_symbols_dvbs2->calculate_cstln_points();
     }
 
-    // Bit-flipping mode.
-    // Deinterleave into hard bits.
-
     p_bbframes = new leansdr::pipebuf<leansdr::bbframe>(m_objScheduler, "BB frames", BUF_FRAMES);
+    p_vbitcount= new leansdr::pipebuf<int>(m_objScheduler, "Bits processed", BUF_S2PACKETS);
+    p_verrcount = new leansdr::pipebuf<int>(m_objScheduler, "Bits corrected", BUF_S2PACKETS);
+    m_softLDPCFramework = m_settings.m_softLDPC;
 
-    p_fecframes = new leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> >(m_objScheduler, "FEC frames", BUF_FRAMES);
+    if (m_softLDPCFramework)
+    {
+        // Soft decision mode.
+        // Deinterleave into LLRs and decode with layered min-sum.
+        // Several FEC frames are decoded in parallel.
 
-    p_s2_deinterleaver = new leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::hard_sb>(
-        m_objScheduler,
-        *(leansdr::pipebuf< leansdr::plslot<leansdr::llr_ss> > *) p_slots_dvbs2,
-        *(leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> > * ) p_fecframes
-    );
+        p_fecframes = new leansdr::pipebuf< leansdr::fecframe<leansdr::llr_sb> >(m_objScheduler, "FEC frames", BUF_FRAMES);
 
-    p_vbitcount= new leansdr::pipebuf<int>(m_objScheduler, "Bits processed", BUF_S2PACKETS);
-    p_verrcount = new leansdr::pipebuf<int>(m_objScheduler, "Bits corrected", BUF_S2PACKETS);
+        p_s2_deinterleaver = new leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::llr_sb>(
+            m_objScheduler,
+            *(leansdr::pipebuf< leansdr::plslot<leansdr::llr_ss> > *) p_slots_dvbs2,
+            *(leansdr::pipebuf< leansdr::fecframe<leansdr::llr_sb> > * ) p_fecframes
+        );
+
+        r_fecdec =  new leansdr::s2_fecdec<leansdr::llr_t, leansdr::llr_sb>(
+            m_objScheduler, *(leansdr::pipebuf< leansdr::fecframe<leansdr::llr_sb> > * ) p_fecframes,
+            *(leansdr::pipebuf<leansdr::bbframe> *) p_bbframes,
+            p_vbitcount,
+            p_verrcount
+        );
+        leansdr::s2_fecdec<leansdr::llr_t, leansdr::llr_sb> *fecdec = (leansdr::s2_fecdec<leansdr::llr_t, leansdr::llr_sb> * ) r_fecdec;
+
+        fecdec->max_iterations = m_settings.m_maxLDPCIterations;
+        fecdec->nthreads = std::min(4, std::max(1, QThread::idealThreadCount() / 2));
+        qDebug("DATVDemod::InitDATVS2Framework: soft LDPC: %d iterations max on %d threads",
+            fecdec->max_iterations, fecdec->nthreads);
+    }
+    else
+    {
+        // Bit-flipping mode.
+        // Deinterleave into hard bits.
 
-    r_fecdec =  new leansdr::s2_fecdec<bool, leansdr::hard_sb>(
-        m_objScheduler, *(leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> > * ) p_fecframes,
-        *(leansdr::pipebuf<leansdr::bbframe> *) p_bbframes,
-        p_vbitcount,
-        p_verrcount
-    );
-    leansdr::s2_fecdec<bool, leansdr::hard_sb> *fecdec = (leansdr::s2_fecdec<bool, leansdr::hard_sb> * ) r_fecdec;
+        p_fecframes = new leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> >(m_objScheduler, "FEC frames", BUF_FRAMES);
 
-    fecdec->bitflips=0;
+        p_s2_deinterleaver = new leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::hard_sb>(
+            m_objScheduler,
+            *(leansdr::pipebuf< leansdr::plslot<leansdr::llr_ss> > *) p_slots_dvbs2,
+            *(leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> > * ) p_fecframes
+        );
+
+        r_fecdec =  new leansdr::s2_fecdec<bool, leansdr::hard_sb>(
+            m_objScheduler, *(leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> > * ) p_fecframes,
+            *(leansdr::pipebuf<leansdr::bbframe> *) p_bbframes,
+            p_vbitcount,
+            p_verrcount
+        );
+        leansdr::s2_fecdec<bool, leansdr::hard_sb> *fecdec = (leansdr::s2_fecdec<bool, leansdr::hard_sb> * ) r_fecdec;
+
+        fecdec->bitflips=0;
+    }
 
     /*
     fecdec->bitflips = cfg.ldpc_bf; //int TODO
@@ -1147,6 +1204,27 @@ void DATVDemod::InitDATVS2Framework()
     // OUTPUT
     r_videoplayer = new leansdr::datvvideoplayer<leansdr::tspacket>(m_objScheduler, *p_tspackets, m_objVideoStream, &m_udpStream);
 
+    if (m_settings.m_multiThreaded)
+    {
+        // Front end stays in group 0. LDPC decoder and TS output each get a thread.
+        m_objScheduler->end_construction();
+
+        if (m_softLDPCFramework)
+        {
+            m_objScheduler->set_group((leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::llr_sb>*) p_s2_deinterleaver, 1);
+            m_objScheduler->set_group((leansdr::s2_fecdec<leansdr::llr_t, leansdr::llr_sb>*) r_fecdec, 1);
+        }
+        else
+        {
+            m_objScheduler->set_group((leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::hard_sb>*) p_s2_deinterleaver, 1);
+            m_objScheduler->set_group((leansdr::s2_fecdec<bool, leansdr::hard_sb>*) r_fecdec, 1);
+        }
+
+        m_objScheduler->set_group((leansdr::s2_deframer*) p_deframer, 2);
+        m_objScheduler->set_group(r_videoplayer, 2);
+        m_objScheduler->start_threads();
+    }
+
     m_blnDVBInitialized = true;
 }
 
@@ -1204,6 +1282,8 @@ void DATVDemod::feed(const SampleVector::const_iterator& begin, const SampleVect
             qDebug("DATVDemod::feed: Settings applied. Standard : %d...", m_settings.m_standard);
             m_objSettingsMutex.lock();
             m_blnNeedConfigUpdate=false;
+            m_rawIQBuffer.clear();
+            m_nbDroppedRawIQ = 0;
 
             if(m_settings.m_standard==DATVDemodSettings::DVB_S2)
             {
@@ -1238,6 +1318,13 @@ void DATVDemod::feed(const SampleVector::const_iterator& begin, const SampleVect
             objRF ++;
 
             if (m_blnDVBInitialized
+               && (p_rawiq_writer!=nullptr)
+               && (m_objScheduler!=nullptr)
+               && m_objScheduler->threaded())
+            {
+                m_rawIQBuffer.push_back(objIQ);
+            }
+            else if (m_blnDVBInitialized
                && (p_rawiq_writer!=nullptr)
                && (m_objScheduler!=nullptr))
             {
@@ -1261,33 +1348,75 @@ void DATVDemod::feed(const SampleVector::const_iterator& begin, const SampleVect
         }
     } // Samples for loop
 
+    if (m_rawIQBuffer.size() > 0) {
+        pushRawIQ();
+    }
+
     // DVBS2: Track change of constellation via MODCOD
+    // The receiver replaces its constellation on the scheduler thread: only use its published status
     if (m_settings.m_standard==DATVDemodSettings::DVB_S2)
     {
         leansdr::s2_frame_receiver<leansdr::f32, leansdr::llr_ss> * objDemodulatorDVBS2 = (leansdr::s2_frame_receiver<leansdr::f32, leansdr::llr_ss> *) m_objDemodulatorDVBS2;
+        leansdr::s2_frame_receiver<leansdr::f32, leansdr::llr_ss>::modcod_status modcodStatus = objDemodulatorDVBS2->get_modcod_status();
 
-        if (objDemodulatorDVBS2->cstln->m_setByModcod && !m_cstlnSetByModcod)
+        if (modcodStatus.set_by_modcod && !m_cstlnSetByModcod)
         {
             qDebug("DATVDemod::feed: change by MODCOD detected");
 
-            if (r_scope_symbols_dvbs2) {
-                r_scope_symbols_dvbs2->calculate_cstln_points();
-            }
-
             if (getMessageQueueToGUI())
             {
                 MsgReportModcodCstlnChange *msg = MsgReportModcodCstlnChange::create(
-                    getModulationFromLeanDVBCode(objDemodulatorDVBS2->cstln->m_typeCode),
-                    getCodeRateFromLeanDVBCode(objDemodulatorDVBS2->cstln->m_rateCode)
+                    getModulationFromLeanDVBCode(modcodStatus.type_code),
+                    getCodeRateFromLeanDVBCode(modcodStatus.rate_code)
                 );
 
                 getMessageQueueToGUI()->push(msg);
             }
         }
 
-        m_cstlnSetByModcod = objDemodulatorDVBS2->cstln->m_setByModcod;
-        m_modcodModulation = objDemodulatorDVBS2->m_modcodType;
-        m_modcodCodeRate = objDemodulatorDVBS2->m_modcodRate;
+        m_cstlnSetByModcod = modcodStatus.set_by_modcod;
+        m_modcodModulation = modcodStatus.modcod_type;
+        m_modcodCodeRate = modcodStatus.modcod_rate;
+    }
+}
+
+void DATVDemod::pushRawIQ()
+{
+    // Decoder runs on the scheduler threads: push what fits under the input pipe
+    // lock and never wait on the DSP thread. What does not fit is dropped and counted.
+    p_rawiq->lock();
+    std::size_t count = std::min(m_rawIQBuffer.size(), (std::size_t) p_rawiq_writer->writable());
+    std::copy(m_rawIQBuffer.begin(), m_rawIQBuffer.begin() + count, p_rawiq_writer->wr());
+    p_rawiq_writer->written(count);
+    p_rawiq->unlock();
+
+    m_objScheduler->step();
+
+    if (count < m_rawIQBuffer.size())
+    {
+        std::size_t dropped = m_rawIQBuffer.size() - count;
+
+        if (m_nbDroppedRawIQ.fetch_add(dropped) == 0) {
+            qDebug("DATVDemod::pushRawIQ: decoder overrun: dropping input samples");
+        }
+    }
+
+    m_rawIQBuffer.clear();
+}
+
+void DATVDemod::getRunnableLoads(std::vector<RunnableLoad>& loads)
+{
+    loads.clear();
+    QMutexLocker mlock(&m_objSettingsMutex);
+
+    if (!m_objScheduler) {
+        return;
+    }
+
+    for (int i = 0; i < m_objScheduler->nrunnables; i++)
+    {
+        leansdr::runnable_common *runnable = m_objScheduler->runnables[i];
+        loads.push_back(RunnableLoad{QString(runnable->name), runnable->group, runnable->cpu_ns.load()});
     }
 }
 
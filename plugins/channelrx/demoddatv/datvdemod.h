@@ -194,6 +194,16 @@ public:
     static int getLeanDVBCodeRateFromDATV(DATVDemodSettings::DATVCodeRate datvCodeRate);
     static int getLeanDVBModulationFromDATV(DATVDemodSettings::DATVModulation datvModulation);
 
+    struct RunnableLoad
+    {
+        QString m_name;
+        int m_group;          //!< Scheduler thread group
+        quint64 m_cpuTimeNs;  //!< Cumulated CPU time spent in the runnable
+    };
+
+    void getRunnableLoads(std::vector<RunnableLoad>& loads); //!< Snapshot of the leansdr runnables CPU usage
+    quint64 getNbDroppedSamples() const { return m_nbDroppedRawIQ.load(); } //!< Input samples dropped on decoder overrun since last settings change
+
     static const QString m_channelIdURI;
     static const QString m_channelId;
 
@@ -300,6 +310,7 @@ private:
 
     leansdr::pipebuf<leansdr::cf32> *p_rawiq;
     leansdr::pipewriter<leansdr::cf32> *p_rawiq_writer;
+    std::vector<leansdr::cf32> m_rawIQBuffer; //!< Input block pushed at once in multi-threaded mode
     leansdr::pipebuf<leansdr::cf32> *p_preprocessed;
 
     // NOTCH FILTER
@@ -342,6 +353,7 @@ private:
     void *p_s2_deinterleaver;
     void *r_fecdec;
     void *p_deframer;
+    bool m_softLDPCFramework; //!< DVB-S2 FEC frames are soft (llr_sb) else hard (hard_sb)
 
     //DECIMATION
     leansdr::pipebuf<leansdr::cf32> *p_decimated;
@@ -420,6 +432,7 @@ private:
     bool m_cstlnSetByModcod;
     int m_modcodModulation;
     int m_modcodCodeRate;
+    std::atomic<quint64> m_nbDroppedRawIQ; //!< Input samples that did not fit in the decoder input pipe
 
     DATVDemodSettings::DATVModulation m_enmModulation;
 
@@ -434,6 +447,7 @@ private:
     //void ApplySettings();
     void applySettings(const DATVDemodSettings& settings, bool force = false);
 	void applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force = false);
+    void pushRawIQ();
 };
 
 #endif // INCLUDE_DATVDEMOD_H
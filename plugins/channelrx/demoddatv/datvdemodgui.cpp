@@ -20,6 +20,7 @@
 #include <QDockWidget>
 #include <QMainWindow>
 #include <QMediaMetaData>
+#include <QDateTime>
 
 #include "datvdemodgui.h"
 
@@ -179,13 +180,13 @@ DATVDemodGUI::DATVDemodGUI(PluginAPI* objPluginAPI, DeviceUISet *deviceUISet, Ba
 
     m_objDATVDemod->SetTVScreen(ui->screenTV);
 
-    connect(m_objDATVDemod->SetVideoRender(ui->screenTV_2), &DATVideostream::onDataPackets, this, &DATVDemodGUI::on_StreamDataAvailable);
+    m_objVideoStream = m_objDATVDemod->SetVideoRender(ui->screenTV_2);
     connect(ui->screenTV_2, &DATVideoRender::onMetaDataChanged, this, &DATVDemodGUI::on_StreamMetaDataChanged);
 
     m_intPreviousDecodedData=0;
     m_intLastDecodedData=0;
     m_intLastSpeed=0;
-    m_intReadyDecodedData=0;
+    m_runnableLoadsTimeNs=0;
     m_objTimer.setInterval(1000);
     connect(&m_objTimer, SIGNAL(timeout()), this, SLOT(tick()));
     m_objTimer.start();
@@ -296,6 +297,9 @@ void DATVDemodGUI::displaySettings()
     ui->udpTS->setChecked(m_settings.m_udpTS);
     ui->udpTSAddress->setText(m_settings.m_udpTSAddress);
     ui->udpTSPort->setText(tr("%1").arg(m_settings.m_udpTSPort));
+    ui->multiThreaded->setChecked(m_settings.m_multiThreaded);
+    ui->softLDPC->setChecked(m_settings.m_softLDPC);
+    ui->maxLDPCIterations->setValue(m_settings.m_maxLDPCIterations);
 
     blockApplySettings(false);
     m_objChannelMarker.blockSignals(false);
@@ -422,6 +426,13 @@ void DATVDemodGUI::tick()
         }
     }
 
+    m_intLastDecodedData = m_objVideoStream->getTotalReceived();
+    ui->lblStatus->setText(QString("Data: %1B").arg(formatBytes(m_intLastDecodedData)));
+    ui->prgSynchro->setValue(m_objVideoStream->getFillPercent());
+    ui->prgSynchro->setToolTip(QString("Video buffer fill - latency: %1 ms - overruns: %2")
+        .arg(m_objVideoStream->getLatencyMs(), 0, 'f', 1)
+        .arg(m_objVideoStream->getOverruns()));
+
     if((m_intLastDecodedData-m_intPreviousDecodedData)>=0)
     {
         m_intLastSpeed = 8*(m_intLastDecodedData-m_intPreviousDecodedData);
@@ -456,12 +467,48 @@ void DATVDemodGUI::tick()
 
     m_intPreviousDecodedData = m_intLastDecodedData;
 
+    displayCPULoad();
+
     //Try to start video rendering
     m_objDATVDemod->PlayVideo(false);
 
     return;
 }
 
+void DATVDemodGUI::displayCPULoad()
+{
+    std::vector<DATVDemod::RunnableLoad> loads;
+    m_objDATVDemod->getRunnableLoads(loads);
+    qint64 timeNs = QDateTime::currentMSecsSinceEpoch() * 1000000LL;
+    qint64 elapsedNs = timeNs - m_runnableLoadsTimeNs;
+
+    // Framework was re-created or first call: just take the reference
+    if ((loads.size() != m_runnableLoads.size()) || (elapsedNs <= 0))
+    {
+        m_runnableLoads = loads;
+        m_runnableLoadsTimeNs = timeNs;
+        return;
+    }
+
+    double total = 0.0;
+    QString details;
+
+    for (unsigned int i = 0; i < loads.size(); i++)
+    {
+        quint64 prevNs = m_runnableLoads[i].m_cpuTimeNs;
+        double load = loads[i].m_cpuTimeNs < prevNs ? 0.0 : (100.0 * (loads[i].m_cpuTimeNs - prevNs)) / elapsedNs;
+        total += load;
+        details += tr("%1 [%2]: %3%\n").arg(loads[i].m_name).arg(loads[i].m_group).arg(load, 0, 'f', 1);
+    }
+
+    ui->cpuLoadText->setText(tr("%1%").arg(total, 0, 'f', 0));
+    ui->cpuLoadText->setToolTip(tr("Decoder CPU load per block [thread group]\n%1\nDropped input samples: %2")
+        .arg(details.trimmed())
+        .arg(m_objDATVDemod->getNbDroppedSamples()));
+    m_runnableLoads = loads;
+    m_runnableLoadsTimeNs = timeNs;
+}
+
 void DATVDemodGUI::on_cmbStandard_currentIndexChanged(int index)
 {
     m_settings.m_standard = (DATVDemodSettings::dvb_version) index;
@@ -583,21 +630,6 @@ QString DATVDemodGUI::formatBytes(qint64 intBytes)
 }
 
 
-void DATVDemodGUI::on_StreamDataAvailable(int *intPackets, int *intBytes, int *intPercent, qint64 *intTotalReceived)
-{
-    (void) intPackets;
-    ui->lblStatus->setText(QString("Data: %1B").arg(formatBytes(*intTotalReceived)));
-    m_intLastDecodedData = *intTotalReceived;
-
-    if((*intPercent)<100) {
-        ui->prgSynchro->setValue(*intPercent);
-    } else {
-        ui->prgSynchro->setValue(100);
-    }
-
-    m_intReadyDecodedData = *intBytes;
-}
-
 void DATVDemodGUI::on_deltaFrequency_changed(qint64 value)
 {
     m_objChannelMarker.setCenterFrequency(value);
@@ -724,4 +756,22 @@ void DATVDemodGUI::on_udpTSPort_editingFinished()
     m_settings.m_udpTSPort = udpPort;
     ui->udpTSPort->setText(tr("%1").arg(udpPort));
     applySettings();
-}
\ No newline at end of file
+}
+
+void DATVDemodGUI::on_multiThreaded_toggled(bool checked)
+{
+    m_settings.m_multiThreaded = checked;
+    applySettings();
+}
+
+void DATVDemodGUI::on_softLDPC_toggled(bool checked)
+{
+    m_settings.m_softLDPC = checked;
+    applySettings();
+}
+
+void DATVDemodGUI::on_maxLDPCIterations_valueChanged(int value)
+{
+    m_settings.m_maxLDPCIterations = value;
+    applySettings();
+}
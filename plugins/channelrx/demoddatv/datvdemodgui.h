@@ -83,7 +83,6 @@ private slots:
     void on_chkAllowDrift_clicked();
     void on_fullScreen_clicked();
     void on_mouseEvent(QMouseEvent* obj);
-    void on_StreamDataAvailable(int *intPackets, int *intBytes, int *intPercent, qint64 *intTotalReceived);
     void on_StreamMetaDataChanged(DataTSMetaData2 *objMetaData);
     void on_chkFastlock_clicked();
     void on_cmbFilter_currentIndexChanged(int index);
@@ -97,6 +96,9 @@ private slots:
     void on_udpTS_clicked(bool checked);
     void on_udpTSAddress_editingFinished();
     void on_udpTSPort_editingFinished();
+    void on_multiThreaded_toggled(bool checked);
+    void on_softLDPC_toggled(bool checked);
+    void on_maxLDPCIterations_valueChanged(int value);
 
 private:
     Ui::DATVDemodGUI* ui;
@@ -115,7 +117,9 @@ private:
     qint64 m_intPreviousDecodedData;
     qint64 m_intLastDecodedData;
     qint64 m_intLastSpeed;
-    int m_intReadyDecodedData;
+    const DATVideostream *m_objVideoStream; //!< polled for TS ring metrics
+    std::vector<DATVDemod::RunnableLoad> m_runnableLoads; //!< Previous snapshot for CPU load computation
+    qint64 m_runnableLoadsTimeNs;
 
     bool m_blnBasicSettingsShown;
     bool m_blnDoApplySettings;
@@ -136,6 +140,7 @@ private:
     QString formatBytes(qint64 intBytes);
 
     void displayRRCParameters(bool blnVisible);
+    void displayCPULoad();
 
 	void leaveEvent(QEvent*);
 	void enterEvent(QEvent*);
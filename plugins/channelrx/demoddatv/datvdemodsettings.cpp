@@ -55,6 +55,9 @@ void DATVDemodSettings::resetToDefaults()
     m_udpTSAddress = "127.0.0.1";
     m_udpTSPort = 8882;
     m_udpTS = false;
+    m_multiThreaded = false;
+    m_softLDPC = false;
+    m_maxLDPCIterations = 25;
 }
 
 QByteArray DATVDemodSettings::serialize() const
@@ -88,6 +91,9 @@ QByteArray DATVDemodSettings::serialize() const
     s.writeString(23, m_udpTSAddress);
     s.writeU32(24, m_udpTSPort);
     s.writeBool(25, m_udpTS);
+    s.writeBool(26, m_multiThreaded);
+    s.writeBool(27, m_softLDPC);
+    s.writeS32(28, m_maxLDPCIterations);
 
     return s.final();
 }
@@ -154,6 +160,10 @@ bool DATVDemodSettings::deserialize(const QByteArray& data)
         d.readU32(24, &utmp, 8882);
         m_udpTSPort = utmp < 1024 ? 1024 : utmp > 65536 ? 65535 : utmp;
         d.readBool(25, &m_udpTS, false);
+        d.readBool(26, &m_multiThreaded, false);
+        d.readBool(27, &m_softLDPC, false);
+        d.readS32(28, &tmp, 25);
+        m_maxLDPCIterations = tmp < 1 ? 1 : tmp > 100 ? 100 : tmp;
 
         validateSystemConfiguration();
 
@@ -187,7 +197,10 @@ void DATVDemodSettings::debug(const QString& msg) const
         << " m_audioMute: " << m_audioMute
         << " m_audioDeviceName: " << m_audioDeviceName
         << " m_audioVolume: " << m_audioVolume
-        << " m_videoMute: " << m_videoMute;
+        << " m_videoMute: " << m_videoMute
+        << " m_multiThreaded: " << m_multiThreaded
+        << " m_softLDPC: " << m_softLDPC
+        << " m_maxLDPCIterations: " << m_maxLDPCIterations;
 }
 
 bool DATVDemodSettings::isDifferent(const DATVDemodSettings& other)
@@ -204,6 +217,9 @@ bool DATVDemodSettings::isDifferent(const DATVDemodSettings& other)
         || (m_notchFilters != other.m_notchFilters)
         || (m_symbolRate != other.m_symbolRate)
         || (m_excursion != other.m_excursion)
+        || (m_multiThreaded != other.m_multiThreaded)
+        || (m_softLDPC != other.m_softLDPC)
+        || (m_maxLDPCIterations != other.m_maxLDPCIterations)
         || (m_standard != other.m_standard));
 }
 
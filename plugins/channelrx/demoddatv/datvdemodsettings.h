@@ -96,6 +96,9 @@ struct DATVDemodSettings
     QString m_udpTSAddress;
     quint32 m_udpTSPort;
     bool m_udpTS;
+    bool m_multiThreaded; //!< Run the leansdr decoder chain on several threads
+    bool m_softLDPC;      //!< DVB-S2 soft decision (min-sum) LDPC decoding instead of bit flipping
+    int m_maxLDPCIterations; //!< DVB-S2 soft decision LDPC maximum number of iterations
 
     DATVDemodSettings();
     void resetToDefaults();
@@ -121,6 +121,8 @@ template<typename T> struct datvdvbs2constellation: runnable
     unsigned long phase;
     std::vector<int> cstln_rows;
     std::vector<int> cstln_cols;
+    cstln_base *cstln_plotted; // Constellation cstln_rows and cstln_cols were calculated from
+    int cstln_plotted_nsymbols;
 
     datvdvbs2constellation(
             scheduler *sch,
@@ -137,12 +139,20 @@ template<typename T> struct datvdvbs2constellation: runnable
         cstln(0),
         m_objDATVScreen(objDATVScreen),
         in(_in),
-        phase(0)
+        phase(0),
+        cstln_plotted(nullptr),
+        cstln_plotted_nsymbols(0)
     {
     }
 
     void run()
     {
+        // The constellation may be replaced by the receiver on MODCOD change.
+        // Both run in the same scheduler group so it is safe to follow it here.
+        if (cstln && (*cstln)
+         && ((*cstln != cstln_plotted) || ((*cstln)->nsymbols != cstln_plotted_nsymbols))) {
+            calculate_cstln_points();
+        }
 
         phase=0;
         //Symbols
@@ -198,6 +208,8 @@ template<typename T> struct datvdvbs2constellation: runnable
 
         cstln_rows.clear();
         cstln_cols.clear();
+        cstln_plotted = *cstln;
+        cstln_plotted_nsymbols = (*cstln)->nsymbols;
 
         for (int i = 0; i < (*cstln)->nsymbols; ++i)
         {
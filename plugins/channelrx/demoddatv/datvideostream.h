@@ -20,15 +20,16 @@
 #define DATVIDEOSTREAM_H
 
 #include <QIODevice>
-#include <QQueue>
-#include <QByteArray>
-#include <QEventLoop>
-#include <QMutex>
-#include <QThread>
 
-#define MinStackSize    4
+#include "datvtsring.h"
+
+#define TSPacketSize        188
 #define DefaultMemoryLimit  2048000
 
+/**
+ * QIODevice facade of the TS packet ring for the video decoder (ffmpeg AVIO read callback).
+ * Data is pushed by the leansdr output and read from the ring without intermediate queue.
+ */
 class DATVideostream : public QIODevice
 {
     Q_OBJECT
@@ -37,24 +38,20 @@ public:
     DATVideostream();
     ~DATVideostream();
 
-    bool MultiThreaded;
-    int ThreadTimeOut;
+    int pushData(const char * chrData, int intSize); //!< size is a whole number of TS packets
+    void setThreadTimeout(int timeoutMs);            //!< read timeout (-1: wait forever). A pending read is woken up.
 
-    int pushData(const char * chrData, int intSize);
-    bool setMemoryLimit(int intMemoryLimit);
+    DATVTSRing& getRing() { return m_ring; }
+    int getFillPercent() const { return m_ring.getFillPercent(); }
+    float getLatencyMs() const { return m_ring.getLatencyMs(); }
+    qint64 getTotalReceived() const { return m_ring.getTotalBytes(); }
+    quint64 getOverruns() const { return m_ring.getOverruns(); }
 
     virtual bool isSequential() const;
     virtual qint64 bytesAvailable() const;
     virtual void close();
     virtual bool open(OpenMode mode);
 
-    QQueue<QByteArray> m_objFIFO;
-
-signals:
-
-    void onDataAvailable();
-    void onDataPackets(int *intDataPackets, int *intDataBytes, int *intPercentBuffer,qint64 *intTotalReceived);
-
 protected:
 
     virtual qint64 readData(char *data, qint64 len);
@@ -63,17 +60,7 @@ protected:
 
 private:
 
-    QEventLoop m_objeventLoop;
-    QMutex m_objMutex;
-    int m_intMemoryLimit;
-    int m_intBytesAvailable;
-    int m_intBytesWaiting;
-    int m_intQueueWaiting;
-    int m_intPercentBuffer;
-    qint64 m_intTotalReceived;
-    qint64 m_intPacketReceived;
-
-    void cleanUp();
+    DATVTSRing m_ring;
 };
 
 #endif // DATVIDEOSTREAM_H
@@ -0,0 +1,188 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <climits>
+
+#include <QDebug>
+
+#include "datvtsring.h"
+
+DATVTSRing::DATVTSRing(int packetSize, int nbPackets) :
+    m_packetSize(packetSize),
+    m_nbPackets(nbPackets),
+    m_writeCount(0),
+    m_readByte(0),
+    m_overruns(0),
+    m_readTimeoutMs(-1),
+    m_latencyMs(0.0f)
+{
+    m_size = (qint64) m_packetSize * m_nbPackets;
+    m_buffer = new char[m_size];
+    m_timestamps = new qint64[m_nbPackets];
+    std::fill(m_timestamps, m_timestamps + m_nbPackets, 0);
+    m_timer.start();
+    qDebug("DATVTSRing::DATVTSRing: %d packets of %d bytes", m_nbPackets, m_packetSize);
+}
+
+DATVTSRing::~DATVTSRing()
+{
+    delete[] m_timestamps;
+    delete[] m_buffer;
+}
+
+void DATVTSRing::write(const char *data, int nbPackets)
+{
+    if (nbPackets <= 0) {
+        return;
+    }
+
+    qint64 now = m_timer.nsecsElapsed();
+    QMutexLocker mutexLocker(&m_mutex);
+
+    // packets that would be overwritten within this write are skipped but counted
+    int skip = nbPackets > m_nbPackets ? nbPackets - m_nbPackets : 0;
+    quint64 writeCount = m_writeCount + skip;
+    data += (qint64) skip * m_packetSize;
+    int remainder = nbPackets - skip;
+
+    while (remainder > 0)
+    {
+        int slot = writeCount % m_nbPackets;
+        int count = std::min(remainder, m_nbPackets - slot);
+        std::copy(data, data + (qint64) count * m_packetSize, m_buffer + (qint64) slot * m_packetSize);
+        std::fill(m_timestamps + slot, m_timestamps + slot + count, now);
+        data += (qint64) count * m_packetSize;
+        writeCount += count;
+        remainder -= count;
+    }
+
+    m_writeCount = writeCount;
+    m_dataAvailable.wakeAll();
+}
+
+void DATVTSRing::checkReadOverrun()
+{
+    quint64 oldest = m_writeCount > (quint64) m_nbPackets ? (m_writeCount - m_nbPackets) * m_packetSize : 0;
+
+    if (m_readByte < oldest)
+    {
+        m_readByte = oldest;
+        m_overruns++;
+    }
+}
+
+qint64 DATVTSRing::read(char *data, qint64 maxBytes)
+{
+    if (maxBytes <= 0) {
+        return 0;
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+
+    while (m_readByte == m_writeCount * m_packetSize)
+    {
+        if (m_readTimeoutMs == 0) {
+            return -1;
+        }
+
+        // a timeout change wakes up the wait and is taken into account in the next turn
+        if (!m_dataAvailable.wait(&m_mutex, m_readTimeoutMs < 0 ? ULONG_MAX : m_readTimeoutMs)
+            && (m_readByte == m_writeCount * m_packetSize))
+        {
+            return -1;
+        }
+    }
+
+    checkReadOverrun();
+
+    qint64 available = m_writeCount * m_packetSize - m_readByte;
+    qint64 remainder = std::min(available, maxBytes);
+    qint64 read = remainder;
+    int firstSlot = (m_readByte / m_packetSize) % m_nbPackets;
+
+    while (remainder > 0)
+    {
+        qint64 offset = m_readByte % m_size;
+        qint64 count = std::min(remainder, m_size - offset);
+        std::copy(m_buffer + offset, m_buffer + offset + count, data);
+        data += count;
+        m_readByte += count;
+        remainder -= count;
+    }
+
+    float latencyMs = (m_timer.nsecsElapsed() - m_timestamps[firstSlot]) / 1e6f;
+    m_latencyMs = m_latencyMs == 0.0f ? latencyMs : 0.9f * m_latencyMs + 0.1f * latencyMs;
+
+    return read;
+}
+
+void DATVTSRing::setReadTimeout(int timeoutMs)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_readTimeoutMs = timeoutMs;
+    m_dataAvailable.wakeAll();
+}
+
+void DATVTSRing::flush()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_readByte = m_writeCount * m_packetSize;
+    m_latencyMs = 0.0f;
+}
+
+qint64 DATVTSRing::bytesAvailable() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return std::min((qint64) (m_writeCount * m_packetSize - m_readByte), m_size); // overrun is caught up at next read
+}
+
+const char *DATVTSRing::peek(quint64& packetCursor, int& nbPackets)
+{
+    if (m_writeCount - packetCursor > (quint64) m_nbPackets) {
+        packetCursor = m_writeCount - m_nbPackets;
+    }
+
+    int slot = packetCursor % m_nbPackets;
+    nbPackets = std::min(m_writeCount - packetCursor, (quint64) (m_nbPackets - slot));
+
+    return m_buffer + (qint64) slot * m_packetSize;
+}
+
+int DATVTSRing::getFillPercent() const
+{
+    return (int) ((100 * bytesAvailable()) / m_size);
+}
+
+float DATVTSRing::getLatencyMs() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_latencyMs;
+}
+
+quint64 DATVTSRing::getTotalBytes() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_writeCount * m_packetSize;
+}
+
+quint64 DATVTSRing::getOverruns() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_overruns;
+}
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DATVTSRING_H
+#define DATVTSRING_H
+
+#include <QtGlobal>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+
+/**
+ * Preallocated ring of fixed size TS packets between the leansdr output and its consumers.
+ *
+ * The producer (leansdr scheduler thread) copies whole packets in. Positions are counted
+ * since start (packets written, bytes read) so a reader lagging by more than the ring size
+ * detects it and skips to the oldest packet still in the ring (overrun).
+ *
+ * There are two readers:
+ *   - the video decoder reads bytes from its own cursor and may block until data arrives
+ *   - the packet reader (UDP) runs in the producer thread and looks at contiguous packets
+ *     in place through its own packet cursor
+ */
+class DATVTSRing
+{
+public:
+    DATVTSRing(int packetSize, int nbPackets);
+    ~DATVTSRing();
+
+    int getPacketSize() const { return m_packetSize; }
+    int getNbPackets() const { return m_nbPackets; }
+
+    /** Producer: copy nbPackets packets and wake up a waiting reader */
+    void write(const char *data, int nbPackets);
+    quint64 getWriteCount() const { return m_writeCount; } //!< packets written since start. Producer thread only.
+
+    /** Video reader: copy at most maxBytes. Waits for data at most the read timeout. Returns -1 on timeout */
+    qint64 read(char *data, qint64 maxBytes);
+    void setReadTimeout(int timeoutMs); //!< -1: wait forever, 0: do not wait. Applies to a waiting read.
+    void flush();          //!< video reader catches up with the producer
+    qint64 bytesAvailable() const;
+
+    /** Packet reader: contiguous packets from packetCursor in place. Producer thread only. */
+    const char *peek(quint64& packetCursor, int& nbPackets);
+
+    int getFillPercent() const;    //!< video reader backlog in percent of ring size
+    float getLatencyMs() const;    //!< time spent by bytes in the ring before being read (averaged)
+    quint64 getTotalBytes() const; //!< bytes written since start
+    quint64 getOverruns() const;   //!< times the video reader was overtaken by the producer
+
+private:
+    void checkReadOverrun();
+
+    int m_packetSize;
+    int m_nbPackets;
+    qint64 m_size;              //!< ring size in bytes
+    char *m_buffer;
+    qint64 *m_timestamps;       //!< write time of each packet slot (ns)
+    quint64 m_writeCount;       //!< packets
+    quint64 m_readByte;         //!< video reader position in bytes
+    quint64 m_overruns;
+    int m_readTimeoutMs;
+    float m_latencyMs;
+    QElapsedTimer m_timer;
+    mutable QMutex m_mutex;
+    QWaitCondition m_dataAvailable;
+};
+
+#endif // DATVTSRING_H
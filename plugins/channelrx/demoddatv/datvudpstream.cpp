@@ -16,43 +16,47 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#include <algorithm>
+#include "datvtsring.h"
 #include "datvudpstream.h"
 
 const int DATVUDPStream::m_tsBlocksPerFrame = 7; // The usual value
 
-DATVUDPStream::DATVUDPStream(int tsBlockSize) :
+DATVUDPStream::DATVUDPStream() :
     m_active(false),
     m_address(QHostAddress::LocalHost),
     m_port(8882),
-    m_tsBlockSize(tsBlockSize),
-    m_tsBlockIndex(0)
+    m_tsBlockCursor(0)
 {
-    m_tsBuffer = new char[m_tsBlocksPerFrame*m_tsBlockSize];
 }
 
 DATVUDPStream::~DATVUDPStream()
 {
-    delete[] m_tsBuffer;
 }
 
-void DATVUDPStream::pushData(const char *chrData, int nbTSBlocks)
+void DATVUDPStream::sendData(DATVTSRing& ring)
 {
-    if (!m_active) {
+    quint64 writeCount = ring.getWriteCount();
+
+    if (!m_active)
+    {
+        m_tsBlockCursor = writeCount - (writeCount % m_tsBlocksPerFrame); // keep frames aligned
         return;
     }
 
-    for (int i = 0; i < nbTSBlocks; i++)
+    // datagrams are sent straight from the ring slots. The ring size is a multiple of the frame size
+    // so frames do not wrap around.
+    while (writeCount - m_tsBlockCursor >= (quint64) m_tsBlocksPerFrame)
     {
-        if (m_tsBlockIndex < m_tsBlocksPerFrame)
-        {
-            std::copy(chrData + i*m_tsBlockSize, chrData + (i+1)*m_tsBlockSize, m_tsBuffer + m_tsBlockIndex*m_tsBlockSize);
-            m_tsBlockIndex++;
-        }
-        else
+        int nbTSBlocks;
+        const char *tsBlocks = ring.peek(m_tsBlockCursor, nbTSBlocks);
+
+        if (m_tsBlockCursor % m_tsBlocksPerFrame != 0) // overrun: realign on next frame
         {
-            m_udpSocket.writeDatagram(m_tsBuffer, m_tsBlocksPerFrame*m_tsBlockSize, m_address, m_port);
-            m_tsBlockIndex = 0;
+            m_tsBlockCursor += m_tsBlocksPerFrame - (m_tsBlockCursor % m_tsBlocksPerFrame);
+            continue;
         }
+
+        m_udpSocket.writeDatagram(tsBlocks, m_tsBlocksPerFrame*ring.getPacketSize(), m_address, m_port);
+        m_tsBlockCursor += m_tsBlocksPerFrame;
     }
 }
@@ -24,14 +24,15 @@
 #include <QString>
 
 class QString;
+class DATVTSRing;
 
 class DATVUDPStream
 {
 public:
-    DATVUDPStream(int tsBlockSize);
+    DATVUDPStream();
     ~DATVUDPStream();
 
-    void pushData(const char *chrData, int nbTSBlocks);
+    void sendData(DATVTSRing& ring); //!< send the TS blocks written in the ring since last call. Ring producer thread only.
     void setActive(bool active) { m_active = active; }
     bool setAddress(const QString& address) { return m_address.setAddress(address); }
     void setPort(quint16 port) { m_port = port; }
@@ -43,9 +44,7 @@ private:
     QUdpSocket m_udpSocket;
     QHostAddress m_address;
     quint16 m_port;
-    int m_tsBlockSize;
-    int m_tsBlockIndex;
-    char *m_tsBuffer;
+    quint64 m_tsBlockCursor; //!< next TS block to send in the ring
 };
 
 #endif // DATVUDPSTREAM_H
\ No newline at end of file
@@ -48,8 +48,9 @@ template<typename T> struct datvvideoplayer: runnable
             return;
         }
 
-        m_udpStream->pushData((const char *) in.rd(), in.readable());
+        // one copy into the TS ring. The UDP stream sends from the ring.
         int nw = m_objVideoStream->pushData((const char *) in.rd(), size);
+        m_udpStream->sendData(m_objVideoStream->getRing());
 
         if (!nw)
         {
@@ -1460,8 +1460,8 @@ struct derandomizer : runnable
 // Supports all code rates and constellations
 // Simplified metric to support large constellations.
 
-// This version implements puncturing by expanding the trellis.
-// TBD Compare performance vs skipping updates in a 1/2 trellis.
+// Punctured rates are decoded on the rate 1/2 trellis with a
+// vectorized K=7 decoder (see viterbi_dec_k7).
 
 struct viterbi_sync : runnable
 {
@@ -1469,41 +1469,7 @@ struct viterbi_sync : runnable
     typedef int32_t TBM; // Only 16 bits per IQ, but several IQ per Viterbi CS
     typedef int32_t TPM;
     typedef viterbi_dec_interface<TUS, TCS, TBM, TPM> dvb_dec_interface;
-
-    // 1/2: 6 bits of state, 1 bit in, 2 bits out
-    typedef bitpath<uint32_t, TUS, 1, 32> path_12;
-    typedef trellis<TS, 64, TUS, 2, 4> trellis_12;
-    typedef viterbi_dec<TS, 64, TUS, 2, TCS, 4, TBM, TPM, path_12> dvb_dec_12;
-
-    // 2/3: 6 bits of state, 2 bits in, 3 bits out
-    typedef bitpath<uint64_t, TUS, 3, 21> path_23;
-    typedef trellis<TS, 64, TUS, 4, 8> trellis_23;
-    typedef viterbi_dec<TS, 64, TUS, 4, TCS, 8, TBM, TPM, path_23> dvb_dec_23;
-
-    // 4/6: 6 bits of state, 4 bits in, 6 bits out
-    typedef bitpath<uint64_t, TUS, 4, 16> path_46;
-    typedef trellis<TS, 64, TUS, 16, 64> trellis_46;
-    typedef viterbi_dec<TS, 64, TUS, 16, TCS, 64, TBM, TPM, path_46> dvb_dec_46;
-
-    // 3/4: 6 bits of state, 3 bits in, 4 bits out
-    typedef bitpath<uint64_t, TUS, 3, 21> path_34;
-    typedef trellis<TS, 64, TUS, 8, 16> trellis_34;
-    typedef viterbi_dec<TS, 64, TUS, 8, TCS, 16, TBM, TPM, path_34> dvb_dec_34;
-
-    // 4/5: 6 bits of state, 4 bits in, 5 bits out (non-standard)
-    typedef bitpath<uint64_t, TUS, 4, 16> path_45;
-    typedef trellis<TS, 64, TUS, 16, 32> trellis_45;
-    typedef viterbi_dec<TS, 64, TUS, 16, TCS, 32, TBM, TPM, path_45> dvb_dec_45;
-
-    // 5/6: 6 bits of state, 5 bits in, 6 bits out
-    typedef bitpath<uint64_t, TUS, 5, 12> path_56;
-    typedef trellis<TS, 64, TUS, 32, 64> trellis_56;
-    typedef viterbi_dec<TS, 64, TUS, 32, TCS, 64, TBM, TPM, path_56> dvb_dec_56;
-
-    // 7/8: 6 bits of state, 7 bits in, 8 bits out
-    typedef bitpath<uint64_t, TUS, 7, 9> path_78;
-    typedef trellis<TS, 64, TUS, 128, 256> trellis_78;
-    typedef viterbi_dec<TS, 64, TUS, 128, TCS, 256, TBM, TPM, path_78> dvb_dec_78;
+    typedef viterbi_dec_k7<TUS, TCS, TBM, TPM> dvb_dec_k7;
 
   private:
     pipereader<eucl_ss> in;
@@ -1607,59 +1573,15 @@ struct viterbi_sync : runnable
 #endif
         }
 
-        if (cr == FEC12)
-        {
-            trellis_12 *trell = new trellis_12();
-            trell->init_convolutional(fec->polys);
-            for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_12(trell);
-        }
-        else if (cr == FEC23)
-        {
-            trellis_23 *trell = new trellis_23();
-            trell->init_convolutional(fec->polys);
-            for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_23(trell);
-        }
-        else if (cr == FEC46)
-        {
-            trellis_46 *trell = new trellis_46();
-            trell->init_convolutional(fec->polys);
-            for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_46(trell);
-        }
-        else if (cr == FEC34)
-        {
-            trellis_34 *trell = new trellis_34();
-            trell->init_convolutional(fec->polys);
-            for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_34(trell);
-        }
-        else if (cr == FEC45)
-        {
-            trellis_45 *trell = new trellis_45();
-            trell->init_convolutional(fec->polys);
-            for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_45(trell);
-        }
-        else if (cr == FEC56)
-        {
-            trellis_56 *trell = new trellis_56();
-            trell->init_convolutional(fec->polys);
-            for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_56(trell);
-        }
-        else if (cr == FEC78)
-        {
-            trellis_78 *trell = new trellis_78();
-            trell->init_convolutional(fec->polys);
-            for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_78(trell);
-        }
-        else
+        if (cr != FEC12 && cr != FEC23 && cr != FEC46 && cr != FEC34 &&
+            cr != FEC45 && cr != FEC56 && cr != FEC78)
         {
             fail("CR not supported");
         }
+
+        for (int s = 0; s < nsyncs; ++s)
+            syncs[s].dec = new dvb_dec_k7(fec->bits_in, fec->bits_out, fec->polys,
+                                          DVBS_G1, DVBS_G2);
     }
 
     TCS *init_map(bool conj, float angle)
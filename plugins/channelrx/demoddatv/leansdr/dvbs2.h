@@ -476,6 +476,11 @@ struct s2_frame_receiver : runnable
           m_modcodType(-1),
           m_modcodRate(-1)
     {
+        modcod_published.set_by_modcod = false;
+        modcod_published.type_code = -1;
+        modcod_published.rate_code = -1;
+        modcod_published.modcod_type = -1;
+        modcod_published.modcod_rate = -1;
         // Constellation for PLS
         qpsk = new cstln_lut<SOFTSYMB, 256>(cstln_base::QPSK);
         add_syncs(qpsk);
@@ -798,11 +803,15 @@ struct s2_frame_receiver : runnable
         }
 #endif
         // Store current MODCOD info
+        bool modcod_changed = false;
+
         if (mcinfo->c != m_modcodType) {
             m_modcodType = mcinfo->c;
+            modcod_changed = true;
         }
         if (mcinfo->rate != m_modcodRate) {
             m_modcodRate = mcinfo->rate;
+            modcod_changed = true;
         }
 
         // TBD Comparison of nsymbols is insufficient for DVB-S2X.
@@ -820,12 +829,17 @@ struct s2_frame_receiver : runnable
             cstln->m_rateCode = (int) mcinfo->rate;
             cstln->m_typeCode = (int) mcinfo->c;
             cstln->m_setByModcod = true;
+            modcod_changed = true;
 #if 0
 	fprintf(stderr, "Dumping constellation LUT to stdout.\n");
 	cstln->dump(stdout);
 #endif
         }
 
+        if (modcod_changed) {
+            publish_modcod_status();
+        }
+
         int S = pls.sf ? mcinfo->nslots_nf / 4 : mcinfo->nslots_nf;
 
         plslot<SOFTSYMB> *pout = out.wr(), *pout0 = pout;
@@ -1207,6 +1221,40 @@ struct s2_frame_receiver : runnable
     s2_sof<T> sof;
     int m_modcodType;
     int m_modcodRate;
+
+    // MODCOD and constellation state as seen by the receiver. cstln is
+    // replaced on the scheduler thread so other threads must only read
+    // this copy through get_modcod_status().
+    struct modcod_status
+    {
+        bool set_by_modcod; // cstln was created from a decoded MODCOD
+        int type_code;      // cstln_base::predef of cstln
+        int rate_code;      // code_rate of cstln
+        int modcod_type;    // Last decoded MODCOD constellation
+        int modcod_rate;    // Last decoded MODCOD code rate
+    };
+
+    modcod_status get_modcod_status()
+    {
+        std::lock_guard<std::mutex> lock(modcod_mutex);
+        return modcod_published;
+    }
+
+  private:
+    std::mutex modcod_mutex;
+    modcod_status modcod_published;
+
+    void publish_modcod_status()
+    {
+        std::lock_guard<std::mutex> lock(modcod_mutex);
+        modcod_published.set_by_modcod = cstln && cstln->m_setByModcod;
+        modcod_published.type_code = cstln ? cstln->m_typeCode : -1;
+        modcod_published.rate_code = cstln ? cstln->m_rateCode : -1;
+        modcod_published.modcod_type = m_modcodType;
+        modcod_published.modcod_rate = m_modcodRate;
+    }
+
+  public:
     // Max size of one frame
     //    static const int MAX_SLOTS = 360;
     static const int MAX_SLOTS = 240; // DEBUG match test signal
@@ -2090,82 +2138,155 @@ template <typename SOFTBIT, typename SOFTBYTE>
 struct s2_fecdec : runnable
 {
     int bitflips;
+    int max_iterations; // Soft decision LDPC (SOFTBYTE=llr_sb)
+    int nthreads;       // Frames decoded in parallel (SOFTBYTE=llr_sb)
     s2_fecdec(scheduler *sch,
               pipebuf<fecframe<SOFTBYTE>> &_in, pipebuf<bbframe> &_out,
               pipebuf<int> *_bitcount = NULL,
               pipebuf<int> *_errcount = NULL)
         : runnable(sch, "S2 fecdec"),
           bitflips(0),
+          max_iterations(25),
+          nthreads(1),
+          pool(NULL),
           in(_in), out(_out),
           bitcount(opt_writer(_bitcount, 1)),
           errcount(opt_writer(_errcount, 1))
     {
+        memset(minsum, 0, sizeof(minsum));
         if (sch->debug)
             s2ldpc.print_node_stats();
     }
+    ~s2_fecdec()
+    {
+        for (int sf = 0; sf <= 1; ++sf)
+            for (int fec = 0; fec < FEC_COUNT; ++fec)
+                delete minsum[sf][fec];
+        delete pool;
+    }
     void run()
     {
         while (in.readable() >= 1 && out.writable() >= 1 &&
                opt_writable(bitcount, 1) && opt_writable(errcount, 1))
         {
-            fecframe<SOFTBYTE> *pin = in.rd();
-            const modcod_info *mcinfo = check_modcod(pin->pls.modcod);
-            const fec_info *fi = &fec_infos[pin->pls.sf][mcinfo->rate];
-            bool corrupted = false;
-            bool residual_errors;
-            if (true)
-            {
-                // LDPC decode
-                size_t cwbits = pin->pls.framebits();
-                size_t msgbits = fi->kldpc;
-                size_t chkbits = cwbits - msgbits;
-                s2_ldpc_engine *ldpc = s2ldpc.ldpcs[pin->pls.sf][mcinfo->rate];
-                int ncorr = ldpc->decode_bitflip(fi->ldpc, pin->bytes, msgbits, cwbits, bitflips);
-                if (sch->debug2)
-                    fprintf(stderr, "LDPCCORR = %d\n", ncorr);
-            }
-            uint8_t *hardbytes = softbytes_harden(pin->bytes, fi->kldpc / 8, bch_buf);
-            if (true)
-            {
-                // BCH decode
-                size_t cwbytes = fi->kldpc / 8;
-                size_t msgbytes = fi->Kbch / 8;
-                size_t chkbytes = cwbytes - msgbytes;
-                // Decode with suitable BCH decoder for this MODCOD
-                bch_interface *bch = s2bch.bchs[pin->pls.sf][mcinfo->rate];
-                int ncorr = bch->decode(hardbytes, cwbytes);
-                if (sch->debug2)
-                    fprintf(stderr, "BCHCORR = %d\n", ncorr);
-                corrupted = (ncorr < 0);
-                residual_errors = (ncorr != 0);
-                // Report VER
-                opt_write(bitcount, fi->Kbch);
-                opt_write(errcount, (ncorr >= 0) ? ncorr : fi->Kbch);
-            }
-            int bbsize = fi->Kbch / 8;
-            // TBD Some decoders want the bad packets.
+            // Take as many frames as can be output in one go,
+            // up to one per decoding thread.
+            int nframes = 1;
+            int maxframes = batch_size(in.rd());
+            while (nframes < maxframes &&
+                   in.readable() > nframes &&
+                   out.writable() > nframes &&
+                   opt_writable(bitcount, nframes + 1) &&
+                   opt_writable(errcount, nframes + 1))
+                ++nframes;
+            // LDPC decode
+            decode_ldpc(in.rd(), nframes);
+            for (int f = 0; f < nframes; ++f)
+                decode_bch(in.rd());
+        }
+    }
+
+  private:
+    void decode_bch(fecframe<SOFTBYTE> *pin)
+    {
+        const modcod_info *mcinfo = check_modcod(pin->pls.modcod);
+        const fec_info *fi = &fec_infos[pin->pls.sf][mcinfo->rate];
+        bool corrupted = false;
+        bool residual_errors;
+        uint8_t *hardbytes = softbytes_harden(pin->bytes, fi->kldpc / 8, bch_buf);
+        if (true)
+        {
+            // BCH decode
+            size_t cwbytes = fi->kldpc / 8;
+            size_t msgbytes = fi->Kbch / 8;
+            size_t chkbytes = cwbytes - msgbytes;
+            // Decode with suitable BCH decoder for this MODCOD
+            bch_interface *bch = s2bch.bchs[pin->pls.sf][mcinfo->rate];
+            int ncorr = bch->decode(hardbytes, cwbytes);
+            if (sch->debug2)
+                fprintf(stderr, "BCHCORR = %d\n", ncorr);
+            corrupted = (ncorr < 0);
+            residual_errors = (ncorr != 0);
+            // Report VER
+            opt_write(bitcount, fi->Kbch);
+            opt_write(errcount, (ncorr >= 0) ? ncorr : fi->Kbch);
+        }
+        int bbsize = fi->Kbch / 8;
+        // TBD Some decoders want the bad packets.
 #if 0
 	if ( corrupted ) {
 	  fprintf(stderr, "Passing bad frame\n");
 	  corrupted = false;
 	}
 #endif
-            if (!corrupted)
-            {
-                // Descramble and output
-                bbframe *pout = out.wr();
-                pout->pls = pin->pls;
-                bbscrambling.transform(hardbytes, bbsize, pout->bytes);
-                out.written(1);
-            }
-            if (sch->debug)
-                fprintf(stderr, "%c", corrupted ? ':' : residual_errors ? '.' : '_');
-            in.read(1);
+        if (!corrupted)
+        {
+            // Descramble and output
+            bbframe *pout = out.wr();
+            pout->pls = pin->pls;
+            bbscrambling.transform(hardbytes, bbsize, pout->bytes);
+            out.written(1);
         }
+        if (sch->debug)
+            fprintf(stderr, "%c", corrupted ? ':' : residual_errors ? '.' : '_');
+        in.read(1);
     }
 
-  private:
+    int batch_size(fecframe<hard_sb> *)
+    {
+        return 1;
+    }
+
+    int batch_size(fecframe<llr_sb> *)
+    {
+        return nthreads < 1 ? 1 : nthreads > MAX_BATCH ? MAX_BATCH : nthreads;
+    }
+
+    // Hard decision bit flipping
+    void decode_ldpc(fecframe<hard_sb> *pin, int nframes)
+    {
+        for (int f = 0; f < nframes; ++f, ++pin)
+        {
+            const modcod_info *mcinfo = check_modcod(pin->pls.modcod);
+            const fec_info *fi = &fec_infos[pin->pls.sf][mcinfo->rate];
+            size_t cwbits = pin->pls.framebits();
+            size_t msgbits = fi->kldpc;
+            typename s2_ldpc_engines<SOFTBIT, SOFTBYTE>::s2_ldpc_engine *ldpc =
+                s2ldpc.ldpcs[pin->pls.sf][mcinfo->rate];
+            int ncorr = ldpc->decode_bitflip(fi->ldpc, pin->bytes, msgbits, cwbits, bitflips);
+            if (sch->debug2)
+                fprintf(stderr, "LDPCCORR = %d\n", ncorr);
+        }
+    }
+
+    // Soft decision layered min-sum, frames in parallel
+    void decode_ldpc(fecframe<llr_sb> *pin, int nframes)
+    {
+        if (!pool)
+            pool = new ldpc_minsum_pool<uint16_t>(batch_size(pin));
+        typename ldpc_minsum_pool<uint16_t>::job jobs[MAX_BATCH];
+        for (int f = 0; f < nframes; ++f)
+        {
+            const modcod_info *mcinfo = check_modcod(pin[f].pls.modcod);
+            const fec_info *fi = &fec_infos[pin[f].pls.sf][mcinfo->rate];
+            ldpc_minsum_decoder<uint16_t> *&dec = minsum[pin[f].pls.sf][mcinfo->rate];
+            if (!dec)
+                dec = new ldpc_minsum_decoder<uint16_t>(fi->ldpc, fi->kldpc, pin[f].pls.framebits());
+            jobs[f].decoder = dec;
+            jobs[f].llrs = (int8_t *)pin[f].bytes;
+        }
+        pool->decode(jobs, nframes, max_iterations);
+        if (sch->debug2)
+        {
+            for (int f = 0; f < nframes; ++f)
+                fprintf(stderr, "LDPCITER = %d\n", jobs[f].result);
+        }
+    }
+
+    static const int MAX_BATCH = 16;
     s2_ldpc_engines<SOFTBIT, SOFTBYTE> s2ldpc;
+    ldpc_minsum_decoder<uint16_t> *minsum[2][FEC_COUNT]; // Built on first use
+    ldpc_minsum_pool<uint16_t> *pool;
     uint8_t bch_buf[64800 / 8]; // Temp storage for hardening before BCH
     s2_bch_engines s2bch;
     s2_bbscrambling bbscrambling;
@@ -1363,18 +1363,18 @@ static const s2_ldpc_table ldpc_sf_fec25 =
                  {12, {4108, 3781, 7577, 6810, 9322, 8226, 5396, 5867, 4428, 8827, 7766, 2254}},
                  {12, {4247, 888, 4367, 8821, 9660, 324, 5864, 4774, 227, 7889, 6405, 8963}},
                  {12, {9693, 500, 2520, 2227, 1811, 9330, 1928, 5140, 4030, 4824, 806, 3134}},
-                 {12, {1652, 8171, 1435}},
-                 {12, {3366, 6543, 3745}},
-                 {12, {9286, 8509, 4645}},
-                 {12, {7397, 5790, 8972}},
-                 {12, {6597, 4422, 1799}},
-                 {12, {9276, 4041, 3847}},
-                 {12, {8683, 7378, 4946}},
-                 {12, {5348, 1993, 9186}},
-                 {12, {6724, 9015, 5646}},
-                 {12, {4502, 4439, 8474}},
-                 {12, {5107, 7342, 9442}},
-                 {12, {1387, 8910, 2660}},
+                 {3, {1652, 8171, 1435}},
+                 {3, {3366, 6543, 3745}},
+                 {3, {9286, 8509, 4645}},
+                 {3, {7397, 5790, 8972}},
+                 {3, {6597, 4422, 1799}},
+                 {3, {9276, 4041, 3847}},
+                 {3, {8683, 7378, 4946}},
+                 {3, {5348, 1993, 9186}},
+                 {3, {6724, 9015, 5646}},
+                 {3, {4502, 4439, 8474}},
+                 {3, {5107, 7342, 9442}},
+                 {3, {1387, 8910, 2660}},
              }};
 
 // EN 302 307-1 Table C.4
@@ -1472,7 +1472,7 @@ static const s2_ldpc_table ldpc_sf_fec23 =
 // EN 302 307-1 Table C.7
 static const s2_ldpc_table ldpc_sf_fec34 =
     {12, 33, {
-                 {3, {3, 3198, 478, 4207, 1481, 1009, 2616, 1924, 3437, 554, 683, 1801}},
+                 {12, {3, 3198, 478, 4207, 1481, 1009, 2616, 1924, 3437, 554, 683, 1801}},
                  {3, {4, 2681, 2135}},
                  {3, {5, 3107, 4027}},
                  {3, {6, 2637, 3373}},
@@ -1,5 +1,13 @@
 #include "framework.h"
 
+#include <chrono>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
 namespace leansdr
 {
 
@@ -13,4 +21,155 @@ void fail(const char *s)
     fprintf(stderr, "** %s\n", s);
 }
 
+unsigned long long scheduler::thread_cpu_ns()
+{
+#if defined(_WIN32)
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+
+    if (GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime))
+    {
+        unsigned long long k = ((unsigned long long) kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+        unsigned long long u = ((unsigned long long) userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+        return (k + u) * 100; // 100ns units
+    }
+
+    return 0;
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (unsigned long long) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void scheduler::start_threads()
+{
+    if (workers_running)
+        return;
+
+    constructing = NULL;
+    ngroups = 0;
+
+    // A pipe is shared if its clients are not all in the same group
+    for (int i = 0; i < npipes; ++i)
+    {
+        pipes[i]->owner = -1;
+        pipes[i]->shared = pipes[i]->external;
+    }
+
+    for (int i = 0; i < nrunnables; ++i)
+    {
+        runnable_common *r = runnables[i];
+
+        if (r->group + 1 > ngroups)
+            ngroups = r->group + 1;
+
+        for (int j = 0; j < r->npipes; ++j)
+        {
+            pipebuf_common *p = r->pipes[j];
+
+            if (p->owner < 0)
+                p->owner = r->group;
+            else if (p->owner != r->group)
+                p->shared = true;
+        }
+    }
+
+    // Locks are always taken in pipe index order
+    for (int i = 0; i < nrunnables; ++i)
+    {
+        runnable_common *r = runnables[i];
+        r->nlocked = 0;
+
+        for (int k = 0; k < npipes; ++k)
+        {
+            for (int j = 0; j < r->npipes; ++j)
+            {
+                if ((r->pipes[j] == pipes[k]) && pipes[k]->shared)
+                {
+                    r->locked[r->nlocked++] = pipes[k];
+                    break;
+                }
+            }
+        }
+    }
+
+    workers_running = true;
+
+    for (int g = 0; g < ngroups; ++g)
+        workers.push_back(std::thread(&scheduler::run_group, this, g));
+}
+
+void scheduler::stop_threads()
+{
+    if (!workers_running)
+        return;
+
+    workers_running = false;
+    wake();
+
+    for (std::size_t i = 0; i < workers.size(); ++i)
+        workers[i].join();
+
+    workers.clear();
+}
+
+void scheduler::wake()
+{
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        wake_gen++;
+    }
+
+    wake_cv.notify_all();
+}
+
+void scheduler::run_group(int group)
+{
+    while (workers_running)
+    {
+        unsigned long gen;
+
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            gen = wake_gen;
+        }
+
+        bool progress = false;
+
+        for (int i = 0; i < nrunnables; ++i)
+        {
+            runnable_common *r = runnables[i];
+
+            if (r->group != group)
+                continue;
+
+            for (int j = 0; j < r->nlocked; ++j)
+                r->locked[j]->mutex.lock();
+
+            unsigned long long h = r->pipes_hash();
+            run_timed(r);
+            progress |= (r->pipes_hash() != h);
+
+            for (int j = r->nlocked - 1; j >= 0; --j)
+                r->locked[j]->mutex.unlock();
+        }
+
+        if (progress)
+        {
+            wake(); // Other groups may have something to do now
+        }
+        else
+        {
+            // Nothing to do until another group or the application makes progress
+            std::unique_lock<std::mutex> lock(wake_mutex);
+            wake_cv.wait_for(lock, std::chrono::milliseconds(20), [&] {
+                return (wake_gen != gen) || !workers_running;
+            });
+        }
+    }
+}
+
 } // leansdr
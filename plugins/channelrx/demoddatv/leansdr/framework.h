@@ -19,6 +19,11 @@
 
 #include <cstddef>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include <math.h>
 #include <stdint.h>
@@ -45,10 +50,18 @@ void fail(const char *s);
 // [pipereader] is a client-side hook reading from a [pipebuf].
 // [runnable] is anything that moves data between [pipebufs].
 // [scheduler] is a global context which invokes [runnables] until fixpoint.
+//
+// In threaded mode runnables are partitioned in groups each run by
+// its own thread. Pipes with clients in more than one group (or with
+// a client outside any runnable) are locked by the scheduler for the
+// duration of the run() of each of their clients.
 
 static const int MAX_PIPES = 64;
 static const int MAX_RUNNABLES = 64;
 static const int MAX_READERS = 8;
+static const int MAX_RUNNABLE_PIPES = 16;
+
+struct scheduler;
 
 struct pipebuf_common
 {
@@ -68,24 +81,77 @@ struct pipebuf_common
     }
 
     const char *name;
+    scheduler *sch;
+    int index;     // Position in scheduler, gives the locking order
+    bool external; // Has a client outside any runnable
+    bool shared;   // Accessed from more than one thread in threaded mode
+    int owner;     // Group of the first client (threaded mode setup)
+    std::mutex mutex;
 
-    pipebuf_common(const char *_name) : name(_name)
+    pipebuf_common(const char *_name) : name(_name),
+                                        sch(NULL),
+                                        index(0),
+                                        external(false),
+                                        shared(false),
+                                        owner(-1)
     {
     }
 
     virtual ~pipebuf_common()
     {
     }
+
+    // For clients outside runnables in threaded mode
+    void lock()
+    {
+        mutex.lock();
+    }
+
+    void unlock()
+    {
+        mutex.unlock();
+    }
 };
 
 struct runnable_common
 {
     const char *name;
+    int group; // Thread group in threaded mode
+    pipebuf_common *pipes[MAX_RUNNABLE_PIPES];
+    int npipes;
+    pipebuf_common *locked[MAX_RUNNABLE_PIPES]; // Shared pipes in locking order
+    int nlocked;
+    std::atomic<unsigned long long> cpu_ns; // CPU time spent in run()
+    std::atomic<unsigned long long> nruns;
 
-    runnable_common(const char *_name) : name(_name)
+    runnable_common(const char *_name) : name(_name),
+                                         group(0),
+                                         npipes(0),
+                                         nlocked(0),
+                                         cpu_ns(0),
+                                         nruns(0)
     {
     }
 
+    void attach_pipe(pipebuf_common *p)
+    {
+        for (int i = 0; i < npipes; ++i)
+            if (pipes[i] == p)
+                return;
+        if (npipes == MAX_RUNNABLE_PIPES)
+            fail("MAX_RUNNABLE_PIPES");
+        else
+            pipes[npipes++] = p;
+    }
+
+    unsigned long long pipes_hash()
+    {
+        unsigned long long h = 0;
+        for (int i = 0; i < npipes; ++i)
+            h += pipes[i]->hash();
+        return h;
+    }
+
     virtual ~runnable_common()
     {
     }
@@ -117,22 +183,34 @@ struct scheduler
     int npipes;
     runnable_common *runnables[MAX_RUNNABLES];
     int nrunnables;
+    runnable_common *constructing; // Runnable being constructed: owner of new pipe clients
     window_placement *windows;
     bool verbose, debug, debug2;
 
     scheduler() : npipes(0),
                   nrunnables(0),
+                  constructing(NULL),
                   windows(NULL),
                   verbose(false),
                   debug(false),
-                  debug2(false)
+                  debug2(false),
+                  ngroups(0),
+                  workers_running(false),
+                  wake_gen(0)
+    {
+    }
+
+    ~scheduler()
     {
+        stop_threads();
     }
 
     void add_pipe(pipebuf_common *p)
     {
         if (npipes == MAX_PIPES)
             fail("MAX_PIPES");
+        p->sch = this;
+        p->index = npipes;
         pipes[npipes++] = p;
     }
 
@@ -141,12 +219,41 @@ struct scheduler
         if (nrunnables == MAX_RUNNABLES)
             fail("MAX_RUNNABLES");
         runnables[nrunnables++] = r;
+        constructing = r;
+    }
+
+    // Called by pipe readers and writers when they are created.
+    // Clients created before the first runnable or after end_construction()
+    // belong to the application.
+    void attach_client(pipebuf_common *p)
+    {
+        if (constructing)
+            constructing->attach_pipe(p);
+        else
+            p->external = true;
+    }
+
+    void end_construction()
+    {
+        constructing = NULL;
+    }
+
+    void set_group(runnable_common *r, int group)
+    {
+        if (r)
+            r->group = group;
     }
 
     void step()
     {
+        if (workers_running)
+        {
+            wake(); // Worker threads do the job
+            return;
+        }
+
         for (int i = 0; i < nrunnables; ++i)
-            runnables[i]->run();
+            run_timed(runnables[i]);
     }
 
     void run()
@@ -165,6 +272,8 @@ struct scheduler
 
     void shutdown()
     {
+        stop_threads();
+
         for (int i = 0; i < nrunnables; ++i)
             runnables[i]->shutdown();
     }
@@ -186,6 +295,34 @@ struct scheduler
         fprintf(stderr, "Total buffer memory: %ld KiB\n",
                 (unsigned long)total_bufs / 1024);
     }
+
+    // Threaded mode: one thread per group of runnables (see set_group)
+    void start_threads();
+    void stop_threads();
+    bool threaded() const
+    {
+        return workers_running;
+    }
+    void wake();
+    static unsigned long long thread_cpu_ns();
+
+  private:
+    int ngroups;
+    std::vector<std::thread> workers;
+    std::atomic<bool> workers_running;
+    std::mutex wake_mutex;
+    std::condition_variable wake_cv;
+    unsigned long wake_gen;
+
+    void run_timed(runnable_common *r)
+    {
+        unsigned long long t0 = thread_cpu_ns();
+        r->run();
+        r->cpu_ns += thread_cpu_ns() - t0;
+        r->nruns++;
+    }
+
+    void run_group(int group);
 };
 
 struct runnable : runnable_common
@@ -291,6 +428,7 @@ struct pipewriter
     {
         if (min_write > buf.min_write)
             buf.min_write = min_write;
+        buf.sch->attach_client(&buf);
     }
     // Return number of items writable at this->wr, 0 if full.
     long writable()
@@ -352,6 +490,7 @@ struct pipereader
 
     pipereader(pipebuf<T> &_buf) : buf(_buf), id(_buf.add_reader())
     {
+        buf.sch->attach_client(&buf);
     }
 
     long readable()
@@ -17,6 +17,21 @@
 #ifndef LEANSDR_LDPC_H
 #define LEANSDR_LDPC_H
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(USE_AVX2)
+#include <immintrin.h>
+#elif defined(USE_SSSE3)
+#include <tmmintrin.h>
+#endif
+
 #define lfprintf(...) \
     {                 \
     }
@@ -520,6 +535,501 @@ struct ldpc_engine
 
 }; // ldpc_engine
 
+// LAYERED NORMALIZED MIN-SUM DECODER
+
+// Soft decision decoder for S2-style tables.
+// The parity part is the staircase of EN 302 307-1 5.3.2.1:
+// check c covers the message bits given by the table,
+// parity bit c and parity bit c-1 (as transmitted).
+// Checks c = r + q*i (i = 0..359) form layer r. In a layer the message
+// bits of each table entry are a cyclic shift of a group of 360 bits,
+// so the 360 checks of a layer are processed in parallel SIMD lanes
+// with contiguous loads.
+// LLRs are int8 (llr_t convention, positive means 0) with saturation.
+
+struct ldpc_minsum_workspace
+{
+    static const int LANES = 360;
+    static const int PLANES = 384; // LANES padded to a multiple of the SIMD width
+
+    int8_t *post; // Posterior LLRs. Message bits then parity bits in layer order.
+    int8_t *cmsg; // Check to variable messages [edge][PLANES]
+    int8_t *gath; // Posteriors of the layer being processed [edge][PLANES]
+    int8_t *tmp;  // Variable to check messages [edge][PLANES]
+    int8_t *orig; // Gathered posteriors before update [edge][PLANES]
+    int npost, ncmsg, ngath;
+
+    ldpc_minsum_workspace()
+        : post(NULL), cmsg(NULL), gath(NULL), tmp(NULL), orig(NULL),
+          npost(0), ncmsg(0), ngath(0)
+    {
+    }
+
+    ~ldpc_minsum_workspace()
+    {
+        free(post);
+        free(cmsg);
+        free(gath);
+        free(tmp);
+        free(orig);
+    }
+
+    void reserve(int _npost, int _ncmsg, int _ngath)
+    {
+        if (_npost > npost)
+        {
+            free(post);
+            post = (int8_t *)malloc(_npost);
+            npost = _npost;
+        }
+        if (_ncmsg > ncmsg)
+        {
+            free(cmsg);
+            cmsg = (int8_t *)malloc(_ncmsg);
+            ncmsg = _ncmsg;
+        }
+        if (_ngath > ngath)
+        {
+            free(gath);
+            free(tmp);
+            free(orig);
+            gath = (int8_t *)malloc(_ngath);
+            tmp = (int8_t *)malloc(_ngath);
+            orig = (int8_t *)malloc(_ngath);
+            ngath = _ngath;
+        }
+        if (!post || !cmsg || !gath || !tmp || !orig)
+            fatal("ldpc_minsum_workspace");
+    }
+};
+
+template <typename Taddr>
+struct ldpc_minsum_decoder
+{
+    static const int LANES = ldpc_minsum_workspace::LANES;
+    static const int PLANES = ldpc_minsum_workspace::PLANES;
+
+    struct edge
+    {
+        int base;  // Posterior of lane i is post[base+(i-shift)%360]
+        int shift;
+        bool skip0; // Lane 0 is not connected (check 0 has no parity bit -1)
+        bool dup;   // Group has several edges in the layer: updates are summed
+    };
+
+    int k, n, q;
+    int *layers; // [q+1] First edge of each layer
+    edge *edges;
+    int nedges;
+    int maxdeg;
+
+    ldpc_minsum_decoder(const ldpc_table<Taddr> *table, int _k, int _n)
+        : k(_k), n(_n), q(table->q)
+    {
+        if (k != table->nrows * LANES)
+            fatal("Bad table");
+        if (q * LANES != n - k)
+            fatal("Bad q");
+
+        // Sort table entries by layer
+        std::vector<std::vector<edge>> bylayer(q);
+        for (int row = 0; row < table->nrows; ++row)
+        {
+            const typename ldpc_table<Taddr>::row *prow = &table->rows[row];
+            for (int c = 0; c < prow->ncols; ++c)
+            {
+                int a = prow->cols[c];
+                edge e = {row * LANES, a / q, false, false};
+                std::vector<edge> &layer = bylayer[a % q];
+                for (size_t j = 0; j < layer.size(); ++j)
+                {
+                    if (layer[j].base == e.base)
+                        layer[j].dup = e.dup = true;
+                }
+                layer.push_back(e);
+            }
+        }
+
+        nedges = 0;
+        for (int r = 0; r < q; ++r)
+            nedges += bylayer[r].size() + 2;
+        layers = new int[q + 1];
+        edges = new edge[nedges];
+        maxdeg = 0;
+
+        int ne = 0;
+        for (int r = 0; r < q; ++r)
+        {
+            layers[r] = ne;
+            for (size_t j = 0; j < bylayer[r].size(); ++j)
+                edges[ne++] = bylayer[r][j];
+            // Parity bit c = r+q*i
+            edge pc = {k + r * LANES, 0, false, false};
+            edges[ne++] = pc;
+            // Parity bit c-1: previous layer, previous lane when wrapping
+            edge pp = {k + (r ? r - 1 : q - 1) * LANES, r ? 0 : 1, r == 0, false};
+            edges[ne++] = pp;
+            if (ne - layers[r] > maxdeg)
+                maxdeg = ne - layers[r];
+        }
+        layers[q] = ne;
+    }
+
+    ~ldpc_minsum_decoder()
+    {
+        delete[] layers;
+        delete[] edges;
+    }
+
+    // llrs: n LLRs as transmitted (message bits then parity bits),
+    // replaced by the decoded posteriors.
+    // Returns the number of iterations or -1 if not converged.
+
+    int decode(int8_t *llrs, int max_iterations, ldpc_minsum_workspace *ws) const
+    {
+        ws->reserve(n, nedges * PLANES, maxdeg * PLANES);
+        int8_t *post = ws->post;
+
+        for (int i = 0; i < k; ++i)
+            post[i] = clamp(llrs[i]);
+        for (int r = 0; r < q; ++r)
+            for (int i = 0; i < LANES; ++i)
+                post[k + r * LANES + i] = clamp(llrs[k + r + q * i]);
+
+        memset(ws->cmsg, 0, nedges * PLANES);
+        int iterations = -1;
+
+        for (int it = 1; it <= max_iterations; ++it)
+        {
+            bool unsatisfied = false, changed = false;
+
+            for (int r = 0; r < q; ++r)
+            {
+                int e0 = layers[r], d = layers[r + 1] - e0;
+                for (int e = 0; e < d; ++e)
+                {
+                    gather(post, &edges[e0 + e], ws->gath + e * PLANES);
+                    if (edges[e0 + e].dup)
+                        memcpy(ws->orig + e * PLANES, ws->gath + e * PLANES, PLANES);
+                }
+                process_layer(ws->gath, ws->tmp, ws->cmsg + e0 * PLANES, d, unsatisfied, changed);
+                for (int e = 0; e < d; ++e)
+                {
+                    if (edges[e0 + e].dup)
+                        scatter_add(ws->gath + e * PLANES, ws->orig + e * PLANES, &edges[e0 + e], post);
+                    else
+                        scatter(ws->gath + e * PLANES, &edges[e0 + e], post, ws->cmsg + (e0 + e) * PLANES);
+                }
+            }
+
+            // No sign changed during the whole iteration and every check
+            // was satisfied when processed: the hard decision is a codeword.
+            if (!unsatisfied && !changed)
+            {
+                iterations = it;
+                break;
+            }
+        }
+
+        memcpy(llrs, post, k);
+        for (int r = 0; r < q; ++r)
+            for (int i = 0; i < LANES; ++i)
+                llrs[k + r + q * i] = post[k + r * LANES + i];
+
+        return iterations;
+    }
+
+  private:
+    static inline int8_t clamp(int8_t l)
+    {
+        return l == -128 ? -127 : l;
+    }
+
+    static void gather(const int8_t *post, const edge *pe, int8_t *g)
+    {
+        const int8_t *p = post + pe->base;
+        memcpy(g + pe->shift, p, LANES - pe->shift);
+        memcpy(g, p + LANES - pe->shift, pe->shift);
+        if (pe->skip0)
+            g[0] = 127; // Neutral: positive with maximum reliability
+        memset(g + LANES, 127, PLANES - LANES);
+    }
+
+    static void scatter(const int8_t *g, const edge *pe, int8_t *post, int8_t *cmsg)
+    {
+        int8_t *p = post + pe->base;
+        memcpy(p, g + pe->shift, LANES - pe->shift);
+        if (pe->skip0)
+            cmsg[0] = 0; // Keep the unconnected lane neutral
+        else
+            memcpy(p + LANES - pe->shift, g, pe->shift);
+    }
+
+    // Add the update to the posteriors. Used when the same bit is
+    // connected to several checks of the layer.
+    static void scatter_add(const int8_t *g, const int8_t *orig, const edge *pe, int8_t *post)
+    {
+        int8_t *p = post + pe->base;
+        for (int i = 0; i < LANES; ++i)
+        {
+            int8_t *pv = &p[(i + LANES - pe->shift) % LANES];
+            int l = *pv + g[i] - orig[i];
+            *pv = l < -127 ? -127 : l > 127 ? 127 : l;
+        }
+    }
+
+    // Update the d edges of a layer.
+    // g: posteriors in, updated posteriors out.
+    // cmsg: check to variable messages in and out.
+    // Normalization factor is 7/8.
+    // The stored message is the increment actually applied to the
+    // saturated posterior so that removing it next iteration is exact.
+
+    static void process_layer(int8_t *g, int8_t *t, int8_t *cmsg, int d,
+                              bool &unsatisfied, bool &changed)
+    {
+#if defined(USE_AVX2)
+        const __m256i m128 = _mm256_set1_epi8(-128);
+        const __m256i one = _mm256_set1_epi8(1);
+        const __m256i m1f = _mm256_set1_epi8(0x1f);
+        __m256i unsat = _mm256_setzero_si256(), chg = _mm256_setzero_si256();
+
+        for (int p = 0; p < PLANES; p += 32)
+        {
+            __m256i min1 = _mm256_set1_epi8(127), min2 = min1;
+            __m256i sgn = _mm256_setzero_si256();
+
+            for (int e = 0; e < d; ++e)
+            {
+                __m256i x = _mm256_loadu_si256((const __m256i *)(g + e * PLANES + p));
+                __m256i c = _mm256_loadu_si256((const __m256i *)(cmsg + e * PLANES + p));
+                __m256i v = _mm256_subs_epi8(x, c);
+                v = _mm256_sub_epi8(v, _mm256_cmpeq_epi8(v, m128));
+                _mm256_storeu_si256((__m256i *)(t + e * PLANES + p), v);
+                __m256i a = _mm256_abs_epi8(v);
+                min2 = _mm256_min_epu8(min2, _mm256_max_epu8(min1, a));
+                min1 = _mm256_min_epu8(min1, a);
+                sgn = _mm256_xor_si256(sgn, v);
+            }
+
+            __m256i n1 = _mm256_sub_epi8(min1, _mm256_and_si256(_mm256_srli_epi16(min1, 3), m1f));
+            __m256i n2 = _mm256_sub_epi8(min2, _mm256_and_si256(_mm256_srli_epi16(min2, 3), m1f));
+            __m256i par = _mm256_setzero_si256();
+
+            for (int e = 0; e < d; ++e)
+            {
+                __m256i v = _mm256_loadu_si256((const __m256i *)(t + e * PLANES + p));
+                __m256i mag = _mm256_blendv_epi8(n1, n2, _mm256_cmpeq_epi8(_mm256_abs_epi8(v), min1));
+                __m256i c = _mm256_sign_epi8(mag, _mm256_or_si256(_mm256_xor_si256(v, sgn), one));
+                __m256i l = _mm256_adds_epi8(v, c);
+                l = _mm256_sub_epi8(l, _mm256_cmpeq_epi8(l, m128));
+                __m256i x = _mm256_loadu_si256((const __m256i *)(g + e * PLANES + p));
+                chg = _mm256_or_si256(chg, _mm256_xor_si256(x, l));
+                par = _mm256_xor_si256(par, l);
+                _mm256_storeu_si256((__m256i *)(g + e * PLANES + p), l);
+                _mm256_storeu_si256((__m256i *)(cmsg + e * PLANES + p), _mm256_sub_epi8(l, v));
+            }
+
+            unsat = _mm256_or_si256(unsat, par);
+        }
+
+        unsatisfied |= (_mm256_movemask_epi8(unsat) != 0);
+        changed |= (_mm256_movemask_epi8(chg) != 0);
+#elif defined(USE_SSSE3)
+        const __m128i m128 = _mm_set1_epi8(-128);
+        const __m128i one = _mm_set1_epi8(1);
+        const __m128i m1f = _mm_set1_epi8(0x1f);
+        __m128i unsat = _mm_setzero_si128(), chg = _mm_setzero_si128();
+
+        for (int p = 0; p < PLANES; p += 16)
+        {
+            __m128i min1 = _mm_set1_epi8(127), min2 = min1;
+            __m128i sgn = _mm_setzero_si128();
+
+            for (int e = 0; e < d; ++e)
+            {
+                __m128i x = _mm_loadu_si128((const __m128i *)(g + e * PLANES + p));
+                __m128i c = _mm_loadu_si128((const __m128i *)(cmsg + e * PLANES + p));
+                __m128i v = _mm_subs_epi8(x, c);
+                v = _mm_sub_epi8(v, _mm_cmpeq_epi8(v, m128));
+                _mm_storeu_si128((__m128i *)(t + e * PLANES + p), v);
+                __m128i a = _mm_abs_epi8(v);
+                min2 = _mm_min_epu8(min2, _mm_max_epu8(min1, a));
+                min1 = _mm_min_epu8(min1, a);
+                sgn = _mm_xor_si128(sgn, v);
+            }
+
+            __m128i n1 = _mm_sub_epi8(min1, _mm_and_si128(_mm_srli_epi16(min1, 3), m1f));
+            __m128i n2 = _mm_sub_epi8(min2, _mm_and_si128(_mm_srli_epi16(min2, 3), m1f));
+            __m128i par = _mm_setzero_si128();
+
+            for (int e = 0; e < d; ++e)
+            {
+                __m128i v = _mm_loadu_si128((const __m128i *)(t + e * PLANES + p));
+                __m128i is1 = _mm_cmpeq_epi8(_mm_abs_epi8(v), min1);
+                __m128i mag = _mm_or_si128(_mm_and_si128(is1, n2), _mm_andnot_si128(is1, n1));
+                __m128i c = _mm_sign_epi8(mag, _mm_or_si128(_mm_xor_si128(v, sgn), one));
+                __m128i l = _mm_adds_epi8(v, c);
+                l = _mm_sub_epi8(l, _mm_cmpeq_epi8(l, m128));
+                __m128i x = _mm_loadu_si128((const __m128i *)(g + e * PLANES + p));
+                chg = _mm_or_si128(chg, _mm_xor_si128(x, l));
+                par = _mm_xor_si128(par, l);
+                _mm_storeu_si128((__m128i *)(g + e * PLANES + p), l);
+                _mm_storeu_si128((__m128i *)(cmsg + e * PLANES + p), _mm_sub_epi8(l, v));
+            }
+
+            unsat = _mm_or_si128(unsat, par);
+        }
+
+        unsatisfied |= (_mm_movemask_epi8(unsat) != 0);
+        changed |= (_mm_movemask_epi8(chg) != 0);
+#else
+        for (int i = 0; i < LANES; ++i)
+        {
+            int min1 = 127, min2 = 127, sgn = 0;
+
+            for (int e = 0; e < d; ++e)
+            {
+                int v = g[e * PLANES + i] - cmsg[e * PLANES + i];
+                v = v < -127 ? -127 : v > 127 ? 127 : v;
+                t[e * PLANES + i] = v;
+                int a = v < 0 ? -v : v;
+                if (a < min1)
+                {
+                    min2 = min1;
+                    min1 = a;
+                }
+                else if (a < min2)
+                    min2 = a;
+                sgn ^= (v < 0);
+            }
+
+            int n1 = min1 - (min1 >> 3), n2 = min2 - (min2 >> 3);
+            int par = 0;
+
+            for (int e = 0; e < d; ++e)
+            {
+                int v = t[e * PLANES + i];
+                int a = v < 0 ? -v : v;
+                int c = (a == min1) ? n2 : n1;
+                if (sgn ^ (v < 0))
+                    c = -c;
+                int l = v + c;
+                l = l < -127 ? -127 : l > 127 ? 127 : l;
+                changed |= ((l < 0) != (g[e * PLANES + i] < 0));
+                par ^= (l < 0);
+                g[e * PLANES + i] = l;
+                cmsg[e * PLANES + i] = l - v;
+            }
+
+            unsatisfied |= (par != 0);
+        }
+#endif
+    }
+}; // ldpc_minsum_decoder
+
+// Decodes several frames in parallel with the calling thread
+// and nthreads-1 helper threads, each with its own workspace.
+
+template <typename Taddr>
+struct ldpc_minsum_pool
+{
+    struct job
+    {
+        const ldpc_minsum_decoder<Taddr> *decoder;
+        int8_t *llrs;
+        int result;
+    };
+
+    ldpc_minsum_pool(int _nthreads)
+        : nthreads(_nthreads < 1 ? 1 : _nthreads),
+          jobs(NULL), njobs(0), max_iterations(0),
+          generation(0), running(true)
+    {
+        workspaces = new ldpc_minsum_workspace[nthreads];
+        for (int i = 1; i < nthreads; ++i)
+            threads.push_back(std::thread(&ldpc_minsum_pool::worker, this, i));
+    }
+
+    ~ldpc_minsum_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        start_cv.notify_all();
+        for (size_t i = 0; i < threads.size(); ++i)
+            threads[i].join();
+        delete[] workspaces;
+    }
+
+    void decode(job *_jobs, int _njobs, int _max_iterations)
+    {
+        if (_njobs == 1 || nthreads == 1)
+        {
+            for (int j = 0; j < _njobs; ++j)
+                _jobs[j].result = _jobs[j].decoder->decode(_jobs[j].llrs, _max_iterations, &workspaces[0]);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs = _jobs;
+            njobs = _njobs;
+            max_iterations = _max_iterations;
+            next = 0;
+            pending = nthreads - 1;
+            ++generation;
+        }
+        start_cv.notify_all();
+        run_jobs(0);
+        std::unique_lock<std::mutex> lock(mutex);
+        done_cv.wait(lock, [this] { return pending == 0; });
+    }
+
+    int nthreads;
+
+  private:
+    void run_jobs(int w)
+    {
+        int j;
+        while ((j = next++) < njobs)
+            jobs[j].result = jobs[j].decoder->decode(jobs[j].llrs, max_iterations, &workspaces[w]);
+    }
+
+    void worker(int w)
+    {
+        unsigned long seen = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                start_cv.wait(lock, [&] { return generation != seen || !running; });
+                if (!running)
+                    return;
+                seen = generation;
+            }
+            run_jobs(w);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                --pending;
+            }
+            done_cv.notify_one();
+        }
+    }
+
+    ldpc_minsum_workspace *workspaces;
+    std::vector<std::thread> threads;
+    job *jobs;
+    int njobs;
+    int max_iterations;
+    std::atomic<int> next;
+    int pending;
+    unsigned long generation;
+    bool running;
+    std::mutex mutex;
+    std::condition_variable start_cv, done_cv;
+}; // ldpc_minsum_pool
+
 } // namespace leansdr
 
 #endif // LEANSDR_LDPC_H
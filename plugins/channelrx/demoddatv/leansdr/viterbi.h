@@ -21,6 +21,14 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(USE_AVX2)
+#include <immintrin.h>
+#elif defined(USE_SSE2)
+#include <emmintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
+#endif
+
 // This is a generic implementation of Viterbi with explicit
 // representation of the trellis.  There is special support for
 // convolutional coding, but the code can handle other schemes.
@@ -325,6 +333,316 @@ struct viterbi_dec : viterbi_dec_interface<TUS, TCS, TBM, TPM>
     TPM max_tpm;
 };
 
+// VECTORIZED K=7 DECODER
+
+// Specialized decoder for a K=7 rate 1/2 code (e.g. DVB-S 0171/0133)
+// and its punctured rates, with the same interface as viterbi_dec.
+// polys[bits_out] are the generators of the coded bits of one block
+// shifted by the step of the block they belong to, as in fec_specs.
+// Both generators must tap the oldest and the newest bits so that each
+// step is made of 32 add-compare-select butterflies, computed in
+// parallel with AVX2, SSE2 or NEON.
+// Branch metrics are the Hamming distance to the coded symbol weighted
+// by the symbol cost. Path metrics are 16-bit and renormalized after
+// each block. Decisions are kept one byte per state and traced back
+// every few blocks: decoded symbols are output with a fixed delay
+// of [delay] blocks.
+
+template <typename TUS, typename TCS, typename TBM, typename TPM>
+struct viterbi_dec_k7 : viterbi_dec_interface<TUS, TCS, TBM, TPM>
+{
+    static const int NSTATES = 64;
+    static const int HISTORY = 128; // Steps and blocks kept (power of 2)
+    static const int MAX_WEIGHT = 511; // Keeps path metrics within 16 bits
+
+    int delay; // Output delay in blocks
+
+    viterbi_dec_k7(int _bits_in, int _bits_out, const uint16_t *polys,
+                   uint16_t g1, uint16_t g2)
+        : bits_in(_bits_in), bits_out(_bits_out),
+          nsteps(0), nblocks(0)
+    {
+        if (!(g1 & g2 & 1) || !(g1 & g2 & 64) || (g1 | g2) >= 128)
+            fail("viterbi_dec_k7: Unsupported generators");
+        if (bits_in < 1 || bits_in > 8)
+            fail("viterbi_dec_k7: Unsupported code rate");
+
+        for (int t = 0; t < bits_in; ++t)
+            xbit[t] = ybit[t] = -1;
+
+        for (int p = 0; p < bits_out; ++p)
+        {
+            int t;
+
+            for (t = 0; t < bits_in; ++t)
+            {
+                if (polys[p] == (g1 << t) && xbit[t] < 0)
+                {
+                    xbit[t] = p;
+                    break;
+                }
+                if (polys[p] == (g2 << t) && ybit[t] < 0)
+                {
+                    ybit[t] = p;
+                    break;
+                }
+            }
+
+            if (t == bits_in)
+                fail("viterbi_dec_k7: Not a punctured rate 1/2 code");
+        }
+
+        // Coded bits of butterfly j (even state 2j, input 0) as masks
+        for (int j = 0; j < NSTATES / 2; ++j)
+        {
+            xmask[j] = parity((uint8_t)((2 * j) & g1)) ? -1 : 0;
+            ymask[j] = parity((uint8_t)((2 * j) & g2)) ? -1 : 0;
+        }
+
+        // Trace back 48 steps before decoding 32 steps at a time
+        traceback = (48 + bits_in - 1) / bits_in;
+        chunk = (32 + bits_in - 1) / bits_in;
+        delay = traceback + chunk;
+
+        memset(metrics, 0, sizeof(metrics));
+        memset(decisions, 0, sizeof(decisions));
+        memset(outputs, 0, sizeof(outputs));
+    }
+
+    // Update with full metric: hard decision on the best coded symbol
+    // weighted by its margin over the second best.
+
+    TUS update(TBM *costs, TPM *quality = NULL)
+    {
+        int ncs = 1 << bits_out;
+        TCS best = 0;
+        TBM best2_cost = costs[1];
+
+        for (int cs = 1; cs < ncs; ++cs)
+        {
+            if (costs[cs] < costs[best])
+            {
+                best2_cost = costs[best];
+                best = cs;
+            }
+            else if (cs > 1 && costs[cs] < best2_cost)
+            {
+                best2_cost = costs[cs];
+            }
+        }
+
+        return update(best, costs[best] - best2_cost, quality);
+    }
+
+    // Update with single-symbol metric.
+    // cost must be negative.
+
+    TUS update(TCS cs, TBM cost, TPM *quality = NULL)
+    {
+        int w = (-cost) >> 4;
+        w = w < 0 ? 0 : w > MAX_WEIGHT ? MAX_WEIGHT : w;
+
+        for (int t = 0; t < bits_in; ++t, ++nsteps)
+        {
+            int16_t wx = 0, wy = 0, rx = 0, ry = 0;
+
+            if (xbit[t] >= 0)
+            {
+                wx = w;
+                rx = ((cs >> (bits_out - 1 - xbit[t])) & 1) ? -1 : 0;
+            }
+            if (ybit[t] >= 0)
+            {
+                wy = w;
+                ry = ((cs >> (bits_out - 1 - ybit[t])) & 1) ? -1 : 0;
+            }
+
+            acs(wx, rx, wy, ry, decisions[nsteps & (HISTORY - 1)]);
+        }
+
+        int best2 = renormalize();
+
+        if (quality)
+            *quality = best2;
+        if (++nblocks % chunk == 0)
+            trace_back();
+
+        return outputs[(nblocks - 1 - delay) & (HISTORY - 1)];
+    }
+
+  private:
+    int bits_in, bits_out;
+    int xbit[8], ybit[8]; // Index of coded bits X and Y of each step, or -1
+    int16_t xmask[NSTATES / 2], ymask[NSTATES / 2];
+    int16_t metrics[NSTATES];
+    uint8_t decisions[HISTORY][NSTATES]; // Non-zero if the odd predecessor survived
+    TUS outputs[HISTORY];
+    int traceback, chunk;
+    unsigned long nsteps, nblocks;
+
+    // One trellis step. State s with input bit u goes to (s>>1)|(u<<5).
+    // Butterfly j: states 2j and 2j+1 to states j and j+32.
+    // rx, ry: received bits as masks. wx, wy: weights (0 if punctured).
+
+    void acs(int16_t wx, int16_t rx, int16_t wy, int16_t ry, uint8_t *dec)
+    {
+        int16_t newmetrics[NSTATES];
+#if defined(USE_AVX2)
+        const __m256i vwx = _mm256_set1_epi16(wx), vwy = _mm256_set1_epi16(wy);
+        const __m256i vrx = _mm256_set1_epi16(rx), vry = _mm256_set1_epi16(ry);
+        const __m256i vw = _mm256_set1_epi16(wx + wy);
+
+        for (int j = 0; j < NSTATES / 2; j += 16)
+        {
+            __m256i a = _mm256_loadu_si256((const __m256i *)&metrics[2 * j]);
+            __m256i b = _mm256_loadu_si256((const __m256i *)&metrics[2 * j + 16]);
+            __m256i e = _mm256_packs_epi32(_mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16),
+                                           _mm256_srai_epi32(_mm256_slli_epi32(b, 16), 16));
+            __m256i o = _mm256_packs_epi32(_mm256_srai_epi32(a, 16), _mm256_srai_epi32(b, 16));
+            e = _mm256_permute4x64_epi64(e, 0xd8);
+            o = _mm256_permute4x64_epi64(o, 0xd8);
+            __m256i xm = _mm256_loadu_si256((const __m256i *)&xmask[j]);
+            __m256i ym = _mm256_loadu_si256((const __m256i *)&ymask[j]);
+            __m256i bm = _mm256_add_epi16(_mm256_and_si256(_mm256_xor_si256(xm, vrx), vwx),
+                                          _mm256_and_si256(_mm256_xor_si256(ym, vry), vwy));
+            __m256i bmc = _mm256_sub_epi16(vw, bm);
+            __m256i e0 = _mm256_adds_epi16(e, bm), o0 = _mm256_adds_epi16(o, bmc);
+            __m256i e1 = _mm256_adds_epi16(e, bmc), o1 = _mm256_adds_epi16(o, bm);
+            _mm256_storeu_si256((__m256i *)&newmetrics[j], _mm256_min_epi16(e0, o0));
+            _mm256_storeu_si256((__m256i *)&newmetrics[j + NSTATES / 2], _mm256_min_epi16(e1, o1));
+            __m256i d = _mm256_packs_epi16(_mm256_cmpgt_epi16(e0, o0), _mm256_cmpgt_epi16(e1, o1));
+            d = _mm256_permute4x64_epi64(d, 0xd8);
+            _mm_storeu_si128((__m128i *)&dec[j], _mm256_castsi256_si128(d));
+            _mm_storeu_si128((__m128i *)&dec[j + NSTATES / 2], _mm256_extracti128_si256(d, 1));
+        }
+#elif defined(USE_SSE2)
+        const __m128i vwx = _mm_set1_epi16(wx), vwy = _mm_set1_epi16(wy);
+        const __m128i vrx = _mm_set1_epi16(rx), vry = _mm_set1_epi16(ry);
+        const __m128i vw = _mm_set1_epi16(wx + wy);
+
+        for (int j = 0; j < NSTATES / 2; j += 8)
+        {
+            __m128i a = _mm_loadu_si128((const __m128i *)&metrics[2 * j]);
+            __m128i b = _mm_loadu_si128((const __m128i *)&metrics[2 * j + 8]);
+            __m128i e = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                                        _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+            __m128i o = _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16));
+            __m128i xm = _mm_loadu_si128((const __m128i *)&xmask[j]);
+            __m128i ym = _mm_loadu_si128((const __m128i *)&ymask[j]);
+            __m128i bm = _mm_add_epi16(_mm_and_si128(_mm_xor_si128(xm, vrx), vwx),
+                                       _mm_and_si128(_mm_xor_si128(ym, vry), vwy));
+            __m128i bmc = _mm_sub_epi16(vw, bm);
+            __m128i e0 = _mm_adds_epi16(e, bm), o0 = _mm_adds_epi16(o, bmc);
+            __m128i e1 = _mm_adds_epi16(e, bmc), o1 = _mm_adds_epi16(o, bm);
+            _mm_storeu_si128((__m128i *)&newmetrics[j], _mm_min_epi16(e0, o0));
+            _mm_storeu_si128((__m128i *)&newmetrics[j + NSTATES / 2], _mm_min_epi16(e1, o1));
+            __m128i d = _mm_packs_epi16(_mm_cmpgt_epi16(e0, o0), _mm_cmpgt_epi16(e1, o1));
+            _mm_storel_epi64((__m128i *)&dec[j], d);
+            _mm_storel_epi64((__m128i *)&dec[j + NSTATES / 2], _mm_unpackhi_epi64(d, d));
+        }
+#elif defined(USE_NEON)
+        const int16x8_t vwx = vdupq_n_s16(wx), vwy = vdupq_n_s16(wy);
+        const int16x8_t vrx = vdupq_n_s16(rx), vry = vdupq_n_s16(ry);
+        const int16x8_t vw = vdupq_n_s16(wx + wy);
+
+        for (int j = 0; j < NSTATES / 2; j += 8)
+        {
+            int16x8x2_t eo = vld2q_s16(&metrics[2 * j]);
+            int16x8_t xm = vld1q_s16(&xmask[j]);
+            int16x8_t ym = vld1q_s16(&ymask[j]);
+            int16x8_t bm = vaddq_s16(vandq_s16(veorq_s16(xm, vrx), vwx),
+                                     vandq_s16(veorq_s16(ym, vry), vwy));
+            int16x8_t bmc = vsubq_s16(vw, bm);
+            int16x8_t e0 = vqaddq_s16(eo.val[0], bm), o0 = vqaddq_s16(eo.val[1], bmc);
+            int16x8_t e1 = vqaddq_s16(eo.val[0], bmc), o1 = vqaddq_s16(eo.val[1], bm);
+            vst1q_s16(&newmetrics[j], vminq_s16(e0, o0));
+            vst1q_s16(&newmetrics[j + NSTATES / 2], vminq_s16(e1, o1));
+            vst1_u8(&dec[j], vmovn_u16(vcgtq_s16(e0, o0)));
+            vst1_u8(&dec[j + NSTATES / 2], vmovn_u16(vcgtq_s16(e1, o1)));
+        }
+#else
+        for (int j = 0; j < NSTATES / 2; ++j)
+        {
+            int e = metrics[2 * j], o = metrics[2 * j + 1];
+            int bm = ((xmask[j] ^ rx) & wx) + ((ymask[j] ^ ry) & wy);
+            int bmc = wx + wy - bm;
+            int e0 = e + bm, o0 = o + bmc, e1 = e + bmc, o1 = o + bm;
+            newmetrics[j] = e0 > o0 ? o0 : e0;
+            newmetrics[j + NSTATES / 2] = e1 > o1 ? o1 : e1;
+            dec[j] = e0 > o0;
+            dec[j + NSTATES / 2] = e1 > o1;
+        }
+#endif
+        memcpy(metrics, newmetrics, sizeof(metrics));
+    }
+
+    // Subtract the best path metric from all states.
+    // Returns the difference between best and second-best
+    // (0 if several states share the best metric).
+
+    int renormalize()
+    {
+        int best = metrics[0], best2 = 32767, nbest = 0;
+
+        for (int s = 1; s < NSTATES; ++s)
+        {
+            if (metrics[s] < best)
+                best = metrics[s];
+        }
+
+        for (int s = 0; s < NSTATES; ++s)
+        {
+            metrics[s] -= best;
+
+            if (metrics[s] == 0)
+                ++nbest;
+            else if (metrics[s] < best2)
+                best2 = metrics[s];
+        }
+
+        return nbest > 1 ? 0 : best2;
+    }
+
+    // Decode the [chunk] blocks ending [traceback] blocks before
+    // the current one, starting from the best state.
+
+    void trace_back()
+    {
+        int state = 0;
+
+        for (int s = 1; s < NSTATES; ++s)
+        {
+            if (metrics[s] < metrics[state])
+                state = s;
+        }
+
+        unsigned long step = nsteps;
+
+        for (int n = traceback * bits_in; n--;)
+        {
+            --step;
+            state = ((state << 1) & (NSTATES - 1)) | (decisions[step & (HISTORY - 1)][state] & 1);
+        }
+
+        unsigned long block = nblocks - traceback;
+
+        for (int b = chunk; b--;)
+        {
+            --block;
+            TUS us = 0;
+
+            for (int t = 0; t < bits_in; ++t)
+            {
+                --step;
+                us |= (state >> 5) << t;
+                state = ((state << 1) & (NSTATES - 1)) | (decisions[step & (HISTORY - 1)][state] & 1);
+            }
+
+            outputs[block & (HISTORY - 1)] = us;
+        }
+    }
+};
+
 // Paths (sequences of uncoded symbols) represented as bitstreams.
 // NBITS is the number of bits per symbol.
 // DEPTH is the number of symbols stored in the path.
@@ -28,6 +28,7 @@
 #include "device/deviceapi.h"
 
 #include "lorademod.h"
+#include "lorademodcore.h"
 #include "lorabits.h"
 
 MESSAGE_CLASS_DEFINITION(LoRaDemod::MsgConfigureLoRaDemod, Message)
@@ -51,21 +52,7 @@ LoRaDemod::LoRaDemod(DeviceAPI* deviceAPI) :
 	m_interpolator.create(16, m_sampleRate, m_Bandwidth/1.9);
 	m_sampleDistanceRemain = (Real)m_sampleRate / m_Bandwidth;
 
-	m_chirp = 0;
-	m_angle = 0;
-	m_bin = 0;
-	m_result = 0;
-	m_count = 0;
-	m_header = 0;
-	m_time = 0;
-	m_tune = 0;
-
-	loraFilter = new sfft(LORA_SFFT_LEN);
-	negaFilter = new sfft(LORA_SFFT_LEN);
-
-	mov = new float[4*LORA_SFFT_LEN];
-	history = new short[1024];
-	finetune = new short[16];
+	applySpreadFactors(m_settings, true);
 
     m_channelizer = new DownChannelizer(this);
     m_threadedChannelizer = new ThreadedBasebandSampleSink(m_channelizer);
@@ -75,16 +62,9 @@ LoRaDemod::LoRaDemod(DeviceAPI* deviceAPI) :
 
 LoRaDemod::~LoRaDemod()
 {
-	if (loraFilter)
-		delete loraFilter;
-	if (negaFilter)
-		delete negaFilter;
-	if (mov)
-		delete [] mov;
-	if (history)
-		delete [] history;
-	if (finetune)
-		delete [] finetune;
+	for (std::vector<LoRaDemodCore*>::iterator it = m_cores.begin(); it != m_cores.end(); ++it) {
+		delete *it;
+	}
 
 	m_deviceAPI->removeChannelSinkAPI(this);
     m_deviceAPI->removeChannelSink(m_threadedChannelizer);
@@ -92,12 +72,55 @@ LoRaDemod::~LoRaDemod()
     delete m_channelizer;
 }
 
-void LoRaDemod::dumpRaw()
+void LoRaDemod::applySpreadFactors(const LoRaDemodSettings& settings, bool force)
+{
+	if ((settings.m_spreadFactor == m_settings.m_spreadFactor)
+	 && (settings.m_decodeAllSpreadFactors == m_settings.m_decodeAllSpreadFactors) && !force) {
+		return;
+	}
+
+	for (std::vector<LoRaDemodCore*>::iterator it = m_cores.begin(); it != m_cores.end(); ++it) {
+		delete *it;
+	}
+
+	m_cores.clear();
+
+	if (settings.m_decodeAllSpreadFactors)
+	{
+		for (int sf = LoRaDemodSettings::minSpreadFactor; sf <= LoRaDemodSettings::maxSpreadFactor; sf++) {
+			m_cores.push_back(new LoRaDemodCore(sf));
+		}
+	}
+	else
+	{
+		m_cores.push_back(new LoRaDemodCore(settings.m_spreadFactor));
+	}
+}
+
+void LoRaDemod::frameReceived(const LoRaDemodCore& core)
+{
+	const std::vector<unsigned short>& symbols = core.getSymbols();
+	QString symbolsStr;
+
+	for (std::vector<unsigned short>::const_iterator it = symbols.begin(); it != symbols.end(); ++it) {
+		symbolsStr.append(QString(" %1").arg(*it, 0, 16));
+	}
+
+	qDebug("LoRaDemod::frameReceived: SF%u %u symbols SNR %.1f dB frequency offset %.2f bins:%s",
+		core.getSpreadFactor(), (unsigned int) symbols.size(), core.getSNR(), core.getFrequencyOffset(),
+		qPrintable(symbolsStr));
+
+	if (core.getSpreadFactor() == 8) { // legacy "spreading 8, low rate" 6 bit mode
+		dumpRaw(symbols);
+	}
+}
+
+void LoRaDemod::dumpRaw(const std::vector<unsigned short>& symbols)
 {
-	short bin, j, max;
+	short j, max;
 	char text[256];
 
-	max = m_time / 4 - 3;
+	max = symbols.size();
 
 	if (max > 140)
 	{
@@ -106,8 +129,7 @@ void LoRaDemod::dumpRaw()
 
 	for ( j=0; j < max; j++)
 	{
-		bin = (history[(j + 1)  * 4] + m_tune ) & (LORA_SFFT_LEN - 1);
-		text[j] = toGray(bin >> 1);
+		text[j] = toGray(symbols[j] >> 2);
 	}
 
 	prng6(text, max);
@@ -135,127 +157,9 @@ void LoRaDemod::dumpRaw()
 	printf("%s\n", &text[1]);
 }
 
-short LoRaDemod::synch(short bin)
-{
-	short i, j;
-
-	if (bin < 0)
-	{
-		if (m_time > 70)
-		{
-			dumpRaw();
-		}
-
-		m_time = 0;
-		return -1;
-	}
-
-	history[m_time] = bin;
-
-	if (m_time > 12)
-	{
-		if (bin == history[m_time - 6])
-		{
-			if (bin == history[m_time - 12])
-			{
-				m_tune = LORA_SFFT_LEN - bin;
-				j = 0;
-
-				for (i=0; i<12; i++)
-				{
-					j += finetune[15 & (m_time - i)];
-				}
-
-				if (j < 0)
-				{
-					m_tune += 1;
-				}
-
-				m_tune &= (LORA_SFFT_LEN - 1);
-				m_time = 0;
-				return -1;
-			}
-		}
-	}
-
-	m_time++;
-	m_time &= 1023;
-
-	if (m_time & 3)
-	{
-		return -1;
-	}
-
-	return (bin + m_tune) & (LORA_SFFT_LEN - 1);
-}
-
-int LoRaDemod::detect(Complex c, Complex a)
-{
-	int p, q;
-	short i, result, negresult, movpoint;
-	float peak, negpeak, tfloat;
-	float mag[LORA_SFFT_LEN];
-	float rev[LORA_SFFT_LEN];
-
-	loraFilter->run(c * a);
-	negaFilter->run(c * conj(a));
-
-	// process spectrum twice in FFTLEN
-	if (++m_count & ((1 << DATA_BITS) - 1))
-	{
-		return m_result;
-	}
-
-	movpoint = 3 & (m_count >> DATA_BITS);
-
-	loraFilter->fetch(mag);
-	negaFilter->fetch(rev);
-	peak = negpeak = 0.0f;
-	result = negresult = 0;
-
-	for (i = 0; i < LORA_SFFT_LEN; i++)
-	{
-		if (rev[i] > negpeak)
-		{
-			negpeak = rev[i];
-			negresult = i;
-		}
-
-		tfloat = mov[i] + mov[LORA_SFFT_LEN + i] +mov[2 * LORA_SFFT_LEN + i]
-				+ mov[3 * LORA_SFFT_LEN + i] + mag[i];
-
-		if (tfloat > peak)
-		{
-			peak = tfloat;
-			result = i;
-		}
-
-		mov[movpoint * LORA_SFFT_LEN + i] = mag[i];
-	}
-
-	p = (result - 1 + LORA_SFFT_LEN) & (LORA_SFFT_LEN -1);
-	q = (result + 1) & (LORA_SFFT_LEN -1);
-	finetune[15 & m_time] = (mag[p] > mag[q]) ? -1 : 1;
-
-	if (peak < negpeak * LORA_SQUELCH)
-	{
-		result = -1;
-	}
-
-	result = synch(result);
-
-	if (result >= 0)
-	{
-		m_result = result;
-	}
-
-	return m_result;
-}
-
 void LoRaDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool pO)
 {
     (void) pO;
-	int newangle;
 	Complex ci;
 
 	m_sampleBuffer.clear();
@@ -269,14 +173,15 @@ void LoRaDemod::feed(const SampleVector::const_iterator& begin, const SampleVect
 
 		if(m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
 		{
-			m_chirp = (m_chirp + 1) & (SPREADFACTOR - 1);
-                        m_angle = (m_angle + m_chirp) & (SPREADFACTOR - 1);
-			Complex cangle(cos(M_PI*2*m_angle/SPREADFACTOR),-sin(M_PI*2*m_angle/SPREADFACTOR));
-			newangle = detect(ci, cangle);
-
-			m_bin = (m_bin + newangle) & (LORA_SFFT_LEN - 1);
-			Complex nangle(cos(M_PI*2*m_bin/LORA_SFFT_LEN),sin(M_PI*2*m_bin/LORA_SFFT_LEN));
-			m_sampleBuffer.push_back(Sample(nangle.real() * 100, nangle.imag() * 100));
+			// one sample per chip: every core works on symbol aligned blocks
+			for (std::vector<LoRaDemodCore*>::iterator core = m_cores.begin(); core != m_cores.end(); ++core)
+			{
+				if ((*core)->feed(ci)) {
+					frameReceived(**core);
+				}
+			}
+
+			m_sampleBuffer.push_back(Sample(ci.real() * SDR_RX_SCALEF, ci.imag() * SDR_RX_SCALEF));
 			m_sampleDistanceRemain += (Real)m_sampleRate / m_Bandwidth;
 		}
 	}
@@ -342,11 +247,14 @@ bool LoRaDemod::handleMessage(const Message& cmd)
 
 		m_Bandwidth = LoRaDemodSettings::bandwidths[settings.m_bandwidthIndex];
 		m_interpolator.create(16, m_sampleRate, m_Bandwidth/1.9);
+		applySpreadFactors(settings, cfg.getForce());
 
 		m_settingsMutex.unlock();
 
 		m_settings = settings;
-		qDebug() << "LoRaDemod::handleMessage: MsgConfigureLoRaDemod: m_Bandwidth: " << m_Bandwidth;
+		qDebug() << "LoRaDemod::handleMessage: MsgConfigureLoRaDemod: m_Bandwidth: " << m_Bandwidth
+				<< " m_spreadFactor: " << settings.m_spreadFactor
+				<< " m_decodeAllSpreadFactors: " << settings.m_decodeAllSpreadFactors;
 
 		return true;
 	}
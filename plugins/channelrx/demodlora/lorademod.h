@@ -27,17 +27,11 @@
 #include "dsp/nco.h"
 #include "dsp/interpolator.h"
 #include "util/message.h"
-#include "dsp/fftfilt.h"
 
 #include "lorademodsettings.h"
 
-#define DATA_BITS (6)
-#define SAMPLEBITS (DATA_BITS + 2)
-#define SPREADFACTOR (1 << SAMPLEBITS)
-#define LORA_SFFT_LEN (SPREADFACTOR / 2)
-#define LORA_SQUELCH (3)
-
 class DeviceAPI;
+class LoRaDemodCore;
 class ThreadedBasebandSampleSink;
 class DownChannelizer;
 
@@ -120,9 +114,9 @@ public:
     static const QString m_channelId;
 
 private:
-	int  detect(Complex sample, Complex angle);
-	void dumpRaw(void);
-	short synch (short bin);
+	void applySpreadFactors(const LoRaDemodSettings& settings, bool force = false);
+	void frameReceived(const LoRaDemodCore& core);
+	void dumpRaw(const std::vector<unsigned short>& symbols);
 	short toGray(short bin);
 	void interleave6(char* inout, int size);
 	void hamming6(char* inout, int size);
@@ -136,20 +130,8 @@ private:
 	Real m_Bandwidth;
 	int m_sampleRate;
 	int m_frequency;
-	int m_chirp;
-	int m_angle;
-	int m_bin;
-	int m_result;
-	int m_count;
-	int m_header;
-	int m_time;
-	short m_tune;
-
-	sfft* loraFilter;
-	sfft* negaFilter;
-	float* mov;
-	short* history;
-	short* finetune;
+
+	std::vector<LoRaDemodCore*> m_cores; //!< one symbol demodulator per decoded spreading factor
 
 	NCO m_nco;
 	Interpolator m_interpolator;
@@ -0,0 +1,268 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include <QDebug>
+
+#include "dsp/fftengine.h"
+#include "lorademodcore.h"
+
+LoRaDemodCore::LoRaDemodCore(unsigned int spreadFactor) :
+    m_spreadFactor(spreadFactor < 7 ? 7 : spreadFactor > 12 ? 12 : spreadFactor)
+{
+    m_nbBins = 1 << m_spreadFactor;
+    m_upChirp.resize(m_nbBins);
+    m_downChirp.resize(m_nbBins);
+    m_dataChirp.resize(m_nbBins);
+    m_block.resize(m_nbBins);
+
+    // Base up chirp from -BW/2 to +BW/2. Its phase is continuous over cyclic shifts.
+    for (unsigned int i = 0; i < m_nbBins; i++)
+    {
+        double phase = 2.0 * M_PI * ((i * (double) i) / (2.0 * m_nbBins) - i / 2.0);
+        m_upChirp[i] = Complex(std::cos(phase), std::sin(phase));
+        m_downChirp[i] = std::conj(m_upChirp[i]);
+    }
+
+    // Peak to mean power ratio of noise alone is about ln(N)
+    m_detectionRatio = 2.5f * std::log((Real) m_nbBins);
+
+    m_fft = FFTEngine::create();
+    m_fft->configure(m_nbBins, false);
+    m_snr = 0.0f;
+
+    reset();
+    qDebug("LoRaDemodCore::LoRaDemodCore: SF: %u", m_spreadFactor);
+}
+
+LoRaDemodCore::~LoRaDemodCore()
+{
+    delete m_fft;
+}
+
+void LoRaDemodCore::reset()
+{
+    m_blockIndex = 0;
+    m_skip = 0;
+    m_state = StatePreamble;
+    m_preambleCount = 0;
+    m_preambleBin = 0;
+    m_syncCount = 0;
+    m_frequencyOffset = 0.0f;
+    m_noiseBlocks = 0;
+    m_snrSum = 0.0f;
+    m_symbols.clear();
+}
+
+bool LoRaDemodCore::feed(const Complex& c)
+{
+    if (m_skip > 0)
+    {
+        m_skip--;
+        return false;
+    }
+
+    m_block[m_blockIndex++] = c;
+
+    if (m_blockIndex < m_nbBins) {
+        return false;
+    }
+
+    m_blockIndex = 0;
+    return processBlock();
+}
+
+Real LoRaDemodCore::dechirp(const std::vector<Complex>& chirp, Real& peakPower, Real& meanPower)
+{
+    Complex *in = m_fft->in();
+
+    for (unsigned int i = 0; i < m_nbBins; i++) {
+        in[i] = m_block[i] * chirp[i];
+    }
+
+    m_fft->transform();
+
+    const Complex *out = m_fft->out();
+    unsigned int peakBin = 0;
+    Real total = 0.0f;
+    peakPower = 0.0f;
+
+    for (unsigned int i = 0; i < m_nbBins; i++)
+    {
+        Real power = std::norm(out[i]);
+        total += power;
+
+        if (power > peakPower)
+        {
+            peakPower = power;
+            peakBin = i;
+        }
+    }
+
+    meanPower = (total - peakPower) / (m_nbBins - 1);
+
+    // interpolate the peak position between bins (Jacobsen estimator)
+    Complex prev = out[(peakBin - 1) & (m_nbBins - 1)];
+    Complex next = out[(peakBin + 1) & (m_nbBins - 1)];
+    Complex den = 2.0f * out[peakBin] - prev - next;
+    Real delta = std::norm(den) > 0.0f ? std::real((prev - next) / den) : 0.0f;
+
+    return peakBin + (delta < -0.5f ? -0.5f : delta > 0.5f ? 0.5f : delta);
+}
+
+unsigned int LoRaDemodCore::binDistance(Real a, Real b) const
+{
+    int distance = std::lround(a - b) & (m_nbBins - 1);
+    return distance > (int) (m_nbBins / 2) ? m_nbBins - distance : distance;
+}
+
+void LoRaDemodCore::averagePreambleBin(Real bin)
+{
+    unsigned int n = m_preambleCount < m_preambleMaxAverage ? m_preambleCount : m_preambleMaxAverage;
+    m_preambleBin += std::remainder(bin - m_preambleBin, (Real) m_nbBins) / n;
+    m_preambleBin = std::fmod(m_preambleBin + m_nbBins, (Real) m_nbBins);
+}
+
+bool LoRaDemodCore::processBlock()
+{
+    Real peakPower, meanPower;
+    unsigned int mask = m_nbBins - 1;
+
+    if (m_state == StatePreamble)
+    {
+        Real bin = dechirp(m_downChirp, peakPower, meanPower);
+
+        // a run of identical peaks is unlikely in noise: relax detection
+        if (peakPower < 0.5f * m_detectionRatio * meanPower)
+        {
+            m_preambleCount = 0;
+        }
+        else
+        {
+            if ((m_preambleCount > 0) && (binDistance(bin, m_preambleBin) <= 1))
+            {
+                m_preambleCount++;
+                averagePreambleBin(bin);
+            }
+            else
+            {
+                m_preambleCount = 1;
+                m_preambleBin = bin;
+            }
+        }
+
+        if (m_preambleCount >= m_preambleMinChirps)
+        {
+            m_state = StateSync;
+            m_syncCount = 0;
+        }
+
+        return false;
+    }
+    else if (m_state == StateSync)
+    {
+        Real downPeakPower, downMeanPower;
+        Real upBin = dechirp(m_downChirp, peakPower, meanPower);
+        Real downBin = dechirp(m_upChirp, downPeakPower, downMeanPower);
+
+        // the first down chirp block may be partial: relax detection
+        if ((downPeakPower > peakPower) && (downPeakPower >= 0.5f * m_detectionRatio * downMeanPower))
+        {
+            // up bin is time + frequency offsets and down bin is frequency - time offsets (modulo N)
+            // the frequency offset is taken within +/- N/4 bins
+            Real frequencyOffset = std::fmod(m_preambleBin + downBin + m_nbBins, (Real) m_nbBins) / 2.0f;
+
+            if (frequencyOffset >= m_nbBins / 4) {
+                frequencyOffset -= m_nbBins / 2;
+            }
+
+            // this block started timeOffset samples after a symbol boundary. Either it straddles
+            // the start of the down chirps (only the last timeOffset samples are down chirp) or it
+            // lies entirely in the down chirps. Close to N/2 tell them apart by the up chirp peak
+            // expected from the first N - timeOffset samples. Data starts 2.25 symbols after the
+            // first down chirp.
+            unsigned int timeOffset = std::lround(m_preambleBin - frequencyOffset) & mask;
+            bool straddle;
+
+            if (timeOffset < m_nbBins / 3) {
+                straddle = false;
+            } else if (timeOffset > (2 * m_nbBins) / 3) {
+                straddle = true;
+            } else {
+                Real upRatio = (m_nbBins - timeOffset) / (Real) timeOffset;
+                straddle = peakPower > 0.5f * upRatio * upRatio * downPeakPower;
+            }
+
+            m_skip = m_nbBins + m_nbBins / 4 - timeOffset + (straddle ? m_nbBins : 0);
+
+            // once aligned the up chirps are offset by the frequency offset plus the residual
+            // (fractional) time offset. Remove it along with dechirping.
+            m_frequencyOffset = std::fmod(m_preambleBin - timeOffset + m_nbBins + m_nbBins / 2, (Real) m_nbBins) - m_nbBins / 2;
+
+            for (unsigned int i = 0; i < m_nbBins; i++)
+            {
+                Real phase = -2.0f * M_PI * m_frequencyOffset * i / m_nbBins;
+                m_dataChirp[i] = m_downChirp[i] * Complex(std::cos(phase), std::sin(phase));
+            }
+
+            m_state = StateData;
+            m_noiseBlocks = 0;
+            m_snrSum = 0.0f;
+            m_symbols.clear();
+        }
+        else if ((peakPower >= 0.5f * m_detectionRatio * meanPower) && (binDistance(upBin, m_preambleBin) <= 1))
+        {
+            m_preambleCount++; // still in preamble
+            averagePreambleBin(upBin);
+            m_syncCount = 0;
+        }
+        else if (++m_syncCount > m_syncMaxBlocks) // sync word, partial chirps or lost
+        {
+            m_state = StatePreamble;
+            m_preambleCount = 0;
+        }
+
+        return false;
+    }
+    else // StateData
+    {
+        Real bin = dechirp(m_dataChirp, peakPower, meanPower);
+
+        if (peakPower < m_detectionRatio * meanPower) {
+            m_noiseBlocks++;
+        } else {
+            m_noiseBlocks = 0;
+        }
+
+        m_symbols.push_back(std::lround(bin) & mask);
+        m_snrSum += meanPower > 0.0f ? peakPower / meanPower : 0.0f;
+
+        if ((m_noiseBlocks < 2) && (m_symbols.size() < m_maxSymbols)) {
+            return false;
+        }
+
+        // end of frame: trailing noise blocks are not part of it
+        m_symbols.resize(m_symbols.size() - m_noiseBlocks);
+        m_snr = m_symbols.size() > 0 ? 10.0f * std::log10(m_snrSum / (m_symbols.size() + m_noiseBlocks)) : 0.0f;
+        m_state = StatePreamble;
+        m_preambleCount = 0;
+
+        return m_symbols.size() > 0;
+    }
+}
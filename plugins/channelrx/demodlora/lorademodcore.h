@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLUGINS_CHANNELRX_DEMODLORA_LORADEMODCORE_H_
+#define PLUGINS_CHANNELRX_DEMODLORA_LORADEMODCORE_H_
+
+#include <vector>
+
+#include "dsp/dsptypes.h"
+
+class FFTEngine;
+
+/**
+ * LoRa symbol demodulator for one spreading factor.
+ *
+ * Samples are expected at the chip rate (one sample per chip i.e. the LoRa bandwidth).
+ * They are collected in blocks of one symbol length (2^SF samples). Each block is dechirped
+ * by the conjugate of the base up chirp and the symbol value is the bin of the FFT peak.
+ *
+ * The preamble is detected as a run of blocks with the same peak. Then the sync downchirps
+ * are dechirped by the base up chirp. The peaks of the up and down chirps give the time and
+ * frequency offsets: blocks are realigned on symbol boundaries and the frequency offset is
+ * removed from the data symbols. The frame ends when the peak falls back into noise.
+ */
+class LoRaDemodCore
+{
+public:
+    LoRaDemodCore(unsigned int spreadFactor);
+    ~LoRaDemodCore();
+
+    void reset();
+    /** Push one chip rate sample. Returns true when a frame has been completed (see getSymbols()) */
+    bool feed(const Complex& c);
+
+    unsigned int getSpreadFactor() const { return m_spreadFactor; }
+    unsigned int getNbSymbolBins() const { return m_nbBins; }
+    const std::vector<unsigned short>& getSymbols() const { return m_symbols; }
+    Real getFrequencyOffset() const { return m_frequencyOffset; } //!< in FFT bins
+    Real getSNR() const { return m_snr; } //!< average peak to noise power ratio of the last frame in dB
+
+private:
+    enum State
+    {
+        StatePreamble, //!< look for repeated up chirps
+        StateSync,     //!< look for the first sync down chirp
+        StateData      //!< symbol aligned data blocks
+    };
+
+    static const unsigned int m_preambleMinChirps = 4;  //!< identical up chirps to detect a preamble
+    static const unsigned int m_preambleMaxAverage = 8; //!< up chirps averaged for the preamble peak position
+    static const unsigned int m_syncMaxBlocks = 8;      //!< give up sync if no down chirp within that many blocks
+    static const unsigned int m_maxSymbols = 1024;      //!< force end of frame past that many symbols
+
+    bool processBlock();
+    Real dechirp(const std::vector<Complex>& chirp, Real& peakPower, Real& meanPower); //!< returns the interpolated peak bin
+    unsigned int binDistance(Real a, Real b) const;
+    void averagePreambleBin(Real bin);
+
+    unsigned int m_spreadFactor;
+    unsigned int m_nbBins;           //!< symbol length in samples and number of FFT bins
+    Real m_detectionRatio;           //!< minimum peak power over mean bin power
+    FFTEngine *m_fft;
+    std::vector<Complex> m_upChirp;
+    std::vector<Complex> m_downChirp;
+    std::vector<Complex> m_dataChirp; //!< down chirp with frequency offset correction
+    std::vector<Complex> m_block;
+    unsigned int m_blockIndex;
+    unsigned int m_skip;             //!< samples to drop before the next block (realignment)
+    State m_state;
+    unsigned int m_preambleCount;
+    Real m_preambleBin;
+    unsigned int m_syncCount;
+    Real m_frequencyOffset;
+    unsigned int m_noiseBlocks;
+    Real m_snrSum;
+    Real m_snr;
+    std::vector<unsigned short> m_symbols;
+};
+
+#endif // PLUGINS_CHANNELRX_DEMODLORA_LORADEMODCORE_H_
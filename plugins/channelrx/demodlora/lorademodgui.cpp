@@ -90,16 +90,26 @@ void LoRaDemodGUI::on_BW_valueChanged(int value)
         m_settings.m_bandwidthIndex = LoRaDemodSettings::nb_bandwidths - 1;
     }
 
-	int thisBW = LoRaDemodSettings::bandwidths[value];
+	int thisBW = LoRaDemodSettings::bandwidths[m_settings.m_bandwidthIndex];
 	ui->BWText->setText(QString("%1 Hz").arg(thisBW));
 	m_channelMarker.setBandwidth(thisBW);
+	ui->glSpectrum->setSampleRate(thisBW);
 
 	applySettings();
 }
 
 void LoRaDemodGUI::on_Spread_valueChanged(int value)
 {
-    (void) value;
+    m_settings.m_spreadFactor = value;
+    ui->SpreadText->setText(QString("SF%1").arg(value));
+    applySettings();
+}
+
+void LoRaDemodGUI::on_allSF_toggled(bool checked)
+{
+    m_settings.m_decodeAllSpreadFactors = checked;
+    ui->Spread->setEnabled(!checked);
+    applySettings();
 }
 
 void LoRaDemodGUI::onWidgetRolled(QWidget* widget, bool rollDown)
@@ -124,8 +134,8 @@ LoRaDemodGUI::LoRaDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, Baseb
 	m_LoRaDemod = (LoRaDemod*) rxChannel; //new LoRaDemod(m_deviceUISet->m_deviceSourceAPI);
 	m_LoRaDemod->setSpectrumSink(m_spectrumVis);
 
-	ui->glSpectrum->setCenterFrequency(16000);
-	ui->glSpectrum->setSampleRate(32000);
+	ui->glSpectrum->setCenterFrequency(0);
+	ui->glSpectrum->setSampleRate(LoRaDemodSettings::bandwidths[0]);
 	ui->glSpectrum->setDisplayWaterfall(true);
 	ui->glSpectrum->setDisplayMaxHold(true);
 
@@ -190,5 +200,10 @@ void LoRaDemodGUI::displaySettings()
     blockApplySettings(true);
     ui->BWText->setText(QString("%1 Hz").arg(thisBW));
     ui->BW->setValue(m_settings.m_bandwidthIndex);
+    ui->glSpectrum->setSampleRate(thisBW);
+    ui->Spread->setValue(m_settings.m_spreadFactor);
+    ui->SpreadText->setText(QString("SF%1").arg(m_settings.m_spreadFactor));
+    ui->Spread->setEnabled(!m_settings.m_decodeAllSpreadFactors);
+    ui->allSF->setChecked(m_settings.m_decodeAllSpreadFactors);
     blockApplySettings(false);
 }
@@ -13,7 +13,8 @@ struct LoRaDemodSettings
 {
     int m_centerFrequency;
     int m_bandwidthIndex;
-    int m_spread;
+    int m_spreadFactor;            //!< LoRa spreading factor (7 to 12)
+    bool m_decodeAllSpreadFactors; //!< decode all spreading factors in parallel
     uint32_t m_rgbColor;
     QString m_title;
 
@@ -22,6 +23,8 @@ struct LoRaDemodSettings
 
     static const int bandwidths[];
     static const int nb_bandwidths;
+    static const int minSpreadFactor;
+    static const int maxSpreadFactor;
 
     LoRaDemodSettings();
     void resetToDefaults();
@@ -44,6 +44,7 @@
 MESSAGE_CLASS_DEFINITION(NFMDemod::MsgConfigureNFMDemod, Message)
 MESSAGE_CLASS_DEFINITION(NFMDemod::MsgConfigureChannelizer, Message)
 MESSAGE_CLASS_DEFINITION(NFMDemod::MsgReportCTCSSFreq, Message)
+MESSAGE_CLASS_DEFINITION(NFMDemod::MsgReportDCSCode, Message)
 
 const QString NFMDemod::m_channelIdURI = "sdrangel.channel.nfmdemod";
 const QString NFMDemod::m_channelId = "NFMDemod";
@@ -59,6 +60,7 @@ NFMDemod::NFMDemod(DeviceAPI *devieAPI) :
         m_inputFrequencyOffset(0),
         m_running(false),
         m_ctcssIndex(0),
+        m_dcsDetected(false),
         m_sampleCount(0),
         m_squelchCount(0),
         m_squelchGate(4800),
@@ -88,6 +90,7 @@ NFMDemod::NFMDemod(DeviceAPI *devieAPI) :
     m_discriCompensation *= sqrt(m_discriCompensation);
 
 	m_ctcssDetector.setCoefficients(m_audioSampleRate/16, m_audioSampleRate/8.0f); // 0.5s / 2 Hz resolution
+	m_dcsDetector.setSampleRate(m_audioSampleRate/8); // same decimated signal as CTCSS
 	m_afSquelch.setCoefficients(m_audioSampleRate/2000, 600, m_audioSampleRate, 200, 0, afSqTones); // 0.5ms test period, 300ms average span, audio SR, 100ms attack, no decay
 
     m_ctcssLowpass.create(301, m_audioSampleRate, 250.0);
@@ -255,6 +258,7 @@ void NFMDemod::processOneSample(Complex &ci)
         }
     }
 
+    bool squelchWasOpen = m_squelchOpen;
     m_squelchOpen = (m_squelchCount > m_squelchGate);
 
     if (m_settings.m_audioMute)
@@ -267,10 +271,14 @@ void NFMDemod::processOneSample(Complex &ci)
         {
             if (m_settings.m_ctcssOn)
             {
-                Real ctcss_sample = m_ctcssLowpass.filter(demod * m_discriCompensation);
-
-                if ((m_sampleCount & 7) == 7) // decimate 48k -> 6k
+                if ((m_sampleCount & 7) != 7) // decimate 48k -> 6k: only the kept samples are filtered
+                {
+                    m_ctcssLowpass.push(demod * m_discriCompensation);
+                }
+                else
                 {
+                    Real ctcss_sample = m_ctcssLowpass.filter(demod * m_discriCompensation);
+
                     if (m_ctcssDetector.analyze(&ctcss_sample))
                     {
                         int maxToneIndex;
@@ -298,6 +306,21 @@ void NFMDemod::processOneSample(Complex &ci)
                             }
                         }
                     }
+
+                    if (m_dcsDetector.analyze(ctcss_sample))
+                    {
+                        unsigned int dcsCode;
+                        bool dcsInverted;
+                        m_dcsDetected = m_dcsDetector.getDetectedCode(dcsCode, dcsInverted);
+
+                        if (getMessageQueueToGUI())
+                        {
+                            MsgReportDCSCode *msg = m_dcsDetected ?
+                                MsgReportDCSCode::create(true, dcsCode, dcsInverted) :
+                                MsgReportDCSCode::create(false, 0, false);
+                            getMessageQueueToGUI()->push(msg);
+                        }
+                    }
                 }
             }
 
@@ -326,6 +349,20 @@ void NFMDemod::processOneSample(Complex &ci)
                 m_ctcssIndex = 0;
             }
 
+            if (m_dcsDetected)
+            {
+                if (getMessageQueueToGUI()) {
+                    MsgReportDCSCode *msg = MsgReportDCSCode::create(false, 0, false);
+                    getMessageQueueToGUI()->push(msg);
+                }
+
+                m_dcsDetected = false;
+            }
+
+            if (squelchWasOpen) {
+                m_dcsDetector.reset(); // start afresh on next transmission
+            }
+
             sample = 0;
         }
     }
@@ -335,7 +372,7 @@ void NFMDemod::processOneSample(Complex &ci)
     m_audioBuffer[m_audioBufferFill].r = sample;
     ++m_audioBufferFill;
 
-    if (m_audioBufferFill >= m_audioBuffer.size())
+    if (m_audioBufferFill >= m_audioFifo.getWriteBlockSize(m_audioBuffer.size()))
     {
         uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
@@ -460,6 +497,7 @@ void NFMDemod::applyAudioSampleRate(int sampleRate)
     m_squelchGate = (sampleRate / 100) * m_settings.m_squelchGate; // gate is given in 10s of ms at 48000 Hz audio sample rate
     m_squelchCount = 0; // reset squelch open counter
     m_ctcssDetector.setCoefficients(sampleRate/16, sampleRate/8.0f); // 0.5s / 2 Hz resolution
+    m_dcsDetector.setSampleRate(sampleRate/8);
 
     if (sampleRate < 16000) {
         m_afSquelch.setCoefficients(sampleRate/2000, 600, sampleRate, 200, 0, afSqTones_lowrate); // 0.5ms test period, 300ms average span, audio SR, 100ms attack, no decay
@@ -836,6 +874,10 @@ void NFMDemod::webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response
     response.getNfmDemodReport()->setSquelch(m_squelchOpen ? 1 : 0);
     response.getNfmDemodReport()->setAudioSampleRate(m_audioSampleRate);
     response.getNfmDemodReport()->setChannelSampleRate(m_inputSampleRate);
+    response.getNfmDemodReport()->setAudioFifoFillMin(m_audioFifo.getFillMin());
+    response.getNfmDemodReport()->setAudioFifoFillMax(m_audioFifo.getFillMax());
+    response.getNfmDemodReport()->setAudioFifoUnderruns(m_audioFifo.getUnderrunCount());
+    response.getNfmDemodReport()->setAudioFifoOverruns(m_audioFifo.getOverrunCount());
 }
 
 void NFMDemod::webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const NFMDemodSettings& settings, bool force)
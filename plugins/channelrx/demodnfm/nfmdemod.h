@@ -34,6 +34,7 @@
 #include "dsp/afsquelch.h"
 #include "dsp/agc.h"
 #include "dsp/ctcssdetector.h"
+#include "dsp/dcsdetector.h"
 #include "audio/audiofifo.h"
 #include "util/message.h"
 #include "util/movingaverage.h"
@@ -116,6 +117,32 @@ public:
         { }
     };
 
+    class MsgReportDCSCode : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        bool getDetected() const { return m_detected; }
+        unsigned int getCode() const { return m_code; } //!< octal representation is the code
+        bool getInverted() const { return m_inverted; }
+
+        static MsgReportDCSCode* create(bool detected, unsigned int code, bool inverted)
+        {
+            return new MsgReportDCSCode(detected, code, inverted);
+        }
+
+    private:
+        bool m_detected;
+        unsigned int m_code;
+        bool m_inverted;
+
+        MsgReportDCSCode(bool detected, unsigned int code, bool inverted) :
+            Message(),
+            m_detected(detected),
+            m_code(code),
+            m_inverted(inverted)
+        { }
+    };
+
     NFMDemod(DeviceAPI *deviceAPI);
 	~NFMDemod();
 	virtual void destroy() { delete this; }
@@ -226,6 +253,8 @@ private:
 	CTCSSDetector m_ctcssDetector;
 	int m_ctcssIndex; // 0 for nothing detected
 	int m_ctcssIndexSelected;
+	DCSDetector m_dcsDetector;
+	bool m_dcsDetected;
 	int m_sampleCount;
 	int m_squelchCount;
 	int m_squelchGate;
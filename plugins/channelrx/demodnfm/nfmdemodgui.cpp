@@ -82,6 +82,12 @@ bool NFMDemodGUI::handleMessage(const Message& message)
         //qDebug("NFMDemodGUI::handleMessage: MsgReportCTCSSFreq: %f", report.getFrequency());
         return true;
     }
+    else if (NFMDemod::MsgReportDCSCode::match(message))
+    {
+        NFMDemod::MsgReportDCSCode& report = (NFMDemod::MsgReportDCSCode&) message;
+        setDcsCode(report.getDetected(), report.getCode(), report.getInverted());
+        return true;
+    }
     else if (NFMDemod::MsgConfigureNFMDemod::match(message))
     {
         qDebug("NFMDemodGUI::handleMessage: NFMDemod::MsgConfigureNFMDemod");
@@ -269,6 +275,7 @@ NFMDemodGUI::NFMDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, Baseban
 	m_basicSettingsShown(false),
 	m_doApplySettings(true),
 	m_squelchOpen(false),
+	m_ctcssFreq(0),
 	m_tickCount(0)
 {
 	ui->setupUi(this);
@@ -424,13 +431,29 @@ void NFMDemodGUI::enterEvent(QEvent*)
 
 void NFMDemodGUI::setCtcssFreq(Real ctcssFreq)
 {
-	if (ctcssFreq == 0)
-	{
-		ui->ctcssText->setText("--");
+	m_ctcssFreq = ctcssFreq;
+	displayCtcssDcs();
+}
+
+void NFMDemodGUI::setDcsCode(bool detected, unsigned int code, bool inverted)
+{
+	if (detected) {
+		m_dcsCodeStr = QString("D%1%2").arg(code, 3, 8, QChar('0')).arg(inverted ? "I" : "N");
+	} else {
+		m_dcsCodeStr.clear();
 	}
-	else
-	{
-		ui->ctcssText->setText(QString("%1").arg(ctcssFreq));
+
+	displayCtcssDcs();
+}
+
+void NFMDemodGUI::displayCtcssDcs()
+{
+	if (m_ctcssFreq != 0) {
+		ui->ctcssText->setText(QString("%1").arg(m_ctcssFreq));
+	} else if (!m_dcsCodeStr.isEmpty()) {
+		ui->ctcssText->setText(m_dcsCodeStr);
+	} else {
+		ui->ctcssText->setText("--");
 	}
 }
 
@@ -37,6 +37,7 @@ public:
 	virtual MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; }
 	virtual bool handleMessage(const Message& message);
 	void setCtcssFreq(Real ctcssFreq);
+	void setDcsCode(bool detected, unsigned int code, bool inverted);
 
 public slots:
 	void channelMarkerChangedByCursor();
@@ -53,6 +54,8 @@ private:
 
 	NFMDemod* m_nfmDemod;
 	bool m_squelchOpen;
+	Real m_ctcssFreq;
+	QString m_dcsCodeStr; //!< empty if no DCS code is detected
 	uint32_t m_tickCount;
 	MessageQueue m_inputMessageQueue;
 
@@ -62,6 +65,7 @@ private:
 	void blockApplySettings(bool block);
 	void applySettings(bool force = false);
 	void displaySettings();
+	void displayCtcssDcs();
 
 	void leaveEvent(QEvent*);
 	void enterEvent(QEvent*);
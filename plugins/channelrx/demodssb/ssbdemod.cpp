@@ -272,7 +272,7 @@ void SSBDemod::processOneSample(Complex &ci)
 
         ++m_audioBufferFill;
 
-        if (m_audioBufferFill >= m_audioBuffer.size())
+        if (m_audioBufferFill >= m_audioFifo.getWriteBlockSize(m_audioBuffer.size()))
         {
             uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
@@ -843,6 +843,10 @@ void SSBDemod::webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response
     response.getSsbDemodReport()->setSquelch(m_audioActive ? 1 : 0);
     response.getSsbDemodReport()->setAudioSampleRate(m_audioSampleRate);
     response.getSsbDemodReport()->setChannelSampleRate(m_inputSampleRate);
+    response.getSsbDemodReport()->setAudioFifoFillMin(m_audioFifo.getFillMin());
+    response.getSsbDemodReport()->setAudioFifoFillMax(m_audioFifo.getFillMax());
+    response.getSsbDemodReport()->setAudioFifoUnderruns(m_audioFifo.getUnderrunCount());
+    response.getSsbDemodReport()->setAudioFifoOverruns(m_audioFifo.getOverrunCount());
 }
 
 void SSBDemod::webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const SSBDemodSettings& settings, bool force)
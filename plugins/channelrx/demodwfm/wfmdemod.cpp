@@ -161,7 +161,7 @@ void WFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 				++m_audioBufferFill;
 
-				if(m_audioBufferFill >= m_audioBuffer.size())
+				if(m_audioBufferFill >= m_audioFifo.getWriteBlockSize(m_audioBuffer.size()))
 				{
 					uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
@@ -581,6 +581,10 @@ void WFMDemod::webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response
     response.getWfmDemodReport()->setSquelch(m_squelchState > 0 ? 1 : 0);
     response.getWfmDemodReport()->setAudioSampleRate(m_audioSampleRate);
     response.getWfmDemodReport()->setChannelSampleRate(m_inputSampleRate);
+    response.getWfmDemodReport()->setAudioFifoFillMin(m_audioFifo.getFillMin());
+    response.getWfmDemodReport()->setAudioFifoFillMax(m_audioFifo.getFillMax());
+    response.getWfmDemodReport()->setAudioFifoUnderruns(m_audioFifo.getUnderrunCount());
+    response.getWfmDemodReport()->setAudioFifoOverruns(m_audioFifo.getOverrunCount());
 }
 
 void WFMDemod::webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const WFMDemodSettings& settings, bool force)
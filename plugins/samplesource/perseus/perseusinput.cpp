@@ -245,6 +245,12 @@ bool PerseusInput::openDevice()
     m_deviceAPI->getSamplingDeviceSerial();
     int deviceSequence = DevicePerseus::instance().getSequenceFromSerial(m_deviceAPI->getSamplingDeviceSerial().toStdString());
 
+    if (deviceSequence < 0) // device enumeration may come from the cache with no scan done yet
+    {
+        DevicePerseus::instance().scan();
+        deviceSequence = DevicePerseus::instance().getSequenceFromSerial(m_deviceAPI->getSamplingDeviceSerial().toStdString());
+    }
+
     if ((m_perseusDescriptor = perseus_open(deviceSequence)) == 0)
     {
         qCritical("PerseusInput::openDevice: cannot open device: %s", perseus_errorstr());
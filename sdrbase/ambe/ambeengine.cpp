@@ -217,19 +217,21 @@ bool AMBEEngine::registerController(const std::string& deviceRef)
 
     if (worker->open(deviceRef))
     {
+        QThread *thread = new QThread();
+        worker->moveToThread(thread);
+        connect(worker, SIGNAL(finished()), thread, SLOT(quit()));
+        connect(worker, SIGNAL(finished()), worker, SLOT(deleteLater()));
+        connect(thread, SIGNAL(finished()), thread, SLOT(deleteLater()));
+        connect(&worker->m_inputMessageQueue, SIGNAL(messageEnqueued()), worker, SLOT(handleInputMessages()));
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        thread->start();
+
+        QMutexLocker locker(&m_mutex);
         m_controllers.push_back(AMBEController());
         m_controllers.back().worker = worker;
-        m_controllers.back().thread = new QThread();
+        m_controllers.back().thread = thread;
         m_controllers.back().device = deviceRef;
 
-        m_controllers.back().worker->moveToThread(m_controllers.back().thread);
-        connect(m_controllers.back().worker, SIGNAL(finished()), m_controllers.back().thread, SLOT(quit()));
-        connect(m_controllers.back().worker, SIGNAL(finished()), m_controllers.back().worker, SLOT(deleteLater()));
-        connect(m_controllers.back().thread, SIGNAL(finished()), m_controllers.back().thread, SLOT(deleteLater()));
-        connect(&m_controllers.back().worker->m_inputMessageQueue, SIGNAL(messageEnqueued()), m_controllers.back().worker, SLOT(handleInputMessages()));
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-        m_controllers.back().thread->start();
-
         return true;
     }
 
@@ -238,6 +240,7 @@ bool AMBEEngine::registerController(const std::string& deviceRef)
 
 void AMBEEngine::releaseController(const std::string& deviceRef)
 {
+    QMutexLocker locker(&m_mutex);
     std::vector<AMBEController>::iterator it = m_controllers.begin();
 
     while (it != m_controllers.end())
@@ -247,9 +250,10 @@ void AMBEEngine::releaseController(const std::string& deviceRef)
             disconnect(&it->worker->m_inputMessageQueue, SIGNAL(messageEnqueued()), it->worker, SLOT(handleInputMessages()));
             it->worker->stop();
             it->thread->wait(100);
-            it->worker->m_inputMessageQueue.clear();
+            it->worker->dropQueuedFrames();
             it->worker->close();
             qDebug() << "AMBEEngine::releaseController: closed device at: " << it->device.c_str();
+            releaseControllerStreams(it - m_controllers.begin());
             m_controllers.erase(it);
             break;
         }
@@ -260,6 +264,7 @@ void AMBEEngine::releaseController(const std::string& deviceRef)
 
 void AMBEEngine::releaseAll()
 {
+    QMutexLocker locker(&m_mutex);
     std::vector<AMBEController>::iterator it = m_controllers.begin();
 
     while (it != m_controllers.end())
@@ -267,13 +272,14 @@ void AMBEEngine::releaseAll()
         disconnect(&it->worker->m_inputMessageQueue, SIGNAL(messageEnqueued()), it->worker, SLOT(handleInputMessages()));
         it->worker->stop();
         it->thread->wait(100);
-        it->worker->m_inputMessageQueue.clear();
+        it->worker->dropQueuedFrames();
         it->worker->close();
         qDebug() << "AMBEEngine::release: closed device at: " << it->device.c_str();
         ++it;
     }
 
     m_controllers.clear();
+    m_streams.clear(); // no frames are in flight anymore
 }
 
 void AMBEEngine::getDeviceRefs(std::vector<QString>& deviceNames)
@@ -296,38 +302,117 @@ void AMBEEngine::pushMbeFrame(
         int upsampling,
         AudioFifo *audioFifo)
 {
-    std::vector<AMBEController>::iterator it = m_controllers.begin();
-    std::vector<AMBEController>::iterator itAvail = m_controllers.end();
-    bool done = false;
     QMutexLocker locker(&m_mutex);
 
-    while (it != m_controllers.end())
+    if (m_controllers.size() == 0)
+    {
+        qDebug("AMBEEngine::pushMbeFrame: no DV device available. MBE frame dropped");
+        return;
+    }
+
+    if (m_streams.find(audioFifo) == m_streams.end()) {
+        pruneIdleStreams(); // streams of deleted channels are not kept forever
+    }
+
+    AMBEStream& stream = m_streams[audioFifo];
+    int leastLoaded = getLeastLoadedControllerIndex();
+
+    if (stream.controllerIndex < 0)
+    {
+        qDebug("AMBEEngine::pushMbeFrame: push %p on queue %d", audioFifo, leastLoaded);
+        stream.controllerIndex = leastLoaded;
+    }
+    else if ((stream.pendingFrames.load() <= 0) && (leastLoaded != stream.controllerIndex)
+        && (m_controllers[stream.controllerIndex].worker->getQueueDepth() > m_controllers[leastLoaded].worker->getQueueDepth() + 1))
     {
-        if (it->worker->hasFifo(audioFifo))
+        // idle stream on a busy device: move it (margin of one frame to avoid swapping back and forth)
+        qDebug("AMBEEngine::pushMbeFrame: move %p from queue %d to queue %d", audioFifo, stream.controllerIndex, leastLoaded);
+        stream.controllerIndex = leastLoaded;
+    }
+
+    stream.pendingFrames.fetchAndAddOrdered(1);
+    m_controllers[stream.controllerIndex].worker->pushMbeFrame(
+        mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useLP, upsampling, audioFifo, &stream.pendingFrames);
+}
+
+int AMBEEngine::getLeastLoadedControllerIndex() const
+{
+    int index = 0;
+    int minQueueDepth = m_controllers[0].worker->getQueueDepth();
+
+    for (unsigned int i = 1; i < m_controllers.size(); i++)
+    {
+        int queueDepth = m_controllers[i].worker->getQueueDepth();
+
+        if (queueDepth < minQueueDepth)
         {
-            it->worker->pushMbeFrame(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useLP, upsampling, audioFifo);
-            done = true;
+            minQueueDepth = queueDepth;
+            index = i;
         }
-        else if (it->worker->isAvailable())
+    }
+
+    return index;
+}
+
+void AMBEEngine::releaseControllerStreams(int controllerIndex)
+{
+    // the frames of the released device were decoded or dropped so its streams are idle and
+    // can be forgotten. Controllers past it are shifted down by one.
+    std::map<AudioFifo*, AMBEStream>::iterator it = m_streams.begin();
+
+    while (it != m_streams.end())
+    {
+        if (it->second.controllerIndex == controllerIndex)
         {
-            itAvail = it;
+            it = m_streams.erase(it);
         }
+        else
+        {
+            if (it->second.controllerIndex > controllerIndex) {
+                it->second.controllerIndex--;
+            }
 
-        ++it;
+            ++it;
+        }
     }
+}
 
-    if (!done)
-    {
-        if (itAvail != m_controllers.end())
-        {
-            int wNum = itAvail - m_controllers.begin();
+void AMBEEngine::pruneIdleStreams()
+{
+    // an idle stream is not referenced by any frame in flight and would be reassigned anyway
+    std::map<AudioFifo*, AMBEStream>::iterator it = m_streams.begin();
 
-            qDebug("AMBEEngine::pushMbeFrame: push %p on empty queue %d", audioFifo, wNum);
-            itAvail->worker->pushMbeFrame(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useLP, upsampling, audioFifo);
+    while (it != m_streams.end())
+    {
+        if (it->second.pendingFrames.load() <= 0) {
+            it = m_streams.erase(it);
+        } else {
+            ++it;
         }
-        else
+    }
+}
+
+void AMBEEngine::getDeviceStats(std::vector<DeviceStats>& deviceStats)
+{
+    QMutexLocker locker(&m_mutex);
+    deviceStats.clear();
+
+    for (unsigned int i = 0; i < m_controllers.size(); i++)
+    {
+        deviceStats.push_back(DeviceStats());
+        DeviceStats& stats = deviceStats.back();
+        stats.device = m_controllers[i].device;
+        stats.queueDepth = m_controllers[i].worker->getQueueDepth();
+        stats.nbFramesDecoded = m_controllers[i].worker->getNbFramesDecoded();
+        stats.nbFramesDropped = m_controllers[i].worker->getNbFramesDropped();
+        stats.latencyMs = m_controllers[i].worker->getLatencyMs();
+        stats.nbStreams = 0;
+
+        for (const auto& stream : m_streams)
         {
-            qDebug("AMBEEngine::pushMbeFrame: no DV device available. MBE frame dropped");
+            if ((stream.second.controllerIndex == (int) i) && (stream.second.pendingFrames.load() > 0)) {
+                stats.nbStreams++;
+            }
         }
     }
 }
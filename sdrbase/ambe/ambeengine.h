@@ -21,9 +21,11 @@
 
 #include <vector>
 #include <string>
+#include <map>
 
 #include <QObject>
 #include <QMutex>
+#include <QAtomicInt>
 #include <QString>
 #include <QByteArray>
 
@@ -37,6 +39,16 @@ class SDRBASE_API AMBEEngine : public QObject
 {
     Q_OBJECT
 public:
+    struct DeviceStats
+    {
+        std::string device;
+        int queueDepth;      //!< frames waiting for decode
+        int nbStreams;       //!< DSD streams currently assigned to the device
+        int nbFramesDecoded;
+        int nbFramesDropped; //!< decode failures and queue overflows
+        float latencyMs;     //!< average time from push to decoded frame
+    };
+
     AMBEEngine();
     ~AMBEEngine();
 
@@ -57,6 +69,8 @@ public:
             int upsampling,
             AudioFifo *audioFifo);
 
+    void getDeviceStats(std::vector<DeviceStats>& deviceStats); //!< per device load and latency
+
     QByteArray serialize() const;
     bool deserialize(const QByteArray& data);
 
@@ -73,14 +87,34 @@ private:
         std::string device;
     };
 
+    /**
+     * A stream is the flow of frames of one DSD channel (identified by its audio FIFO).
+     * All its frames are decoded by the same device as long as some are still in flight
+     * so that they are decoded in order and the FIFO is fed from a single thread.
+     * When it is idle it can be moved to the least loaded device or be forgotten.
+     */
+    struct AMBEStream
+    {
+        AMBEStream() :
+            controllerIndex(-1)
+        {}
+
+        int controllerIndex;
+        QAtomicInt pendingFrames; //!< frames pushed and not yet written to the audio FIFO
+    };
+
 #ifndef __WINDOWS__
     static std::string get_driver(const std::string& tty);
     static void register_comport(std::vector<std::string>& comList, std::vector<std::string>& comList8250, const std::string& dir);
     static void probe_serial8250_comports(std::vector<std::string>& comList, std::vector<std::string> comList8250);
 #endif
     void getComList();
+    int getLeastLoadedControllerIndex() const;
+    void releaseControllerStreams(int controllerIndex);
+    void pruneIdleStreams();
 
     std::vector<AMBEController> m_controllers;
+    std::map<AudioFifo*, AMBEStream> m_streams;
     std::vector<std::string> m_comList;
     std::vector<std::string> m_comList8250;
     QMutex m_mutex;
@@ -38,6 +38,8 @@ AMBEWorker::AMBEWorker() :
     m_audioBuffer.resize(48000);
     m_audioBufferFill = 0;
     m_audioFifo = 0;
+    m_audioStreamPending = nullptr;
+    m_audioBufferFrames = 0;
     std::fill(m_dvAudioSamples, m_dvAudioSamples+SerialDV::MBE_AUDIO_BLOCK_SIZE, 0);
     setVolumeFactors();
 }
@@ -76,15 +78,21 @@ void AMBEWorker::stop()
 
 void AMBEWorker::handleInputMessages()
 {
+    QMutexLocker locker(&m_decodeMutex);
     Message* message;
-    m_audioBufferFill = 0;
-    AudioFifo *audioFifo = 0;
 
+    // decode all queued frames in one go. The audio buffer holds samples of one stream only and
+    // is written to its FIFO when the stream changes or after the last queued frame.
     while ((message = m_inputMessageQueue.pop()) != 0)
     {
         if (MsgMbeDecode::match(*message))
         {
             MsgMbeDecode *decodeMsg = (MsgMbeDecode *) message;
+
+            if (decodeMsg->getAudioFifo() != m_audioFifo) {
+                flushAudio();
+            }
+
             int dBVolume = (decodeMsg->getVolumeIndex() - 30) / 4;
             float volume = pow(10.0, dBVolume / 10.0f);
             int upsampling = decodeMsg->getUpsampling();
@@ -107,22 +115,25 @@ void AMBEWorker::handleInputMessages()
                     noUpsample(m_dvAudioSamples, SerialDV::MBE_AUDIO_BLOCK_SIZE, decodeMsg->getChannels());
                 }
 
-                audioFifo = decodeMsg->getAudioFifo();
-
-                if (audioFifo && (m_audioBufferFill >= m_audioBuffer.size() - 960))
-                {
-                    uint res = audioFifo->write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
+                m_audioFifo = decodeMsg->getAudioFifo();
+                m_audioStreamPending = decodeMsg->getStreamPendingFrames();
+                m_audioBufferFrames++;
+                m_queueDepth.fetchAndAddOrdered(-1);
+                m_nbFramesDecoded.fetchAndAddOrdered(1);
 
-                    if (res != m_audioBufferFill) {
-                        qDebug("AMBEWorker::handleInputMessages: %u/%u audio samples written", res, m_audioBufferFill);
-                    }
+                int latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - decodeMsg->getTimestamp()).count();
+                int averageUs = m_latencyUs.load();
+                m_latencyUs.store(averageUs + (latencyUs - averageUs) / 16);
 
-                    m_audioBufferFill = 0;
+                if (m_audioBufferFill >= m_audioBuffer.size() - 960) {
+                    flushAudio();
                 }
             }
             else
             {
                 qDebug("AMBEWorker::handleInputMessages: MsgMbeDecode: decode failed");
+                dropFrame(decodeMsg);
             }
         }
 
@@ -131,49 +142,80 @@ void AMBEWorker::handleInputMessages()
         if (m_inputMessageQueue.size() > 100)
         {
             qDebug("AMBEWorker::handleInputMessages: MsgMbeDecode: too many messages in queue. Flushing...");
-            m_inputMessageQueue.clear();
+
+            while ((message = m_inputMessageQueue.pop()) != 0)
+            {
+                if (MsgMbeDecode::match(*message)) {
+                    dropFrame((MsgMbeDecode *) message);
+                }
+
+                delete message;
+            }
+
             break;
         }
     }
 
-    if (audioFifo)
+    flushAudio();
+}
+
+void AMBEWorker::flushAudio()
+{
+    if (m_audioFifo && (m_audioBufferFill > 0))
     {
-        uint res = audioFifo->write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
+        uint res = m_audioFifo->write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
         if (res != m_audioBufferFill) {
-            qDebug("AMBEWorker::handleInputMessages: %u/%u audio samples written", res, m_audioBufferFill);
+            qDebug("AMBEWorker::flushAudio: %u/%u audio samples written", res, m_audioBufferFill);
         }
+    }
 
-        m_audioBufferFill = 0;
+    // the frames are out: the stream may now be moved to another device
+    if (m_audioStreamPending) {
+        m_audioStreamPending->fetchAndAddOrdered(-m_audioBufferFrames);
     }
 
-    m_timestamp = QDateTime::currentDateTime();
+    m_audioBufferFill = 0;
+    m_audioBufferFrames = 0;
+    m_audioStreamPending = nullptr;
 }
 
-void AMBEWorker::pushMbeFrame(const unsigned char *mbeFrame,
-        int mbeRateIndex,
-        int mbeVolumeIndex,
-        unsigned char channels,
-        bool useHP,
-        int upsampling,
-        AudioFifo *audioFifo)
+void AMBEWorker::dropQueuedFrames()
 {
-    m_audioFifo = audioFifo;
-    m_inputMessageQueue.push(MsgMbeDecode::create(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useHP, upsampling, audioFifo));
+    QMutexLocker locker(&m_decodeMutex);
+    Message* message;
+
+    while ((message = m_inputMessageQueue.pop()) != 0)
+    {
+        if (MsgMbeDecode::match(*message)) {
+            dropFrame((MsgMbeDecode *) message);
+        }
+
+        delete message;
+    }
 }
 
-bool AMBEWorker::isAvailable()
+void AMBEWorker::dropFrame(MsgMbeDecode *decodeMsg)
 {
-	if (m_audioFifo == 0) {
-		return true;
-	}
+    if (decodeMsg->getStreamPendingFrames()) {
+        decodeMsg->getStreamPendingFrames()->fetchAndAddOrdered(-1);
+    }
 
-	return m_timestamp.time().msecsTo(QDateTime::currentDateTime().time()) > 1000; // 1 second inactivity timeout
+    m_queueDepth.fetchAndAddOrdered(-1);
+    m_nbFramesDropped.fetchAndAddOrdered(1);
 }
 
-bool AMBEWorker::hasFifo(AudioFifo *audioFifo)
+void AMBEWorker::pushMbeFrame(const unsigned char *mbeFrame,
+        int mbeRateIndex,
+        int mbeVolumeIndex,
+        unsigned char channels,
+        bool useHP,
+        int upsampling,
+        AudioFifo *audioFifo,
+        QAtomicInt *streamPendingFrames)
 {
-    return m_audioFifo == audioFifo;
+    m_queueDepth.fetchAndAddOrdered(1);
+    m_inputMessageQueue.push(MsgMbeDecode::create(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useHP, upsampling, audioFifo, streamPendingFrames));
 }
 
 void AMBEWorker::upsample(int upsampling, short *in, int nbSamplesIn, unsigned char channels)
@@ -19,9 +19,12 @@
 #ifndef SDRBASE_AMBE_AMBEWORKER_H_
 #define SDRBASE_AMBE_AMBEWORKER_H_
 
+#include <chrono>
+
 #include <QObject>
 #include <QDebug>
-#include <QDateTime>
+#include <QAtomicInt>
+#include <QMutex>
 
 #include "export.h"
 #include "dvcontroller.h"
@@ -57,6 +60,8 @@ public:
         bool getUseHP() const { return m_useHP; }
         int getUpsampling() const { return m_upsampling; }
         AudioFifo *getAudioFifo() { return m_audioFifo; }
+        QAtomicInt *getStreamPendingFrames() { return m_streamPendingFrames; }
+        std::chrono::steady_clock::time_point getTimestamp() const { return m_timestamp; }
 
         static MsgMbeDecode* create(
                 const unsigned char *mbeFrame,
@@ -65,9 +70,10 @@ public:
                 unsigned char channels,
                 bool useHP,
                 int upsampling,
-                AudioFifo *audioFifo)
+                AudioFifo *audioFifo,
+                QAtomicInt *streamPendingFrames)
         {
-            return new MsgMbeDecode(mbeFrame, (SerialDV::DVRate) mbeRateIndex, volumeIndex, channels, useHP, upsampling, audioFifo);
+            return new MsgMbeDecode(mbeFrame, (SerialDV::DVRate) mbeRateIndex, volumeIndex, channels, useHP, upsampling, audioFifo, streamPendingFrames);
         }
 
     private:
@@ -78,6 +84,8 @@ public:
         bool m_useHP;
         int m_upsampling;
         AudioFifo *m_audioFifo;
+        QAtomicInt *m_streamPendingFrames; //!< frames of the stream not yet written to its audio FIFO
+        std::chrono::steady_clock::time_point m_timestamp;
 
         MsgMbeDecode(const unsigned char *mbeFrame,
                 SerialDV::DVRate mbeRate,
@@ -85,14 +93,17 @@ public:
                 unsigned char channels,
                 bool useHP,
                 int upsampling,
-                AudioFifo *audioFifo) :
+                AudioFifo *audioFifo,
+                QAtomicInt *streamPendingFrames) :
             Message(),
             m_mbeRate(mbeRate),
             m_volumeIndex(volumeIndex),
             m_channels(channels),
             m_useHP(useHP),
             m_upsampling(upsampling),
-            m_audioFifo(audioFifo)
+            m_audioFifo(audioFifo),
+            m_streamPendingFrames(streamPendingFrames),
+            m_timestamp(std::chrono::steady_clock::now())
         {
             memcpy((void *) m_mbeFrame, (const void *) mbeFrame, SerialDV::DVController::getNbMbeBytes(m_mbeRate));
         }
@@ -107,14 +118,18 @@ public:
             unsigned char channels,
             bool useHP,
             int upsampling,
-            AudioFifo *audioFifo);
+            AudioFifo *audioFifo,
+            QAtomicInt *streamPendingFrames);
 
     bool open(const std::string& deviceRef); //!< Either serial device or ip:port
     void close();
     void process();
     void stop();
-    bool isAvailable();
-    bool hasFifo(AudioFifo *audioFifo);
+    void dropQueuedFrames(); //!< wait for the frames being decoded and drop the queued ones
+    int getQueueDepth() const { return m_queueDepth.load(); } //!< frames pushed and not yet decoded
+    int getNbFramesDecoded() const { return m_nbFramesDecoded.load(); }
+    int getNbFramesDropped() const { return m_nbFramesDropped.load(); }
+    float getLatencyMs() const { return m_latencyUs.load() / 1000.0f; } //!< average time from push to decoded frame
 
     void postTest()
     {
@@ -134,10 +149,18 @@ private:
     void upsample(int upsampling, short *in, int nbSamplesIn, unsigned char channels);
     void noUpsample(short *in, int nbSamplesIn, unsigned char channels);
     void setVolumeFactors();
+    void flushAudio();
+    void dropFrame(MsgMbeDecode *decodeMsg);
 
     SerialDV::DVController m_dvController;
-    AudioFifo *m_audioFifo;
-    QDateTime m_timestamp;
+    QMutex m_decodeMutex;               //!< held while queued frames are decoded
+    AudioFifo *m_audioFifo;             //!< FIFO of the samples in the audio buffer (one stream at a time)
+    QAtomicInt *m_audioStreamPending;   //!< pending frames counter of that stream
+    int m_audioBufferFrames;            //!< number of frames in the audio buffer
+    QAtomicInt m_queueDepth;
+    QAtomicInt m_nbFramesDecoded;
+    QAtomicInt m_nbFramesDropped;
+    QAtomicInt m_latencyUs;             //!< moving average of the decode latency in microseconds
     volatile bool m_running;
     int m_currentGainIn;
     int m_currentGainOut;
@@ -50,11 +50,14 @@ QDataStream& operator<<(QDataStream& ds, const AudioDeviceManager::OutputDeviceI
         << info.udpUseRTP
         << (int) info.udpChannelMode
         << (int) info.udpChannelCodec
-        << info.udpDecimationFactor;
+        << info.udpDecimationFactor
+        << info.udpBlockSize
+        << info.udpOpusFrameDuration
+        << info.lowLatency;
     return ds;
 }
 
-QDataStream& operator>>(QDataStream& ds, AudioDeviceManager::OutputDeviceInfo& info)
+static QDataStream& readOutputDeviceInfoV1(QDataStream& ds, AudioDeviceManager::OutputDeviceInfo& info)
 {
     int intChannelMode;
     int intChannelCodec;
@@ -72,6 +75,15 @@ QDataStream& operator>>(QDataStream& ds, AudioDeviceManager::OutputDeviceInfo& i
     return ds;
 }
 
+QDataStream& operator>>(QDataStream& ds, AudioDeviceManager::OutputDeviceInfo& info)
+{
+    readOutputDeviceInfoV1(ds, info);
+    ds >> info.udpBlockSize
+        >> info.udpOpusFrameDuration
+        >> info.lowLatency;
+    return ds;
+}
+
 AudioDeviceManager::AudioDeviceManager()
 {
     qDebug("AudioDeviceManager::AudioDeviceManager: scan input devices");
@@ -177,7 +189,7 @@ QByteArray AudioDeviceManager::serialize() const
     debugAudioInputInfos();
     debugAudioOutputInfos();
 
-    SimpleSerializer s(1);
+    SimpleSerializer s(2);
     QByteArray data;
 
     serializeInputMap(data);
@@ -213,14 +225,19 @@ bool AudioDeviceManager::deserialize(const QByteArray& data)
         return false;
     }
 
-    if(d.getVersion() == 1)
+    if ((d.getVersion() == 1) || (d.getVersion() == 2))
     {
         QByteArray data;
 
         d.readBlob(1, &data);
         deserializeInputMap(data);
         d.readBlob(2, &data);
-        deserializeOutputMap(data);
+
+        if (d.getVersion() == 1) {
+            deserializeOutputMapV1(data);
+        } else {
+            deserializeOutputMap(data);
+        }
 
         debugAudioInputInfos();
         debugAudioOutputInfos();
@@ -246,6 +263,28 @@ void AudioDeviceManager::deserializeOutputMap(QByteArray& data)
     readStream >> m_audioOutputInfos;
 }
 
+void AudioDeviceManager::deserializeOutputMapV1(QByteArray& data)
+{
+    // Same layout as the map stream operator with the version 1 device info fields
+    QDataStream readStream(&data, QIODevice::ReadOnly);
+    quint32 count;
+
+    m_audioOutputInfos.clear();
+    readStream >> count;
+
+    for (quint32 i = 0; (i < count) && (readStream.status() == QDataStream::Ok); i++)
+    {
+        QString deviceName;
+        OutputDeviceInfo deviceInfo;
+        readStream >> deviceName;
+        readOutputDeviceInfoV1(readStream, deviceInfo);
+
+        if (readStream.status() == QDataStream::Ok) {
+            m_audioOutputInfos[deviceName] = deviceInfo;
+        }
+    }
+}
+
 void AudioDeviceManager::addAudioSink(AudioFifo* audioFifo, MessageQueue *sampleSinkMessageQueue, int outputDeviceIndex)
 {
     qDebug("AudioDeviceManager::addAudioSink: %d: %p", outputDeviceIndex, audioFifo);
@@ -366,6 +405,9 @@ void AudioDeviceManager::startAudioOutput(int outputDeviceIndex)
     AudioOutput::UDPChannelMode udpChannelMode;
     AudioOutput::UDPChannelCodec udpChannelCodec;
     uint32_t decimationFactor;
+    int udpBlockSize;
+    int udpOpusFrameDuration;
+    bool lowLatency;
     QString deviceName;
 
     if (getOutputDeviceName(outputDeviceIndex, deviceName))
@@ -380,6 +422,9 @@ void AudioDeviceManager::startAudioOutput(int outputDeviceIndex)
             udpChannelMode = AudioOutput::UDPChannelLeft;
             udpChannelCodec = AudioOutput::UDPCodecL16;
             decimationFactor = 1;
+            udpBlockSize = m_defaultUDPBlockSize;
+            udpOpusFrameDuration = m_defaultUDPOpusFrameDuration;
+            lowLatency = false;
         }
         else
         {
@@ -391,9 +436,15 @@ void AudioDeviceManager::startAudioOutput(int outputDeviceIndex)
             udpChannelMode = m_audioOutputInfos[deviceName].udpChannelMode;
             udpChannelCodec = m_audioOutputInfos[deviceName].udpChannelCodec;
             decimationFactor = m_audioOutputInfos[deviceName].udpDecimationFactor;
+            udpBlockSize = m_audioOutputInfos[deviceName].udpBlockSize;
+            udpOpusFrameDuration = m_audioOutputInfos[deviceName].udpOpusFrameDuration;
+            lowLatency = m_audioOutputInfos[deviceName].lowLatency;
         }
 
         m_audioOutputs[outputDeviceIndex]->start(outputDeviceIndex, sampleRate);
+        m_audioOutputs[outputDeviceIndex]->setUdpBlockSize(udpBlockSize);
+        m_audioOutputs[outputDeviceIndex]->setUdpOpusFrameDuration(udpOpusFrameDuration);
+        m_audioOutputs[outputDeviceIndex]->setLowLatency(lowLatency);
         m_audioOutputInfos[deviceName].sampleRate = m_audioOutputs[outputDeviceIndex]->getRate(); // update with actual rate
         m_audioOutputInfos[deviceName].udpAddress = udpAddress;
         m_audioOutputInfos[deviceName].udpPort = udpPort;
@@ -402,6 +453,9 @@ void AudioDeviceManager::startAudioOutput(int outputDeviceIndex)
         m_audioOutputInfos[deviceName].udpChannelMode = udpChannelMode;
         m_audioOutputInfos[deviceName].udpChannelCodec = udpChannelCodec;
         m_audioOutputInfos[deviceName].udpDecimationFactor = decimationFactor;
+        m_audioOutputInfos[deviceName].udpBlockSize = udpBlockSize;
+        m_audioOutputInfos[deviceName].udpOpusFrameDuration = udpOpusFrameDuration;
+        m_audioOutputInfos[deviceName].lowLatency = lowLatency;
     }
     else
     {
@@ -521,6 +575,14 @@ int AudioDeviceManager::getOutputSampleRate(int outputDeviceIndex)
     }
 }
 
+uint32_t AudioDeviceManager::getOutputUdpNbDroppedSamples(int outputDeviceIndex)
+{
+    if (m_audioOutputs.find(outputDeviceIndex) == m_audioOutputs.end()) {
+        return 0;
+    }
+
+    return m_audioOutputs[outputDeviceIndex]->getUdpNbDroppedSamples();
+}
 
 void AudioDeviceManager::setInputDeviceInfo(int inputDeviceIndex, const InputDeviceInfo& deviceInfo)
 {
@@ -616,6 +678,9 @@ void AudioDeviceManager::setOutputDeviceInfo(int outputDeviceIndex, const Output
     audioOutput->setUdpChannelMode(deviceInfo.udpChannelMode);
     audioOutput->setUdpChannelFormat(deviceInfo.udpChannelCodec, deviceInfo.udpChannelMode == AudioOutput::UDPChannelStereo, deviceInfo.sampleRate);
     audioOutput->setUdpDecimation(deviceInfo.udpDecimationFactor);
+    audioOutput->setUdpBlockSize(deviceInfo.udpBlockSize);
+    audioOutput->setUdpOpusFrameDuration(deviceInfo.udpOpusFrameDuration);
+    audioOutput->setLowLatency(deviceInfo.lowLatency);
 
     qDebug("AudioDeviceManager::setOutputDeviceInfo: index: %d device: %s updated",
             outputDeviceIndex, qPrintable(deviceName));
@@ -785,6 +850,9 @@ void AudioDeviceManager::debugAudioOutputInfos() const
                 << " udpUseRTP: " << it.value().udpUseRTP
                 << " udpChannelMode: " << (int) it.value().udpChannelMode
                 << " udpChannelCodec: " << (int) it.value().udpChannelCodec
-                << " decimationFactor: " << it.value().udpDecimationFactor;
+                << " decimationFactor: " << it.value().udpDecimationFactor
+                << " udpBlockSize: " << it.value().udpBlockSize
+                << " udpOpusFrameDuration: " << it.value().udpOpusFrameDuration
+                << " lowLatency: " << it.value().lowLatency;
     }
 }
@@ -62,7 +62,10 @@ public:
             udpUseRTP(false),
             udpChannelMode(AudioOutput::UDPChannelLeft),
             udpChannelCodec(AudioOutput::UDPCodecL16),
-            udpDecimationFactor(1)
+            udpDecimationFactor(1),
+            udpBlockSize(m_defaultUDPBlockSize),
+            udpOpusFrameDuration(m_defaultUDPOpusFrameDuration),
+            lowLatency(false)
         {}
         void resetToDefaults() {
             sampleRate = m_defaultAudioSampleRate;
@@ -73,6 +76,9 @@ public:
             udpChannelMode = AudioOutput::UDPChannelLeft;
             udpChannelCodec = AudioOutput::UDPCodecL16;
             udpDecimationFactor = 1;
+            udpBlockSize = m_defaultUDPBlockSize;
+            udpOpusFrameDuration = m_defaultUDPOpusFrameDuration;
+            lowLatency = false;
         }
         unsigned int sampleRate;
         QString udpAddress;
@@ -82,6 +88,9 @@ public:
         AudioOutput::UDPChannelMode udpChannelMode;
         AudioOutput::UDPChannelCodec udpChannelCodec;
         uint32_t udpDecimationFactor;
+        int udpBlockSize;         //!< UDP datagram size in bytes of the raw codecs
+        int udpOpusFrameDuration; //!< Opus frame duration in ms (5, 10 or 20)
+        bool lowLatency; //!< Channels push small audio blocks and the output drops old samples to keep the delay low
         friend QDataStream& operator<<(QDataStream& ds, const OutputDeviceInfo& info);
         friend QDataStream& operator>>(QDataStream& ds, OutputDeviceInfo& info);
     };
@@ -107,6 +116,7 @@ public:
     bool getOutputDeviceInfo(const QString& deviceName, OutputDeviceInfo& deviceInfo) const;
     int getInputSampleRate(int inputDeviceIndex = -1);
     int getOutputSampleRate(int outputDeviceIndex = -1);
+    uint32_t getOutputUdpNbDroppedSamples(int outputDeviceIndex = -1); //!< 0 if the output is not started
     void setInputDeviceInfo(int inputDeviceIndex, const InputDeviceInfo& deviceInfo);
     void setOutputDeviceInfo(int outputDeviceIndex, const OutputDeviceInfo& deviceInfo);
     void unsetInputDeviceInfo(int inputDeviceIndex);
@@ -118,6 +128,8 @@ public:
     static const float m_defaultAudioInputVolume;
     static const QString m_defaultUDPAddress;
     static const quint16 m_defaultUDPPort = 9998;
+    static const int m_defaultUDPBlockSize = 512;
+    static const int m_defaultUDPOpusFrameDuration = 20;
     static const QString m_defaultDeviceName;
 
 private:
@@ -151,6 +163,7 @@ private:
 
     void serializeOutputMap(QByteArray& data) const;
     void deserializeOutputMap(QByteArray& data);
+    void deserializeOutputMapV1(QByteArray& data);
     void debugAudioOutputInfos() const;
 
 	friend class MainSettings;
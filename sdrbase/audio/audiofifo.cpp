@@ -17,35 +17,57 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <string.h>
-#include <QTime>
+#include <QThread>
 #include "dsp/dsptypes.h"
 #include "audio/audiofifo.h"
 #include "audio/audionetsink.h"
+#include "audio/audiomixer.h"
 
 #define MIN(x, y) ((x) < (y) ? (x) : (y))
 
 AudioFifo::AudioFifo() :
 	m_fifo(0),
-	m_sampleSize(sizeof(AudioSample))
+	m_sampleSize(sizeof(AudioSample)),
+	m_size(0),
+	m_fill(0),
+	m_head(0),
+	m_tail(0),
+	m_sampleRate(0),
+	m_lowLatency(0),
+	m_writerBusy(0),
+	m_readerBusy(0),
+	m_control(0),
+	m_fillMin(0),
+	m_fillMax(0),
+	m_underrunCount(0),
+	m_overrunCount(0)
 {
-	m_size = 0;
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
+	resetWindow();
 }
 
 AudioFifo::AudioFifo(uint32_t numSamples) :
 	m_fifo(0),
-    m_sampleSize(sizeof(AudioSample))
+	m_sampleSize(sizeof(AudioSample)),
+	m_size(0),
+	m_fill(0),
+	m_head(0),
+	m_tail(0),
+	m_sampleRate(0),
+	m_lowLatency(0),
+	m_writerBusy(0),
+	m_readerBusy(0),
+	m_control(0),
+	m_fillMin(0),
+	m_fillMax(0),
+	m_underrunCount(0),
+	m_overrunCount(0)
 {
-	QMutexLocker mutexLocker(&m_mutex);
-
 	create(numSamples);
 }
 
 AudioFifo::~AudioFifo()
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	lockControl();
 
 	if (m_fifo != 0)
 	{
@@ -54,112 +76,144 @@ AudioFifo::~AudioFifo()
 	}
 
 	m_size = 0;
+
+	unlockControl();
 }
 
 bool AudioFifo::setSize(uint32_t numSamples)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	lockControl();
+	bool res = create(numSamples);
+	unlockControl();
 
-	return create(numSamples);
+	return res;
 }
 
 uint AudioFifo::write(const quint8* data, uint32_t numSamples)
 {
-	uint32_t total;
-	uint32_t remaining;
-	uint32_t copyLen;
+	if (!enter(m_writerBusy)) {
+		return 0;
+	}
 
-	if (m_fifo == 0) {
+	if (m_fifo == 0)
+	{
+		leave(m_writerBusy);
 		return 0;
 	}
 
-	m_mutex.lock();
+	// the reader only frees space so the fill can only decrease until our own update
+	uint32_t space = m_size - (uint32_t) m_fill.loadAcquire();
+	uint32_t total = MIN(numSamples, space);
+	uint32_t copyLen = MIN(total, m_size - m_tail);
 
-	total = MIN(numSamples, m_size - m_fill);
-	remaining = total;
+	memcpy(m_fifo + (m_tail * m_sampleSize), data, copyLen * m_sampleSize);
 
-	while (remaining != 0)
-	{
-		if (isFull())
-		{
-			m_mutex.unlock();
-			return total - remaining; // written so far
-		}
-
-		copyLen = MIN(remaining, m_size - m_fill);
-		copyLen = MIN(copyLen, m_size - m_tail);
-		memcpy(m_fifo + (m_tail * m_sampleSize), data, copyLen * m_sampleSize);
-		m_tail += copyLen;
-		m_tail %= m_size;
-		m_fill += copyLen;
-		data += copyLen * m_sampleSize;
-		remaining -= copyLen;
+	if (total > copyLen) {
+		memcpy(m_fifo, data + (copyLen * m_sampleSize), (total - copyLen) * m_sampleSize);
 	}
 
-	m_mutex.unlock();
+	m_tail = (m_tail + total) % m_size;
+	m_fill.fetchAndAddRelease(total); // publish the samples
+
+	if (total < numSamples) {
+		m_overrunCount.fetchAndAddRelaxed(1);
+	}
+
+	leave(m_writerBusy);
 	return total;
 }
 
 uint AudioFifo::read(quint8* data, uint32_t numSamples)
 {
-	uint32_t total;
-	uint32_t remaining;
-	uint32_t copyLen;
+	if (!enter(m_readerBusy)) {
+		return 0;
+	}
 
-	if (m_fifo == 0) {
+	if (m_fifo == 0)
+	{
+		leave(m_readerBusy);
 		return 0;
 	}
 
-	m_mutex.lock();
+	uint32_t total = readerPrepare(numSamples);
+	uint32_t copyLen = MIN(total, m_size - m_head);
 
-	total = MIN(numSamples, m_fill);
-	remaining = total;
+	memcpy(data, m_fifo + (m_head * m_sampleSize), copyLen * m_sampleSize);
 
-	while (remaining != 0)
+	if (total > copyLen) {
+		memcpy(data + (copyLen * m_sampleSize), m_fifo, (total - copyLen) * m_sampleSize);
+	}
+
+	readerAdvance(total);
+	leave(m_readerBusy);
+	return total;
+}
+
+uint AudioFifo::readMix(qint32* mix, uint32_t numSamples)
+{
+	if (!enter(m_readerBusy)) {
+		return 0;
+	}
+
+	if (m_fifo == 0)
 	{
-		if (isEmpty())
-		{
-			m_mutex.unlock();
-			return total - remaining; // read so far
-		}
+		leave(m_readerBusy);
+		return 0;
+	}
 
-		copyLen = MIN(remaining, m_fill);
-		copyLen = MIN(copyLen, m_size - m_head);
-		memcpy(data, m_fifo + (m_head * m_sampleSize), copyLen * m_sampleSize);
+	uint32_t total = readerPrepare(numSamples);
+	uint32_t copyLen = MIN(total, m_size - m_head);
 
-		m_head += copyLen;
-		m_head %= m_size;
-		m_fill -= copyLen;
-		data += copyLen * m_sampleSize;
-		remaining -= copyLen;
+	AudioMixer::mixAdd(mix, (const qint16*) (m_fifo + (m_head * m_sampleSize)), 2*copyLen);
+
+	if (total > copyLen) {
+		AudioMixer::mixAdd(mix + 2*copyLen, (const qint16*) m_fifo, 2*(total - copyLen));
 	}
 
-	m_mutex.unlock();
+	readerAdvance(total);
+	leave(m_readerBusy);
 	return total;
 }
 
 uint AudioFifo::drain(uint32_t numSamples)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	if (!enter(m_readerBusy)) {
+		return 0;
+	}
 
-	if(numSamples > m_fill)
+	if (m_fifo == 0)
 	{
-		numSamples = m_fill;
+		leave(m_readerBusy);
+		return 0;
 	}
 
-	m_head = (m_head + numSamples) % m_size;
-	m_fill -= numSamples;
+	uint32_t fill = m_fill.loadAcquire();
+
+	if (numSamples > fill) {
+		numSamples = fill;
+	}
 
+	readerAdvance(numSamples);
+	leave(m_readerBusy);
 	return numSamples;
 }
 
 void AudioFifo::clear()
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	lockControl();
 
-	m_fill = 0;
+	m_fill.store(0);
 	m_head = 0;
 	m_tail = 0;
+	resetWindow();
+
+	unlockControl();
+}
+
+void AudioFifo::resetCounters()
+{
+	m_underrunCount.store(0);
+	m_overrunCount.store(0);
 }
 
 bool AudioFifo::create(uint32_t numSamples)
@@ -170,12 +224,91 @@ bool AudioFifo::create(uint32_t numSamples)
 		m_fifo = 0;
 	}
 
-	m_fill = 0;
+	m_fill.store(0);
 	m_head = 0;
 	m_tail = 0;
 
 	m_fifo = new qint8[numSamples * m_sampleSize];
 	m_size = numSamples;
 
+	m_fillMin.store(0);
+	m_fillMax.store(0);
+	resetWindow();
+
 	return true;
 }
+
+bool AudioFifo::enter(QAtomicInt& busy)
+{
+	busy.fetchAndStoreOrdered(1);
+
+	if (m_control.loadAcquire()) // resize or clear in progress: back off
+	{
+		busy.storeRelease(0);
+		return false;
+	}
+
+	return true;
+}
+
+void AudioFifo::lockControl()
+{
+	m_mutex.lock();
+	m_control.fetchAndStoreOrdered(1);
+
+	// a read or write in progress is a short memory copy
+	while (m_writerBusy.loadAcquire() || m_readerBusy.loadAcquire()) {
+		QThread::yieldCurrentThread();
+	}
+}
+
+void AudioFifo::unlockControl()
+{
+	m_control.storeRelease(0);
+	m_mutex.unlock();
+}
+
+uint32_t AudioFifo::readerPrepare(uint32_t numSamples)
+{
+	uint32_t fill = m_fill.loadAcquire();
+
+	if (getLowLatency() && (fill > numSamples + 4*AUDIOFIFO_LOWLATENCY_BLOCK))
+	{
+		// the writer is ahead: drop the oldest samples keeping a margin of two blocks
+		uint32_t excess = fill - numSamples - 2*AUDIOFIFO_LOWLATENCY_BLOCK;
+		readerAdvance(excess);
+		fill -= excess;
+	}
+
+	m_windowMin = fill < m_windowMin ? fill : m_windowMin;
+	m_windowMax = fill > m_windowMax ? fill : m_windowMax;
+	m_windowCount += numSamples;
+
+	if (m_windowCount >= m_size)
+	{
+		m_fillMin.store(m_windowMin);
+		m_fillMax.store(m_windowMax);
+		resetWindow();
+	}
+
+	if (fill < numSamples)
+	{
+		m_underrunCount.fetchAndAddRelaxed(1);
+		return fill;
+	}
+
+	return numSamples;
+}
+
+void AudioFifo::readerAdvance(uint32_t numSamples)
+{
+	m_head = (m_head + numSamples) % m_size;
+	m_fill.fetchAndAddRelease(-(int) numSamples); // give back the space once the samples have been consumed
+}
+
+void AudioFifo::resetWindow()
+{
+	m_windowMin = m_size;
+	m_windowMax = 0;
+	m_windowCount = 0;
+}
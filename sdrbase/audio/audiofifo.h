@@ -21,11 +21,20 @@
 
 #include <QObject>
 #include <QMutex>
-#include <QWaitCondition>
+#include <QAtomicInt>
 
 #include "dsp/dsptypes.h"
 #include "export.h"
 
+#define AUDIOFIFO_LOWLATENCY_BLOCK 256 //!< Write block size in low latency mode (~5ms at 48 kS/s)
+
+/**
+ * Single producer single consumer audio FIFO. One thread writes (demodulator DSP thread or audio input)
+ * while another reads (audio output device callback or modulator DSP thread). Write and read sides
+ * never block: the fill level is the only shared state and is exchanged with atomic operations.
+ * Resizing and clearing are done by the controlling thread: they wait for a read or write
+ * in progress to complete and make the other side return empty handed in the meantime.
+ */
 class SDRBASE_API AudioFifo : public QObject {
 	Q_OBJECT
 public:
@@ -37,29 +46,69 @@ public:
 
 	uint32_t write(const quint8* data, uint32_t numSamples);
 	uint32_t read(quint8* data, uint32_t numSamples);
+	uint32_t readMix(qint32* mix, uint32_t numSamples); //!< Read and add to a stereo 32 bit mix buffer
 
 	uint32_t drain(uint32_t numSamples);
 	void clear();
 
-	inline uint32_t flush() { return drain(m_fill); }
-	inline uint32_t fill() const { return m_fill; }
-	inline bool isEmpty() const { return m_fill == 0; }
-	inline bool isFull() const { return m_fill == m_size; }
+	inline uint32_t flush() { return drain(fill()); }
+	inline uint32_t fill() const { return m_fill.load(); }
+	inline bool isEmpty() const { return fill() == 0; }
+	inline bool isFull() const { return fill() == m_size; }
 	inline uint32_t size() const { return m_size; }
 
+	void setSampleRate(unsigned int sampleRate) { m_sampleRate = sampleRate; } //!< Rate of written samples if different from the audio device rate (0: device rate)
+	unsigned int getSampleRate() const { return m_sampleRate; }
+
+	/**
+	 * In low latency mode the writer is expected to push blocks of getWriteBlockSize() samples
+	 * and the reader drops the oldest samples when more than a few blocks are queued beyond its
+	 * request so that the delay does not build up when the writer runs ahead of the audio clock.
+	 */
+	void setLowLatency(bool lowLatency) { m_lowLatency.store(lowLatency ? 1 : 0); } //!< Set by the audio device the FIFO is attached to
+	bool getLowLatency() const { return m_lowLatency.load() != 0; }
+	uint32_t getWriteBlockSize(uint32_t defaultBlockSize) const { return getLowLatency() ? AUDIOFIFO_LOWLATENCY_BLOCK : defaultBlockSize; }
+
+	uint32_t getFillMin() const { return m_fillMin.load(); } //!< Minimum fill seen by reads over the last FIFO size worth of samples read
+	uint32_t getFillMax() const { return m_fillMax.load(); } //!< Maximum fill seen by reads over the last FIFO size worth of samples read
+	uint32_t getUnderrunCount() const { return m_underrunCount.load(); } //!< Number of reads that could not be fully served
+	uint32_t getOverrunCount() const { return m_overrunCount.load(); }   //!< Number of writes that could not be fully stored
+	void resetCounters();
+
 private:
-	QMutex m_mutex;
+	QMutex m_mutex; //!< Serializes the control operations (resize, clear)
 
 	qint8* m_fifo;
 
 	const uint32_t m_sampleSize;
 
 	uint32_t m_size;
-	uint32_t m_fill;
-	uint32_t m_head;
-	uint32_t m_tail;
+	QAtomicInt m_fill;
+	uint32_t m_head; //!< Owned by the reader
+	uint32_t m_tail; //!< Owned by the writer
+	unsigned int m_sampleRate;
+	QAtomicInt m_lowLatency; //!< Changed by the controlling thread while reader and writer run
+
+	QAtomicInt m_writerBusy;
+	QAtomicInt m_readerBusy;
+	QAtomicInt m_control; //!< A control operation is in progress
+
+	uint32_t m_windowMin;   //!< Reader side statistics window
+	uint32_t m_windowMax;
+	uint32_t m_windowCount;
+	QAtomicInt m_fillMin;   //!< Published statistics
+	QAtomicInt m_fillMax;
+	QAtomicInt m_underrunCount;
+	QAtomicInt m_overrunCount;
 
 	bool create(uint32_t numSamples);
+	bool enter(QAtomicInt& busy);
+	void leave(QAtomicInt& busy) { busy.storeRelease(0); }
+	void lockControl();
+	void unlockControl();
+	uint32_t readerPrepare(uint32_t numSamples);
+	void readerAdvance(uint32_t numSamples);
+	void resetWindow();
 };
 
 #endif // INCLUDE_AUDIOFIFO_H
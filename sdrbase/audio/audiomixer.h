@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_AUDIO_AUDIOMIXER_H_
+#define SDRBASE_AUDIO_AUDIOMIXER_H_
+
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <QtGlobal>
+
+/**
+ * Audio mix buffer primitives. Values are interleaved stereo samples (2 values per sample).
+ */
+class AudioMixer
+{
+public:
+    /** Add nbValues 16 bit values to the 32 bit mix buffer */
+    static inline void mixAdd(qint32 *mix, const qint16 *src, unsigned int nbValues)
+    {
+        unsigned int i = 0;
+#if defined(USE_SSE2)
+        for (; i + 8 <= nbValues; i += 8)
+        {
+            __m128i x = _mm_loadu_si128((const __m128i*) &src[i]);
+            __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16); // sign extend
+            __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+            _mm_storeu_si128((__m128i*) &mix[i], _mm_add_epi32(_mm_loadu_si128((const __m128i*) &mix[i]), lo));
+            _mm_storeu_si128((__m128i*) &mix[i+4], _mm_add_epi32(_mm_loadu_si128((const __m128i*) &mix[i+4]), hi));
+        }
+#elif defined(USE_NEON)
+        for (; i + 8 <= nbValues; i += 8)
+        {
+            int16x8_t x = vld1q_s16(&src[i]);
+            vst1q_s32(&mix[i], vaddw_s16(vld1q_s32(&mix[i]), vget_low_s16(x)));
+            vst1q_s32(&mix[i+4], vaddw_s16(vld1q_s32(&mix[i+4]), vget_high_s16(x)));
+        }
+#endif
+        for (; i < nbValues; i++) {
+            mix[i] += src[i];
+        }
+    }
+
+    /** Convert nbValues 32 bit mix values to 16 bit with saturation */
+    static inline void mixClip(qint16 *dst, const qint32 *mix, unsigned int nbValues)
+    {
+        unsigned int i = 0;
+#if defined(USE_SSE2)
+        for (; i + 8 <= nbValues; i += 8)
+        {
+            __m128i lo = _mm_loadu_si128((const __m128i*) &mix[i]);
+            __m128i hi = _mm_loadu_si128((const __m128i*) &mix[i+4]);
+            _mm_storeu_si128((__m128i*) &dst[i], _mm_packs_epi32(lo, hi)); // saturating pack
+        }
+#elif defined(USE_NEON)
+        for (; i + 8 <= nbValues; i += 8)
+        {
+            int16x4_t lo = vqmovn_s32(vld1q_s32(&mix[i]));
+            int16x4_t hi = vqmovn_s32(vld1q_s32(&mix[i+4]));
+            vst1q_s16(&dst[i], vcombine_s16(lo, hi));
+        }
+#endif
+        for (; i < nbValues; i++) {
+            dst[i] = mix[i] < -32768 ? -32768 : mix[i] > 32767 ? 32767 : mix[i];
+        }
+    }
+};
+
+#endif // SDRBASE_AUDIO_AUDIOMIXER_H_
@@ -19,14 +19,19 @@
 #include <algorithm>
 
 #include "audionetsink.h"
+#include "audionetsinkworker.h"
 #include "util/rtpsink.h"
 
 #include <QDebug>
 #include <QUdpSocket>
-
-const int AudioNetSink::m_udpBlockSize = 512;
+#include <QThread>
 
 AudioNetSink::AudioNetSink(QObject *parent) :
+    m_fifo(48000),
+    m_nbDroppedSamples(0),
+    m_channelMode(ChannelLeft),
+    m_udpBlockSize(m_udpBlockSizeDefault),
+    m_opusFrameMs(20),
     m_type(SinkUDP),
     m_codec(CodecL16),
     m_rtpBufferAudio(0),
@@ -42,10 +47,17 @@ AudioNetSink::AudioNetSink(QObject *parent) :
     std::fill(m_data, m_data+m_dataBlockSize, 0);
     std::fill(m_opusIn, m_opusIn+m_opusBlockSize, 0);
     m_codecRatio = (m_sampleRate / m_decimation) / (AudioOpus::m_bitrate / 8); // compressor ratio
-    m_udpSocket = new QUdpSocket(parent);
+    m_udpSocket = new QUdpSocket(); // moved to the network audio thread: cannot have a parent
+    startWorker();
+    Q_UNUSED(parent)
 }
 
 AudioNetSink::AudioNetSink(QObject *parent, int sampleRate, bool stereo) :
+    m_fifo(48000),
+    m_nbDroppedSamples(0),
+    m_channelMode(ChannelLeft),
+    m_udpBlockSize(m_udpBlockSizeDefault),
+    m_opusFrameMs(20),
     m_type(SinkUDP),
     m_codec(CodecL16),
     m_rtpBufferAudio(0),
@@ -61,17 +73,34 @@ AudioNetSink::AudioNetSink(QObject *parent, int sampleRate, bool stereo) :
     std::fill(m_data, m_data+m_dataBlockSize, 0);
     std::fill(m_opusIn, m_opusIn+m_opusBlockSize, 0);
     m_codecRatio = (m_sampleRate / m_decimation) / (AudioOpus::m_bitrate / 8); // compressor ratio
-    m_udpSocket = new QUdpSocket(parent);
+    m_udpSocket = new QUdpSocket(); // moved to the network audio thread: cannot have a parent
     m_rtpBufferAudio = new RTPSink(m_udpSocket, sampleRate, stereo);
+    startWorker();
+    Q_UNUSED(parent)
 }
 
 AudioNetSink::~AudioNetSink()
 {
+    m_thread->quit();
+    m_thread->wait();
+    delete m_worker;
+
     if (m_rtpBufferAudio) {
         delete m_rtpBufferAudio;
     }
 
-    m_udpSocket->deleteLater(); // this thread is not the owner thread (was moved)
+    delete m_udpSocket; // its thread is finished
+    delete m_thread;
+}
+
+void AudioNetSink::startWorker()
+{
+    m_fifoBuffer.resize(4096);
+    m_thread = new QThread();
+    m_worker = new AudioNetSinkWorker(this);
+    m_worker->moveToThread(m_thread);
+    m_udpSocket->moveToThread(m_thread);
+    m_thread->start();
 }
 
 bool AudioNetSink::isRTPCapable() const
@@ -81,6 +110,8 @@ bool AudioNetSink::isRTPCapable() const
 
 bool AudioNetSink::selectType(SinkType type)
 {
+    QMutexLocker mutexLocker(&m_mutex);
+
     if (type == SinkUDP)
     {
         m_type = SinkUDP;
@@ -95,6 +126,8 @@ bool AudioNetSink::selectType(SinkType type)
 
 void AudioNetSink::setDestination(const QString& address, uint16_t port)
 {
+    QMutexLocker mutexLocker(&m_mutex);
+
     m_address.setAddress(const_cast<QString&>(address));
     m_port = port;
 
@@ -105,6 +138,8 @@ void AudioNetSink::setDestination(const QString& address, uint16_t port)
 
 void AudioNetSink::addDestination(const QString& address, uint16_t port)
 {
+    QMutexLocker mutexLocker(&m_mutex);
+
     if (m_rtpBufferAudio) {
         m_rtpBufferAudio->addDestination(address, port);
     }
@@ -112,6 +147,8 @@ void AudioNetSink::addDestination(const QString& address, uint16_t port)
 
 void AudioNetSink::deleteDestination(const QString& address, uint16_t port)
 {
+    QMutexLocker mutexLocker(&m_mutex);
+
     if (m_rtpBufferAudio) {
         m_rtpBufferAudio->deleteDestination(address, port);
     }
@@ -124,6 +161,7 @@ void AudioNetSink::setParameters(Codec codec, bool stereo, int sampleRate)
             << " stereo: " << stereo
             << " sampleRate: " << sampleRate;
 
+    QMutexLocker mutexLocker(&m_mutex);
     m_codec = codec;
     m_stereo = stereo;
     m_sampleRate = sampleRate;
@@ -149,7 +187,7 @@ void AudioNetSink::setParameters(Codec codec, bool stereo, int sampleRate)
             m_rtpBufferAudio->setPayloadInformation(RTPSink::PayloadG722, sampleRate/2);
             break;
         case CodecOpus:
-            m_rtpBufferAudio->setPayloadInformation(RTPSink::PayloadOpus, sampleRate);
+            m_rtpBufferAudio->setPayloadInformation(RTPSink::PayloadOpus, sampleRate, m_opusFrameMs);
             break;
         case CodecL16: // actually no codec
         default:
@@ -161,21 +199,98 @@ void AudioNetSink::setParameters(Codec codec, bool stereo, int sampleRate)
 
 void AudioNetSink::setDecimation(uint32_t decimation)
 {
+    QMutexLocker mutexLocker(&m_mutex);
     m_decimation = decimation < 1 ? 1 : decimation > 6 ? 6 : decimation;
     qDebug() << "AudioNetSink::setDecimation: " << m_decimation << " from: " << decimation;
     setNewCodecData();
     m_decimationCount = 0;
 }
 
+void AudioNetSink::setChannelMode(ChannelMode channelMode)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_channelMode = channelMode;
+}
+
+void AudioNetSink::setUdpBlockSize(int udpBlockSize)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    // multiple of a stereo 16 bit sample so that datagrams hold whole samples
+    udpBlockSize = udpBlockSize < 64 ? 64 : udpBlockSize > m_udpBlockSizeMax ? m_udpBlockSizeMax : udpBlockSize;
+    m_udpBlockSize = udpBlockSize - (udpBlockSize % 4);
+    m_bufferIndex = 0;
+    qDebug() << "AudioNetSink::setUdpBlockSize: " << m_udpBlockSize;
+}
+
+void AudioNetSink::setOpusFrameDuration(int opusFrameMs)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_opusFrameMs = opusFrameMs <= 5 ? 5 : opusFrameMs <= 10 ? 10 : 20;
+    qDebug() << "AudioNetSink::setOpusFrameDuration: " << m_opusFrameMs << " ms";
+    setNewCodecData();
+
+    if (m_rtpBufferAudio && (m_codec == CodecOpus)) { // RTP packet size and timestamp follow the frame duration
+        m_rtpBufferAudio->setPayloadInformation(RTPSink::PayloadOpus, m_sampleRate, m_opusFrameMs);
+    }
+}
+
+void AudioNetSink::write(const AudioSample *samples, unsigned int nbSamples)
+{
+    uint32_t nbWritten = m_fifo.write((const quint8*) samples, nbSamples);
+
+    if (nbWritten < nbSamples) {
+        m_nbDroppedSamples.fetchAndAddRelaxed(nbSamples - nbWritten);
+    }
+
+    m_worker->notify();
+}
+
+void AudioNetSink::processFifo()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    uint32_t nbSamples;
+
+    while ((nbSamples = m_fifo.read((quint8*) &m_fifoBuffer[0], m_fifoBuffer.size())) > 0)
+    {
+        const AudioSample *samples = &m_fifoBuffer[0];
+
+        switch (m_channelMode)
+        {
+        case ChannelStereo:
+            for (uint32_t i = 0; i < nbSamples; i++) {
+                write(samples[i].l, samples[i].r);
+            }
+            break;
+        case ChannelMixed:
+            for (uint32_t i = 0; i < nbSamples; i++) {
+                write((qint16) ((samples[i].l + samples[i].r) / 2));
+            }
+            break;
+        case ChannelRight:
+            for (uint32_t i = 0; i < nbSamples; i++) {
+                write(samples[i].r);
+            }
+            break;
+        case ChannelLeft:
+        default:
+            for (uint32_t i = 0; i < nbSamples; i++) {
+                write(samples[i].l);
+            }
+            break;
+        }
+    }
+}
+
 void AudioNetSink::setNewCodecData()
 {
     if (m_codec == CodecOpus)
     {
-        m_codecInputSize = m_sampleRate / (m_decimation * 50); // 20ms = 1/50s - size is per channel
-        m_codecInputSize = m_codecInputSize > 960 ? 960 : m_codecInputSize; // hard limit of 48 kS/s
+        m_codecInputSize = ((m_sampleRate / m_decimation) * m_opusFrameMs) / 1000; // size is per channel
+        m_codecInputSize = m_codecInputSize > 960 ? 960 : m_codecInputSize; // hard limit of 20ms at 48 kS/s
         m_codecRatio = (m_sampleRate / m_decimation) / (AudioOpus::m_bitrate / 8); // compressor ratio
         qDebug() << "AudioNetSink::setNewCodecData: CodecOpus:"
             << " m_codecInputSize: " << m_codecInputSize
+            << " m_opusFrameMs: " << m_opusFrameMs
             << " m_codecRatio: " << m_codecRatio
             << " Fs: " << m_sampleRate/m_decimation
             << " stereo: " << m_stereo;
@@ -281,7 +396,7 @@ void AudioNetSink::write(qint16 isample)
             if (m_codecInputIndex == m_codecInputSize)
             {
                 int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
-                nbBytes = nbBytes > m_udpBlockSize ? m_udpBlockSize : nbBytes;
+                nbBytes = nbBytes > m_udpBlockSizeMax ? m_udpBlockSizeMax : nbBytes;
                 m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) nbBytes, m_address, m_port);
                 m_codecInputIndex = 0;
             }
@@ -339,7 +454,7 @@ void AudioNetSink::write(qint16 isample)
             if (m_codecInputIndex == m_codecInputSize)
             {
                 int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
-                if (nbBytes != AudioOpus::m_bitrate/400) { // 8 bits for 1/50s (20ms)
+                if (nbBytes != (AudioOpus::m_bitrate/8000) * m_opusFrameMs) { // constant bit rate
                     qWarning("AudioNetSink::write: CodecOpus mono: unexpected output frame size: %d bytes", nbBytes);
                 }
                 m_bufferIndex = 0;
@@ -403,7 +518,7 @@ void AudioNetSink::write(qint16 ilSample, qint16 irSample)
             if (m_codecInputIndex == m_codecInputSize)
             {
                 int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
-                nbBytes = nbBytes > m_udpBlockSize ? m_udpBlockSize : nbBytes;
+                nbBytes = nbBytes > m_udpBlockSizeMax ? m_udpBlockSizeMax : nbBytes;
                 m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) nbBytes, m_address, m_port);
                 m_codecInputIndex = 0;
             }
@@ -449,7 +564,7 @@ void AudioNetSink::write(qint16 ilSample, qint16 irSample)
             if (m_codecInputIndex == m_codecInputSize)
             {
                 int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
-                if (nbBytes != AudioOpus::m_bitrate/400) { // 8 bits for 1/50s (20ms)
+                if (nbBytes != (AudioOpus::m_bitrate/8000) * m_opusFrameMs) { // constant bit rate
                     qWarning("AudioNetSink::write: CodecOpus stereo: unexpected output frame size: %d bytes", nbBytes);
                 }
                 m_bufferIndex = 0;
@@ -479,9 +594,3 @@ void AudioNetSink::write(qint16 ilSample, qint16 irSample)
         }
     }
 }
-
-void AudioNetSink::moveToThread(QThread *thread)
-{
-    m_udpSocket->moveToThread(thread);
-}
-
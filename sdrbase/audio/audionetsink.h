@@ -24,16 +24,24 @@
 #include "audiocompressor.h"
 #include "audiog722.h"
 #include "audioopus.h"
+#include "audiofifo.h"
 #include "export.h"
 
 #include <QObject>
+#include <QMutex>
 #include <QHostAddress>
 #include <stdint.h>
 
 class QUdpSocket;
 class RTPSink;
 class QThread;
+class AudioNetSinkWorker;
 
+/**
+ * Copies audio to the network as raw UDP or RTP with optional compression.
+ * Blocks of samples are queued without blocking by the writer (the audio device thread) and
+ * are decimated, encoded and sent from a dedicated network audio thread.
+ */
 class SDRBASE_API AudioNetSink {
 public:
     typedef enum
@@ -52,6 +60,14 @@ public:
         CodecOpus  //!< Opus compressed 8 bit samples at 64kbits/s (8kS/s out). Various input sample rates
     } Codec;
 
+    typedef enum
+    {
+        ChannelLeft,
+        ChannelRight,
+        ChannelMixed,
+        ChannelStereo
+    } ChannelMode; //!< channels taken from the stereo samples written
+
     AudioNetSink(QObject *parent); //!< without RTP
     AudioNetSink(QObject *parent, int sampleRate, bool stereo); //!< with RTP
     ~AudioNetSink();
@@ -61,25 +77,43 @@ public:
     void deleteDestination(const QString& address, uint16_t port);
     void setParameters(Codec codec, bool stereo, int sampleRate);
     void setDecimation(uint32_t decimation);
+    void setChannelMode(ChannelMode channelMode);
+    void setUdpBlockSize(int udpBlockSize);       //!< UDP datagram size in bytes of raw (not Opus) codecs
+    void setOpusFrameDuration(int opusFrameMs);   //!< Opus frame duration: 5, 10 or 20 ms
 
-    void write(qint16 sample);
-    void write(qint16 lSample, qint16 rSample);
+    void write(const AudioSample *samples, unsigned int nbSamples); //!< queue a block of stereo samples (does not block)
 
     bool isRTPCapable() const;
     bool selectType(SinkType type);
 
-    void moveToThread(QThread *thread);
+    uint32_t getNbDroppedSamples() const { return m_nbDroppedSamples.load(); } //!< samples that did not fit in the queue
 
-    static const int m_udpBlockSize;
+    static const int m_udpBlockSizeDefault = 512;
+    static const int m_udpBlockSizeMax = 4096;    // G722 input and output must fit in the data block
     static const int m_dataBlockSize = 65536; // room for G722 conversion (64000 = 12800*5 largest to date)
     static const int m_g722BlockSize = 12800; // number of resulting G722 bytes (80*20ms frames)
     static const int m_opusBlockSize = 960*2; // provision for 20ms of 2 int16 channels at 48 kS/s
     static const int m_opusOutputSize = 160;  // output frame: 20ms of 8 bit data @ 64 kbits/s = 160 bytes
 
 protected:
+    friend class AudioNetSinkWorker;
+
     void setNewCodecData();       // actions to take when changes affecting codec dependent data occurs
     void setDecimationFilters();  // set decimation filters limits depending on effective sample rate and codec
+    void startWorker();           // start the network audio thread
+    void processFifo();           // encode and send queued samples. Runs in the network audio thread.
+    void write(qint16 sample);
+    void write(qint16 lSample, qint16 rSample);
 
+    QMutex m_mutex;               // settings versus network audio thread
+    QThread *m_thread;
+    AudioNetSinkWorker *m_worker;
+    AudioFifo m_fifo;             // samples queued for the network audio thread
+    QAtomicInt m_nbDroppedSamples; // written samples that did not fit in m_fifo
+    AudioVector m_fifoBuffer;
+    ChannelMode m_channelMode;
+    int m_udpBlockSize;
+    int m_opusFrameMs;
     SinkType m_type;
     Codec m_codec;
     QUdpSocket *m_udpSocket;
@@ -0,0 +1,43 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "audionetsink.h"
+#include "audionetsinkworker.h"
+
+AudioNetSinkWorker::AudioNetSinkWorker(AudioNetSink *audioNetSink) :
+    m_audioNetSink(audioNetSink),
+    m_notified(0)
+{
+    connect(this, SIGNAL(dataReady()), this, SLOT(handleData()), Qt::QueuedConnection);
+}
+
+AudioNetSinkWorker::~AudioNetSinkWorker()
+{}
+
+void AudioNetSinkWorker::notify()
+{
+    if (m_notified.testAndSetOrdered(0, 1)) {
+        emit dataReady();
+    }
+}
+
+void AudioNetSinkWorker::handleData()
+{
+    m_notified.storeRelease(0); // samples written from now on need a new notification
+    m_audioNetSink->processFifo();
+}
@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_AUDIO_AUDIONETSINKWORKER_H_
+#define SDRBASE_AUDIO_AUDIONETSINKWORKER_H_
+
+#include <QObject>
+#include <QAtomicInt>
+
+#include "export.h"
+
+class AudioNetSink;
+
+/**
+ * Lives in the network audio thread of an AudioNetSink. Encoding and sending of the
+ * samples queued by the sink are triggered from there.
+ */
+class SDRBASE_API AudioNetSinkWorker : public QObject {
+    Q_OBJECT
+public:
+    AudioNetSinkWorker(AudioNetSink *audioNetSink);
+    ~AudioNetSinkWorker();
+
+    void notify(); //!< Called by the writer thread after samples were queued. Does not block.
+
+signals:
+    void dataReady();
+
+private slots:
+    void handleData();
+
+private:
+    AudioNetSink *m_audioNetSink;
+    QAtomicInt m_notified; //!< a dataReady signal is pending: do not queue another one
+};
+
+#endif /* SDRBASE_AUDIO_AUDIONETSINKWORKER_H_ */
@@ -23,6 +23,7 @@
 #include "audiooutput.h"
 #include "audiofifo.h"
 #include "audionetsink.h"
+#include "audiomixer.h"
 
 AudioOutput::AudioOutput() :
 	m_mutex(QMutex::Recursive),
@@ -33,6 +34,7 @@ AudioOutput::AudioOutput() :
 	m_udpChannelCodec(UDPCodecL16),
 	m_audioUsageCount(0),
 	m_onExit(false),
+	m_lowLatency(false),
 	m_audioFifos()
 {
 }
@@ -112,8 +114,13 @@ bool AudioOutput::start(int device, int rate)
             return false;
         }
 
+        for (std::map<AudioFifo*, FifoResampler*>::iterator it = m_fifoResamplers.begin(); it != m_fifoResamplers.end(); ++it) {
+            it->second->m_inputRate = 0; // device rate may have changed: reconfigure on next read
+        }
+
         m_audioOutput = new QAudioOutput(devInfo, m_audioFormat);
         m_audioNetSink = new AudioNetSink(0, m_audioFormat.sampleRate(), false);
+        m_audioNetSink->setChannelMode((AudioNetSink::ChannelMode) m_udpChannelMode);
 
         QIODevice::open(QIODevice::ReadOnly);
 
@@ -161,6 +168,7 @@ void AudioOutput::addFifo(AudioFifo* audioFifo)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
+	audioFifo->setLowLatency(m_lowLatency);
 	m_audioFifos.push_back(audioFifo);
 }
 
@@ -169,6 +177,14 @@ void AudioOutput::removeFifo(AudioFifo* audioFifo)
 	QMutexLocker mutexLocker(&m_mutex);
 
 	m_audioFifos.remove(audioFifo);
+	audioFifo->setLowLatency(false);
+	std::map<AudioFifo*, FifoResampler*>::iterator it = m_fifoResamplers.find(audioFifo);
+
+	if (it != m_fifoResamplers.end())
+	{
+		delete it->second;
+		m_fifoResamplers.erase(it);
+	}
 }
 
 /*
@@ -200,6 +216,10 @@ void AudioOutput::setUdpUseRTP(bool useRTP)
 void AudioOutput::setUdpChannelMode(UDPChannelMode udpChannelMode)
 {
     m_udpChannelMode = udpChannelMode;
+
+    if (m_audioNetSink) {
+        m_audioNetSink->setChannelMode((AudioNetSink::ChannelMode) m_udpChannelMode);
+    }
 }
 
 void AudioOutput::setUdpChannelFormat(UDPChannelCodec udpChannelCodec, bool stereo, int sampleRate)
@@ -218,6 +238,37 @@ void AudioOutput::setUdpDecimation(uint32_t decimation)
 	}
 }
 
+void AudioOutput::setUdpBlockSize(int udpBlockSize)
+{
+	if (m_audioNetSink) {
+		m_audioNetSink->setUdpBlockSize(udpBlockSize);
+	}
+}
+
+void AudioOutput::setUdpOpusFrameDuration(int opusFrameMs)
+{
+	if (m_audioNetSink) {
+		m_audioNetSink->setOpusFrameDuration(opusFrameMs);
+	}
+}
+
+uint32_t AudioOutput::getUdpNbDroppedSamples()
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	return m_audioNetSink ? m_audioNetSink->getNbDroppedSamples() : 0;
+}
+
+void AudioOutput::setLowLatency(bool lowLatency)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	m_lowLatency = lowLatency;
+
+	for (std::list<AudioFifo*>::iterator it = m_audioFifos.begin(); it != m_audioFifos.end(); ++it) {
+		(*it)->setLowLatency(lowLatency);
+	}
+}
+
 qint64 AudioOutput::readData(char* data, qint64 maxLen)
 {
     //qDebug("AudioOutput::readData: %lld", maxLen);
@@ -247,92 +298,109 @@ qint64 AudioOutput::readData(char* data, qint64 maxLen)
 
 	memset(&m_mixBuffer[0], 0x00, 2 * samplesPerBuffer * sizeof(m_mixBuffer[0])); // start with silence
 
-	// sum up a block from all fifos
+	// sum up a block from all fifos directly into the mix buffer
 
 	for (std::list<AudioFifo*>::iterator it = m_audioFifos.begin(); it != m_audioFifos.end(); ++it)
 	{
-		// use outputBuffer as temp - yes, one memcpy could be saved
-		unsigned int samples = (*it)->read((quint8*) data, samplesPerBuffer);
-		const qint16* src = (const qint16*) data;
-		std::vector<qint32>::iterator dst = m_mixBuffer.begin();
-
-//		if (samples != framesPerBuffer)
-//		{
-//            qDebug("AudioOutput::readData: read %d samples vs %d requested", samples, framesPerBuffer);
-//		}
+		unsigned int fifoRate = (*it)->getSampleRate();
 
-		for (unsigned int i = 0; i < samples; i++)
-		{
-			*dst += *src;
-			++src;
-			++dst;
-			*dst += *src;
-			++src;
-			++dst;
+		if ((fifoRate == 0) || (fifoRate == (unsigned int) m_audioFormat.sampleRate())) {
+			(*it)->readMix(&m_mixBuffer[0], samplesPerBuffer);
+		} else {
+			mixResampled(*it, samplesPerBuffer);
 		}
-    }
-	// convert to int16
+	}
+
+	// convert to int16 with saturation
 
-	//std::vector<qint32>::const_iterator src = m_mixBuffer.begin(); // Valgrind optim
 	qint16* dst = (qint16*) data;
-	qint32 sl, sr;
+	AudioMixer::mixClip(dst, &m_mixBuffer[0], 2 * samplesPerBuffer);
 
-	for (unsigned int i = 0; i < samplesPerBuffer; i++)
+	// encoding and sending is done in the network audio thread
+
+	if ((m_copyAudioToUdp) && (m_audioNetSink)) {
+		m_audioNetSink->write((const AudioSample*) dst, samplesPerBuffer);
+	}
+
+	return samplesPerBuffer * 4;
+}
+
+void AudioOutput::mixResampled(AudioFifo* audioFifo, unsigned int nbSamples)
+{
+	FifoResampler *resampler;
+	std::map<AudioFifo*, FifoResampler*>::iterator it = m_fifoResamplers.find(audioFifo);
+
+	if (it == m_fifoResamplers.end())
 	{
-		// left channel
+		resampler = new FifoResampler();
+		m_fifoResamplers[audioFifo] = resampler;
+	}
+	else
+	{
+		resampler = it->second;
+	}
 
-		//s = *src++; // Valgrind optim
-		sl = m_mixBuffer[2*i];
+	if (resampler->m_inputRate != audioFifo->getSampleRate()) {
+		resampler->configure(audioFifo->getSampleRate(), m_audioFormat.sampleRate());
+	}
 
-		if(sl < -32768)
-		{
-			sl = -32768;
-		}
-		else if (sl > 32767)
-		{
-			sl = 32767;
-		}
+	// top up pending input samples with what is needed for this block
+	unsigned int nbPending = resampler->m_pending.size() - resampler->m_pendingIndex;
+	unsigned int nbNeeded = (unsigned int) (nbSamples * resampler->m_distance) + 2;
 
-		*dst++ = sl;
+	if (nbPending < nbNeeded)
+	{
+		resampler->m_pending.erase(resampler->m_pending.begin(), resampler->m_pending.begin() + resampler->m_pendingIndex);
+		resampler->m_pendingIndex = 0;
+		resampler->m_pending.resize(nbNeeded);
+		unsigned int nbRead = audioFifo->read((quint8*) &resampler->m_pending[nbPending], nbNeeded - nbPending);
+		resampler->m_pending.resize(nbPending + nbRead);
+	}
 
-		// right channel
+	qint32 *mix = &m_mixBuffer[0];
+	unsigned int nbOut = 0;
+	Complex ci;
 
-		//s = *src++; // Valgrind optim
-		sr = m_mixBuffer[2*i + 1];
+	while ((nbOut < nbSamples) && (resampler->m_pendingIndex < resampler->m_pending.size()))
+	{
+		const AudioSample& s = resampler->m_pending[resampler->m_pendingIndex];
+		Complex c(s.l, s.r);
 
-		if(sr < -32768)
+		if (resampler->m_distance < 1.0f) // upsampling: one output per call
 		{
-			sr = -32768;
+			if (resampler->m_interpolator.interpolate(&resampler->m_distanceRemain, c, &ci)) {
+				resampler->m_pendingIndex++;
+			}
+
+			mix[2*nbOut] += (qint32) ci.real();
+			mix[2*nbOut + 1] += (qint32) ci.imag();
+			nbOut++;
+			resampler->m_distanceRemain += resampler->m_distance;
 		}
-		else if (sr > 32767)
+		else // downsampling: one input per call
 		{
-			sr = 32767;
-		}
-
-		*dst++ = sr;
-
-		if ((m_copyAudioToUdp) && (m_audioNetSink))
-		{
-	        switch (m_udpChannelMode)
-	        {
-            case UDPChannelStereo:
-                m_audioNetSink->write(sl, sr);
-                break;
-            case UDPChannelMixed:
-                m_audioNetSink->write((sl+sr)/2);
-                break;
-            case UDPChannelRight:
-                m_audioNetSink->write(sr);
-                break;
-	        case UDPChannelLeft:
-	        default:
-	            m_audioNetSink->write(sl);
-	            break;
-	        }
+			resampler->m_pendingIndex++;
+
+			if (resampler->m_interpolator.decimate(&resampler->m_distanceRemain, c, &ci))
+			{
+				mix[2*nbOut] += (qint32) ci.real();
+				mix[2*nbOut + 1] += (qint32) ci.imag();
+				nbOut++;
+				resampler->m_distanceRemain += resampler->m_distance;
+			}
 		}
 	}
+}
 
-	return samplesPerBuffer * 4;
+void AudioOutput::FifoResampler::configure(unsigned int inputRate, unsigned int outputRate)
+{
+	qDebug("AudioOutput::FifoResampler::configure: %u -> %u", inputRate, outputRate);
+	m_inputRate = inputRate;
+	m_interpolator.create(16, inputRate, 0.45f * (inputRate < outputRate ? inputRate : outputRate));
+	m_distance = (Real) inputRate / (Real) outputRate;
+	m_distanceRemain = m_distance < 1.0f ? 0.0f : m_distance;
+	m_pending.clear();
+	m_pendingIndex = 0;
 }
 
 qint64 AudioOutput::writeData(const char* data, qint64 len)
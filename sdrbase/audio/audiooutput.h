@@ -23,8 +23,11 @@
 #include <QIODevice>
 #include <QAudioFormat>
 #include <list>
+#include <map>
 #include <vector>
 #include <stdint.h>
+#include "dsp/dsptypes.h"
+#include "dsp/interpolator.h"
 #include "export.h"
 
 class QAudioOutput;
@@ -71,6 +74,10 @@ public:
 	void setUdpChannelMode(UDPChannelMode udpChannelMode);
 	void setUdpChannelFormat(UDPChannelCodec udpChannelCodec, bool stereo, int sampleRate);
 	void setUdpDecimation(uint32_t decimation);
+	void setUdpBlockSize(int udpBlockSize);
+	void setUdpOpusFrameDuration(int opusFrameMs);
+	uint32_t getUdpNbDroppedSamples(); //!< Samples not sent to UDP because the network audio thread lagged
+	void setLowLatency(bool lowLatency); //!< Applies to the FIFOs attached to this output
 
 private:
 	QMutex m_mutex;
@@ -81,8 +88,24 @@ private:
 	UDPChannelCodec m_udpChannelCodec;
 	uint m_audioUsageCount;
 	bool m_onExit;
+	bool m_lowLatency;
+
+	/** Converts the rate of a FIFO written at a rate different from the device rate */
+	struct FifoResampler
+	{
+		FifoResampler() : m_inputRate(0), m_distance(1.0f), m_distanceRemain(0.0f), m_pendingIndex(0) {}
+		void configure(unsigned int inputRate, unsigned int outputRate);
+
+		unsigned int m_inputRate;
+		Interpolator m_interpolator;    //!< stereo samples as complex (L: real, R: imag)
+		Real m_distance;
+		Real m_distanceRemain;
+		AudioVector m_pending;          //!< samples read from the FIFO not yet consumed
+		unsigned int m_pendingIndex;
+	};
 
 	std::list<AudioFifo*> m_audioFifos;
+	std::map<AudioFifo*, FifoResampler*> m_fifoResamplers;
 	std::vector<qint32> m_mixBuffer;
 
 	QAudioFormat m_audioFormat;
@@ -90,6 +113,7 @@ private:
 	//virtual bool open(OpenMode mode);
 	virtual qint64 readData(char* data, qint64 maxLen);
 	virtual qint64 writeData(const char* data, qint64 len);
+	void mixResampled(AudioFifo* audioFifo, unsigned int nbSamples);
 
 	friend class AudioOutputPipe;
 };
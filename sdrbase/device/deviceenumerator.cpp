@@ -16,102 +16,606 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <QGlobalStatic>
+#include <QCoreApplication>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMap>
+
+#include <cstring>
 
 #include "plugin/pluginmanager.h"
+#include "plugin/pluginproxy.h"
 #include "deviceenumerator.h"
 
+/**
+ * Enumerates the plugins of a hardware family serially. Owns its results so that it can be
+ * abandoned if it times out.
+ */
+class DeviceEnumerationThread : public QThread
+{
+public:
+    DeviceEnumerationThread(const QString& hardwareFamily) :
+        m_hardwareFamily(hardwareFamily)
+    {}
+
+    void addPlugin(int pluginIndex, int streamDirection, const QString& deviceId, PluginInterface *plugin)
+    {
+        m_pluginIndexes.push_back(pluginIndex);
+        m_streamDirections.push_back(streamDirection);
+        m_deviceIds.push_back(deviceId);
+        m_plugins.push_back(plugin);
+    }
+
+    const QString& getHardwareFamily() const { return m_hardwareFamily; }
+    const std::vector<int>& getPluginIndexes() const { return m_pluginIndexes; }
+    const std::vector<PluginInterface::SamplingDevices>& getSamplingDevices() const { return m_samplingDevices; }
+
+protected:
+    virtual void run()
+    {
+        QElapsedTimer timer;
+
+        for (unsigned int i = 0; i < m_plugins.size(); i++)
+        {
+            timer.start();
+
+            if (m_streamDirections[i] == 0) {
+                m_samplingDevices.push_back(m_plugins[i]->enumSampleSources());
+            } else if (m_streamDirections[i] == 1) {
+                m_samplingDevices.push_back(m_plugins[i]->enumSampleSinks());
+            } else {
+                m_samplingDevices.push_back(m_plugins[i]->enumSampleMIMO());
+            }
+
+            qDebug("DeviceEnumerationThread::run: %s: %d devices in %lld ms",
+                qPrintable(m_deviceIds[i]), m_samplingDevices.back().size(), timer.elapsed());
+        }
+    }
+
+private:
+    QString m_hardwareFamily;
+    std::vector<int> m_pluginIndexes;
+    std::vector<int> m_streamDirections;
+    std::vector<QString> m_deviceIds;
+    std::vector<PluginInterface*> m_plugins;
+    std::vector<PluginInterface::SamplingDevices> m_samplingDevices;
+};
+
+static QJsonObject samplingDeviceToJson(const PluginInterface::SamplingDevice& samplingDevice)
+{
+    QJsonObject jsonObject;
+    jsonObject.insert("displayedName", samplingDevice.displayedName);
+    jsonObject.insert("hardwareId", samplingDevice.hardwareId);
+    jsonObject.insert("id", samplingDevice.id);
+    jsonObject.insert("serial", samplingDevice.serial);
+    jsonObject.insert("sequence", samplingDevice.sequence);
+    jsonObject.insert("type", (int) samplingDevice.type);
+    jsonObject.insert("streamType", (int) samplingDevice.streamType);
+    jsonObject.insert("deviceNbItems", samplingDevice.deviceNbItems);
+    jsonObject.insert("deviceItemIndex", samplingDevice.deviceItemIndex);
+    return jsonObject;
+}
+
+static PluginInterface::SamplingDevice samplingDeviceFromJson(const QJsonObject& jsonObject)
+{
+    return PluginInterface::SamplingDevice(
+        jsonObject.value("displayedName").toString(),
+        jsonObject.value("hardwareId").toString(),
+        jsonObject.value("id").toString(),
+        jsonObject.value("serial").toString(),
+        jsonObject.value("sequence").toInt(),
+        (PluginInterface::SamplingDevice::SamplingDeviceType) jsonObject.value("type").toInt(),
+        (PluginInterface::SamplingDevice::StreamType) jsonObject.value("streamType").toInt(),
+        jsonObject.value("deviceNbItems").toInt(),
+        jsonObject.value("deviceItemIndex").toInt()
+    );
+}
+
+const int DeviceEnumerator::m_cacheVersion = 1;
+
 Q_GLOBAL_STATIC(DeviceEnumerator, deviceEnumerator)
 DeviceEnumerator *DeviceEnumerator::instance()
 {
     return deviceEnumerator;
 }
 
-DeviceEnumerator::DeviceEnumerator()
+DeviceEnumerator::DeviceEnumerator() :
+    m_pluginManager(nullptr),
+    m_enumerationTimeout(5000)
 {}
 
 DeviceEnumerator::~DeviceEnumerator()
-{}
+{
+    // a thread still running cannot be deleted: it is left to the process exit
+    for (int i = 0; i < m_lateThreads.size(); i++)
+    {
+        if (m_lateThreads[i]->isFinished()) {
+            delete m_lateThreads[i];
+        }
+    }
+}
 
-void DeviceEnumerator::enumerateRxDevices(PluginManager *pluginManager)
+void DeviceEnumerator::enumerateDevices(PluginManager *pluginManager, const QString& cacheFileName)
 {
+    QElapsedTimer timer;
+    timer.start();
+    m_pluginManager = pluginManager;
+    m_cacheFileName = cacheFileName;
+    m_usbTopology = getUSBTopology();
+    m_pluginEnumerations.clear();
     m_rxEnumeration.clear();
-    PluginAPI::SamplingDeviceRegistrations& rxDeviceRegistrations = pluginManager->getSourceDeviceRegistrations();
-    int index = 0;
+    m_txEnumeration.clear();
+    m_mimoEnumeration.clear();
 
-    for (int i = 0; i < rxDeviceRegistrations.count(); i++)
+    addPluginEnumerations(StreamRx, pluginManager->getSourceDeviceRegistrations());
+    addPluginEnumerations(StreamTx, pluginManager->getSinkDeviceRegistrations());
+    addPluginEnumerations(StreamMIMO, pluginManager->getMIMODeviceRegistrations());
+    loadCache();
+
+    QList<int> pluginIndexes;
+
+    for (int i = 0; i < m_pluginEnumerations.size(); i++)
+    {
+        if (!m_pluginEnumerations[i].m_valid) {
+            pluginIndexes.append(i);
+        }
+    }
+
+    qDebug("DeviceEnumerator::enumerateDevices: %d plugins from cache %d to enumerate",
+        m_pluginEnumerations.size() - pluginIndexes.size(), pluginIndexes.size());
+    enumeratePlugins(pluginIndexes);
+    updateDevicesEnumeration(StreamRx, m_rxEnumeration);
+    updateDevicesEnumeration(StreamTx, m_txEnumeration);
+    updateDevicesEnumeration(StreamMIMO, m_mimoEnumeration);
+
+    if (pluginIndexes.size() > 0) {
+        saveCache();
+    }
+
+    qInfo("DeviceEnumerator::enumerateDevices: %d Rx %d Tx %d MIMO devices in %lld ms",
+        (int) m_rxEnumeration.size(), (int) m_txEnumeration.size(), (int) m_mimoEnumeration.size(), timer.elapsed());
+}
+
+void DeviceEnumerator::rescanDevices()
+{
+    if (!m_pluginManager) {
+        return;
+    }
+
+    m_usbTopology = getUSBTopology();
+    QList<int> pluginIndexes;
+
+    for (int i = 0; i < m_pluginEnumerations.size(); i++)
     {
-        qDebug("DeviceEnumerator::enumerateRxDevices: %s", qPrintable(rxDeviceRegistrations[i].m_deviceId));
-        PluginInterface::SamplingDevices samplingDevices = rxDeviceRegistrations[i].m_plugin->enumSampleSources();
+        const PluginEnumeration& pluginEnumeration = m_pluginEnumerations[i];
+
+        // a plugin skipped while in use keeps its topology so it is enumerated once released
+        if (pluginEnumeration.m_valid
+            && !(!m_usbTopology.isEmpty() && isTopologyDependent(pluginEnumeration) && (pluginEnumeration.m_usbTopology != m_usbTopology))) {
+            continue;
+        }
 
-        for (int j = 0; j < samplingDevices.count(); j++)
+        // enumerating may open the devices of the plugin
+        if (isHardwareFamilyInUse(getHardwareFamily(pluginEnumeration.m_deviceId)))
         {
-            m_rxEnumeration.push_back(
-                DeviceEnumeration(
-                    samplingDevices[j],
-                    rxDeviceRegistrations[i].m_plugin,
-                    index
-                )
-            );
-            index++;
+            qDebug("DeviceEnumerator::rescanDevices: %s: device in use", qPrintable(pluginEnumeration.m_deviceId));
+            continue;
         }
+
+        pluginIndexes.append(i);
     }
+
+    if (pluginIndexes.size() == 0) {
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    enumeratePlugins(pluginIndexes);
+    updateDevicesEnumeration(StreamRx, m_rxEnumeration);
+    updateDevicesEnumeration(StreamTx, m_txEnumeration);
+    updateDevicesEnumeration(StreamMIMO, m_mimoEnumeration);
+    saveCache();
+    qInfo("DeviceEnumerator::rescanDevices: %d plugins enumerated in %lld ms", pluginIndexes.size(), timer.elapsed());
 }
 
-void DeviceEnumerator::enumerateTxDevices(PluginManager *pluginManager)
+void DeviceEnumerator::removePluginDevices(PluginInterface *plugin)
 {
-    m_txEnumeration.clear();
-    PluginAPI::SamplingDeviceRegistrations& txDeviceRegistrations = pluginManager->getSinkDeviceRegistrations();
-    int index = 0;
+    DevicesEnumeration *devicesEnumerations[3] = {&m_rxEnumeration, &m_txEnumeration, &m_mimoEnumeration};
 
-    for (int i = 0; i < txDeviceRegistrations.count(); i++)
+    for (int i = 0; i < 3; i++)
     {
-        qDebug("DeviceEnumerator::enumerateTxDevices: %s", qPrintable(txDeviceRegistrations[i].m_deviceId));
-        PluginInterface::SamplingDevices samplingDevices = txDeviceRegistrations[i].m_plugin->enumSampleSinks();
+        for (DevicesEnumeration::iterator it = devicesEnumerations[i]->begin(); it != devicesEnumerations[i]->end(); ++it)
+        {
+            if (it->m_pluginInterface == plugin) {
+                it->m_present = false;
+            }
+        }
+    }
 
-        for (int j = 0; j < samplingDevices.count(); j++)
+    for (int i = 0; i < m_pluginEnumerations.size(); i++)
+    {
+        if (m_pluginEnumerations[i].m_plugin == plugin)
         {
-            m_txEnumeration.push_back(
-                DeviceEnumeration(
-                    samplingDevices[j],
-                    txDeviceRegistrations[i].m_plugin,
-                    index
-                )
-            );
-            index++;
+            m_pluginEnumerations[i].m_samplingDevices.clear();
+            m_pluginEnumerations[i].m_lastModified = 0; // not cached
+            m_pluginEnumerations[i].m_valid = true;
         }
     }
 }
 
-void DeviceEnumerator::enumerateMIMODevices(PluginManager *pluginManager)
+void DeviceEnumerator::addPluginEnumerations(StreamDirection streamDirection, const PluginAPI::SamplingDeviceRegistrations& registrations)
 {
-    m_mimoEnumeration.clear();
-    PluginAPI::SamplingDeviceRegistrations& mimoDeviceRegistrations = pluginManager->getMIMODeviceRegistrations();
-    int index = 0;
+    for (int i = 0; i < registrations.count(); i++)
+    {
+        PluginEnumeration pluginEnumeration(streamDirection, registrations[i].m_deviceId, registrations[i].m_plugin);
+        PluginProxy *pluginProxy = dynamic_cast<PluginProxy*>(registrations[i].m_plugin);
 
-    for (int i = 0; i < mimoDeviceRegistrations.count(); i++)
+        if (pluginProxy)
+        {
+            pluginEnumeration.m_lastModified = pluginProxy->getManifest().m_lastModified;
+            pluginEnumeration.m_size = pluginProxy->getManifest().m_size;
+        }
+
+        m_pluginEnumerations.append(pluginEnumeration);
+    }
+}
+
+void DeviceEnumerator::enumeratePlugins(const QList<int>& pluginIndexes)
+{
+    for (int i = m_lateThreads.size() - 1; i >= 0; i--)
     {
-        qDebug("DeviceEnumerator::enumerateMIMODevices: %s", qPrintable(mimoDeviceRegistrations[i].m_deviceId));
-        PluginInterface::SamplingDevices samplingDevices = mimoDeviceRegistrations[i].m_plugin->enumSampleMIMO();
+        if (m_lateThreads[i]->isFinished())
+        {
+            delete m_lateThreads[i];
+            m_lateThreads.removeAt(i);
+        }
+    }
+
+    QMap<QString, DeviceEnumerationThread*> threads;
+
+    for (int i = 0; i < pluginIndexes.size(); i++)
+    {
+        PluginEnumeration& pluginEnumeration = m_pluginEnumerations[pluginIndexes[i]];
+        QString hardwareFamily = getHardwareFamily(pluginEnumeration.m_deviceId);
+        bool late = false;
+
+        for (int j = 0; j < m_lateThreads.size(); j++) {
+            late = late || (m_lateThreads[j]->getHardwareFamily() == hardwareFamily);
+        }
 
-        for (int j = 0; j < samplingDevices.count(); j++)
+        if (late)
         {
-            m_mimoEnumeration.push_back(
-                DeviceEnumeration(
-                    samplingDevices[j],
-                    mimoDeviceRegistrations[i].m_plugin,
-                    index
-                )
-            );
-            index++;
+            qWarning("DeviceEnumerator::enumeratePlugins: %s: previous enumeration still running", qPrintable(pluginEnumeration.m_deviceId));
+            continue;
+        }
+
+        // load the library before enumerating so that a plugin that cannot be loaded is unregistered here
+        PluginProxy *pluginProxy = dynamic_cast<PluginProxy*>(pluginEnumeration.m_plugin);
+
+        if (pluginProxy && !pluginProxy->getPlugin())
+        {
+            pluginEnumeration.m_samplingDevices.clear();
+            pluginEnumeration.m_valid = true;
+            continue;
+        }
+
+        if (!threads.contains(hardwareFamily)) {
+            threads.insert(hardwareFamily, new DeviceEnumerationThread(hardwareFamily));
         }
+
+        threads[hardwareFamily]->addPlugin(pluginIndexes[i], (int) pluginEnumeration.m_streamDirection,
+            pluginEnumeration.m_deviceId, pluginEnumeration.m_plugin);
+    }
+
+    QString usbTopologyBefore = getUSBTopology();
+    QList<DeviceEnumerationThread*> finishedThreads;
+    QElapsedTimer timer;
+    timer.start();
+
+    for (QMap<QString, DeviceEnumerationThread*>::iterator it = threads.begin(); it != threads.end(); ++it) {
+        it.value()->start();
+    }
+
+    for (QMap<QString, DeviceEnumerationThread*>::iterator it = threads.begin(); it != threads.end(); ++it)
+    {
+        DeviceEnumerationThread *thread = it.value();
+        qint64 remaining = m_enumerationTimeout - timer.elapsed();
+
+        if (thread->wait(remaining < 0 ? 0 : (unsigned long) remaining))
+        {
+            finishedThreads.append(thread);
+        }
+        else // the devices of the previous enumeration or cache if any are kept
+        {
+            qWarning("DeviceEnumerator::enumeratePlugins: %s enumeration timed out after %d ms",
+                qPrintable(it.key()), m_enumerationTimeout);
+            m_lateThreads.append(thread);
+        }
+    }
+
+    // Devices may re-enumerate on the bus while scanned (e.g. Perseus after its firmware download) so the
+    // topology is taken after the enumeration. If it changed meanwhile the results are not tied to a topology
+    // and the plugins are enumerated again at the next rescan or start.
+    m_usbTopology = getUSBTopology();
+    QString usbTopology = (m_usbTopology == usbTopologyBefore) ? m_usbTopology : QString();
+
+    for (int t = 0; t < finishedThreads.size(); t++)
+    {
+        const std::vector<int>& threadPluginIndexes = finishedThreads[t]->getPluginIndexes();
+
+        for (unsigned int i = 0; i < threadPluginIndexes.size(); i++)
+        {
+            PluginEnumeration& pluginEnumeration = m_pluginEnumerations[threadPluginIndexes[i]];
+            pluginEnumeration.m_samplingDevices = finishedThreads[t]->getSamplingDevices()[i];
+            pluginEnumeration.m_usbTopology = usbTopology;
+            pluginEnumeration.m_valid = true;
+        }
+
+        delete finishedThreads[t];
     }
 }
 
+void DeviceEnumerator::updateDevicesEnumeration(StreamDirection streamDirection, DevicesEnumeration& devicesEnumeration)
+{
+    for (DevicesEnumeration::iterator it = devicesEnumeration.begin(); it != devicesEnumeration.end(); ++it) {
+        it->m_present = false;
+    }
+
+    for (int i = 0; i < m_pluginEnumerations.size(); i++)
+    {
+        const PluginEnumeration& pluginEnumeration = m_pluginEnumerations[i];
+
+        if (pluginEnumeration.m_streamDirection != streamDirection) {
+            continue;
+        }
+
+        for (int j = 0; j < pluginEnumeration.m_samplingDevices.count(); j++)
+        {
+            const PluginInterface::SamplingDevice& samplingDevice = pluginEnumeration.m_samplingDevices[j];
+            DevicesEnumeration::iterator it = devicesEnumeration.begin();
+
+            for (; it != devicesEnumeration.end(); ++it)
+            {
+                if ((it->m_samplingDevice.id == samplingDevice.id)
+                    && (it->m_samplingDevice.serial == samplingDevice.serial)
+                    && (it->m_samplingDevice.sequence == samplingDevice.sequence)
+                    && (it->m_samplingDevice.deviceItemIndex == samplingDevice.deviceItemIndex)) {
+                    break;
+                }
+            }
+
+            if (it == devicesEnumeration.end()) // new device
+            {
+                devicesEnumeration.push_back(DeviceEnumeration(samplingDevice, pluginEnumeration.m_plugin, devicesEnumeration.size()));
+            }
+            else // same device: keep its index and claim
+            {
+                int claimed = it->m_samplingDevice.claimed;
+                it->m_samplingDevice = samplingDevice;
+                it->m_samplingDevice.claimed = claimed;
+                it->m_pluginInterface = pluginEnumeration.m_plugin;
+                it->m_present = true;
+            }
+        }
+    }
+}
+
+bool DeviceEnumerator::isHardwareFamilyInUse(const QString& hardwareFamily) const
+{
+    const DevicesEnumeration *devicesEnumerations[3] = {&m_rxEnumeration, &m_txEnumeration, &m_mimoEnumeration};
+
+    for (int i = 0; i < 3; i++)
+    {
+        for (DevicesEnumeration::const_iterator it = devicesEnumerations[i]->begin(); it != devicesEnumerations[i]->end(); ++it)
+        {
+            if ((it->m_samplingDevice.claimed >= 0)
+                && (it->m_samplingDevice.type == PluginInterface::SamplingDevice::PhysicalDevice)
+                && (getHardwareFamily(it->m_samplingDevice.id) == hardwareFamily)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void DeviceEnumerator::loadCache()
+{
+    QFile cacheFile(m_cacheFileName);
+
+    if (m_cacheFileName.isEmpty() || !cacheFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QJsonObject cacheObject = QJsonDocument::fromJson(cacheFile.readAll()).object();
+
+    if ((cacheObject.value("version").toInt() != m_cacheVersion)
+        || (cacheObject.value("applicationVersion").toString() != QCoreApplication::applicationVersion()))
+    {
+        qDebug("DeviceEnumerator::loadCache: %s is outdated", qPrintable(m_cacheFileName));
+        return;
+    }
+
+    QMap<QString, QJsonObject> cachedPlugins;
+    QJsonArray plugins = cacheObject.value("plugins").toArray();
+
+    for (int i = 0; i < plugins.size(); i++)
+    {
+        QJsonObject pluginObject = plugins[i].toObject();
+        cachedPlugins.insert(QString("%1:%2").arg(pluginObject.value("streamDirection").toInt()).arg(pluginObject.value("deviceId").toString()), pluginObject);
+    }
+
+    for (int i = 0; i < m_pluginEnumerations.size(); i++)
+    {
+        PluginEnumeration& pluginEnumeration = m_pluginEnumerations[i];
+        QMap<QString, QJsonObject>::const_iterator it = cachedPlugins.find(
+            QString("%1:%2").arg((int) pluginEnumeration.m_streamDirection).arg(pluginEnumeration.m_deviceId));
+
+        if ((it == cachedPlugins.end())
+            || mayFindNetworkDevices(pluginEnumeration.m_deviceId)
+            || (pluginEnumeration.m_lastModified == 0)
+            || (it->value("lastModified").toVariant().toLongLong() != pluginEnumeration.m_lastModified)
+            || (it->value("size").toVariant().toLongLong() != pluginEnumeration.m_size)) {
+            continue;
+        }
+
+        QJsonArray devices = it->value("devices").toArray();
+
+        for (int j = 0; j < devices.size(); j++) {
+            pluginEnumeration.m_samplingDevices.append(samplingDeviceFromJson(devices[j].toObject()));
+        }
+
+        pluginEnumeration.m_usbTopology = it->value("usbTopology").toString();
+        pluginEnumeration.m_valid = !isTopologyDependent(pluginEnumeration)
+            || (!m_usbTopology.isEmpty() && (pluginEnumeration.m_usbTopology == m_usbTopology));
+    }
+}
+
+void DeviceEnumerator::saveCache()
+{
+    if (m_cacheFileName.isEmpty()) {
+        return;
+    }
+
+    QJsonArray plugins;
+
+    for (int i = 0; i < m_pluginEnumerations.size(); i++)
+    {
+        const PluginEnumeration& pluginEnumeration = m_pluginEnumerations[i];
+
+        if (!pluginEnumeration.m_valid || (pluginEnumeration.m_lastModified == 0)) {
+            continue;
+        }
+
+        if (mayFindNetworkDevices(pluginEnumeration.m_deviceId)) { // not tied to the USB topology: enumerated at each start
+            continue;
+        }
+
+        QJsonArray devices;
+
+        for (int j = 0; j < pluginEnumeration.m_samplingDevices.count(); j++) {
+            devices.append(samplingDeviceToJson(pluginEnumeration.m_samplingDevices[j]));
+        }
+
+        QJsonObject pluginObject;
+        pluginObject.insert("streamDirection", (int) pluginEnumeration.m_streamDirection);
+        pluginObject.insert("deviceId", pluginEnumeration.m_deviceId);
+        pluginObject.insert("lastModified", QString::number(pluginEnumeration.m_lastModified));
+        pluginObject.insert("size", QString::number(pluginEnumeration.m_size));
+        pluginObject.insert("usbTopology", pluginEnumeration.m_usbTopology);
+        pluginObject.insert("devices", devices);
+        plugins.append(pluginObject);
+    }
+
+    QJsonObject cacheObject;
+    cacheObject.insert("version", m_cacheVersion);
+    cacheObject.insert("applicationVersion", QCoreApplication::applicationVersion());
+    cacheObject.insert("plugins", plugins);
+
+    QDir().mkpath(QFileInfo(m_cacheFileName).absolutePath());
+    QFile cacheFile(m_cacheFileName);
+
+    if (cacheFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        cacheFile.write(QJsonDocument(cacheObject).toJson());
+    } else {
+        qWarning("DeviceEnumerator::saveCache: cannot write %s", qPrintable(m_cacheFileName));
+    }
+}
+
+bool DeviceEnumerator::isTopologyDependent(const PluginEnumeration& pluginEnumeration)
+{
+    if (pluginEnumeration.m_samplingDevices.size() == 0) { // hardware may be plugged in later
+        return true;
+    }
+
+    for (int i = 0; i < pluginEnumeration.m_samplingDevices.size(); i++)
+    {
+        if (pluginEnumeration.m_samplingDevices[i].type != PluginInterface::SamplingDevice::BuiltInDevice) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool DeviceEnumerator::mayFindNetworkDevices(const QString& deviceId)
+{
+    // PlutoSDR scan falls back to ip:pluto.local and SoapySDR may find remote devices
+    QString hardwareFamily = getHardwareFamily(deviceId);
+    return (hardwareFamily == "plutosdr") || (hardwareFamily == "soapysdr");
+}
+
+QString DeviceEnumerator::getHardwareFamily(const QString& deviceId)
+{
+    // e.g. sdrangel.samplesource.plutosdr and sdrangel.samplesink.plutosdr,
+    // sdrangel.samplesource.soapysdrinput and sdrangel.samplesink.soapysdroutput
+    QString hardwareFamily = deviceId.section('.', -1);
+    static const char *suffixes[] = {"input", "output", "source", "sink"};
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (hardwareFamily.endsWith(suffixes[i]) && (hardwareFamily.size() > (int) strlen(suffixes[i])))
+        {
+            hardwareFamily.chop(strlen(suffixes[i]));
+            break;
+        }
+    }
+
+    return hardwareFamily;
+}
+
+QString DeviceEnumerator::getUSBTopology()
+{
+#ifdef __linux__
+    QDir usbDevicesDir("/sys/bus/usb/devices");
+
+    if (!usbDevicesDir.exists()) {
+        return QString();
+    }
+
+    QStringList entries = usbDevicesDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    static const char *attributes[] = {"idVendor", "idProduct", "serial", "devnum"};
+
+    for (int i = 0; i < entries.size(); i++)
+    {
+        if (entries[i].contains(':')) { // interface of a device
+            continue;
+        }
+
+        hash.addData(entries[i].toLatin1());
+
+        for (int j = 0; j < 4; j++)
+        {
+            QFile attributeFile(usbDevicesDir.filePath(entries[i]) + "/" + attributes[j]);
+
+            if (attributeFile.open(QIODevice::ReadOnly)) {
+                hash.addData(attributeFile.readAll());
+            }
+
+            hash.addData("/", 1);
+        }
+    }
+
+    return QString(hash.result().toHex());
+#else
+    return QString(); // unknown: physical devices are always enumerated at startup
+#endif
+}
+
 void DeviceEnumerator::listRxDeviceNames(QList<QString>& list, std::vector<int>& indexes) const
 {
     for (DevicesEnumeration::const_iterator it = m_rxEnumeration.begin(); it != m_rxEnumeration.end(); ++it)
     {
-        if ((it->m_samplingDevice.claimed < 0) || (it->m_samplingDevice.type == PluginInterface::SamplingDevice::BuiltInDevice))
+        if (it->m_present && ((it->m_samplingDevice.claimed < 0) || (it->m_samplingDevice.type == PluginInterface::SamplingDevice::BuiltInDevice)))
         {
             list.append(it->m_samplingDevice.displayedName);
             indexes.push_back(it->m_index);
@@ -123,7 +627,7 @@ void DeviceEnumerator::listTxDeviceNames(QList<QString>& list, std::vector<int>&
 {
     for (DevicesEnumeration::const_iterator it = m_txEnumeration.begin(); it != m_txEnumeration.end(); ++it)
     {
-        if ((it->m_samplingDevice.claimed < 0) || (it->m_samplingDevice.type == PluginInterface::SamplingDevice::BuiltInDevice))
+        if (it->m_present && ((it->m_samplingDevice.claimed < 0) || (it->m_samplingDevice.type == PluginInterface::SamplingDevice::BuiltInDevice)))
         {
             list.append(it->m_samplingDevice.displayedName);
             indexes.push_back(it->m_index);
@@ -135,7 +639,7 @@ void DeviceEnumerator::listMIMODeviceNames(QList<QString>& list, std::vector<int
 {
     for (DevicesEnumeration::const_iterator it = m_mimoEnumeration.begin(); it != m_mimoEnumeration.end(); ++it)
     {
-        if ((it->m_samplingDevice.claimed < 0) || (it->m_samplingDevice.type == PluginInterface::SamplingDevice::BuiltInDevice))
+        if (it->m_present && ((it->m_samplingDevice.claimed < 0) || (it->m_samplingDevice.type == PluginInterface::SamplingDevice::BuiltInDevice)))
         {
             list.append(it->m_samplingDevice.displayedName);
             indexes.push_back(it->m_index);
@@ -248,11 +752,68 @@ int DeviceEnumerator::getTestMIMODeviceIndex() const
     return -1;
 }
 
+bool DeviceEnumerator::waitLateEnumeration(const QString& deviceId)
+{
+    // the device must not be opened while a timed out enumeration of its family may still open it
+    QString hardwareFamily = getHardwareFamily(deviceId);
+
+    for (int i = m_lateThreads.size() - 1; i >= 0; i--)
+    {
+        if (m_lateThreads[i]->getHardwareFamily() != hardwareFamily) {
+            continue;
+        }
+
+        if (!m_lateThreads[i]->wait(m_enumerationTimeout))
+        {
+            qWarning("DeviceEnumerator::waitLateEnumeration: %s: enumeration still running", qPrintable(deviceId));
+            return false;
+        }
+
+        delete m_lateThreads[i];
+        m_lateThreads.removeAt(i);
+    }
+
+    return true;
+}
+
+int DeviceEnumerator::getUsableRxDeviceIndex(int deviceIndex)
+{
+    if ((deviceIndex >= 0)
+        && PluginProxy::isAvailable(m_rxEnumeration[deviceIndex].m_pluginInterface)
+        && waitLateEnumeration(m_rxEnumeration[deviceIndex].m_samplingDevice.id)) {
+        return deviceIndex;
+    } else {
+        return getFileInputDeviceIndex();
+    }
+}
+
+int DeviceEnumerator::getUsableTxDeviceIndex(int deviceIndex)
+{
+    if ((deviceIndex >= 0)
+        && PluginProxy::isAvailable(m_txEnumeration[deviceIndex].m_pluginInterface)
+        && waitLateEnumeration(m_txEnumeration[deviceIndex].m_samplingDevice.id)) {
+        return deviceIndex;
+    } else {
+        return getFileSinkDeviceIndex();
+    }
+}
+
+int DeviceEnumerator::getUsableMIMODeviceIndex(int deviceIndex)
+{
+    if ((deviceIndex >= 0)
+        && PluginProxy::isAvailable(m_mimoEnumeration[deviceIndex].m_pluginInterface)
+        && waitLateEnumeration(m_mimoEnumeration[deviceIndex].m_samplingDevice.id)) {
+        return deviceIndex;
+    } else {
+        return getTestMIMODeviceIndex();
+    }
+}
+
 int DeviceEnumerator::getRxSamplingDeviceIndex(const QString& deviceId, int sequence)
 {
     for (DevicesEnumeration::iterator it = m_rxEnumeration.begin(); it != m_rxEnumeration.end(); ++it)
     {
-        if ((it->m_samplingDevice.id == deviceId) && (it->m_samplingDevice.sequence == sequence)) {
+        if (it->m_present && (it->m_samplingDevice.id == deviceId) && (it->m_samplingDevice.sequence == sequence)) {
             return it->m_index;
         }
     }
@@ -264,7 +825,7 @@ int DeviceEnumerator::getTxSamplingDeviceIndex(const QString& deviceId, int sequ
 {
     for (DevicesEnumeration::iterator it = m_txEnumeration.begin(); it != m_txEnumeration.end(); ++it)
     {
-        if ((it->m_samplingDevice.id == deviceId) && (it->m_samplingDevice.sequence == sequence)) {
+        if (it->m_present && (it->m_samplingDevice.id == deviceId) && (it->m_samplingDevice.sequence == sequence)) {
             return it->m_index;
         }
     }
@@ -276,7 +837,7 @@ int DeviceEnumerator::getMIMOSamplingDeviceIndex(const QString& deviceId, int se
 {
     for (DevicesEnumeration::iterator it = m_mimoEnumeration.begin(); it != m_mimoEnumeration.end(); ++it)
     {
-        if ((it->m_samplingDevice.id == deviceId) && (it->m_samplingDevice.sequence == sequence)) {
+        if (it->m_present && (it->m_samplingDevice.id == deviceId) && (it->m_samplingDevice.sequence == sequence)) {
             return it->m_index;
         }
     }
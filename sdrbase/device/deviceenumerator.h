@@ -20,11 +20,25 @@
 
 #include <vector>
 
+#include <QString>
+#include <QList>
+
 #include "plugin/plugininterface.h"
+#include "plugin/pluginapi.h"
 #include "export.h"
 
 class PluginManager;
+class DeviceEnumerationThread;
 
+/**
+ * Devices of all sampling device plugins. Plugins are enumerated in parallel with a timeout,
+ * plugins of the same hardware family (e.g. PlutoSDR input and output sharing a scan) serially.
+ * Results are cached on disk with the USB topology at enumeration time and reused while the
+ * plugin library and the USB topology are unchanged (built-in devices regardless of topology).
+ * Plugins that may find network devices are not cached.
+ * Rescans re-enumerate only the plugins whose devices may have changed. Device indexes are
+ * stable across rescans: a device gone is kept but no more listed, a new device is appended.
+ */
 class SDRBASE_API DeviceEnumerator
 {
 public:
@@ -33,9 +47,11 @@ public:
 
     static DeviceEnumerator *instance();
 
-    void enumerateRxDevices(PluginManager *pluginManager);
-    void enumerateTxDevices(PluginManager *pluginManager);
-    void enumerateMIMODevices(PluginManager *pluginManager);
+    void enumerateDevices(PluginManager *pluginManager, const QString& cacheFileName); //!< enumerate all plugins using the cache when valid
+    void rescanDevices(); //!< re-enumerate plugins of a changed USB topology and timed out plugins
+    void removePluginDevices(PluginInterface *plugin); //!< devices of a plugin that cannot be loaded are no more listed
+    void setEnumerationTimeout(int timeoutMs) { m_enumerationTimeout = timeoutMs; }
+    int getEnumerationTimeout() const { return m_enumerationTimeout; }
     void listRxDeviceNames(QList<QString>& list, std::vector<int>& indexes) const;
     void listTxDeviceNames(QList<QString>& list, std::vector<int>& indexes) const;
     void listMIMODeviceNames(QList<QString>& list, std::vector<int>& indexes) const;
@@ -51,35 +67,90 @@ public:
     const PluginInterface::SamplingDevice* getRxSamplingDevice(int deviceIndex) const { return &m_rxEnumeration[deviceIndex].m_samplingDevice; }
     const PluginInterface::SamplingDevice* getTxSamplingDevice(int deviceIndex) const { return &m_txEnumeration[deviceIndex].m_samplingDevice; }
     const PluginInterface::SamplingDevice* getMIMOSamplingDevice(int deviceIndex) const { return &m_mimoEnumeration[deviceIndex].m_samplingDevice; }
+    bool isRxSamplingDevicePresent(int deviceIndex) const { return m_rxEnumeration[deviceIndex].m_present; }   //!< false if gone since its enumeration
+    bool isTxSamplingDevicePresent(int deviceIndex) const { return m_txEnumeration[deviceIndex].m_present; }   //!< false if gone since its enumeration
+    bool isMIMOSamplingDevicePresent(int deviceIndex) const { return m_mimoEnumeration[deviceIndex].m_present; } //!< false if gone since its enumeration
     PluginInterface *getRxPluginInterface(int deviceIndex) { return m_rxEnumeration[deviceIndex].m_pluginInterface; }
     PluginInterface *getTxPluginInterface(int deviceIndex) { return m_txEnumeration[deviceIndex].m_pluginInterface; }
     PluginInterface *getMIMOPluginInterface(int deviceIndex) { return m_mimoEnumeration[deviceIndex].m_pluginInterface; }
     int getFileInputDeviceIndex() const;  //!< Get Rx default device
     int getFileSinkDeviceIndex() const;   //!< Get Tx default device
     int getTestMIMODeviceIndex() const;   //!< Get MIMO default device
+    int getUsableRxDeviceIndex(int deviceIndex);   //!< deviceIndex if it can be opened else the Rx default device
+    int getUsableTxDeviceIndex(int deviceIndex);   //!< deviceIndex if it can be opened else the Tx default device
+    int getUsableMIMODeviceIndex(int deviceIndex); //!< deviceIndex if it can be opened else the MIMO default device
     int getRxSamplingDeviceIndex(const QString& deviceId, int sequence);
     int getTxSamplingDeviceIndex(const QString& deviceId, int sequence);
     int getMIMOSamplingDeviceIndex(const QString& deviceId, int sequence);
 
 private:
+    enum StreamDirection
+    {
+        StreamRx,
+        StreamTx,
+        StreamMIMO
+    };
+
     struct DeviceEnumeration
     {
         PluginInterface::SamplingDevice m_samplingDevice;
         PluginInterface *m_pluginInterface;
         int m_index;
+        bool m_present; //!< false if the device was not found by the last enumeration of its plugin
 
         DeviceEnumeration(const PluginInterface::SamplingDevice& samplingDevice, PluginInterface *pluginInterface, int index) :
             m_samplingDevice(samplingDevice),
             m_pluginInterface(pluginInterface),
-            m_index(index)
+            m_index(index),
+            m_present(true)
         {}
     };
 
     typedef std::vector<DeviceEnumeration> DevicesEnumeration;
 
+    struct PluginEnumeration //!< devices of a sampling device plugin registration
+    {
+        StreamDirection m_streamDirection;
+        QString m_deviceId;
+        PluginInterface *m_plugin;
+        PluginInterface::SamplingDevices m_samplingDevices;
+        QString m_usbTopology;   //!< USB topology when the devices were enumerated
+        qint64 m_lastModified;   //!< plugin library modification time (0 if unknown: not cached)
+        qint64 m_size;           //!< plugin library size
+        bool m_valid;            //!< devices enumerated at this run or taken from a valid cache entry
+
+        PluginEnumeration(StreamDirection streamDirection, const QString& deviceId, PluginInterface *plugin) :
+            m_streamDirection(streamDirection),
+            m_deviceId(deviceId),
+            m_plugin(plugin),
+            m_lastModified(0),
+            m_size(0),
+            m_valid(false)
+        {}
+    };
+
     DevicesEnumeration m_rxEnumeration;
     DevicesEnumeration m_txEnumeration;
     DevicesEnumeration m_mimoEnumeration;
+    QList<PluginEnumeration> m_pluginEnumerations;
+    PluginManager *m_pluginManager;
+    QString m_cacheFileName;
+    QString m_usbTopology;       //!< USB topology at the last enumeration. Empty if unknown.
+    int m_enumerationTimeout;    //!< maximum time to wait for all plugins in ms
+    QList<DeviceEnumerationThread*> m_lateThreads; //!< timed out enumerations still running
+    static const int m_cacheVersion;
+
+    void addPluginEnumerations(StreamDirection streamDirection, const PluginAPI::SamplingDeviceRegistrations& registrations);
+    void enumeratePlugins(const QList<int>& pluginIndexes);
+    void updateDevicesEnumeration(StreamDirection streamDirection, DevicesEnumeration& devicesEnumeration);
+    bool isHardwareFamilyInUse(const QString& hardwareFamily) const;
+    bool waitLateEnumeration(const QString& deviceId); //!< false if an enumeration of the device family is still running
+    void loadCache();
+    void saveCache();
+    static bool isTopologyDependent(const PluginEnumeration& pluginEnumeration);
+    static bool mayFindNetworkDevices(const QString& deviceId);
+    static QString getHardwareFamily(const QString& deviceId);
+    static QString getUSBTopology();
 };
 
 #endif /* SDRBASE_DEVICE_DEVICEENUMERATOR_H_ */
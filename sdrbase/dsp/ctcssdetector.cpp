@@ -5,6 +5,15 @@
  *      Author: f4exb
  */
 #include <math.h>
+
+#if defined(USE_AVX2)
+#include <immintrin.h>
+#elif defined(USE_SSE2)
+#include <emmintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "dsp/ctcssdetector.h"
 
 #undef M_PI
@@ -19,12 +28,7 @@ CTCSSDetector::CTCSSDetector() :
 			maxPower(0.0)
 {
 	nTones = 32;
-	k = new Real[nTones];
-	coef = new Real[nTones];
-	toneSet = new Real[nTones];
-	u0 = new Real[nTones];
-	u1 = new Real[nTones];
-	power = new Real[nTones];
+	allocate();
 
 	// The 32 EIA standard tones
 	toneSet[0]  = 67.0;
@@ -70,12 +74,7 @@ CTCSSDetector::CTCSSDetector(int _nTones, Real *tones) :
 			maxPower(0.0)
 {
 	nTones = _nTones;
-	k = new Real[nTones];
-	coef = new Real[nTones];
-	toneSet = new Real[nTones];
-	u0 = new Real[nTones];
-	u1 = new Real[nTones];
-	power = new Real[nTones];
+	allocate();
 
 	for (int j = 0; j < nTones; ++j)
 	{
@@ -84,6 +83,22 @@ CTCSSDetector::CTCSSDetector(int _nTones, Real *tones) :
 }
 
 
+void CTCSSDetector::allocate()
+{
+	nTonesPadded = (nTones + 3) & ~3;
+	k = new Real[nTones];
+	coef = new Real[nTonesPadded];
+	toneSet = new Real[nTones];
+	u0 = new Real[nTonesPadded];
+	u1 = new Real[nTonesPadded];
+	power = new Real[nTones];
+	blockFill = 0;
+
+	for (int j = 0; j < nTonesPadded; ++j) {
+		coef[j] = u0[j] = u1[j] = 0.0;
+	}
+}
+
 CTCSSDetector::~CTCSSDetector()
 {
 	delete[] k;
@@ -118,34 +133,155 @@ void CTCSSDetector::setCoefficients(int zN, int _samplerate )
 // Analyze an input signal for the presence of CTCSS tones.
 bool CTCSSDetector::analyze(Real *sample)
 {
-
-	feedback(*sample); // Goertzel feedback
+	block[blockFill++] = *sample;
 	samplesProcessed += 1;
 
 	if (samplesProcessed == N) // completed a block of N
 	{
+		feedback(); // Goertzel feedback
 		feedForward(); // calculate the power at each tone
 		samplesProcessed = 0;
 		return true; // have a result
 	}
 	else
 	{
+		if (blockFill == blockSize) {
+			feedback();
+		}
+
 		return false;
 	}
 }
 
 
-void CTCSSDetector::feedback(Real in)
+void CTCSSDetector::feedback()
 {
-	Real t;
+	int j = 0;
 
-	// feedback for each tone
-	for (int j = 0; j < nTones; ++j)
+	// u0 = in + coef*u0 - u1 is computed as (in - u1) + coef*u0 to keep the
+	// dependency chain on u0 short. Several vectors are processed at a time so
+	// that the recurrences of independent tones interleave.
+#if defined(USE_AVX2)
+	for (; j + 32 <= nTonesPadded; j += 32)
+	{
+		__m256 c0 = _mm256_loadu_ps(&coef[j]),    c1 = _mm256_loadu_ps(&coef[j+8]);
+		__m256 c2 = _mm256_loadu_ps(&coef[j+16]), c3 = _mm256_loadu_ps(&coef[j+24]);
+		__m256 a0 = _mm256_loadu_ps(&u0[j]),      a1 = _mm256_loadu_ps(&u0[j+8]);
+		__m256 a2 = _mm256_loadu_ps(&u0[j+16]),   a3 = _mm256_loadu_ps(&u0[j+24]);
+		__m256 b0 = _mm256_loadu_ps(&u1[j]),      b1 = _mm256_loadu_ps(&u1[j+8]);
+		__m256 b2 = _mm256_loadu_ps(&u1[j+16]),   b3 = _mm256_loadu_ps(&u1[j+24]);
+
+		for (int i = 0; i < blockFill; i++)
+		{
+			__m256 in = _mm256_set1_ps(block[i]);
+			__m256 t0 = a0, t1 = a1, t2 = a2, t3 = a3;
+			a0 = _mm256_add_ps(_mm256_sub_ps(in, b0), _mm256_mul_ps(c0, a0));
+			a1 = _mm256_add_ps(_mm256_sub_ps(in, b1), _mm256_mul_ps(c1, a1));
+			a2 = _mm256_add_ps(_mm256_sub_ps(in, b2), _mm256_mul_ps(c2, a2));
+			a3 = _mm256_add_ps(_mm256_sub_ps(in, b3), _mm256_mul_ps(c3, a3));
+			b0 = t0; b1 = t1; b2 = t2; b3 = t3;
+		}
+
+		_mm256_storeu_ps(&u0[j], a0);     _mm256_storeu_ps(&u0[j+8], a1);
+		_mm256_storeu_ps(&u0[j+16], a2);  _mm256_storeu_ps(&u0[j+24], a3);
+		_mm256_storeu_ps(&u1[j], b0);     _mm256_storeu_ps(&u1[j+8], b1);
+		_mm256_storeu_ps(&u1[j+16], b2);  _mm256_storeu_ps(&u1[j+24], b3);
+	}
+
+	for (; j + 8 <= nTonesPadded; j += 8)
+	{
+		__m256 c = _mm256_loadu_ps(&coef[j]);
+		__m256 a = _mm256_loadu_ps(&u0[j]);
+		__m256 b = _mm256_loadu_ps(&u1[j]);
+
+		for (int i = 0; i < blockFill; i++)
+		{
+			__m256 t = a;
+			a = _mm256_add_ps(_mm256_sub_ps(_mm256_set1_ps(block[i]), b), _mm256_mul_ps(c, a));
+			b = t;
+		}
+
+		_mm256_storeu_ps(&u0[j], a);
+		_mm256_storeu_ps(&u1[j], b);
+	}
+#endif
+#if defined(USE_SSE2)
+	for (; j + 16 <= nTonesPadded; j += 16)
 	{
-		t = u0[j];
-		u0[j] = in + (coef[j] * u0[j]) - u1[j];
-		u1[j] = t;
+		__m128 c0 = _mm_loadu_ps(&coef[j]),    c1 = _mm_loadu_ps(&coef[j+4]);
+		__m128 c2 = _mm_loadu_ps(&coef[j+8]),  c3 = _mm_loadu_ps(&coef[j+12]);
+		__m128 a0 = _mm_loadu_ps(&u0[j]),      a1 = _mm_loadu_ps(&u0[j+4]);
+		__m128 a2 = _mm_loadu_ps(&u0[j+8]),    a3 = _mm_loadu_ps(&u0[j+12]);
+		__m128 b0 = _mm_loadu_ps(&u1[j]),      b1 = _mm_loadu_ps(&u1[j+4]);
+		__m128 b2 = _mm_loadu_ps(&u1[j+8]),    b3 = _mm_loadu_ps(&u1[j+12]);
+
+		for (int i = 0; i < blockFill; i++)
+		{
+			__m128 in = _mm_set1_ps(block[i]);
+			__m128 t0 = a0, t1 = a1, t2 = a2, t3 = a3;
+			a0 = _mm_add_ps(_mm_sub_ps(in, b0), _mm_mul_ps(c0, a0));
+			a1 = _mm_add_ps(_mm_sub_ps(in, b1), _mm_mul_ps(c1, a1));
+			a2 = _mm_add_ps(_mm_sub_ps(in, b2), _mm_mul_ps(c2, a2));
+			a3 = _mm_add_ps(_mm_sub_ps(in, b3), _mm_mul_ps(c3, a3));
+			b0 = t0; b1 = t1; b2 = t2; b3 = t3;
+		}
+
+		_mm_storeu_ps(&u0[j], a0);    _mm_storeu_ps(&u0[j+4], a1);
+		_mm_storeu_ps(&u0[j+8], a2);  _mm_storeu_ps(&u0[j+12], a3);
+		_mm_storeu_ps(&u1[j], b0);    _mm_storeu_ps(&u1[j+4], b1);
+		_mm_storeu_ps(&u1[j+8], b2);  _mm_storeu_ps(&u1[j+12], b3);
+	}
+
+	for (; j < nTonesPadded; j += 4)
+	{
+		__m128 c = _mm_loadu_ps(&coef[j]);
+		__m128 a = _mm_loadu_ps(&u0[j]);
+		__m128 b = _mm_loadu_ps(&u1[j]);
+
+		for (int i = 0; i < blockFill; i++)
+		{
+			__m128 t = a;
+			a = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(block[i]), b), _mm_mul_ps(c, a));
+			b = t;
+		}
+
+		_mm_storeu_ps(&u0[j], a);
+		_mm_storeu_ps(&u1[j], b);
 	}
+#elif defined(USE_NEON)
+	for (; j < nTonesPadded; j += 4)
+	{
+		float32x4_t c = vld1q_f32(&coef[j]);
+		float32x4_t a = vld1q_f32(&u0[j]);
+		float32x4_t b = vld1q_f32(&u1[j]);
+
+		for (int i = 0; i < blockFill; i++)
+		{
+			float32x4_t t = a;
+			a = vmlaq_f32(vsubq_f32(vdupq_n_f32(block[i]), b), c, a);
+			b = t;
+		}
+
+		vst1q_f32(&u0[j], a);
+		vst1q_f32(&u1[j], b);
+	}
+#endif
+
+	// no SIMD: sample by sample with all the tones in the inner loop
+	if (j < nTones)
+	{
+		for (int i = 0; i < blockFill; i++)
+		{
+			for (int jj = j; jj < nTones; ++jj)
+			{
+				Real t = u0[jj];
+				u0[jj] = block[i] + (coef[jj] * u0[jj]) - u1[jj];
+				u1[jj] = t;
+			}
+		}
+	}
+
+	blockFill = 0;
 }
 
 
@@ -159,6 +295,10 @@ void CTCSSDetector::feedForward()
 		u0[j] = u1[j] = 0.0; // reset for next block.
 	}
 
+	for (int j = nTones; j < nTonesPadded; ++j) {
+		u0[j] = u1[j] = 0.0; // padding
+	}
+
 	evaluatePower();
 }
 
@@ -171,6 +311,7 @@ void CTCSSDetector::reset()
 	}
 
 	samplesProcessed = 0;
+	blockFill = 0;
 	maxPower = 0.0;
 	maxPowerIndex = 0;
 	toneDetected = false;
@@ -15,6 +15,9 @@
 /** CTCSSDetector: Continuous Tone Coded Squelch System
  * tone detector class based on the Modified Goertzel
  * algorithm.
+ *
+ * Samples are buffered and the Goertzel feedback is run for all the tones
+ * over each buffered block at once (4 tones per SIMD vector when available).
  */
 class SDRBASE_API CTCSSDetector {
 public:
@@ -66,13 +69,18 @@ protected:
     // Override these to change behavior of the detector
     virtual void initializePower();
     virtual void evaluatePower();
-    void feedback(Real sample);
+    void feedback();     // run the Goertzel feedback over the buffered samples
     void feedForward();
 
 private:
+    static const int blockSize = 64; // maximum number of buffered samples
+
+    void allocate();
+
     int N;
     int sampleRate;
     int nTones;
+    int nTonesPadded;    // multiple of the SIMD vector size. Extra tones have null coefficients.
     int samplesProcessed;
     int maxPowerIndex;
     bool toneDetected;
@@ -83,6 +91,8 @@ private:
     Real *u0;
     Real *u1;
     Real *power;
+    Real block[blockSize];
+    int blockFill;
 };
 
 
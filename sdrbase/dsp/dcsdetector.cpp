@@ -0,0 +1,160 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "dsp/dcsdetector.h"
+
+const Real DCSDetector::m_bitRate = 134.4f;
+
+const unsigned int DCSDetector::m_codes[DCSDetector::m_nbCodes] = {
+    0023, 0025, 0026, 0031, 0032, 0036, 0043, 0047, 0051, 0053, 0054, 0065, 0071, 0072, 0073, 0074,
+    0114, 0115, 0116, 0122, 0125, 0131, 0132, 0134, 0143, 0145, 0152, 0155, 0156, 0162, 0165, 0172,
+    0174, 0205, 0212, 0223, 0225, 0226, 0243, 0244, 0245, 0246, 0251, 0252, 0255, 0261, 0263, 0265,
+    0266, 0271, 0274, 0306, 0311, 0315, 0325, 0331, 0332, 0343, 0346, 0351, 0356, 0364, 0365, 0371,
+    0411, 0412, 0413, 0423, 0431, 0432, 0445, 0446, 0452, 0454, 0455, 0462, 0464, 0465, 0466, 0503,
+    0506, 0516, 0523, 0526, 0532, 0546, 0565, 0606, 0612, 0624, 0627, 0631, 0632, 0654, 0662, 0664,
+    0703, 0712, 0723, 0731, 0732, 0734, 0743, 0754
+};
+
+DCSDetector::DCSDetector()
+{
+    for (int i = 0; i < m_nbCodes; i++)
+    {
+        uint32_t word = getCodeWord(m_codes[i]);
+        m_words[word] = 2*i;
+        m_words[word ^ 0x7FFFFF] = 2*i + 1;
+    }
+
+    setSampleRate(6000);
+}
+
+DCSDetector::~DCSDetector()
+{}
+
+uint32_t DCSDetector::getCodeWord(unsigned int code)
+{
+    // 12 data bits: code and 100 marker. Parity from the Golay (23,12) generator polynomial.
+    uint32_t data = (code & 0x1FF) | 0x800;
+    uint32_t parity = data;
+
+    for (int i = 0; i < 12; i++)
+    {
+        parity <<= 1;
+
+        if (parity & 0x1000) {
+            parity ^= 0x08EA;
+        }
+    }
+
+    return data | ((parity & 0x0FFE) << 11);
+}
+
+void DCSDetector::setSampleRate(int sampleRate)
+{
+    m_sampleRate = sampleRate;
+    m_bitStep = m_bitRate / sampleRate;
+    m_dcAlpha = 1.0f / sampleRate; // about 1s time constant: over many words
+    reset();
+}
+
+void DCSDetector::reset()
+{
+    m_bitPhase = 0.0f;
+    m_dcLevel = 0.0f;
+    m_level = false;
+    m_word = 0;
+    m_bitCount = 0;
+    m_detectedIndex = -1;
+    m_detectedLastSeen = 0;
+
+    for (int i = 0; i < 2*m_nbCodes; i++) {
+        m_lastSeen[i] = -m_wordBits;
+    }
+}
+
+bool DCSDetector::analyze(Real sample)
+{
+    m_dcLevel += (sample - m_dcLevel) * m_dcAlpha;
+    bool level = sample > m_dcLevel;
+
+    if (level != m_level)
+    {
+        // transitions are expected on bit boundaries (phase 0): pull the bit clock towards them
+        Real error = m_bitPhase < 0.5f ? m_bitPhase : m_bitPhase - 1.0f;
+        m_bitPhase -= 0.25f * error;
+        m_level = level;
+    }
+
+    Real previousPhase = m_bitPhase;
+    m_bitPhase += m_bitStep;
+
+    if (m_bitPhase >= 1.0f) {
+        m_bitPhase -= 1.0f;
+    } else if (m_bitPhase < 0.0f) {
+        m_bitPhase += 1.0f;
+    }
+
+    if ((previousPhase < 0.5f) && (m_bitPhase >= 0.5f)) // middle of the bit
+    {
+        int detectedIndex = m_detectedIndex;
+        processBit(level);
+        return detectedIndex != m_detectedIndex;
+    }
+
+    return false;
+}
+
+void DCSDetector::processBit(bool bit)
+{
+    m_word = (m_word >> 1) | (bit ? (1 << (m_wordBits - 1)) : 0);
+    m_bitCount++;
+
+    std::map<uint32_t, int>::const_iterator it = m_words.find(m_word);
+
+    if (it != m_words.end())
+    {
+        int index = it->second;
+
+        // some rotations of a codeword are other codewords (equivalent codes e.g. 023N and 047I)
+        // and repeat as well. Report the one with the smallest priority value.
+        if (m_lastSeen[index] == m_bitCount - m_wordBits)
+        {
+            if ((m_detectedIndex < 0) || (index == m_detectedIndex) || (m_bitCount - m_detectedLastSeen > m_wordBits)
+                || (priority(index) < priority(m_detectedIndex)))
+            {
+                m_detectedIndex = index;
+                m_detectedLastSeen = m_bitCount;
+            }
+        }
+
+        m_lastSeen[index] = m_bitCount;
+    }
+
+    if ((m_detectedIndex >= 0) && (m_bitCount - m_detectedLastSeen > 3*m_wordBits)) {
+        m_detectedIndex = -1;
+    }
+
+    if (m_bitCount > (1<<30)) // keep counts away from overflow
+    {
+        for (int i = 0; i < 2*m_nbCodes; i++) {
+            m_lastSeen[i] -= (1<<29);
+        }
+
+        m_bitCount -= (1<<29);
+        m_detectedLastSeen -= (1<<29);
+    }
+}
@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_DCSDETECTOR_H_
+#define SDRBASE_DSP_DCSDETECTOR_H_
+
+#include <stdint.h>
+#include <map>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * DCS: Digital Coded Squelch detector.
+ *
+ * DCS is a 134.4 bit/s NRZ stream repeating a 23 bit Golay (23,12) codeword made of the
+ * 9 bit code (3 octal digits), the 100 marker and 11 parity bits, sent LSB first.
+ * The input is the low passed (below 300 Hz) discriminator output. Bits are sliced around
+ * a slow DC average with a zero crossing locked bit clock. The last 23 bits are looked up
+ * in the table of the standard codes in both polarities at each bit. A code is detected
+ * when it is seen again exactly one word later and lost after 3 words without it.
+ * Codes whose codewords are rotations of each other cannot be told apart: normal polarity
+ * and then the lowest code is reported.
+ */
+class SDRBASE_API DCSDetector
+{
+public:
+    DCSDetector();
+    ~DCSDetector();
+
+    void setSampleRate(int sampleRate);
+    void reset();
+    bool analyze(Real sample); //!< Returns true when the detected code has changed
+
+    /** Detected code as an integer whose octal representation is the code (e.g. 023) */
+    bool getDetectedCode(unsigned int& code, bool& inverted) const
+    {
+        if (m_detectedIndex < 0) {
+            return false;
+        }
+
+        code = m_codes[m_detectedIndex / 2];
+        inverted = (m_detectedIndex % 2) == 1;
+        return true;
+    }
+
+    static uint32_t getCodeWord(unsigned int code); //!< 23 bit codeword of a code (normal polarity)
+
+    static const int m_nbCodes = 104;
+    static const unsigned int m_codes[m_nbCodes]; //!< standard codes
+
+private:
+    static const int m_wordBits = 23;
+    static const Real m_bitRate;
+
+    void processBit(bool bit);
+    static int priority(int index) { return (index % 2) * m_nbCodes + index / 2; } //!< normal polarity first then code order
+
+    std::map<uint32_t, int> m_words; //!< codeword to index (code index * 2 + inverted)
+    int m_lastSeen[2*m_nbCodes];     //!< bit count when the codeword was last seen
+    int m_sampleRate;
+    Real m_bitStep;                  //!< bit clock phase increment per sample
+    Real m_bitPhase;
+    Real m_dcLevel;
+    Real m_dcAlpha;
+    bool m_level;
+    uint32_t m_word;
+    int m_bitCount;
+    int m_detectedIndex;             //!< -1 if none
+    int m_detectedLastSeen;
+};
+
+#endif // SDRBASE_DSP_DCSDETECTOR_H_
@@ -25,9 +25,11 @@
 #include <QDebug>
 
 MESSAGE_CLASS_DEFINITION(DownChannelizer::MsgChannelizerNotification, Message)
+MESSAGE_CLASS_POOL_DEFINITION(DownChannelizer::MsgChannelizerNotification)
 MESSAGE_CLASS_DEFINITION(DownChannelizer::MsgSetChannelizer, Message)
 
 DownChannelizer::DownChannelizer(BasebandSampleSink* sampleSink) :
+    m_chainKernel(nullptr),
     m_filterChainSetMode(false),
 	m_sampleSink(sampleSink),
 	m_inputSampleRate(0),
@@ -71,34 +73,7 @@ void DownChannelizer::feed(const SampleVector::const_iterator& begin, const Samp
 	else
 	{
 		m_mutex.lock();
-
-		for(SampleVector::const_iterator sample = begin; sample != end; ++sample)
-		{
-			Sample s(*sample);
-			FilterStages::iterator stage = m_filterStages.begin();
-
-			for (; stage != m_filterStages.end(); ++stage)
-			{
-#ifndef SDR_RX_SAMPLE_24BIT
-                s.m_real /= 2; // avoid saturation on 16 bit samples
-                s.m_imag /= 2;
-#endif
-				if(!(*stage)->work(&s))
-				{
-					break;
-				}
-			}
-
-			if(stage == m_filterStages.end())
-			{
-#ifdef SDR_RX_SAMPLE_24BIT
-			    s.m_real /= (1<<(m_filterStages.size())); // on 32 bit samples there is enough headroom to just divide the final result
-			    s.m_imag /= (1<<(m_filterStages.size()));
-#endif
-				m_sampleBuffer.push_back(s);
-			}
-		}
-
+		m_chainKernel(m_stageVector.data(), m_stageVector.size(), begin, end, m_sampleBuffer);
 		m_mutex.unlock();
 
 		m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), positiveOnly);
@@ -198,6 +173,7 @@ void DownChannelizer::applyConfiguration()
 	m_currentCenterFrequency = createFilterChain(
 		m_inputSampleRate / -2, m_inputSampleRate / 2,
 		m_requestedCenterFrequency - m_requestedOutputSampleRate / 2, m_requestedCenterFrequency + m_requestedOutputSampleRate / 2);
+	selectChainKernel();
 
 	m_mutex.unlock();
 
@@ -227,6 +203,7 @@ void DownChannelizer::applySetting(unsigned int log2Decim, unsigned int filterCh
     m_mutex.lock();
     freeFilterChain();
     setFilterChain(stageIndexes);
+    selectChainKernel();
     m_mutex.unlock();
 
     m_currentOutputSampleRate = m_inputSampleRate / (1 << m_filterStages.size());
@@ -245,49 +222,26 @@ void DownChannelizer::applySetting(unsigned int log2Decim, unsigned int filterCh
 	}
 }
 
-#ifdef SDR_RX_SAMPLE_24BIT
 DownChannelizer::FilterStage::FilterStage(Mode mode) :
-    m_filter(new IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>),
+    m_filter(new HBFilter),
     m_workFunction(0),
     m_mode(mode),
     m_sse(true)
 {
     switch(mode) {
         case ModeCenter:
-            m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateCenter;
+            m_workFunction = &HBFilter::workDecimateCenter;
             break;
 
         case ModeLowerHalf:
-            m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateLowerHalf;
+            m_workFunction = &HBFilter::workDecimateLowerHalf;
             break;
 
         case ModeUpperHalf:
-            m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateUpperHalf;
+            m_workFunction = &HBFilter::workDecimateUpperHalf;
             break;
     }
 }
-#else
-DownChannelizer::FilterStage::FilterStage(Mode mode) :
-    m_filter(new IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>),
-    m_workFunction(0),
-    m_mode(mode),
-    m_sse(true)
-{
-    switch(mode) {
-        case ModeCenter:
-            m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateCenter;
-            break;
-
-        case ModeLowerHalf:
-            m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateLowerHalf;
-            break;
-
-        case ModeUpperHalf:
-            m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateUpperHalf;
-            break;
-    }
-}
-#endif
 
 DownChannelizer::FilterStage::~FilterStage()
 {
@@ -365,6 +319,117 @@ void DownChannelizer::freeFilterChain()
 	for(FilterStages::iterator it = m_filterStages.begin(); it != m_filterStages.end(); ++it)
 		delete *it;
 	m_filterStages.clear();
+	m_stageVector.clear();
+	m_chainKernel = nullptr;
+}
+
+template<>
+struct DownChannelizer::ChainKernelStages<>
+{
+    static inline bool work(FilterStage* const*, Sample*) {
+        return true;
+    }
+};
+
+template<int Mode, int... Modes>
+struct DownChannelizer::ChainKernelStages<Mode, Modes...>
+{
+    static inline bool work(FilterStage* const* stages, Sample* s)
+    {
+#ifndef SDR_RX_SAMPLE_24BIT
+        s->m_real /= 2; // avoid saturation on 16 bit samples
+        s->m_imag /= 2;
+#endif
+        // Mode is a constant so only one branch is compiled in
+        bool done;
+
+        if (Mode == FilterStage::ModeCenter) {
+            done = stages[0]->m_filter->workDecimateCenter(s);
+        } else if (Mode == FilterStage::ModeLowerHalf) {
+            done = stages[0]->m_filter->workDecimateLowerHalf(s);
+        } else {
+            done = stages[0]->m_filter->workDecimateUpperHalf(s);
+        }
+
+        return done && ChainKernelStages<Modes...>::work(stages + 1, s);
+    }
+};
+
+template<int... Modes>
+void DownChannelizer::runChainKernel(FilterStage* const* stages, unsigned int nbStages,
+    const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, SampleVector& out)
+{
+    const unsigned int nbSpecializedStages = sizeof...(Modes);
+#ifdef SDR_RX_SAMPLE_24BIT
+    const int divisor = 1 << nbStages;
+#endif
+
+    for (SampleVector::const_iterator sample = begin; sample != end; ++sample)
+    {
+        Sample s(*sample);
+
+        if (!ChainKernelStages<Modes...>::work(stages, &s)) {
+            continue;
+        }
+
+        unsigned int i = nbSpecializedStages;
+
+        for (; i < nbStages; i++) // generic tail
+        {
+#ifndef SDR_RX_SAMPLE_24BIT
+            s.m_real /= 2; // avoid saturation on 16 bit samples
+            s.m_imag /= 2;
+#endif
+            if (!stages[i]->work(&s)) {
+                break;
+            }
+        }
+
+        if (i == nbStages)
+        {
+#ifdef SDR_RX_SAMPLE_24BIT
+            s.m_real /= divisor; // on 32 bit samples there is enough headroom to just divide the final result
+            s.m_imag /= divisor;
+#endif
+            out.push_back(s);
+        }
+    }
+}
+
+template<int... Modes>
+struct DownChannelizer::ChainKernelSelector<0, Modes...>
+{
+    static ChainKernel get(FilterStage* const*, unsigned int) {
+        return &DownChannelizer::runChainKernel<Modes...>;
+    }
+};
+
+template<unsigned int Depth, int... Modes>
+struct DownChannelizer::ChainKernelSelector
+{
+    static ChainKernel get(FilterStage* const* stages, unsigned int nbStages)
+    {
+        if (nbStages == 0) {
+            return &DownChannelizer::runChainKernel<Modes...>;
+        }
+
+        switch (stages[0]->m_mode)
+        {
+        case FilterStage::ModeCenter:
+            return ChainKernelSelector<Depth-1, Modes..., FilterStage::ModeCenter>::get(stages + 1, nbStages - 1);
+        case FilterStage::ModeLowerHalf:
+            return ChainKernelSelector<Depth-1, Modes..., FilterStage::ModeLowerHalf>::get(stages + 1, nbStages - 1);
+        case FilterStage::ModeUpperHalf:
+        default:
+            return ChainKernelSelector<Depth-1, Modes..., FilterStage::ModeUpperHalf>::get(stages + 1, nbStages - 1);
+        }
+    }
+};
+
+void DownChannelizer::selectChainKernel()
+{
+    m_stageVector.assign(m_filterStages.begin(), m_filterStages.end());
+    m_chainKernel = ChainKernelSelector<DOWNCHANNELIZER_MAX_SPECIALIZED_STAGES>::get(m_stageVector.data(), m_stageVector.size());
 }
 
 void DownChannelizer::debugFilterChain()
@@ -28,6 +28,7 @@
 #include "dsp/inthalfbandfiltereo.h"
 
 #define DOWNCHANNELIZER_HB_FILTER_ORDER 48
+#define DOWNCHANNELIZER_MAX_SPECIALIZED_STAGES 6
 
 class MessageQueue;
 
@@ -36,6 +37,7 @@ class SDRBASE_API DownChannelizer : public BasebandSampleSink {
 public:
     class SDRBASE_API MsgChannelizerNotification : public Message {
 		MESSAGE_CLASS_DECLARATION
+		MESSAGE_CLASS_POOL_DECLARATION
 
 	public:
 		MsgChannelizerNotification(int samplerate, qint64 frequencyOffset) :
@@ -89,6 +91,12 @@ public:
 	virtual bool handleMessage(const Message& cmd);
 
 protected:
+#ifdef SDR_RX_SAMPLE_24BIT
+    typedef IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER> HBFilter;
+#else
+    typedef IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER> HBFilter;
+#endif
+
 	struct FilterStage {
 		enum Mode {
 			ModeCenter,
@@ -96,14 +104,8 @@ protected:
 			ModeUpperHalf
 		};
 
-#ifdef SDR_RX_SAMPLE_24BIT
-        typedef bool (IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::*WorkFunction)(Sample* s);
-        IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>* m_filter;
-#else
-        typedef bool (IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::*WorkFunction)(Sample* s);
-        IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>* m_filter;
-#endif
-
+        typedef bool (HBFilter::*WorkFunction)(Sample* s);
+        HBFilter* m_filter;
 		WorkFunction m_workFunction;
 		Mode m_mode;
 		bool m_sse;
@@ -118,6 +120,21 @@ protected:
 	};
 	typedef std::list<FilterStage*> FilterStages;
 	FilterStages m_filterStages;
+
+    /**
+     * Filter chain kernel. Runs the whole chain on a block of samples and appends the decimated samples to the output.
+     * Specialized kernels have the mode of the first stages as template parameters and are fully inlined. Stages
+     * beyond DOWNCHANNELIZER_MAX_SPECIALIZED_STAGES run at a low rate and go through the generic work function.
+     */
+    typedef void (*ChainKernel)(FilterStage* const* stages, unsigned int nbStages,
+        const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, SampleVector& out);
+    template<int... Modes> struct ChainKernelStages;
+    template<unsigned int Depth, int... Modes> struct ChainKernelSelector;
+    template<int... Modes> static void runChainKernel(FilterStage* const* stages, unsigned int nbStages,
+        const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, SampleVector& out);
+    ChainKernel m_chainKernel;                //!< Kernel selected at filter chain (re)configuration
+    std::vector<FilterStage*> m_stageVector;  //!< Filter stages in chain order as a contiguous array for the kernels
+
     bool m_filterChainSetMode;
 	BasebandSampleSink* m_sampleSink; //!< Demodulator
 	int m_inputSampleRate;
@@ -134,6 +151,7 @@ protected:
 	Real createFilterChain(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd);
     void setFilterChain(const std::vector<unsigned int>& stageIndexes);
 	void freeFilterChain();
+	void selectChainKernel();
 	void debugFilterChain();
 
 signals:
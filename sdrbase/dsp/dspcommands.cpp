@@ -43,8 +43,12 @@ MESSAGE_CLASS_DEFINITION(DSPAddAudioSink, Message)
 MESSAGE_CLASS_DEFINITION(DSPRemoveAudioSink, Message)
 MESSAGE_CLASS_DEFINITION(DSPConfigureCorrection, Message)
 MESSAGE_CLASS_DEFINITION(DSPEngineReport, Message)
+MESSAGE_CLASS_POOL_DEFINITION(DSPEngineReport)
 MESSAGE_CLASS_DEFINITION(DSPConfigureScopeVis, Message)
 MESSAGE_CLASS_DEFINITION(DSPSignalNotification, Message)
+MESSAGE_CLASS_POOL_DEFINITION(DSPSignalNotification)
 MESSAGE_CLASS_DEFINITION(DSPMIMOSignalNotification, Message)
+MESSAGE_CLASS_POOL_DEFINITION(DSPMIMOSignalNotification)
 MESSAGE_CLASS_DEFINITION(DSPConfigureChannelizer, Message)
+MESSAGE_CLASS_POOL_DEFINITION(DSPConfigureChannelizer)
 MESSAGE_CLASS_DEFINITION(DSPConfigureAudio, Message)
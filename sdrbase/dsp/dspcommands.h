@@ -278,6 +278,7 @@ private:
 
 class SDRBASE_API DSPEngineReport : public Message {
 	MESSAGE_CLASS_DECLARATION
+	MESSAGE_CLASS_POOL_DECLARATION
 
 public:
 	DSPEngineReport(int sampleRate, quint64 centerFrequency) :
@@ -317,6 +318,7 @@ private:
 
 class SDRBASE_API DSPSignalNotification : public Message {
 	MESSAGE_CLASS_DECLARATION
+	MESSAGE_CLASS_POOL_DECLARATION
 
 public:
 	DSPSignalNotification(int samplerate, qint64 centerFrequency) :
@@ -335,6 +337,7 @@ private:
 
 class SDRBASE_API DSPMIMOSignalNotification : public Message {
 	MESSAGE_CLASS_DECLARATION
+	MESSAGE_CLASS_POOL_DECLARATION
 public:
 	DSPMIMOSignalNotification(int samplerate, qint64 centerFrequency, bool sourceOrSink, unsigned int index) :
 		Message(),
@@ -356,6 +359,7 @@ private:
 
 class SDRBASE_API DSPConfigureChannelizer : public Message {
 	MESSAGE_CLASS_DECLARATION
+	MESSAGE_CLASS_POOL_DECLARATION
 
 public:
 	DSPConfigureChannelizer(int sampleRate, int centerFrequency) :
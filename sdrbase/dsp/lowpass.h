@@ -52,6 +52,18 @@ public:
 			m_taps[i] /= sum;
 	}
 
+	/** Store a sample without computing the output. Use in place of filter() for the
+	 *  samples whose output is discarded when decimating. */
+	void push(Type sample)
+	{
+		m_samples[m_ptr] = sample;
+		m_ptr++;
+
+		if (m_ptr >= (int) m_samples.size()) {
+			m_ptr = 0;
+		}
+	}
+
 	Type filter(Type sample)
 	{
 		Type acc = 0;
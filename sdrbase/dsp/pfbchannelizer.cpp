@@ -0,0 +1,307 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include <QDebug>
+
+#include "dsp/dspcommands.h"
+#include "dsp/fftengine.h"
+#include "dsp/threadedbasebandsamplesink.h"
+#include "pfbchannelizer.h"
+
+PFBChannelizer::PFBChannelizer(unsigned int log2NbChannels, unsigned int tapsPerPhase, bool oversampled) :
+    m_log2NbChannels(log2NbChannels < 1 ? 1 : log2NbChannels > 12 ? 12 : log2NbChannels),
+    m_tapsPerPhase(tapsPerPhase < 2 ? 2 : tapsPerPhase),
+    m_oversampled(oversampled),
+    m_delayIndex(0),
+    m_phase(0),
+    m_outputCount(0),
+    m_nbChannelSinks(0),
+    m_inputSampleRate(0),
+    m_centerFrequency(0),
+    m_running(false)
+{
+    m_nbChannels = 1 << m_log2NbChannels;
+    m_nbTaps = m_nbChannels * m_tapsPerPhase;
+    m_decimation = m_oversampled ? m_nbChannels / 2 : m_nbChannels;
+    m_delayLine.resize(2*m_nbTaps, Complex{0.0f, 0.0f});
+    m_branches.resize(m_nbChannels);
+    m_outputs.resize(m_nbChannels);
+
+    makePrototypeFilter();
+
+    m_fft = FFTEngine::create();
+    m_fft->configure(m_nbChannels, true);
+
+    setObjectName(QString("PFBChannelizer(%1)").arg(m_nbChannels));
+    qDebug("PFBChannelizer::PFBChannelizer: M: %u P: %u decimation: %u", m_nbChannels, m_tapsPerPhase, m_decimation);
+}
+
+PFBChannelizer::~PFBChannelizer()
+{
+    delete m_fft;
+}
+
+void PFBChannelizer::makePrototypeFilter()
+{
+    // Windowed sinc low pass with cutoff at half the channel spacing (Fs/2M) and Blackman-Harris window
+    std::vector<double> h(m_nbTaps);
+    double sum = 0.0;
+    double fc = 0.5 / m_nbChannels;
+    double center = (m_nbTaps - 1) / 2.0;
+
+    for (unsigned int i = 0; i < m_nbTaps; i++)
+    {
+        double t = i - center;
+        double sinc = t == 0.0 ? 2.0 * fc : std::sin(2.0 * M_PI * fc * t) / (M_PI * t);
+        double a = (2.0 * M_PI * i) / (m_nbTaps - 1);
+        double w = 0.35875 - 0.48829 * std::cos(a) + 0.14128 * std::cos(2.0*a) - 0.01168 * std::cos(3.0*a);
+        h[i] = sinc * w;
+        sum += h[i];
+    }
+
+    // store in polyphase order: branch k holds h[p*M + k] for p = 0..P-1
+    m_taps.resize(m_nbTaps);
+
+    for (unsigned int k = 0; k < m_nbChannels; k++)
+    {
+        for (unsigned int p = 0; p < m_tapsPerPhase; p++) {
+            m_taps[k*m_tapsPerPhase + p] = h[p*m_nbChannels + k] / sum; // unity gain at channel center
+        }
+    }
+}
+
+int PFBChannelizer::getChannelSampleRate() const
+{
+    return m_inputSampleRate / (int) m_decimation;
+}
+
+qint64 PFBChannelizer::getChannelFrequencyOffset(unsigned int channelIndex) const
+{
+    qint64 m = channelIndex < m_nbChannels / 2 ? (qint64) channelIndex : (qint64) channelIndex - m_nbChannels;
+    return (m * m_inputSampleRate) / m_nbChannels;
+}
+
+unsigned int PFBChannelizer::getChannelIndex(qint64 frequencyOffset) const
+{
+    if (m_inputSampleRate == 0) {
+        return 0;
+    }
+
+    qint64 m = std::llround(((double) frequencyOffset * m_nbChannels) / m_inputSampleRate);
+    m %= (qint64) m_nbChannels;
+    return m < 0 ? m + m_nbChannels : m;
+}
+
+void PFBChannelizer::addChannelSink(unsigned int channelIndex, ThreadedBasebandSampleSink* sink)
+{
+    if (channelIndex >= m_nbChannels)
+    {
+        qWarning("PFBChannelizer::addChannelSink: channel index %u out of range", channelIndex);
+        return;
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+    m_outputs[channelIndex].m_sinks.push_back(sink);
+    m_nbChannelSinks++;
+    updateActiveChannels();
+    notifyChannel(channelIndex, sink);
+
+    if (m_running) {
+        sink->start();
+    }
+
+    qDebug() << "PFBChannelizer::addChannelSink: channel: " << channelIndex
+        << " sink: " << sink->getSampleSinkObjectName()
+        << " nb sinks: " << m_nbChannelSinks;
+}
+
+bool PFBChannelizer::removeChannelSink(ThreadedBasebandSampleSink* sink)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (std::vector<ChannelOutput>::iterator it = m_outputs.begin(); it != m_outputs.end(); ++it)
+    {
+        ThreadedBasebandSampleSinks::iterator sinkIt = std::find(it->m_sinks.begin(), it->m_sinks.end(), sink);
+
+        if (sinkIt != it->m_sinks.end())
+        {
+            sink->stop();
+            it->m_sinks.erase(sinkIt);
+            m_nbChannelSinks--;
+            updateActiveChannels();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void PFBChannelizer::updateActiveChannels()
+{
+    m_activeChannels.clear();
+
+    for (unsigned int i = 0; i < m_nbChannels; i++)
+    {
+        if (m_outputs[i].m_sinks.size() > 0) {
+            m_activeChannels.push_back(i);
+        }
+    }
+}
+
+void PFBChannelizer::notifyChannel(unsigned int channelIndex, ThreadedBasebandSampleSink *sink)
+{
+    DSPSignalNotification notif(getChannelSampleRate(), m_centerFrequency + getChannelFrequencyOffset(channelIndex));
+    sink->handleSinkMessage(notif);
+}
+
+void PFBChannelizer::start()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_running = true;
+
+    for (std::vector<ChannelOutput>::iterator it = m_outputs.begin(); it != m_outputs.end(); ++it)
+    {
+        for (ThreadedBasebandSampleSinks::const_iterator sinkIt = it->m_sinks.begin(); sinkIt != it->m_sinks.end(); ++sinkIt) {
+            (*sinkIt)->start();
+        }
+    }
+}
+
+void PFBChannelizer::stop()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_running = false;
+
+    for (std::vector<ChannelOutput>::iterator it = m_outputs.begin(); it != m_outputs.end(); ++it)
+    {
+        for (ThreadedBasebandSampleSinks::const_iterator sinkIt = it->m_sinks.begin(); sinkIt != it->m_sinks.end(); ++sinkIt) {
+            (*sinkIt)->stop();
+        }
+    }
+}
+
+void PFBChannelizer::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly)
+{
+    (void) positiveOnly;
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_activeChannels.size() == 0) {
+        return;
+    }
+
+    for (SampleVector::const_iterator it = begin; it != end; ++it)
+    {
+        Complex c(it->real(), it->imag());
+        m_delayLine[m_delayIndex] = c;
+        m_delayLine[m_delayIndex + m_nbTaps] = c;
+
+        if (++m_phase == m_decimation)
+        {
+            m_phase = 0;
+            processBlock();
+        }
+
+        if (++m_delayIndex == m_nbTaps) {
+            m_delayIndex = 0;
+        }
+    }
+
+    for (std::vector<unsigned int>::const_iterator it = m_activeChannels.begin(); it != m_activeChannels.end(); ++it)
+    {
+        ChannelOutput& output = m_outputs[*it];
+
+        for (ThreadedBasebandSampleSinks::const_iterator sinkIt = output.m_sinks.begin(); sinkIt != output.m_sinks.end(); ++sinkIt) {
+            (*sinkIt)->feed(output.m_samples.begin(), output.m_samples.end(), false);
+        }
+
+        output.m_samples.clear();
+    }
+}
+
+void PFBChannelizer::processBlock()
+{
+    // the latest L samples oldest first: window[L-1-l] is x[n-l]
+    const Complex *window = &m_delayLine[m_delayIndex + 1];
+
+    // polyphase branches: v[k] = sum_p h[pM+k] * x[n-pM-k]
+    for (unsigned int k = 0; k < m_nbChannels; k++)
+    {
+        const Real *taps = &m_taps[k*m_tapsPerPhase];
+        const Complex *x = &window[m_nbTaps - 1 - k];
+        Real accI = 0.0f, accQ = 0.0f;
+
+        for (unsigned int p = 0; p < m_tapsPerPhase; p++, x -= m_nbChannels)
+        {
+            accI += taps[p] * x->real();
+            accQ += taps[p] * x->imag();
+        }
+
+        m_branches[k] = Complex{accI, accQ};
+    }
+
+    // channel m output is the inverse DFT of the branches at bin m
+    std::copy(m_branches.begin(), m_branches.end(), m_fft->in());
+    m_fft->transform();
+    const Complex *out = m_fft->out();
+
+    // with M/2 decimation the channel m phase rotates by (-1)^m at each output
+    bool oddOutput = m_oversampled && (m_outputCount & 1);
+    m_outputCount++;
+
+    for (std::vector<unsigned int>::const_iterator it = m_activeChannels.begin(); it != m_activeChannels.end(); ++it)
+    {
+        Complex y = out[*it];
+
+        if (oddOutput && (*it & 1)) {
+            y = -y;
+        }
+
+        m_outputs[*it].m_samples.push_back(Sample((FixReal) y.real(), (FixReal) y.imag()));
+    }
+}
+
+bool PFBChannelizer::handleMessage(const Message& cmd)
+{
+    if (DSPSignalNotification::match(cmd))
+    {
+        DSPSignalNotification& notif = (DSPSignalNotification&) cmd;
+        QMutexLocker mutexLocker(&m_mutex);
+        m_inputSampleRate = notif.getSampleRate();
+        m_centerFrequency = notif.getCenterFrequency();
+        qDebug() << "PFBChannelizer::handleMessage: DSPSignalNotification:"
+            << " inputSampleRate: " << m_inputSampleRate
+            << " centerFrequency: " << m_centerFrequency
+            << " channelSampleRate: " << getChannelSampleRate();
+
+        for (unsigned int i = 0; i < m_nbChannels; i++)
+        {
+            for (ThreadedBasebandSampleSinks::const_iterator it = m_outputs[i].m_sinks.begin(); it != m_outputs[i].m_sinks.end(); ++it) {
+                notifyChannel(i, *it);
+            }
+        }
+
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
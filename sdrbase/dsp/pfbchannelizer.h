@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_PFBCHANNELIZER_H
+#define SDRBASE_DSP_PFBCHANNELIZER_H
+
+#include <list>
+#include <vector>
+#include <QMutex>
+
+#include "dsp/basebandsamplesink.h"
+#include "export.h"
+
+class FFTEngine;
+class ThreadedBasebandSampleSink;
+
+/**
+ * Polyphase FFT filter bank channelizer. Splits the baseband into M uniformly spaced
+ * sub-channels in one pass. Channel m is centered at m*Fs/M (m < M/2) or (m-M)*Fs/M (m >= M/2)
+ * and is delivered at Fs/M (critically sampled) or 2*Fs/M (2x oversampled). Sinks attached
+ * to a channel output receive it as if it was the baseband of a device tuned at the channel center
+ * so that regular channel plugins can be run on it with a much lower input sample rate.
+ *
+ * The channelizer is added to the device like any channel sink, wrapped in a ThreadedBasebandSampleSink
+ * with DeviceAPI::addChannelSink. It starts and stops the sinks attached to its outputs with itself.
+ */
+class SDRBASE_API PFBChannelizer : public BasebandSampleSink {
+    Q_OBJECT
+public:
+    /**
+     * \param log2NbChannels log2 of the number of channels M (1 to 12)
+     * \param tapsPerPhase length of each polyphase branch. Prototype filter has M*tapsPerPhase taps
+     * \param oversampled if true channels are output at 2*Fs/M with a decimation by M/2 so that
+     *        channel edges are free of aliasing. Else the bank is critically sampled (Fs/M).
+     */
+    PFBChannelizer(unsigned int log2NbChannels, unsigned int tapsPerPhase = 12, bool oversampled = true);
+    virtual ~PFBChannelizer();
+
+    void addChannelSink(unsigned int channelIndex, ThreadedBasebandSampleSink* sink); //!< Attach a sink to the output of a channel. Started if the channelizer runs.
+    bool removeChannelSink(ThreadedBasebandSampleSink* sink); //!< Detach and stop a sink. Returns true if it was attached
+    unsigned int getNbChannelSinks() const { return m_nbChannelSinks; }
+
+    unsigned int getNbChannels() const { return m_nbChannels; }
+    int getInputSampleRate() const { return m_inputSampleRate; }
+    int getChannelSampleRate() const; //!< Sample rate at the output of each channel
+    qint64 getChannelFrequencyOffset(unsigned int channelIndex) const; //!< Channel center relative to the baseband center
+    unsigned int getChannelIndex(qint64 frequencyOffset) const; //!< Index of the channel nearest to the given baseband offset
+
+    virtual void start();
+    virtual void stop();
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly);
+    virtual bool handleMessage(const Message& cmd);
+
+private:
+    typedef std::list<ThreadedBasebandSampleSink*> ThreadedBasebandSampleSinks;
+
+    struct ChannelOutput
+    {
+        ThreadedBasebandSampleSinks m_sinks;
+        SampleVector m_samples;
+    };
+
+    unsigned int m_log2NbChannels;
+    unsigned int m_nbChannels;       //!< M
+    unsigned int m_tapsPerPhase;     //!< P
+    unsigned int m_nbTaps;           //!< L = M*P
+    unsigned int m_decimation;       //!< M or M/2
+    bool m_oversampled;
+    std::vector<Real> m_taps;        //!< Prototype filter in polyphase order (taps for branch k are contiguous)
+    std::vector<Complex> m_delayLine; //!< Double length so that the latest L samples are always contiguous
+    unsigned int m_delayIndex;
+    unsigned int m_phase;            //!< Input samples since last output
+    unsigned int m_outputCount;      //!< Output index parity for oversampled mode phase correction
+    std::vector<Complex> m_branches; //!< Polyphase branch outputs (FFT input)
+    FFTEngine *m_fft;
+    std::vector<ChannelOutput> m_outputs;
+    std::vector<unsigned int> m_activeChannels; //!< Channels with at least one sink
+    unsigned int m_nbChannelSinks;
+    int m_inputSampleRate;
+    qint64 m_centerFrequency;
+    bool m_running;
+    QMutex m_mutex;
+
+    void makePrototypeFilter();
+    void updateActiveChannels();
+    void notifyChannel(unsigned int channelIndex, ThreadedBasebandSampleSink *sink);
+    void processBlock();
+};
+
+#endif // SDRBASE_DSP_PFBCHANNELIZER_H
@@ -18,8 +18,93 @@
 
 #define _USE_MATH_DEFINES
 #include <math.h>
+#include <string.h>
+
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
+
 #include "projector.h"
 
+namespace {
+
+// atan(a) / Pi for a in [0..1] (Abramowitz & Stegun 4.4.49: error < 2e-8 rad)
+const float atanPi[8] = {
+    (float) ( 0.9999993329 / M_PI),
+    (float) (-0.3332985605 / M_PI),
+    (float) ( 0.1994653599 / M_PI),
+    (float) (-0.1390853351 / M_PI),
+    (float) ( 0.0964200441 / M_PI),
+    (float) (-0.0559098861 / M_PI),
+    (float) ( 0.0218612288 / M_PI),
+    (float) (-0.0040540580 / M_PI)
+};
+
+const float dBPerLn = 4.342944819f;     // 10 / ln(10)
+const float ln2 = 0.693147181f;
+const float sqrt2 = 1.414213562f;
+const float minMagSq = 1.17549435e-38f; // smallest normal float: log of 0 is finite
+
+inline float phasePi(float re, float im) //!< atan2(im, re) / Pi
+{
+    float ax = fabsf(re);
+    float ay = fabsf(im);
+    float mx = ax > ay ? ax : ay;
+    float a = mx > 0.0f ? (ax > ay ? ay : ax) / mx : 0.0f;
+    float s = a*a;
+    float r = a*(atanPi[0] + s*(atanPi[1] + s*(atanPi[2] + s*(atanPi[3] + s*(atanPi[4] + s*(atanPi[5] + s*(atanPi[6] + s*atanPi[7])))))));
+    r = ay > ax ? 0.5f - r : r;
+    r = re < 0.0f ? 1.0f - r : r;
+    return im < 0.0f ? -r : r;
+}
+
+inline float powerDB(float magsq)
+{
+    magsq = magsq < minMagSq ? minMagSq : magsq;
+    quint32 bits;
+    memcpy(&bits, &magsq, sizeof(float));
+    float e = (float) ((int) (bits >> 23) - 127);
+    bits = (bits & 0x007FFFFF) | 0x3F800000; // mantissa in [1..2[
+    float m;
+    memcpy(&m, &bits, sizeof(float));
+
+    if (m > sqrt2)
+    {
+        m *= 0.5f;
+        e += 1.0f;
+    }
+
+    // ln(m) = 2 atanh(z) with z = (m-1)/(m+1) in [-0.172..0.172]
+    float z = (m - 1.0f) / (m + 1.0f);
+    float z2 = z*z;
+    float lnm = 2.0f*z*(1.0f + z2*(1.0f/3.0f + z2*(1.0f/5.0f + z2*(1.0f/7.0f + z2*(1.0f/9.0f)))));
+    return dBPerLn * (e*ln2 + lnm);
+}
+
+#if defined(USE_SSE2)
+inline void loadSamples(const Sample *s, __m128& re, __m128& im) //!< 4 samples
+{
+    const __m128 scale = _mm_set1_ps(1.0f / SDR_RX_SCALEF);
+#ifdef SDR_RX_SAMPLE_24BIT
+    __m128 a = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) s));       // r0 i0 r1 i1
+    __m128 b = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) (s + 2))); // r2 i2 r3 i3
+    re = _mm_mul_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0)), scale);
+    im = _mm_mul_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1)), scale);
+#else
+    __m128i a = _mm_loadu_si128((const __m128i*) s); // 4 x (16 bit real, 16 bit imaginary)
+    re = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16)), scale);
+    im = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(a, 16)), scale);
+#endif
+}
+
+inline __m128 select(__m128 mask, __m128 a, __m128 b) //!< a where mask is set else b
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
+} // namespace
+
 Projector::Projector(ProjectionType projectionType) :
     m_projectionType(projectionType),
     m_prevArg(0.0f),
@@ -153,7 +238,7 @@ Real Projector::run(const Sample& s)
             if (arg < -15*M_PI/16) {
                v -= 15.0/16;
             } else if (arg < -13*M_PI/16) {
-                v -= 13.0/6;
+                v -= 13.0/16;
             } else if (arg < -11*M_PI/16) {
                 v -= 11.0/16;
             } else if (arg < -9*M_PI/16) {
@@ -212,4 +297,178 @@ Real Projector::normalizeAngle(Real angle)
     return angle;
 }
 
+void Projector::setPrevSample(const Sample& s)
+{
+    m_prevArg = std::atan2((float) s.m_imag, (float) s.m_real);
+}
+
+void Projector::runBlock(const Sample *s, Real *out, unsigned int n)
+{
+    switch (m_projectionType)
+    {
+    case ProjectionImag:
+        for (unsigned int i = 0; i < n; i++) {
+            out[i] = s[i].m_imag / SDR_RX_SCALEF;
+        }
+        break;
+    case ProjectionMagLin:
+    {
+        magSqBlock(s, out, n);
+        unsigned int i = 0;
+#if defined(USE_SSE2)
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_ps(&out[i], _mm_sqrt_ps(_mm_loadu_ps(&out[i])));
+        }
+#endif
+        for (; i < n; i++) {
+            out[i] = std::sqrt(out[i]);
+        }
+    }
+        break;
+    case ProjectionMagSq:
+        magSqBlock(s, out, n);
+        break;
+    case ProjectionMagDB:
+        magSqBlock(s, out, n);
+        powerDBBlock(out, out, n);
+        break;
+    case ProjectionPhase:
+        phaseBlock(s, out, n);
+        break;
+    case ProjectionDPhase:
+    {
+        phaseBlock(s, out, n);
+        Real prev = m_prevArg / M_PI;
+
+        for (unsigned int i = 0; i < n; i++)
+        {
+            Real cur = out[i];
+            Real dPhi = cur - prev;
+            prev = cur;
 
+            if (dPhi < -1.0f) {
+                dPhi += 2.0f;
+            } else if (dPhi > 1.0f) {
+                dPhi -= 2.0f;
+            }
+
+            out[i] = dPhi;
+        }
+
+        m_prevArg = prev * M_PI;
+    }
+        break;
+    case ProjectionBPSK:
+    case ProjectionQPSK:
+    case Projection8PSK:
+    case Projection16PSK:
+    {
+        // the phase comparator value reduces to phase + 1/M wrapped in [-1..1[
+        Real ofs = 1.0f / (1 << (m_projectionType - ProjectionBPSK + 1));
+        phaseBlock(s, out, n);
+
+        for (unsigned int i = 0; i < n; i++)
+        {
+            Real v = out[i] + ofs;
+            out[i] = v < 1.0f ? v : v - 2.0f;
+        }
+    }
+        break;
+    case ProjectionReal:
+    default:
+        for (unsigned int i = 0; i < n; i++) {
+            out[i] = s[i].m_real / SDR_RX_SCALEF;
+        }
+        break;
+    }
+}
+
+void Projector::magSqBlock(const Sample *s, Real *out, unsigned int n)
+{
+    unsigned int i = 0;
+
+#if defined(USE_SSE2)
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 re, im;
+        loadSamples(&s[i], re, im);
+        _mm_storeu_ps(&out[i], _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im)));
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        Real re = s[i].m_real / SDR_RX_SCALEF;
+        Real im = s[i].m_imag / SDR_RX_SCALEF;
+        out[i] = re*re + im*im;
+    }
+}
+
+void Projector::powerDBBlock(const Real *magsq, Real *out, unsigned int n)
+{
+    unsigned int i = 0;
+
+#if defined(USE_SSE2)
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 x = _mm_max_ps(_mm_loadu_ps(&magsq[i]), _mm_set1_ps(minMagSq));
+        __m128i bits = _mm_castps_si128(x);
+        __m128 e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+        __m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+        __m128 big = _mm_cmpgt_ps(m, _mm_set1_ps(sqrt2));
+        m = select(big, _mm_mul_ps(m, _mm_set1_ps(0.5f)), m);
+        e = _mm_add_ps(e, _mm_and_ps(big, one));
+        __m128 z = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+        __m128 z2 = _mm_mul_ps(z, z);
+        __m128 p = _mm_add_ps(_mm_set1_ps(1.0f/7.0f), _mm_mul_ps(z2, _mm_set1_ps(1.0f/9.0f)));
+        p = _mm_add_ps(_mm_set1_ps(1.0f/5.0f), _mm_mul_ps(z2, p));
+        p = _mm_add_ps(_mm_set1_ps(1.0f/3.0f), _mm_mul_ps(z2, p));
+        p = _mm_add_ps(one, _mm_mul_ps(z2, p));
+        __m128 lnm = _mm_mul_ps(_mm_add_ps(z, z), p);
+        __m128 lnx = _mm_add_ps(_mm_mul_ps(e, _mm_set1_ps(ln2)), lnm);
+        _mm_storeu_ps(&out[i], _mm_mul_ps(lnx, _mm_set1_ps(dBPerLn)));
+    }
+#endif
+
+    for (; i < n; i++) {
+        out[i] = powerDB(magsq[i]);
+    }
+}
+
+void Projector::phaseBlock(const Sample *s, Real *out, unsigned int n)
+{
+    unsigned int i = 0;
+
+#if defined(USE_SSE2)
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 re, im;
+        loadSamples(&s[i], re, im);
+        __m128 ax = _mm_andnot_ps(signMask, re);
+        __m128 ay = _mm_andnot_ps(signMask, im);
+        __m128 mx = _mm_max_ps(ax, ay);
+        __m128 a = _mm_div_ps(_mm_min_ps(ax, ay), _mm_max_ps(mx, _mm_set1_ps(minMagSq))); // 0 for 0/0
+        __m128 s2 = _mm_mul_ps(a, a);
+        __m128 r = _mm_add_ps(_mm_set1_ps(atanPi[6]), _mm_mul_ps(s2, _mm_set1_ps(atanPi[7])));
+        r = _mm_add_ps(_mm_set1_ps(atanPi[5]), _mm_mul_ps(s2, r));
+        r = _mm_add_ps(_mm_set1_ps(atanPi[4]), _mm_mul_ps(s2, r));
+        r = _mm_add_ps(_mm_set1_ps(atanPi[3]), _mm_mul_ps(s2, r));
+        r = _mm_add_ps(_mm_set1_ps(atanPi[2]), _mm_mul_ps(s2, r));
+        r = _mm_add_ps(_mm_set1_ps(atanPi[1]), _mm_mul_ps(s2, r));
+        r = _mm_mul_ps(a, _mm_add_ps(_mm_set1_ps(atanPi[0]), _mm_mul_ps(s2, r)));
+        r = select(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(_mm_set1_ps(0.5f), r), r);
+        r = select(_mm_cmplt_ps(re, zero), _mm_sub_ps(_mm_set1_ps(1.0f), r), r);
+        r = _mm_xor_ps(r, _mm_and_ps(_mm_cmplt_ps(im, zero), signMask));
+        _mm_storeu_ps(&out[i], r);
+    }
+#endif
+
+    for (; i < n; i++) {
+        out[i] = phasePi(s[i].m_real / SDR_RX_SCALEF, s[i].m_imag / SDR_RX_SCALEF);
+    }
+}
@@ -47,6 +47,17 @@ public:
     void setCacheMaster(bool cacheMaster) { m_cacheMaster = cacheMaster; }
 
     Real run(const Sample& s);
+    /**
+     * Project n samples at once into out. This does not use the cache. Transcendental
+     * functions are polynomial approximations (better than 1e-6 relative) evaluated with
+     * SIMD instructions when available.
+     */
+    void runBlock(const Sample *s, Real *out, unsigned int n);
+    void setPrevSample(const Sample& s); //!< Set phase derivative state as if s was the last sample projected
+
+    static void magSqBlock(const Sample *s, Real *out, unsigned int n); //!< Squared magnitude of n samples
+    static void powerDBBlock(const Real *magsq, Real *out, unsigned int n); //!< Squared magnitudes to dB
+    static void phaseBlock(const Sample *s, Real *out, unsigned int n); //!< Phase of n samples divided by Pi in [-1..1]
 
 private:
     static Real normalizeAngle(Real angle);
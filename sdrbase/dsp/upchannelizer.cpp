@@ -26,6 +26,7 @@
 #include <QDebug>
 
 MESSAGE_CLASS_DEFINITION(UpChannelizer::MsgChannelizerNotification, Message)
+MESSAGE_CLASS_POOL_DEFINITION(UpChannelizer::MsgChannelizerNotification)
 MESSAGE_CLASS_DEFINITION(UpChannelizer::MsgSetChannelizer, Message)
 
 UpChannelizer::UpChannelizer(BasebandSampleSource* sampleSource) :
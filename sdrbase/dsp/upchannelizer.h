@@ -39,6 +39,7 @@ class SDRBASE_API UpChannelizer : public BasebandSampleSource {
 public:
     class SDRBASE_API MsgChannelizerNotification : public Message {
         MESSAGE_CLASS_DECLARATION
+        MESSAGE_CLASS_POOL_DECLARATION
 
     public:
         MsgChannelizerNotification(int basebandSampleRate, int samplerate, qint64 frequencyOffset) :
@@ -31,11 +31,26 @@ MainParser::MainParser() :
         "Web API server port.",
         "port",
         "8091"),
-    m_mimoOption("mimo", "Activate MIMO functionality")
+    m_mimoOption("mimo", "Activate MIMO functionality"),
+    m_eventsPortOption(QStringList() << "e" << "api-events-port",
+        "Web API WebSocket events port (0: disabled).",
+        "port",
+        "0"),
+    m_eventsPeriodOption("api-events-period",
+        "Web API WebSocket events period in milliseconds.",
+        "period",
+        "1000"),
+    m_deviceSetOption(QStringList() << "d" << "device-set",
+        "Device set to create at startup (server only) as rx|tx,<hardware type>,<sequence>[,<preset group>,<preset description>]. Repeat for each device set.",
+        "deviceset"),
+    m_deviceSetsStartOption("device-sets-start", "Start streaming on the device sets created at startup (server only).")
 {
     m_serverAddress = "127.0.0.1";
     m_serverPort = 8091;
     m_mimoSupport = false;
+    m_eventsPort = 0;
+    m_eventsPeriod = 1000;
+    m_deviceSetsStart = false;
     m_mimoOption.setFlags(QCommandLineOption::HiddenFromHelp);
 
     m_parser.setApplicationDescription("Software Defined Radio application");
@@ -45,6 +60,10 @@ MainParser::MainParser() :
     m_parser.addOption(m_serverAddressOption);
     m_parser.addOption(m_serverPortOption);
     m_parser.addOption(m_mimoOption);
+    m_parser.addOption(m_eventsPortOption);
+    m_parser.addOption(m_eventsPeriodOption);
+    m_parser.addOption(m_deviceSetOption);
+    m_parser.addOption(m_deviceSetsStartOption);
 }
 
 MainParser::~MainParser()
@@ -88,4 +107,57 @@ void MainParser::parse(const QCoreApplication& app)
     // MIMO
 
     m_mimoSupport = m_parser.isSet(m_mimoOption);
+
+    // events port
+
+    QString eventsPortStr = m_parser.value(m_eventsPortOption);
+    int eventsPort = eventsPortStr.toInt(&ok);
+
+    if (ok && ((eventsPort == 0) || ((eventsPort > 1023) && (eventsPort < 65536)))) {
+        m_eventsPort = eventsPort;
+    } else {
+        qWarning() << "MainParser::parse: events port invalid. Defaulting to " << m_eventsPort;
+    }
+
+    // events period
+
+    QString eventsPeriodStr = m_parser.value(m_eventsPeriodOption);
+    int eventsPeriod = eventsPeriodStr.toInt(&ok);
+
+    if (ok && (eventsPeriod >= 50)) {
+        m_eventsPeriod = eventsPeriod;
+    } else {
+        qWarning() << "MainParser::parse: events period invalid. Defaulting to " << m_eventsPeriod;
+    }
+
+    // device sets at startup
+
+    QStringList deviceSetStrs = m_parser.values(m_deviceSetOption);
+
+    for (int i = 0; i < deviceSetStrs.size(); i++)
+    {
+        QStringList fields = deviceSetStrs[i].split(',');
+        DeviceSetSpec deviceSet;
+        int sequence = fields.size() > 2 ? fields[2].toInt(&ok) : 0;
+
+        if ((fields.size() < 3) || ((fields[0] != "rx") && (fields[0] != "tx")) || fields[1].isEmpty() || !ok || (sequence < 0))
+        {
+            qWarning() << "MainParser::parse: device set invalid. Ignoring " << deviceSetStrs[i];
+            continue;
+        }
+
+        deviceSet.m_tx = fields[0] == "tx";
+        deviceSet.m_hwType = fields[1];
+        deviceSet.m_sequence = sequence;
+
+        if (fields.size() > 3)
+        {
+            deviceSet.m_presetGroup = fields[3];
+            deviceSet.m_presetDescription = fields.mid(4).join(','); // description may contain commas
+        }
+
+        m_deviceSets.append(deviceSet);
+    }
+
+    m_deviceSetsStart = m_parser.isSet(m_deviceSetsStartOption);
 }
@@ -20,6 +20,7 @@
 #define SDRBASE_MAINPARSER_H_
 
 #include <QCommandLineParser>
+#include <QList>
 #include <stdint.h>
 
 #include "export.h"
@@ -27,6 +28,15 @@
 class SDRBASE_API MainParser
 {
 public:
+    struct DeviceSetSpec //!< device set to create at startup
+    {
+        bool m_tx;
+        QString m_hwType;
+        int m_sequence;
+        QString m_presetGroup;       //!< no preset if empty
+        QString m_presetDescription;
+    };
+
     MainParser();
     ~MainParser();
 
@@ -35,16 +45,28 @@ public:
     const QString& getServerAddress() const { return m_serverAddress; }
     uint16_t getServerPort() const { return m_serverPort; }
     bool getMIMOSupport() const { return m_mimoSupport; }
+    uint16_t getEventsPort() const { return m_eventsPort; }
+    int getEventsPeriod() const { return m_eventsPeriod; }
+    const QList<DeviceSetSpec>& getDeviceSets() const { return m_deviceSets; }
+    bool getDeviceSetsStart() const { return m_deviceSetsStart; }
 
 private:
     QString  m_serverAddress;
     uint16_t m_serverPort;
     bool m_mimoSupport;
+    uint16_t m_eventsPort;
+    int m_eventsPeriod;
+    QList<DeviceSetSpec> m_deviceSets;
+    bool m_deviceSetsStart;
 
     QCommandLineParser m_parser;
     QCommandLineOption m_serverAddressOption;
     QCommandLineOption m_serverPortOption;
     QCommandLineOption m_mimoOption;
+    QCommandLineOption m_eventsPortOption;
+    QCommandLineOption m_eventsPeriodOption;
+    QCommandLineOption m_deviceSetOption;
+    QCommandLineOption m_deviceSetsStartOption;
 };
 
 
@@ -18,6 +18,14 @@
 #include <QCoreApplication>
 #include <QPluginLoader>
 #include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMap>
 
 #include <cstdio>
 
@@ -47,9 +55,14 @@ const QString PluginManager::m_fileSinkDeviceTypeID = "sdrangel.samplesink.files
 const QString PluginManager::m_testMIMOHardwareID = "TestMI";
 const QString PluginManager::m_testMIMODeviceTypeID = "sdrangel.samplemimo.testmi";
 
+const int PluginManager::m_manifestVersion = 1;
+
 PluginManager::PluginManager(QObject* parent) :
 	QObject(parent),
-    m_pluginAPI(this)
+    m_pluginAPI(this),
+    m_manifestChanged(false),
+    m_registeringProxy(nullptr),
+    m_lazyLoading(false)
 {
 }
 
@@ -92,7 +105,7 @@ void PluginManager::loadPluginsPart(const QString& pluginsSubDir)
         }
 
         found = true;
-        loadPluginsDir(d);
+        loadPluginsDir(d, pluginsSubDir);
         break;
     }
 
@@ -109,16 +122,39 @@ void PluginManager::loadPluginsFinal()
 
     for (Plugins::const_iterator it = m_plugins.begin(); it != m_plugins.end(); ++it)
     {
-        it->pluginInterface->initPlugin(&m_pluginAPI);
+        PluginProxy *pluginProxy = static_cast<PluginProxy*>(it->pluginInterface);
+
+        if (pluginProxy->isLoaded()) // loaded at startup: record its registrations in the manifest
+        {
+            m_registeringProxy = pluginProxy;
+            pluginProxy->getPlugin()->initPlugin(&m_pluginAPI);
+            m_registeringProxy = nullptr;
+        }
+        else // registrations from the manifest
+        {
+            pluginProxy->initPlugin(&m_pluginAPI);
+        }
     }
 
-    DeviceEnumerator::instance()->enumerateRxDevices(this);
-    DeviceEnumerator::instance()->enumerateTxDevices(this);
-    DeviceEnumerator::instance()->enumerateMIMODevices(this);
+    if (m_manifestChanged) {
+        saveManifest();
+    }
+
+    DeviceEnumerator::instance()->enumerateDevices(this, m_devicesCacheFileName);
 }
 
 void PluginManager::registerRxChannel(const QString& channelIdURI, const QString& channelId, PluginInterface* plugin)
 {
+    if (m_lazyLoading) { // plugin loaded on demand is already registered from its manifest
+        return;
+    }
+
+    if (m_registeringProxy) // plugin loaded at startup registers its proxy
+    {
+        m_registeringProxy->addRxChannel(channelIdURI, channelId);
+        plugin = m_registeringProxy;
+    }
+
     qDebug() << "PluginManager::registerRxChannel "
             << plugin->getPluginDescriptor().displayedName.toStdString().c_str()
             << " with channel name " << channelIdURI;
@@ -128,6 +164,16 @@ void PluginManager::registerRxChannel(const QString& channelIdURI, const QString
 
 void PluginManager::registerTxChannel(const QString& channelIdURI, const QString& channelId, PluginInterface* plugin)
 {
+    if (m_lazyLoading) { // plugin loaded on demand is already registered from its manifest
+        return;
+    }
+
+    if (m_registeringProxy) // plugin loaded at startup registers its proxy
+    {
+        m_registeringProxy->addTxChannel(channelIdURI, channelId);
+        plugin = m_registeringProxy;
+    }
+
     qDebug() << "PluginManager::registerTxChannel "
             << plugin->getPluginDescriptor().displayedName.toStdString().c_str()
             << " with channel name " << channelIdURI;
@@ -137,6 +183,16 @@ void PluginManager::registerTxChannel(const QString& channelIdURI, const QString
 
 void PluginManager::registerSampleSource(const QString& sourceName, PluginInterface* plugin)
 {
+    if (m_lazyLoading) { // plugin loaded on demand is already registered from its manifest
+        return;
+    }
+
+    if (m_registeringProxy) // plugin loaded at startup registers its proxy
+    {
+        m_registeringProxy->addSampleSource(sourceName);
+        plugin = m_registeringProxy;
+    }
+
 	qDebug() << "PluginManager::registerSampleSource "
 			<< plugin->getPluginDescriptor().displayedName.toStdString().c_str()
 			<< " with source name " << sourceName.toStdString().c_str();
@@ -146,6 +202,16 @@ void PluginManager::registerSampleSource(const QString& sourceName, PluginInterf
 
 void PluginManager::registerSampleSink(const QString& sinkName, PluginInterface* plugin)
 {
+    if (m_lazyLoading) { // plugin loaded on demand is already registered from its manifest
+        return;
+    }
+
+    if (m_registeringProxy) // plugin loaded at startup registers its proxy
+    {
+        m_registeringProxy->addSampleSink(sinkName);
+        plugin = m_registeringProxy;
+    }
+
 	qDebug() << "PluginManager::registerSampleSink "
 			<< plugin->getPluginDescriptor().displayedName.toStdString().c_str()
 			<< " with sink name " << sinkName.toStdString().c_str();
@@ -155,6 +221,16 @@ void PluginManager::registerSampleSink(const QString& sinkName, PluginInterface*
 
 void PluginManager::registerSampleMIMO(const QString& mimoName, PluginInterface* plugin)
 {
+    if (m_lazyLoading) { // plugin loaded on demand is already registered from its manifest
+        return;
+    }
+
+    if (m_registeringProxy) // plugin loaded at startup registers its proxy
+    {
+        m_registeringProxy->addSampleMIMO(mimoName);
+        plugin = m_registeringProxy;
+    }
+
 	qDebug() << "PluginManager::registerSampleMIMO "
 			<< plugin->getPluginDescriptor().displayedName.toStdString().c_str()
 			<< " with MIMO name " << mimoName.toStdString().c_str();
@@ -162,9 +238,34 @@ void PluginManager::registerSampleMIMO(const QString& mimoName, PluginInterface*
 	m_sampleMIMORegistrations.append(PluginAPI::SamplingDeviceRegistration(mimoName, plugin));
 }
 
-void PluginManager::loadPluginsDir(const QDir& dir)
+void PluginManager::loadPluginsDir(const QDir& dir, const QString& pluginsSubDir)
 {
     QDir pluginsDir(dir);
+    QMap<QString, PluginProxy::Manifest> manifests;
+    m_manifestFileName = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/" + pluginsSubDir + "-manifest.json";
+    m_devicesCacheFileName = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/" + pluginsSubDir + "-devices.json";
+    QFile manifestFile(m_manifestFileName);
+
+    if (manifestFile.open(QIODevice::ReadOnly))
+    {
+        QJsonObject manifestObject = QJsonDocument::fromJson(manifestFile.readAll()).object();
+
+        // plugins are built with the application so a new version invalidates the manifest
+        if ((manifestObject.value("version").toInt() == m_manifestVersion)
+            && (manifestObject.value("applicationVersion").toString() == QCoreApplication::applicationVersion()))
+        {
+            foreach (const QJsonValue& value, manifestObject.value("plugins").toArray())
+            {
+                PluginProxy::Manifest manifest;
+
+                if (manifest.fromJson(value.toObject())) {
+                    manifests.insert(manifest.m_fileName, manifest);
+                }
+            }
+        }
+    }
+
+    int nbManifests = 0;
 
     foreach (QString fileName, pluginsDir.entryList(QDir::Files))
     {
@@ -172,6 +273,17 @@ void PluginManager::loadPluginsDir(const QDir& dir)
         {
             qDebug("PluginManager::loadPluginsDir: fileName: %s", qPrintable(fileName));
 
+            QFileInfo fileInfo(pluginsDir.absoluteFilePath(fileName));
+            qint64 lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+            QMap<QString, PluginProxy::Manifest>::const_iterator manifestIt = manifests.constFind(fileInfo.absoluteFilePath());
+
+            if ((manifestIt != manifests.constEnd()) && (manifestIt->m_lastModified == lastModified) && (manifestIt->m_size == fileInfo.size()))
+            {
+                m_plugins.append(Plugin(fileName, new PluginProxy(*manifestIt, this)));
+                nbManifests++;
+                continue;
+            }
+
             QPluginLoader* pluginLoader = new QPluginLoader(pluginsDir.absoluteFilePath(fileName));
             if (!pluginLoader->load())
             {
@@ -191,9 +303,102 @@ void PluginManager::loadPluginsDir(const QDir& dir)
             delete(pluginLoader);
 
             qInfo("PluginManager::loadPluginsDir: loaded plugin %s", qPrintable(fileName));
-            m_plugins.append(Plugin(fileName, instance));
+            m_plugins.append(Plugin(fileName, new PluginProxy(instance, fileInfo.absoluteFilePath(), lastModified, fileInfo.size(), this)));
+            m_manifestChanged = true;
        }
     }
+
+    if (nbManifests != manifests.size()) { // some plugins were removed or updated
+        m_manifestChanged = true;
+    }
+
+    qInfo("PluginManager::loadPluginsDir: %d plugins of which %d to be loaded on demand", m_plugins.size(), nbManifests);
+}
+
+void PluginManager::saveManifest()
+{
+    QJsonArray plugins;
+
+    for (Plugins::const_iterator it = m_plugins.begin(); it != m_plugins.end(); ++it)
+    {
+        PluginProxy *pluginProxy = static_cast<PluginProxy*>(it->pluginInterface);
+
+        if (!pluginProxy->hasLoadFailed()) {
+            plugins.append(pluginProxy->getManifest().toJson());
+        }
+    }
+
+    QJsonObject manifestObject;
+    manifestObject.insert("version", m_manifestVersion);
+    manifestObject.insert("applicationVersion", QCoreApplication::applicationVersion());
+    manifestObject.insert("plugins", plugins);
+
+    QDir().mkpath(QFileInfo(m_manifestFileName).absolutePath());
+    QFile manifestFile(m_manifestFileName);
+
+    if (manifestFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        manifestFile.write(QJsonDocument(manifestObject).toJson());
+    } else {
+        qWarning("PluginManager::saveManifest: cannot write %s", qPrintable(m_manifestFileName));
+    }
+}
+
+void PluginManager::initLoadedPlugin(PluginInterface *plugin)
+{
+    QMutexLocker mutexLocker(&m_lazyLoadMutex);
+    m_lazyLoading = true;
+    plugin->initPlugin(&m_pluginAPI); // plugins keep the API
+    m_lazyLoading = false;
+}
+
+void PluginManager::unregisterPlugin(PluginInterface *plugin)
+{
+    // The proxy already reports the plugin unavailable. Registrations are not removed so that indexes held by
+    // the GUI, the web API or pending messages stay valid and lists read by other threads are not modified.
+    // The rest is done in the plugin manager thread.
+    qWarning("PluginManager::unregisterPlugin: %s", qPrintable(plugin->getPluginDescriptor().displayedName));
+
+    {
+        QMutexLocker mutexLocker(&m_unavailablePluginsMutex);
+        m_unavailablePlugins.append(plugin);
+    }
+
+    QMetaObject::invokeMethod(this, "handleUnavailablePlugins", Qt::QueuedConnection);
+}
+
+void PluginManager::handleUnavailablePlugins()
+{
+    QList<PluginInterface*> unavailablePlugins;
+
+    {
+        QMutexLocker mutexLocker(&m_unavailablePluginsMutex);
+        unavailablePlugins.swap(m_unavailablePlugins);
+    }
+
+    if (unavailablePlugins.size() == 0) {
+        return;
+    }
+
+    bool channelsChanged = false;
+
+    for (QList<PluginInterface*>::const_iterator it = unavailablePlugins.begin(); it != unavailablePlugins.end(); ++it)
+    {
+        for (int i = 0; i < m_rxChannelRegistrations.size(); i++) {
+            channelsChanged = channelsChanged || (m_rxChannelRegistrations[i].m_plugin == *it);
+        }
+
+        for (int i = 0; i < m_txChannelRegistrations.size(); i++) {
+            channelsChanged = channelsChanged || (m_txChannelRegistrations[i].m_plugin == *it);
+        }
+
+        DeviceEnumerator::instance()->removePluginDevices(*it);
+    }
+
+    saveManifest(); // without the unavailable plugins so that the next start tries a full load
+
+    if (channelsChanged) {
+        emit channelRegistrationsChanged();
+    }
 }
 
 void PluginManager::listTxChannels(QList<QString>& list)
@@ -224,7 +429,10 @@ void PluginManager::createRxChannelInstance(int channelPluginIndex, DeviceUISet
     {
         PluginInterface *pluginInterface = m_rxChannelRegistrations[channelPluginIndex].m_plugin;
         BasebandSampleSink *rxChannel = pluginInterface->createRxChannelBS(deviceAPI);
-        pluginInterface->createRxChannelGUI(deviceUISet, rxChannel);
+
+        if (rxChannel) { // null if the plugin library cannot be loaded
+            pluginInterface->createRxChannelGUI(deviceUISet, rxChannel);
+        }
     }
 }
 
@@ -234,6 +442,9 @@ void PluginManager::createTxChannelInstance(int channelPluginIndex, DeviceUISet
     {
         PluginInterface *pluginInterface = m_txChannelRegistrations[channelPluginIndex].m_plugin;
         BasebandSampleSource *txChannel = pluginInterface->createTxChannelBS(deviceAPI);
-        pluginInterface->createTxChannelGUI(deviceUISet, txChannel);
+
+        if (txChannel) { // null if the plugin library cannot be loaded
+            pluginInterface->createTxChannelGUI(deviceUISet, txChannel);
+        }
     }
 }
@@ -23,9 +23,11 @@
 #include <QDir>
 #include <QList>
 #include <QString>
+#include <QMutex>
 
 #include "plugin/plugininterface.h"
 #include "plugin/pluginapi.h"
+#include "plugin/pluginproxy.h"
 #include "export.h"
 
 class QComboBox;
@@ -42,7 +44,7 @@ public:
 	struct Plugin
 	{
 		QString filename;
-		PluginInterface* pluginInterface;
+		PluginInterface* pluginInterface; //!< a PluginProxy loading the library on demand
 
 		Plugin(const QString& _filename, PluginInterface* _plugin) :
 			filename(_filename),
@@ -84,6 +86,12 @@ public:
 	static const QString& getFileSinkDeviceId() { return m_fileSinkDeviceTypeID; }
 	static const QString& getTestMIMODeviceId() { return m_testMIMODeviceTypeID; }
 
+signals:
+	void channelRegistrationsChanged(); //!< a plugin that cannot be loaded was unregistered: its channels are to be shown unavailable
+
+private slots:
+	void handleUnavailablePlugins();
+
 private:
 	struct SamplingDevice { //!< This is the device registration
 		PluginInterface* m_plugin;
@@ -113,6 +121,16 @@ private:
 	PluginAPI m_pluginAPI;
 	Plugins m_plugins;
 
+	QString m_manifestFileName;        //!< cached manifest of the plugins of the plugins directory
+	QString m_devicesCacheFileName;    //!< cached device enumeration of the plugins of the plugins directory
+	bool m_manifestChanged;            //!< a plugin was loaded at startup or removed: manifest to be saved
+	PluginProxy *m_registeringProxy;   //!< proxy of the plugin loaded at startup that is registering
+	bool m_lazyLoading;                //!< a plugin loaded on demand is initializing: it is already registered
+	QMutex m_lazyLoadMutex;
+	QList<PluginInterface*> m_unavailablePlugins; //!< plugins that failed to load on demand waiting to be unregistered
+	QMutex m_unavailablePluginsMutex;
+	static const int m_manifestVersion;
+
 	PluginAPI::ChannelRegistrations m_rxChannelRegistrations;           //!< Channel plugins register here
 	PluginAPI::SamplingDeviceRegistrations m_sampleSourceRegistrations; //!< Input source plugins (one per device kind) register here
 
@@ -141,7 +159,12 @@ private:
     static const QString m_testMIMOHardwareID;       //!< Test MIMO hardware ID
     static const QString m_testMIMODeviceTypeID;     //!< Test MIMO plugin ID
 
-	void loadPluginsDir(const QDir& dir);
+	void loadPluginsDir(const QDir& dir, const QString& pluginsSubDir);
+	void saveManifest();
+	void initLoadedPlugin(PluginInterface *plugin); //!< called by the proxy of a plugin loaded on demand
+	void unregisterPlugin(PluginInterface *plugin); //!< called from any thread by the proxy of a plugin that cannot be loaded
+
+	friend class PluginProxy;
 };
 
 static inline bool operator<(const PluginManager::Plugin& a, const PluginManager::Plugin& b)
@@ -0,0 +1,367 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QCoreApplication>
+#include <QPluginLoader>
+#include <QElapsedTimer>
+#include <QJsonArray>
+
+#include "plugin/pluginapi.h"
+#include "plugin/pluginmanager.h"
+#include "plugin/pluginproxy.h"
+
+PluginProxy::PluginProxy(const Manifest& manifest, PluginManager *pluginManager) :
+    m_manifest(manifest),
+    m_descriptor(descriptorFromManifest(m_manifest)),
+    m_pluginManager(pluginManager),
+    m_plugin(nullptr),
+    m_loadFailed(0)
+{}
+
+PluginProxy::PluginProxy(PluginInterface *plugin, const QString& fileName, qint64 lastModified, qint64 size, PluginManager *pluginManager) :
+    m_manifest(manifestFromPlugin(plugin, fileName, lastModified, size)),
+    m_descriptor(descriptorFromManifest(m_manifest)),
+    m_pluginManager(pluginManager),
+    m_plugin(plugin),
+    m_loadFailed(0)
+{}
+
+PluginProxy::~PluginProxy()
+{}
+
+PluginDescriptor PluginProxy::descriptorFromManifest(const Manifest& manifest)
+{
+    PluginDescriptor descriptor = {
+        manifest.m_displayedName,
+        manifest.m_version,
+        manifest.m_copyright,
+        manifest.m_website,
+        manifest.m_licenseIsGPL,
+        manifest.m_sourceCodeURL
+    };
+
+    return descriptor;
+}
+
+PluginProxy::Manifest PluginProxy::manifestFromPlugin(PluginInterface *plugin, const QString& fileName, qint64 lastModified, qint64 size)
+{
+    const PluginDescriptor& descriptor = plugin->getPluginDescriptor();
+    Manifest manifest;
+    manifest.m_fileName = fileName;
+    manifest.m_lastModified = lastModified;
+    manifest.m_size = size;
+    manifest.m_displayedName = descriptor.displayedName;
+    manifest.m_version = descriptor.version;
+    manifest.m_copyright = descriptor.copyright;
+    manifest.m_website = descriptor.website;
+    manifest.m_licenseIsGPL = descriptor.licenseIsGPL;
+    manifest.m_sourceCodeURL = descriptor.sourceCodeURL;
+
+    return manifest;
+}
+
+QJsonObject PluginProxy::Manifest::toJson() const
+{
+    QJsonObject jsonObject;
+    jsonObject.insert("fileName", m_fileName);
+    jsonObject.insert("lastModified", m_lastModified);
+    jsonObject.insert("size", m_size);
+    jsonObject.insert("displayedName", m_displayedName);
+    jsonObject.insert("version", m_version);
+    jsonObject.insert("copyright", m_copyright);
+    jsonObject.insert("website", m_website);
+    jsonObject.insert("licenseIsGPL", m_licenseIsGPL);
+    jsonObject.insert("sourceCodeURL", m_sourceCodeURL);
+
+    QJsonArray rxChannels, txChannels;
+
+    for (int i = 0; i < m_rxChannels.size(); i++) {
+        rxChannels.append(QJsonArray({m_rxChannels[i].m_channelIdURI, m_rxChannels[i].m_channelId}));
+    }
+
+    for (int i = 0; i < m_txChannels.size(); i++) {
+        txChannels.append(QJsonArray({m_txChannels[i].m_channelIdURI, m_txChannels[i].m_channelId}));
+    }
+
+    jsonObject.insert("rxChannels", rxChannels);
+    jsonObject.insert("txChannels", txChannels);
+    jsonObject.insert("sampleSources", QJsonArray::fromStringList(m_sampleSources));
+    jsonObject.insert("sampleSinks", QJsonArray::fromStringList(m_sampleSinks));
+    jsonObject.insert("sampleMIMOs", QJsonArray::fromStringList(m_sampleMIMOs));
+
+    return jsonObject;
+}
+
+bool PluginProxy::Manifest::fromJson(const QJsonObject& jsonObject)
+{
+    if (!jsonObject.contains("fileName") || !jsonObject.contains("lastModified") || !jsonObject.contains("displayedName")) {
+        return false;
+    }
+
+    m_fileName = jsonObject.value("fileName").toString();
+    m_lastModified = (qint64) jsonObject.value("lastModified").toDouble();
+    m_size = (qint64) jsonObject.value("size").toDouble();
+    m_displayedName = jsonObject.value("displayedName").toString();
+    m_version = jsonObject.value("version").toString();
+    m_copyright = jsonObject.value("copyright").toString();
+    m_website = jsonObject.value("website").toString();
+    m_licenseIsGPL = jsonObject.value("licenseIsGPL").toBool();
+    m_sourceCodeURL = jsonObject.value("sourceCodeURL").toString();
+
+    QJsonArray rxChannels = jsonObject.value("rxChannels").toArray();
+    QJsonArray txChannels = jsonObject.value("txChannels").toArray();
+    m_rxChannels.clear();
+    m_txChannels.clear();
+
+    for (int i = 0; i < rxChannels.size(); i++)
+    {
+        QJsonArray channel = rxChannels[i].toArray();
+        m_rxChannels.append(ChannelRegistration(channel[0].toString(), channel[1].toString()));
+    }
+
+    for (int i = 0; i < txChannels.size(); i++)
+    {
+        QJsonArray channel = txChannels[i].toArray();
+        m_txChannels.append(ChannelRegistration(channel[0].toString(), channel[1].toString()));
+    }
+
+    m_sampleSources.clear();
+    m_sampleSinks.clear();
+    m_sampleMIMOs.clear();
+
+    foreach (const QJsonValue& value, jsonObject.value("sampleSources").toArray()) {
+        m_sampleSources.append(value.toString());
+    }
+
+    foreach (const QJsonValue& value, jsonObject.value("sampleSinks").toArray()) {
+        m_sampleSinks.append(value.toString());
+    }
+
+    foreach (const QJsonValue& value, jsonObject.value("sampleMIMOs").toArray()) {
+        m_sampleMIMOs.append(value.toString());
+    }
+
+    return true;
+}
+
+void PluginProxy::initPlugin(PluginAPI* pluginAPI)
+{
+    for (int i = 0; i < m_manifest.m_rxChannels.size(); i++) {
+        pluginAPI->registerRxChannel(m_manifest.m_rxChannels[i].m_channelIdURI, m_manifest.m_rxChannels[i].m_channelId, this);
+    }
+
+    for (int i = 0; i < m_manifest.m_txChannels.size(); i++) {
+        pluginAPI->registerTxChannel(m_manifest.m_txChannels[i].m_channelIdURI, m_manifest.m_txChannels[i].m_channelId, this);
+    }
+
+    for (int i = 0; i < m_manifest.m_sampleSources.size(); i++) {
+        pluginAPI->registerSampleSource(m_manifest.m_sampleSources[i], this);
+    }
+
+    for (int i = 0; i < m_manifest.m_sampleSinks.size(); i++) {
+        pluginAPI->registerSampleSink(m_manifest.m_sampleSinks[i], this);
+    }
+
+    for (int i = 0; i < m_manifest.m_sampleMIMOs.size(); i++) {
+        pluginAPI->registerSampleMIMO(m_manifest.m_sampleMIMOs[i], this);
+    }
+}
+
+bool PluginProxy::isAvailable(PluginInterface *plugin)
+{
+    PluginProxy *pluginProxy = dynamic_cast<PluginProxy*>(plugin);
+    return (plugin != nullptr) && (!pluginProxy || pluginProxy->getPlugin());
+}
+
+bool PluginProxy::isUnavailable(PluginInterface *plugin)
+{
+    PluginProxy *pluginProxy = dynamic_cast<PluginProxy*>(plugin);
+    return pluginProxy && pluginProxy->hasLoadFailed();
+}
+
+PluginInterface *PluginProxy::getPlugin()
+{
+    PluginInterface *plugin = m_plugin.loadAcquire();
+
+    if (plugin) {
+        return plugin;
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+    plugin = m_plugin.loadAcquire();
+
+    if (plugin || m_loadFailed.loadAcquire()) { // loaded by another thread meanwhile or cannot be loaded
+        return plugin;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QPluginLoader pluginLoader(m_manifest.m_fileName);
+
+    if (!pluginLoader.load())
+    {
+        qWarning("PluginProxy::getPlugin: %s", qPrintable(pluginLoader.errorString()));
+        m_loadFailed.storeRelease(1);
+        m_pluginManager->unregisterPlugin(this);
+        return nullptr;
+    }
+
+    plugin = qobject_cast<PluginInterface*>(pluginLoader.instance());
+
+    if (plugin == nullptr)
+    {
+        qWarning("PluginProxy::getPlugin: Unable to get main instance of plugin: %s", qPrintable(m_manifest.m_fileName));
+        m_loadFailed.storeRelease(1);
+        m_pluginManager->unregisterPlugin(this);
+        return nullptr;
+    }
+
+    // the first caller may be any thread (device set starter, web API handler...)
+    pluginLoader.instance()->moveToThread(QCoreApplication::instance()->thread());
+    m_pluginManager->initLoadedPlugin(plugin);
+    m_plugin.storeRelease(plugin);
+    qInfo("PluginProxy::getPlugin: loaded plugin %s in %lld ms", qPrintable(m_manifest.m_fileName), timer.elapsed());
+
+    return plugin;
+}
+
+PluginInstanceGUI* PluginProxy::createRxChannelGUI(DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createRxChannelGUI(deviceUISet, rxChannel) : nullptr;
+}
+
+BasebandSampleSink* PluginProxy::createRxChannelBS(DeviceAPI *deviceAPI)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createRxChannelBS(deviceAPI) : nullptr;
+}
+
+ChannelAPI* PluginProxy::createRxChannelCS(DeviceAPI *deviceAPI)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createRxChannelCS(deviceAPI) : nullptr;
+}
+
+PluginInstanceGUI* PluginProxy::createTxChannelGUI(DeviceUISet *deviceUISet, BasebandSampleSource *txChannel)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createTxChannelGUI(deviceUISet, txChannel) : nullptr;
+}
+
+BasebandSampleSource* PluginProxy::createTxChannelBS(DeviceAPI *deviceAPI)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createTxChannelBS(deviceAPI) : nullptr;
+}
+
+ChannelAPI* PluginProxy::createTxChannelCS(DeviceAPI *deviceAPI)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createTxChannelCS(deviceAPI) : nullptr;
+}
+
+PluginInterface::SamplingDevices PluginProxy::enumSampleSources()
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->enumSampleSources() : SamplingDevices();
+}
+
+PluginInstanceGUI* PluginProxy::createSampleSourcePluginInstanceGUI(const QString& sourceId, QWidget **widget, DeviceUISet *deviceUISet)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createSampleSourcePluginInstanceGUI(sourceId, widget, deviceUISet) : nullptr;
+}
+
+DeviceSampleSource* PluginProxy::createSampleSourcePluginInstance(const QString& sourceId, DeviceAPI *deviceAPI)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createSampleSourcePluginInstance(sourceId, deviceAPI) : nullptr;
+}
+
+void PluginProxy::deleteSampleSourcePluginInstanceGUI(PluginInstanceGUI *ui)
+{
+    PluginInterface *plugin = getPlugin();
+    if (plugin) { plugin->deleteSampleSourcePluginInstanceGUI(ui); }
+}
+
+void PluginProxy::deleteSampleSourcePluginInstanceInput(DeviceSampleSource *source)
+{
+    PluginInterface *plugin = getPlugin();
+    if (plugin) { plugin->deleteSampleSourcePluginInstanceInput(source); }
+}
+
+PluginInterface::SamplingDevices PluginProxy::enumSampleSinks()
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->enumSampleSinks() : SamplingDevices();
+}
+
+PluginInstanceGUI* PluginProxy::createSampleSinkPluginInstanceGUI(const QString& sinkId, QWidget **widget, DeviceUISet *deviceUISet)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createSampleSinkPluginInstanceGUI(sinkId, widget, deviceUISet) : nullptr;
+}
+
+DeviceSampleSink* PluginProxy::createSampleSinkPluginInstance(const QString& sinkId, DeviceAPI *deviceAPI)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createSampleSinkPluginInstance(sinkId, deviceAPI) : nullptr;
+}
+
+void PluginProxy::deleteSampleSinkPluginInstanceGUI(PluginInstanceGUI *ui)
+{
+    PluginInterface *plugin = getPlugin();
+    if (plugin) { plugin->deleteSampleSinkPluginInstanceGUI(ui); }
+}
+
+void PluginProxy::deleteSampleSinkPluginInstanceOutput(DeviceSampleSink *sink)
+{
+    PluginInterface *plugin = getPlugin();
+    if (plugin) { plugin->deleteSampleSinkPluginInstanceOutput(sink); }
+}
+
+PluginInterface::SamplingDevices PluginProxy::enumSampleMIMO()
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->enumSampleMIMO() : SamplingDevices();
+}
+
+PluginInstanceGUI* PluginProxy::createSampleMIMOPluginInstanceGUI(const QString& mimoId, QWidget **widget, DeviceUISet *deviceUISet)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createSampleMIMOPluginInstanceGUI(mimoId, widget, deviceUISet) : nullptr;
+}
+
+DeviceSampleMIMO* PluginProxy::createSampleMIMOPluginInstance(const QString& mimoId, DeviceAPI *deviceAPI)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createSampleMIMOPluginInstance(mimoId, deviceAPI) : nullptr;
+}
+
+void PluginProxy::deleteSampleMIMOPluginInstanceGUI(PluginInstanceGUI *ui)
+{
+    PluginInterface *plugin = getPlugin();
+    if (plugin) { plugin->deleteSampleMIMOPluginInstanceGUI(ui); }
+}
+
+void PluginProxy::deleteSampleMIMOPluginInstanceMIMO(DeviceSampleMIMO *mimo)
+{
+    PluginInterface *plugin = getPlugin();
+    if (plugin) { plugin->deleteSampleMIMOPluginInstanceMIMO(mimo); }
+}
@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_PLUGIN_PLUGINPROXY_H_
+#define SDRBASE_PLUGIN_PLUGINPROXY_H_
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QJsonObject>
+#include <QMutex>
+#include <QAtomicPointer>
+#include <QAtomicInt>
+
+#include "plugin/plugininterface.h"
+#include "export.h"
+
+class PluginManager;
+
+/**
+ * Stands for a plugin library in the plugin manager registrations. The library is loaded
+ * on the first call that needs the plugin code (channel or device creation, device enumeration).
+ * Until then the descriptor and registrations are those of the manifest cached at the
+ * previous run. A plugin loaded at startup (no valid manifest) has its manifest recorded
+ * while it registers.
+ */
+class SDRBASE_API PluginProxy : public PluginInterface
+{
+public:
+    struct ChannelRegistration
+    {
+        QString m_channelIdURI;
+        QString m_channelId;
+
+        ChannelRegistration(const QString& channelIdURI, const QString& channelId) :
+            m_channelIdURI(channelIdURI),
+            m_channelId(channelId)
+        {}
+    };
+
+    struct Manifest //!< what is needed to register a plugin without loading it
+    {
+        QString m_fileName;      //!< library absolute path
+        qint64 m_lastModified;   //!< library modification time in ms since epoch
+        qint64 m_size;           //!< library size in bytes
+        QString m_displayedName;
+        QString m_version;
+        QString m_copyright;
+        QString m_website;
+        bool m_licenseIsGPL;
+        QString m_sourceCodeURL;
+        QList<ChannelRegistration> m_rxChannels;
+        QList<ChannelRegistration> m_txChannels;
+        QStringList m_sampleSources;
+        QStringList m_sampleSinks;
+        QStringList m_sampleMIMOs;
+
+        Manifest() : m_lastModified(0), m_size(0), m_licenseIsGPL(false) {}
+        QJsonObject toJson() const;
+        bool fromJson(const QJsonObject& jsonObject);
+    };
+
+    PluginProxy(const Manifest& manifest, PluginManager *pluginManager); //!< plugin not loaded
+    PluginProxy(PluginInterface *plugin, const QString& fileName, qint64 lastModified, qint64 size, PluginManager *pluginManager); //!< plugin loaded
+    virtual ~PluginProxy();
+
+    const Manifest& getManifest() const { return m_manifest; }
+    bool isLoaded() const { return m_plugin.loadAcquire() != nullptr; }
+    PluginInterface *getPlugin(); //!< the plugin loaded if necessary or nullptr if it cannot be loaded (then unregistered)
+    bool hasLoadFailed() const { return m_loadFailed.loadAcquire() != 0; }
+    static bool isAvailable(PluginInterface *plugin); //!< false if the plugin is a proxy whose library cannot be loaded
+    static bool isUnavailable(PluginInterface *plugin); //!< true if the plugin is a proxy whose library failed to load. Does not try to load it.
+
+    // used by the plugin manager to record the manifest while a loaded plugin registers
+    void addRxChannel(const QString& channelIdURI, const QString& channelId) { m_manifest.m_rxChannels.append(ChannelRegistration(channelIdURI, channelId)); }
+    void addTxChannel(const QString& channelIdURI, const QString& channelId) { m_manifest.m_txChannels.append(ChannelRegistration(channelIdURI, channelId)); }
+    void addSampleSource(const QString& sourceName) { m_manifest.m_sampleSources.append(sourceName); }
+    void addSampleSink(const QString& sinkName) { m_manifest.m_sampleSinks.append(sinkName); }
+    void addSampleMIMO(const QString& mimoName) { m_manifest.m_sampleMIMOs.append(mimoName); }
+
+    virtual const PluginDescriptor& getPluginDescriptor() const { return m_descriptor; }
+    virtual void initPlugin(PluginAPI* pluginAPI); //!< registers from the manifest
+
+    virtual PluginInstanceGUI* createRxChannelGUI(DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel);
+    virtual BasebandSampleSink* createRxChannelBS(DeviceAPI *deviceAPI);
+    virtual ChannelAPI* createRxChannelCS(DeviceAPI *deviceAPI);
+
+    virtual PluginInstanceGUI* createTxChannelGUI(DeviceUISet *deviceUISet, BasebandSampleSource *txChannel);
+    virtual BasebandSampleSource* createTxChannelBS(DeviceAPI *deviceAPI);
+    virtual ChannelAPI* createTxChannelCS(DeviceAPI *deviceAPI);
+
+    virtual SamplingDevices enumSampleSources();
+    virtual PluginInstanceGUI* createSampleSourcePluginInstanceGUI(const QString& sourceId, QWidget **widget, DeviceUISet *deviceUISet);
+    virtual DeviceSampleSource* createSampleSourcePluginInstance(const QString& sourceId, DeviceAPI *deviceAPI);
+    virtual void deleteSampleSourcePluginInstanceGUI(PluginInstanceGUI *ui);
+    virtual void deleteSampleSourcePluginInstanceInput(DeviceSampleSource *source);
+
+    virtual SamplingDevices enumSampleSinks();
+    virtual PluginInstanceGUI* createSampleSinkPluginInstanceGUI(const QString& sinkId, QWidget **widget, DeviceUISet *deviceUISet);
+    virtual DeviceSampleSink* createSampleSinkPluginInstance(const QString& sinkId, DeviceAPI *deviceAPI);
+    virtual void deleteSampleSinkPluginInstanceGUI(PluginInstanceGUI *ui);
+    virtual void deleteSampleSinkPluginInstanceOutput(DeviceSampleSink *sink);
+
+    virtual SamplingDevices enumSampleMIMO();
+    virtual PluginInstanceGUI* createSampleMIMOPluginInstanceGUI(const QString& mimoId, QWidget **widget, DeviceUISet *deviceUISet);
+    virtual DeviceSampleMIMO* createSampleMIMOPluginInstance(const QString& mimoId, DeviceAPI *deviceAPI);
+    virtual void deleteSampleMIMOPluginInstanceGUI(PluginInstanceGUI *ui);
+    virtual void deleteSampleMIMOPluginInstanceMIMO(DeviceSampleMIMO *mimo);
+
+private:
+    Manifest m_manifest;
+    PluginDescriptor m_descriptor;
+    PluginManager *m_pluginManager;
+    QAtomicPointer<PluginInterface> m_plugin;
+    QAtomicInt m_loadFailed; //!< set under the load mutex, read by any thread
+    QMutex m_mutex; //!< serializes the library load
+
+    static PluginDescriptor descriptorFromManifest(const Manifest& manifest);
+    static Manifest manifestFromPlugin(PluginInterface *plugin, const QString& fileName, qint64 lastModified, qint64 size);
+};
+
+#endif // SDRBASE_PLUGIN_PLUGINPROXY_H_
@@ -1,11 +1,22 @@
 #include <QSettings>
 #include <QStringList>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QPair>
+#include <QStandardPaths>
+#include <QElapsedTimer>
 
 #include "settings/mainsettings.h"
 #include "commands/command.h"
 #include "audio/audiodevicemanager.h"
 #include "ambe/ambeengine.h"
 
+const quint32 MainSettings::m_presetsFileMagic = 0x53445250; // "SDRP"
+const quint32 MainSettings::m_presetsFileVersion = 1;
+
 MainSettings::MainSettings() :
     m_audioDeviceManager(nullptr),
     m_ambeEngine(nullptr)
@@ -39,9 +50,35 @@ int MainSettings::getFileFormat() const
     return (int) s.format();
 }
 
+QString MainSettings::getPresetsFileLocation() const
+{
+    QSettings s;
+
+#ifdef _WIN32
+    if (s.format() == QSettings::NativeFormat) { // registry: there is no settings file to put it next to
+        return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/presets.bin";
+    }
+#endif
+
+    QFileInfo fileInfo(s.fileName());
+    return fileInfo.absolutePath() + "/" + fileInfo.completeBaseName() + "-presets.bin";
+}
+
 void MainSettings::load()
 {
 	QSettings s;
+    QElapsedTimer timer;
+    timer.start();
+	QStringList groups = s.childGroups();
+    bool presetsInSettings = false;
+
+    // presets are saved in the settings only when the presets file could not be written
+    // (or by a previous version) so that they are more recent than the file
+    for (int i = 0; i < groups.size(); ++i) {
+        presetsInSettings = presetsInSettings || groups[i].startsWith("preset");
+    }
+
+    bool presetsFromFile = !presetsInSettings && loadPresetsFile(getPresetsFileLocation());
 
 	m_preferences.deserialize(qUncompress(QByteArray::fromBase64(s.value("preferences").toByteArray())));
 	m_workingPreset.deserialize(qUncompress(QByteArray::fromBase64(s.value("current").toByteArray())));
@@ -54,8 +91,6 @@ void MainSettings::load()
         m_ambeEngine->deserialize(qUncompress(QByteArray::fromBase64(s.value("ambe").toByteArray())));
     }
 
-	QStringList groups = s.childGroups();
-
 	for(int i = 0; i < groups.size(); ++i)
 	{
 		if (groups[i].startsWith("preset"))
@@ -93,6 +128,8 @@ void MainSettings::load()
 	}
 
     m_hardwareDeviceUserArgs.deserialize(qUncompress(QByteArray::fromBase64(s.value("hwDeviceUserArgs").toByteArray())));
+    qInfo("MainSettings::load: %d presets from %s in %lld ms",
+        m_presets.size(), presetsFromFile ? "presets file" : "settings", timer.elapsed());
 }
 
 void MainSettings::save() const
@@ -120,13 +157,19 @@ void MainSettings::save() const
 		}
 	}
 
-	for (int i = 0; i < m_presets.count(); ++i)
-	{
-		QString group = QString("preset-%1").arg(i + 1);
-		s.beginGroup(group);
-		s.setValue("data", qCompress(m_presets[i]->serialize()).toBase64());
-		s.endGroup();
-	}
+    if (!savePresetsFile(getPresetsFileLocation())) // fall back to the settings
+    {
+        QFile::remove(getPresetsFileLocation()); // outdated now
+
+        for (int i = 0; i < m_presets.count(); ++i)
+        {
+            QString group = QString("preset-%1").arg(i + 1);
+            s.beginGroup(group);
+            // the lazy data may carry an outdated group or description
+            s.setValue("data", qCompress(m_presets[i]->serialize()).toBase64());
+            s.endGroup();
+        }
+    }
 
     for (int i = 0; i < m_commands.count(); ++i)
     {
@@ -273,3 +316,119 @@ const Command* MainSettings::getCommand(const QString& groupName, const QString&
 
     return 0;
 }
+
+/**
+ * The presets file starts with an index of the presets followed by the compressed serialized presets.
+ * Only the index is decoded on load and each preset is decoded on its first use.
+ * - header: magic, version, number of presets
+ * - index entry: group, description, center frequency, source preset flag, offset and size of the data
+ * - data of all presets. Offsets are relative to the start of the data.
+ */
+bool MainSettings::loadPresetsFile(const QString& fileName)
+{
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QByteArray content = file.readAll();
+    file.close();
+
+    QDataStream stream(content);
+    stream.setVersion(QDataStream::Qt_5_0);
+    quint32 magic, version, nbPresets;
+    stream >> magic >> version >> nbPresets;
+
+    if ((stream.status() != QDataStream::Ok) || (magic != m_presetsFileMagic) || (version != m_presetsFileVersion))
+    {
+        qWarning("MainSettings::loadPresetsFile: %s is not a valid presets file", qPrintable(fileName));
+        return false;
+    }
+
+    QList<Preset*> presets;
+    QList<QPair<quint32, quint32>> dataRanges;
+
+    for (quint32 i = 0; (i < nbPresets) && (stream.status() == QDataStream::Ok); i++)
+    {
+        QString group, description;
+        quint64 centerFrequency;
+        bool sourcePreset;
+        quint32 offset, size;
+        stream >> group >> description >> centerFrequency >> sourcePreset >> offset >> size;
+
+        Preset *preset = new Preset();
+        preset->setGroup(group);
+        preset->setDescription(description);
+        preset->setCenterFrequency(centerFrequency);
+        preset->setSourcePreset(sourcePreset);
+        presets.append(preset);
+        dataRanges.append(QPair<quint32, quint32>(offset, size));
+    }
+
+    qint64 dataStart = stream.device()->pos();
+
+    if ((stream.status() != QDataStream::Ok) || (presets.size() != (int) nbPresets))
+    {
+        qWarning("MainSettings::loadPresetsFile: %s index is truncated", qPrintable(fileName));
+        qDeleteAll(presets);
+        return false;
+    }
+
+    for (int i = 0; i < presets.size(); i++)
+    {
+        if (dataStart + dataRanges[i].first + dataRanges[i].second > content.size())
+        {
+            qWarning("MainSettings::loadPresetsFile: %s data is truncated", qPrintable(fileName));
+            qDeleteAll(presets);
+            return false;
+        }
+
+        presets[i]->setLazyData(content.mid(dataStart + dataRanges[i].first, dataRanges[i].second));
+    }
+
+    m_presets.append(presets);
+    return true;
+}
+
+bool MainSettings::savePresetsFile(const QString& fileName) const
+{
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+    QSaveFile file(fileName);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qWarning("MainSettings::savePresetsFile: cannot open %s", qPrintable(fileName));
+        return false;
+    }
+
+    QList<QByteArray> presetsData;
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << m_presetsFileMagic << m_presetsFileVersion << (quint32) m_presets.size();
+    quint32 offset = 0;
+
+    for (int i = 0; i < m_presets.size(); i++)
+    {
+        presetsData.append(m_presets[i]->getCompressedData()); // lazy presets are not decoded
+        stream << m_presets[i]->getGroup()
+            << m_presets[i]->getDescription()
+            << (quint64) m_presets[i]->getCenterFrequency()
+            << m_presets[i]->isSourcePreset()
+            << offset
+            << (quint32) presetsData.back().size();
+        offset += presetsData.back().size();
+    }
+
+    for (int i = 0; i < presetsData.size(); i++) {
+        stream.writeRawData(presetsData[i].constData(), presetsData[i].size());
+    }
+
+    if ((stream.status() != QDataStream::Ok) || !file.commit())
+    {
+        qWarning("MainSettings::savePresetsFile: cannot write %s", qPrintable(fileName));
+        return false;
+    }
+
+    return true;
+}
@@ -22,6 +22,7 @@ public:
 	void resetToDefaults();
 	QString getFileLocation() const;
 	int getFileFormat() const; //!< see QSettings::Format for the values
+	QString getPresetsFileLocation() const; //!< binary file of the presets
 
 	Preset* newPreset(const QString& group, const QString& description);
 	void deletePreset(const Preset* preset);
@@ -76,6 +77,12 @@ protected:
     Commands m_commands;
 	DeviceUserArgs m_hardwareDeviceUserArgs;
     AMBEEngine *m_ambeEngine;
+
+    static const quint32 m_presetsFileMagic;
+    static const quint32 m_presetsFileVersion;
+
+    bool loadPresetsFile(const QString& fileName);
+    bool savePresetsFile(const QString& fileName) const;
 };
 
 #endif // INCLUDE_SETTINGS_H
@@ -2,6 +2,10 @@
 #include "settings/preset.h"
 
 #include <QDebug>
+#include <QMutex>
+
+// serializes the decoding of lazy presets accessed from different threads
+static QMutex s_lazyMutex;
 
 Preset::Preset()
 {
@@ -10,6 +14,8 @@ Preset::Preset()
 
 void Preset::resetToDefaults()
 {
+    m_lazyData.clear();
+    m_lazy.storeRelease(0);
     m_sourcePreset = true;
 	m_group = "default";
 	m_description = "no name";
@@ -27,6 +33,8 @@ void Preset::resetToDefaults()
 
 QByteArray Preset::serialize() const
 {
+    load();
+
 //	qDebug("Preset::serialize: m_group: %s mode: %s m_description: %s m_centerFrequency: %llu",
 //			qPrintable(m_group),
 //			m_sourcePreset ? "Rx" : "Tx",
@@ -78,6 +86,9 @@ QByteArray Preset::serialize() const
 
 bool Preset::deserialize(const QByteArray& data)
 {
+    m_lazyData.clear();
+    m_lazy.storeRelease(0);
+
 	SimpleDeserializer d(data);
 
 	if (!d.isValid())
@@ -159,11 +170,61 @@ bool Preset::deserialize(const QByteArray& data)
 	}
 }
 
+void Preset::setLazyData(const QByteArray& compressedData)
+{
+    QMutexLocker mutexLocker(&s_lazyMutex);
+    m_lazyData = compressedData;
+    m_lazy.storeRelease(1);
+}
+
+QByteArray Preset::getCompressedData() const
+{
+    if (m_lazy.loadAcquire())
+    {
+        QMutexLocker mutexLocker(&s_lazyMutex);
+
+        if (m_lazy.loadAcquire()) {
+            return m_lazyData;
+        }
+    }
+
+    return qCompress(serialize());
+}
+
+void Preset::decodeLazy() const
+{
+    QMutexLocker mutexLocker(&s_lazyMutex);
+
+    if (!m_lazy.loadAcquire()) { // decoded by another thread meanwhile
+        return;
+    }
+
+    // only the configurations are taken from the data as the index values may have changed since (e.g. group renamed)
+    Preset *self = const_cast<Preset*>(this);
+    Preset decoded;
+
+    if (decoded.deserialize(qUncompress(m_lazyData)))
+    {
+        self->m_layout = decoded.m_layout;
+        self->m_spectrumConfig = decoded.m_spectrumConfig;
+        self->m_deviceConfigs = decoded.m_deviceConfigs;
+        self->m_channelConfigs = decoded.m_channelConfigs;
+    }
+    else
+    {
+        qWarning("Preset::decodeLazy: cannot decode preset [%s | %s]", qPrintable(m_group), qPrintable(m_description));
+    }
+
+    self->m_lazyData.clear();
+    m_lazy.storeRelease(0);
+}
+
 void Preset::addOrUpdateDeviceConfig(const QString& sourceId,
 		const QString& sourceSerial,
 		int sourceSequence,
 		const QByteArray& config)
 {
+    load();
 	DeviceeConfigs::iterator it = m_deviceConfigs.begin();
 
 	for (; it != m_deviceConfigs.end(); ++it)
@@ -201,6 +262,8 @@ const QByteArray* Preset::findBestDeviceConfig(const QString& sourceId,
 		const QString& sourceSerial,
 		int sourceSequence) const
 {
+    load();
+
 	// Special case for SoapySDR based on serial (driver name)
 	if (sourceId == "sdrangel.samplesource.soapysdrinput") {
 		return findBestDeviceConfigSoapy(sourceId, sourceSerial);
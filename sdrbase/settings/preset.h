@@ -4,6 +4,7 @@
 #include <QString>
 #include <QList>
 #include <QMetaType>
+#include <QAtomicInt>
 
 #include "export.h"
 
@@ -50,6 +51,12 @@ public:
 	QByteArray serialize() const;
 	bool deserialize(const QByteArray& data);
 
+	/** Keep the compressed serialized data to deserialize it on first use of the configurations.
+	 *  Group, description, center frequency and direction must be set by the caller. */
+	void setLazyData(const QByteArray& compressedData);
+	bool isLazy() const { return m_lazy.loadAcquire() != 0; }
+	QByteArray getCompressedData() const; //!< compressed serialized data without decoding a lazy preset. Group, description, center frequency and direction may be outdated.
+
 	void setGroup(const QString& group) { m_group = group; }
 	const QString& getGroup() const { return m_group; }
 	void setDescription(const QString& description) { m_description = description; }
@@ -57,16 +64,16 @@ public:
 	void setCenterFrequency(const quint64 centerFrequency) { m_centerFrequency = centerFrequency; }
 	quint64 getCenterFrequency() const { return m_centerFrequency; }
 
-	void setSpectrumConfig(const QByteArray& data) { m_spectrumConfig = data; }
-	const QByteArray& getSpectrumConfig() const { return m_spectrumConfig; }
+	void setSpectrumConfig(const QByteArray& data) { load(); m_spectrumConfig = data; }
+	const QByteArray& getSpectrumConfig() const { load(); return m_spectrumConfig; }
 
-	void setLayout(const QByteArray& data) { m_layout = data; }
-	const QByteArray& getLayout() const { return m_layout; }
+	void setLayout(const QByteArray& data) { load(); m_layout = data; }
+	const QByteArray& getLayout() const { load(); return m_layout; }
 
-	void clearChannels() { m_channelConfigs.clear(); }
-	void addChannel(const QString& channel, const QByteArray& config) { m_channelConfigs.append(ChannelConfig(channel, config)); }
-	int getChannelCount() const { return m_channelConfigs.count(); }
-	const ChannelConfig& getChannelConfig(int index) const { return m_channelConfigs.at(index); }
+	void clearChannels() { load(); m_channelConfigs.clear(); }
+	void addChannel(const QString& channel, const QByteArray& config) { load(); m_channelConfigs.append(ChannelConfig(channel, config)); }
+	int getChannelCount() const { load(); return m_channelConfigs.count(); }
+	const ChannelConfig& getChannelConfig(int index) const { load(); return m_channelConfigs.at(index); }
 
 	void setDeviceConfig(const QString& deviceId, const QString& deviceSerial, int deviceSequence, const QByteArray& config)
 	{
@@ -128,7 +135,19 @@ protected:
 	// screen and dock layout
 	QByteArray m_layout;
 
+	// compressed serialized data not decoded yet
+	QByteArray m_lazyData;
+	mutable QAtomicInt m_lazy;
+
+	void load() const //!< decode lazy data if not done yet
+	{
+		if (m_lazy.loadAcquire()) {
+			decodeLazy();
+		}
+	}
+
 private:
+	void decodeLazy() const;
 	const QByteArray* findBestDeviceConfigSoapy(const QString& sourceId, const QString& deviceSerial) const;
 };
 
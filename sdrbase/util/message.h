@@ -20,11 +20,15 @@
 #define INCLUDE_MESSAGE_H
 
 #include <stdlib.h>
+#include <QAtomicPointer>
 #include "export.h"
+#include "util/messagepool.h"
 
 class SDRBASE_API Message {
 public:
 	Message();
+	Message(const Message& other);
+	Message& operator=(const Message& other);
 	virtual ~Message();
 
 	virtual const char* getIdentifier() const;
@@ -38,6 +42,10 @@ protected:
 	// addressing
 	static const char* m_identifier;
 	void* m_destination;
+
+private:
+	friend class MessageQueue;
+	QAtomicPointer<Message> m_queueNext; //!< Intrusive link used by MessageQueue
 };
 
 #define MESSAGE_CLASS_DECLARATION \
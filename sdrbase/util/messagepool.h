@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_UTIL_MESSAGEPOOL_H
+#define INCLUDE_UTIL_MESSAGEPOOL_H
+
+#include <new>
+#include <cstddef>
+
+#include "util/spinlock.h"
+
+#define MESSAGEPOOL_MAX_FREE 256
+
+/**
+ * Free list of storage blocks for one message class. Messages of classes declared with
+ * MESSAGE_CLASS_POOL_DECLARATION are created and deleted from the message producer and consumer
+ * threads at a high rate. Deleted messages storage is kept here (up to MESSAGEPOOL_MAX_FREE blocks)
+ * and reused by the next creation so that the allocator is not hit in steady state.
+ * Derived classes of a pooled class with a different size are served by the global allocator.
+ */
+template<typename T>
+class MessagePool
+{
+public:
+    static void *allocate(std::size_t size)
+    {
+        if (size == sizeof(T))
+        {
+            Pool& pool = instance();
+            SpinlockHolder holder(&pool.m_lock);
+
+            if (pool.m_free)
+            {
+                FreeBlock *block = pool.m_free;
+                pool.m_free = block->m_next;
+                pool.m_nbFree--;
+                return block;
+            }
+        }
+
+        return ::operator new(size);
+    }
+
+    static void release(void *p, std::size_t size)
+    {
+        if (!p) {
+            return;
+        }
+
+        if (size == sizeof(T))
+        {
+            Pool& pool = instance();
+            SpinlockHolder holder(&pool.m_lock);
+
+            if (pool.m_nbFree < MESSAGEPOOL_MAX_FREE)
+            {
+                FreeBlock *block = static_cast<FreeBlock*>(p);
+                block->m_next = pool.m_free;
+                pool.m_free = block;
+                pool.m_nbFree++;
+                return;
+            }
+        }
+
+        ::operator delete(p);
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock *m_next;
+    };
+
+    struct Pool {
+        Pool() : m_free(nullptr), m_nbFree(0) {}
+
+        ~Pool()
+        {
+            while (m_free)
+            {
+                FreeBlock *block = m_free;
+                m_free = block->m_next;
+                ::operator delete(block);
+            }
+        }
+
+        Spinlock m_lock;
+        FreeBlock *m_free;
+        int m_nbFree;
+    };
+
+    static Pool& instance()
+    {
+        static Pool pool;
+        return pool;
+    }
+};
+
+#define MESSAGE_CLASS_POOL_DECLARATION \
+    public: \
+        static void *operator new(std::size_t size); \
+        static void operator delete(void *p, std::size_t size); \
+    private:
+
+#define MESSAGE_CLASS_POOL_DEFINITION(Name) \
+    void *Name::operator new(std::size_t size) { return MessagePool<Name>::allocate(size); } \
+    void Name::operator delete(void *p, std::size_t size) { MessagePool<Name>::release(p, size); }
+
+#endif // INCLUDE_UTIL_MESSAGEPOOL_H
@@ -17,14 +17,14 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <QDebug>
-#include <QMutexLocker>
 #include "util/messagequeue.h"
 #include "util/message.h"
 
 MessageQueue::MessageQueue(QObject* parent) :
 	QObject(parent),
-	m_lock(QMutex::Recursive),
-	m_queue()
+	m_head(&m_stub),
+	m_tail(&m_stub),
+	m_size(0)
 {
 }
 
@@ -39,13 +39,19 @@ MessageQueue::~MessageQueue()
 	}
 }
 
+void MessageQueue::link(Message* message)
+{
+	message->m_queueNext.storeRelease(nullptr);
+	Message* prev = m_head.fetchAndStoreOrdered(message);
+	prev->m_queueNext.storeRelease(message);
+}
+
 void MessageQueue::push(Message* message, bool emitSignal)
 {
 	if (message)
 	{
-		m_lock.lock();
-		m_queue.append(message);
-		m_lock.unlock();
+		m_size.fetchAndAddOrdered(1);
+		link(message);
 	}
 
 	if (emitSignal)
@@ -56,30 +62,51 @@ void MessageQueue::push(Message* message, bool emitSignal)
 
 Message* MessageQueue::pop()
 {
-	QMutexLocker locker(&m_lock);
+	SpinlockHolder holder(&m_popLock);
+	Message* tail = m_tail;
+	Message* next = tail->m_queueNext.loadAcquire();
 
-	if (m_queue.isEmpty())
+	if (tail == &m_stub)
 	{
-		return 0;
+		if (!next) {
+			return 0; // empty
+		}
+
+		m_tail = next;
+		tail = next;
+		next = next->m_queueNext.loadAcquire();
 	}
-	else
+
+	if (next)
 	{
-		return m_queue.takeFirst();
+		m_tail = next;
+		m_size.fetchAndAddOrdered(-1);
+		return tail;
 	}
-}
 
-int MessageQueue::size()
-{
-	QMutexLocker locker(&m_lock);
+	if (tail != m_head.loadAcquire()) {
+		return 0; // a producer is linking a message. It will signal when done.
+	}
 
-	return m_queue.size();
+	// tail is the last message: put the stub back behind it so that it can be detached
+	link(&m_stub);
+	next = tail->m_queueNext.loadAcquire();
+
+	if (next)
+	{
+		m_tail = next;
+		m_size.fetchAndAddOrdered(-1);
+		return tail;
+	}
+
+	return 0;
 }
 
 void MessageQueue::clear()
 {
-	QMutexLocker locker(&m_lock);
+	Message* message;
 
-    while (!m_queue.isEmpty()) {
-        delete m_queue.takeFirst();
-    }
+	while ((message = pop()) != 0) {
+		delete message;
+	}
 }
@@ -20,12 +20,17 @@
 #define INCLUDE_MESSAGEQUEUE_H
 
 #include <QObject>
-#include <QQueue>
-#include <QMutex>
+#include <QAtomicInt>
+#include <QAtomicPointer>
 #include "export.h"
-
-class Message;
-
+#include "util/message.h"
+#include "util/spinlock.h"
+
+/**
+ * Multiple producers single consumer message queue. Messages are linked intrusively so pushing
+ * is lock free and does not allocate. The consumer side is serialized by a spin lock that is
+ * uncontended in normal operation where only the owner of the queue pops messages.
+ */
 class SDRBASE_API MessageQueue : public QObject {
 	Q_OBJECT
 
@@ -36,15 +41,20 @@ public:
 	void push(Message* message, bool emitSignal = true);  //!< Push message onto queue
 	Message* pop(); //!< Pop message from queue
 
-	int size(); //!< Returns queue size
+	int size() const { return m_size.loadAcquire(); } //!< Returns queue size. Lock free hint that can be polled in loops.
 	void clear(); //!< Empty queue
 
 signals:
 	void messageEnqueued();
 
 private:
-	QMutex m_lock;
-	QQueue<Message*> m_queue;
+	QAtomicPointer<Message> m_head; //!< Last pushed message (producers side)
+	Message* m_tail;                //!< Next message to pop (consumer side)
+	Message m_stub;                 //!< Sentinel so that the list is never empty
+	QAtomicInt m_size;
+	Spinlock m_popLock;
+
+	void link(Message* message);
 };
 
 #endif // INCLUDE_MESSAGEQUEUE_H
@@ -72,12 +72,12 @@ RTPSink::~RTPSink()
     }
 }
 
-void RTPSink::setPayloadInformation(PayloadType payloadType, int sampleRate)
+void RTPSink::setPayloadInformation(PayloadType payloadType, int sampleRate, int opusFrameMs)
 {
     uint32_t timestampinc;
     QMutexLocker locker(&m_mutex);
 
-    qDebug("RTPSink::setPayloadInformation: payloadType: %d sampleRate: %d", payloadType, sampleRate);
+    qDebug("RTPSink::setPayloadInformation: payloadType: %d sampleRate: %d opusFrameMs: %d", payloadType, sampleRate, opusFrameMs);
 
     switch (payloadType)
     {
@@ -114,8 +114,8 @@ void RTPSink::setPayloadInformation(PayloadType payloadType, int sampleRate)
     case PayloadOpus:
         m_sampleBytes = 1;
         m_rtpSession.SetDefaultPayloadType(96);
-        m_packetSamples = 160; // Payload size is 160 bytes
-        timestampinc = 960;    // But increment is 960
+        m_packetSamples = 8*opusFrameMs; // One frame per packet: 160 bytes for 20ms at 64 kbits/s
+        timestampinc = 48*opusFrameMs;   // But increment is in 48 kHz clock units: 960 for 20ms
         break;
     case PayloadL16Mono:
     default:
@@ -54,7 +54,7 @@ public:
     ~RTPSink();
 
     bool isValid() const { return m_valid; }
-    void setPayloadInformation(PayloadType payloadType, int sampleRate);
+    void setPayloadInformation(PayloadType payloadType, int sampleRate, int opusFrameMs = 20); //!< Opus frames of 5, 10 or 20 ms are sent one per packet
 
     void setDestination(const QString& address, uint16_t port);
     void deleteDestination(const QString& address, uint16_t port);
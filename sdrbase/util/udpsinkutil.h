@@ -20,55 +20,55 @@
 #define INCLUDE_UTIL_UDPSINK_H_
 
 #include <stdint.h>
+#include <string.h>
+#include <vector>
 #include <QObject>
 #include <QUdpSocket>
 #include <QHostAddress>
 
 #include <cassert>
 
+#ifdef __linux__
+#include <errno.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#endif
+
+/**
+ * Sends samples in fixed size UDP datagrams. Complete datagrams are accumulated in a batch
+ * buffer and sent all at once when it is full or when flush() is called (normally at the end
+ * of each block of samples processed). On Linux the batch goes out in a single sendmmsg call.
+ * When the destination is a multicast group the datagrams are sent once whatever the number
+ * of receivers (multicast TTL is 1 i.e. the local network).
+ */
 template<typename T>
 class UDPSinkUtil
 {
 public:
 	UDPSinkUtil(QObject *parent, unsigned int udpSize) :
-		m_udpSize(udpSize),
-		m_udpSamples(udpSize/sizeof(T)),
 		m_address(QHostAddress::LocalHost),
-		m_port(9999),
-		m_sampleBufferIndex(0)
+		m_port(9999)
 	{
-        assert(m_udpSamples > 0);
-		m_sampleBuffer = new T[m_udpSamples];
-		m_socket = new QUdpSocket(parent);
+		create(parent, udpSize);
 	}
 
     UDPSinkUtil(QObject *parent, unsigned int udpSize, unsigned int port) :
-        m_udpSize(udpSize),
-        m_udpSamples(udpSize/sizeof(T)),
         m_address(QHostAddress::LocalHost),
-        m_port(port),
-        m_sampleBufferIndex(0)
+        m_port(port)
     {
-        assert(m_udpSamples > 0);
-        m_sampleBuffer = new T[m_udpSamples];
-        m_socket = new QUdpSocket(parent);
+        create(parent, udpSize);
     }
 
 	UDPSinkUtil (QObject *parent, unsigned int udpSize, QHostAddress& address, unsigned int port) :
-		m_udpSize(udpSize),
-        m_udpSamples(udpSize/sizeof(T)),
 		m_address(address),
-		m_port(port),
-		m_sampleBufferIndex(0)
+		m_port(port)
 	{
-		assert(m_udpSamples > 0);
-		m_sampleBuffer = new T[m_udpSamples];
-		m_socket = new QUdpSocket(parent);
+		create(parent, udpSize);
 	}
 
 	~UDPSinkUtil()
 	{
-		delete[] m_sampleBuffer;
+		delete[] m_batchBuffer;
 		delete m_socket;
 	}
 
@@ -77,13 +77,21 @@ public:
 	    m_socket->moveToThread(thread);
 	}
 
-	void setAddress(QString& address) { m_address.setAddress(address); }
+	void setAddress(QString& address)
+	{
+		m_address.setAddress(address);
+		bindSocket();
+		setMulticastOptions();
+	}
+
 	void setPort(unsigned int port) { m_port = port; }
 
 	void setDestination(const QString& address, int port)
 	{
 	    m_address.setAddress(const_cast<QString&>(address));
 	    m_port = port;
+	    bindSocket();
+	    setMulticastOptions();
 	}
 
 	/**
@@ -91,53 +99,170 @@ public:
 	 */
 	void write(T sample)
 	{
-		if (m_sampleBufferIndex < m_udpSamples)
-		{
-			m_sampleBuffer[m_sampleBufferIndex] = sample;
-			m_sampleBufferIndex++;
-		}
-		else
+		m_batchBuffer[m_sampleBufferIndex++] = sample;
+
+		if (m_sampleBufferIndex == m_batchSamples)
 		{
-			m_socket->writeDatagram((const char*)&m_sampleBuffer[0], (qint64 ) m_udpSize, m_address, m_port);
-			m_sampleBuffer[0] = sample;
-			m_sampleBufferIndex = 1;
+			sendBatch(m_batchSize);
+			m_sampleBufferIndex = 0;
 		}
 	}
 
 	/**
 	 * Write a bunch of samples
 	 */
-	void write(T *samples, int nbSamples)
+	void write(const T *samples, int nbSamples)
 	{
-	    int samplesIndex = 0;
-
-	    if (m_sampleBufferIndex + nbSamples > m_udpSamples) // fill remainder of buffer and send it
+	    while (nbSamples > 0)
 	    {
-	        memcpy(&m_sampleBuffer[m_sampleBufferIndex], &samples[samplesIndex], (m_udpSamples - m_sampleBufferIndex)*sizeof(T)); // fill remainder of buffer
-	        m_socket->writeDatagram((const char*)&m_sampleBuffer[0], (qint64 ) m_udpSize, m_address, m_port); // send buffer
-            samplesIndex += (m_udpSamples - m_sampleBufferIndex);
-            nbSamples -= (m_udpSamples - m_sampleBufferIndex);
-	        m_sampleBufferIndex = 0;
-	    }
+	        int count = m_batchSamples - m_sampleBufferIndex;
+	        count = nbSamples < count ? nbSamples : count;
+	        memcpy(&m_batchBuffer[m_sampleBufferIndex], samples, count*sizeof(T));
+	        m_sampleBufferIndex += count;
+	        samples += count;
+	        nbSamples -= count;
 
-	    while (nbSamples > m_udpSamples) // send directly from input without buffering
-	    {
-	        m_socket->writeDatagram((const char*)&samples[samplesIndex], (qint64 ) m_udpSize, m_address, m_port);
-	        samplesIndex += m_udpSamples;
-	        nbSamples -= m_udpSamples;
+	        if (m_sampleBufferIndex == m_batchSamples)
+	        {
+	            sendBatch(m_batchSize);
+	            m_sampleBufferIndex = 0;
+	        }
 	    }
+	}
+
+	/**
+	 * Send the complete datagrams. The incomplete one is kept for the next writes.
+	 */
+	void flush()
+	{
+		int nbDatagrams = m_sampleBufferIndex / m_udpSamples;
+
+		if (nbDatagrams == 0) {
+			return;
+		}
 
-	    memcpy(&m_sampleBuffer[m_sampleBufferIndex], &samples[samplesIndex], nbSamples*sizeof(T)); // copy remainder of input to buffer
+		sendBatch(nbDatagrams);
+		int remainder = m_sampleBufferIndex - nbDatagrams*m_udpSamples;
+		memmove(m_batchBuffer, &m_batchBuffer[nbDatagrams*m_udpSamples], remainder*sizeof(T));
+		m_sampleBufferIndex = remainder;
 	}
 
 private:
+	static const int m_batchSize = 32; //!< maximum number of datagrams sent at once
+
+	void create(QObject *parent, unsigned int udpSize)
+	{
+		m_udpSamples = udpSize/sizeof(T);
+		assert(m_udpSamples > 0);
+		m_udpSize = m_udpSamples*sizeof(T);
+		m_batchSamples = m_batchSize*m_udpSamples;
+		m_batchBuffer = new T[m_batchSamples];
+		m_sampleBufferIndex = 0;
+		m_socket = new QUdpSocket(parent);
+		bindSocket(); // from the owner thread rather than implicitly at the first send
+	}
+
+	bool bindSocket()
+	{
+		// the socket must be of the same protocol as the destination
+		QHostAddress bindAddress(m_address.protocol() == QAbstractSocket::IPv6Protocol ? QHostAddress::AnyIPv6 : QHostAddress::AnyIPv4);
+
+		if (m_socket->state() == QAbstractSocket::BoundState)
+		{
+			if (m_socket->localAddress().protocol() == bindAddress.protocol()) {
+				return true;
+			}
+
+			m_socket->abort(); // destination has changed protocol
+		}
+
+		return m_socket->bind(bindAddress, 0);
+	}
+
+	void setMulticastOptions()
+	{
+		if (m_address.isMulticast() && bindSocket())
+		{
+			m_socket->setSocketOption(QAbstractSocket::MulticastTtlOption, 1);
+			m_socket->setSocketOption(QAbstractSocket::MulticastLoopbackOption, 1); // receivers on this host
+		}
+	}
+
+	void sendBatch(int nbDatagrams)
+	{
+#ifdef __linux__
+		if (sendBatchNative(nbDatagrams)) {
+			return;
+		}
+#endif
+		for (int i = 0; i < nbDatagrams; i++) {
+			m_socket->writeDatagram((const char*)&m_batchBuffer[i*m_udpSamples], (qint64 ) m_udpSize, m_address, m_port);
+		}
+	}
+
+#ifdef __linux__
+	bool sendBatchNative(int nbDatagrams)
+	{
+		if ((m_address.protocol() != QAbstractSocket::IPv4Protocol) || !bindSocket()) {
+			return false;
+		}
+
+		int fd = m_socket->socketDescriptor();
+
+		if (fd < 0) {
+			return false;
+		}
+
+		memset(&m_sockAddr, 0, sizeof(m_sockAddr));
+		m_sockAddr.sin_family = AF_INET;
+		m_sockAddr.sin_port = htons(m_port);
+		m_sockAddr.sin_addr.s_addr = htonl(m_address.toIPv4Address());
+
+		for (int i = 0; i < nbDatagrams; i++)
+		{
+			m_iovecs[i].iov_base = (void *) &m_batchBuffer[i*m_udpSamples];
+			m_iovecs[i].iov_len = m_udpSize;
+			memset(&m_msgs[i], 0, sizeof(struct mmsghdr));
+			m_msgs[i].msg_hdr.msg_name = &m_sockAddr;
+			m_msgs[i].msg_hdr.msg_namelen = sizeof(m_sockAddr);
+			m_msgs[i].msg_hdr.msg_iov = &m_iovecs[i];
+			m_msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		int sent = 0;
+
+		while (sent < nbDatagrams)
+		{
+			int res = sendmmsg(fd, &m_msgs[sent], nbDatagrams - sent, 0);
+
+			if (res < 0)
+			{
+				if (errno == EINTR) {
+					continue;
+				}
+
+				break; // non blocking socket: the remainder is dropped like with writeDatagram
+			}
+
+			sent += res;
+		}
+
+		return true;
+	}
+
+	struct sockaddr_in m_sockAddr;
+	struct mmsghdr m_msgs[m_batchSize];
+	struct iovec m_iovecs[m_batchSize];
+#endif
+
 	int m_udpSize;
     int m_udpSamples;
 	QHostAddress m_address;
 	unsigned int m_port;
 	QUdpSocket *m_socket;
-	T *m_sampleBuffer;;
-	int m_sampleBufferIndex;
+	T *m_batchBuffer;          //!< room for m_batchSize datagrams
+	int m_batchSamples;
+	int m_sampleBufferIndex;   //!< write position in the batch buffer
 };
 
 
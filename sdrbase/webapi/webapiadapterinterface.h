@@ -33,6 +33,7 @@ namespace SWGSDRangel
     class SWGInstanceDevicesResponse;
     class SWGInstanceChannelsResponse;
     class SWGLoggingInfo;
+    class SWGStartupTimings;
     class SWGAudioDevices;
     class SWGAudioInputDevice;
     class SWGAudioOutputDevice;
@@ -151,6 +152,20 @@ public:
     	return 501;
     }
 
+    /**
+     * Handler of /sdrangel/startup (GET) swagger/sdrangel/code/html2/index.html#api-Default-instanceStartupGet
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int instanceStartupGet(
+            SWGSDRangel::SWGStartupTimings& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) response;
+    	error.init();
+    	*error.getMessage() = QString("Function not implemented");
+    	return 501;
+    }
+
     /**
      * Handler of /sdrangel/audio (GET) swagger/sdrangel/code/html2/index.html#api-Default-instanceChannels
      * returns the Http status code (default 501: not implemented)
@@ -773,6 +788,7 @@ public:
     static QString instanceDevicesURL;
     static QString instanceChannelsURL;
     static QString instanceLoggingURL;
+    static QString instanceStartupURL;
     static QString instanceAudioURL;
     static QString instanceAudioInputParametersURL;
     static QString instanceAudioOutputParametersURL;
@@ -785,6 +801,7 @@ public:
     static QString instancePresetURL;
     static QString instancePresetFileURL;
     static QString instanceDeviceSetsURL;
+    static QString instanceDeviceSetsReportURL;
     static QString instanceDeviceSetURL;
     static std::regex devicesetURLRe;
     static std::regex devicesetFocusURLRe;
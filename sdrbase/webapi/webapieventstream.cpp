@@ -0,0 +1,154 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QWebSocketServer>
+#include <QWebSocket>
+#include <QHostAddress>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDebug>
+
+#include "webapirequestmapper.h"
+#include "webapieventstream.h"
+
+WebAPIEventStream::WebAPIEventStream(WebAPIRequestMapper *requestMapper, QObject *parent) :
+    QObject(parent),
+    m_requestMapper(requestMapper),
+    m_server(nullptr),
+    m_token(0),
+    m_periodMs(1000)
+{
+    connect(&m_timer, SIGNAL(timeout()), this, SLOT(tick()));
+}
+
+WebAPIEventStream::~WebAPIEventStream()
+{
+    stop();
+}
+
+bool WebAPIEventStream::start(const QString& host, uint16_t port)
+{
+    stop();
+    m_server = new QWebSocketServer(QStringLiteral("SDRangel events"), QWebSocketServer::NonSecureMode, this);
+
+    if (!m_server->listen(QHostAddress(host), port))
+    {
+        qWarning("WebAPIEventStream::start: cannot listen at ws://%s:%d: %s",
+            qPrintable(host), port, qPrintable(m_server->errorString()));
+        delete m_server;
+        m_server = nullptr;
+        return false;
+    }
+
+    connect(m_server, SIGNAL(newConnection()), this, SLOT(newConnection()));
+    m_timer.start(m_periodMs);
+    qInfo("WebAPIEventStream::start: starting web API events at ws://%s:%d every %d ms", qPrintable(host), port, m_periodMs);
+
+    return true;
+}
+
+void WebAPIEventStream::stop()
+{
+    m_timer.stop();
+
+    if (m_server)
+    {
+        m_server->close();
+        qDeleteAll(m_clients);
+        qDeleteAll(m_newClients);
+        m_clients.clear();
+        m_newClients.clear();
+        delete m_server;
+        m_server = nullptr;
+        qInfo("WebAPIEventStream::stop: stopped web API events");
+    }
+}
+
+void WebAPIEventStream::setPeriod(int periodMs)
+{
+    m_periodMs = periodMs < 50 ? 50 : periodMs;
+
+    if (m_timer.isActive()) {
+        m_timer.start(m_periodMs);
+    }
+}
+
+void WebAPIEventStream::newConnection()
+{
+    while (m_server->hasPendingConnections())
+    {
+        QWebSocket *client = m_server->nextPendingConnection();
+        connect(client, SIGNAL(disconnected()), this, SLOT(clientDisconnected()));
+        m_newClients.append(client);
+        qDebug() << "WebAPIEventStream::newConnection:" << client->peerAddress().toString() << client->peerPort();
+    }
+}
+
+void WebAPIEventStream::clientDisconnected()
+{
+    QWebSocket *client = qobject_cast<QWebSocket*>(sender());
+
+    if (client)
+    {
+        qDebug() << "WebAPIEventStream::clientDisconnected:" << client->peerAddress().toString() << client->peerPort();
+        m_clients.removeAll(client);
+        m_newClients.removeAll(client);
+        client->deleteLater();
+    }
+}
+
+void WebAPIEventStream::tick()
+{
+    // nothing is collected without clients. Cached values are kept so that changes
+    // from the last token are still correct when clients are back.
+    if (m_clients.size() > 0)
+    {
+        QJsonObject changes = m_requestMapper->deviceSetsReport(m_cache, m_token, true);
+        m_token = (qint64) changes.value("token").toDouble();
+
+        if ((changes.value("deviceSets").toArray().size() > 0) || (changes.value("removed").toArray().size() > 0))
+        {
+            QString message = QString::fromUtf8(QJsonDocument(changes).toJson(QJsonDocument::Compact));
+
+            for (QWebSocket *client : m_clients) {
+                client->sendTextMessage(message);
+            }
+        }
+    }
+
+    // full state for new clients. Changes found by this second pass have a later generation
+    // than m_token so the other clients get them next time.
+    if (m_newClients.size() > 0)
+    {
+        QJsonObject state = m_requestMapper->deviceSetsReport(m_cache, 0, true);
+        QString message = QString::fromUtf8(QJsonDocument(state).toJson(QJsonDocument::Compact));
+
+        if (m_clients.size() == 0) {
+            m_token = (qint64) state.value("token").toDouble();
+        }
+
+        for (QWebSocket *client : m_newClients)
+        {
+            client->sendTextMessage(message);
+            m_clients.append(client);
+        }
+
+        m_newClients.clear();
+    }
+}
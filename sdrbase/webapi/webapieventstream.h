@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_WEBAPI_WEBAPIEVENTSTREAM_H_
+#define SDRBASE_WEBAPI_WEBAPIEVENTSTREAM_H_
+
+#include <QObject>
+#include <QList>
+#include <QTimer>
+
+#include "webapireportcache.h"
+#include "export.h"
+
+class QWebSocketServer;
+class QWebSocket;
+class WebAPIRequestMapper;
+
+/**
+ * Pushes the changes of device and channel reports, settings and device states to WebSocket clients.
+ *
+ * Every period all reports and settings are collected once and compared to the previous ones. The
+ * changed fields are serialized once in a JSON text message (same layout as /sdrangel/devicesets/report)
+ * sent to all clients. Changes within a period are coalesced and nothing is sent if nothing changed.
+ * A new client first receives the full state then the changes.
+ */
+class SDRBASE_API WebAPIEventStream : public QObject
+{
+    Q_OBJECT
+public:
+    WebAPIEventStream(WebAPIRequestMapper *requestMapper, QObject *parent = nullptr);
+    ~WebAPIEventStream();
+
+    bool start(const QString& host, uint16_t port);
+    void stop();
+    void setPeriod(int periodMs);
+    int getPeriod() const { return m_periodMs; }
+    int getNbClients() const { return m_clients.size() + m_newClients.size(); }
+
+private:
+    WebAPIRequestMapper *m_requestMapper;
+    QWebSocketServer *m_server;
+    QList<QWebSocket*> m_clients;    //!< clients up to date with the last message
+    QList<QWebSocket*> m_newClients; //!< clients waiting for the full state
+    WebAPIReportCache m_cache;
+    qint64 m_token;                  //!< generation of the last changes sent
+    QTimer m_timer;
+    int m_periodMs;
+
+private slots:
+    void newConnection();
+    void clientDisconnected();
+    void tick();
+};
+
+#endif // SDRBASE_WEBAPI_WEBAPIEVENTSTREAM_H_
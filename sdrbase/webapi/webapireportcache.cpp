@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDateTime>
+
+#include "webapireportcache.h"
+
+WebAPIReportCache::WebAPIReportCache()
+{
+    // start from the time so that tokens of a previous run are not taken for tokens of this one
+    m_generation = QDateTime::currentMSecsSinceEpoch();
+    m_firstGeneration = m_generation + 1;
+}
+
+WebAPIReportCache::~WebAPIReportCache()
+{}
+
+qint64 WebAPIReportCache::startGeneration()
+{
+    return ++m_generation;
+}
+
+bool WebAPIReportCache::isKnownToken(qint64 since) const
+{
+    return (since >= m_firstGeneration) && (since < m_generation);
+}
+
+QJsonObject WebAPIReportCache::update(const QString& key, const QJsonObject& report, qint64 since)
+{
+    QHash<QString, QJsonValue> values;
+    flatten(report, QString(), values);
+
+    QHash<QString, Report>::iterator it = m_reports.find(key);
+
+    if (it == m_reports.end()) {
+        it = m_reports.insert(key, Report());
+    }
+
+    Report& cached = it.value();
+    bool sameFields = cached.m_values.size() == values.size();
+
+    for (QHash<QString, QJsonValue>::const_iterator vit = values.begin(); sameFields && (vit != values.end()); ++vit) {
+        sameFields = cached.m_values.contains(vit.key());
+    }
+
+    if (sameFields) // record changes field by field
+    {
+        for (QHash<QString, QJsonValue>::const_iterator vit = values.begin(); vit != values.end(); ++vit)
+        {
+            QJsonValue& cachedValue = cached.m_values[vit.key()];
+
+            if (cachedValue != vit.value())
+            {
+                cachedValue = vit.value();
+                cached.m_changes[vit.key()] = m_generation;
+            }
+        }
+    }
+    else // new report or report structure has changed: all fields change
+    {
+        cached.m_values = values;
+        cached.m_changes.clear();
+
+        for (QHash<QString, QJsonValue>::const_iterator vit = values.begin(); vit != values.end(); ++vit) {
+            cached.m_changes.insert(vit.key(), m_generation);
+        }
+    }
+
+    cached.m_generation = m_generation;
+    m_removed.remove(key);
+
+    if (!isKnownToken(since)) {
+        return report;
+    }
+
+    QJsonObject delta;
+
+    for (QHash<QString, qint64>::const_iterator cit = cached.m_changes.begin(); cit != cached.m_changes.end(); ++cit)
+    {
+        if (cit.value() > since) {
+            insertPath(delta, cit.key().split('.'), 0, cached.m_values[cit.key()]);
+        }
+    }
+
+    return delta;
+}
+
+QStringList WebAPIReportCache::endGeneration(qint64 since)
+{
+    QHash<QString, Report>::iterator it = m_reports.begin();
+
+    while (it != m_reports.end())
+    {
+        if (it.value().m_generation != m_generation)
+        {
+            m_removed.insert(it.key(), m_generation);
+            it = m_reports.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    QStringList removed;
+
+    if (isKnownToken(since))
+    {
+        for (QHash<QString, qint64>::const_iterator rit = m_removed.begin(); rit != m_removed.end(); ++rit)
+        {
+            if (rit.value() > since) {
+                removed.append(rit.key());
+            }
+        }
+    }
+
+    return removed;
+}
+
+void WebAPIReportCache::flatten(const QJsonObject& object, const QString& prefix, QHash<QString, QJsonValue>& values)
+{
+    for (QJsonObject::const_iterator it = object.begin(); it != object.end(); ++it)
+    {
+        QString path = prefix.isEmpty() ? it.key() : prefix + "." + it.key();
+
+        if (it.value().isObject()) {
+            flatten(it.value().toObject(), path, values);
+        } else {
+            values.insert(path, it.value());
+        }
+    }
+}
+
+void WebAPIReportCache::insertPath(QJsonObject& object, const QStringList& path, int level, const QJsonValue& value)
+{
+    if (level == path.size() - 1)
+    {
+        object.insert(path[level], value);
+    }
+    else
+    {
+        QJsonObject child = object.value(path[level]).toObject();
+        insertPath(child, path, level + 1, value);
+        object.insert(path[level], child);
+    }
+}
@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_WEBAPI_WEBAPIREPORTCACHE_H_
+#define SDRBASE_WEBAPI_WEBAPIREPORTCACHE_H_
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QJsonObject>
+#include <QJsonValue>
+
+#include "export.h"
+
+/**
+ * Last values of the reports served in bulk and the generation at which each field last changed.
+ * Each bulk request is a new generation and its number is the token given back to the client.
+ * With this token the next request gets only the fields that changed since.
+ *
+ * Reports are identified by a key (e.g "0" for a device and "0:1" for a channel). Nested objects
+ * are compared field by field and arrays as a whole.
+ *
+ * Not thread safe: the caller serializes generations.
+ */
+class SDRBASE_API WebAPIReportCache
+{
+public:
+    WebAPIReportCache();
+    ~WebAPIReportCache();
+
+    /** Start a new generation of reports and return its token */
+    qint64 startGeneration();
+    /** True if changes since this token are known. If not the full reports should be sent. */
+    bool isKnownToken(qint64 since) const;
+    /**
+     * Store the report of this generation at key and return its fields changed since the given token.
+     * If since is not a known token all fields are returned.
+     */
+    QJsonObject update(const QString& key, const QJsonObject& report, qint64 since);
+    /** End the generation. Reports not updated are removed. Returns the keys removed since the given token. */
+    QStringList endGeneration(qint64 since);
+
+private:
+    struct Report
+    {
+        QHash<QString, QJsonValue> m_values;  //!< field values by path
+        QHash<QString, qint64> m_changes;     //!< generation of last change by path
+        qint64 m_generation;                  //!< generation of last update
+    };
+
+    static void flatten(const QJsonObject& object, const QString& prefix, QHash<QString, QJsonValue>& values);
+    static void insertPath(QJsonObject& object, const QStringList& path, int level, const QJsonValue& value);
+
+    QHash<QString, Report> m_reports;
+    QHash<QString, qint64> m_removed;  //!< generation of removal by key
+    qint64 m_firstGeneration;          //!< changes before this are unknown
+    qint64 m_generation;
+};
+
+#endif // SDRBASE_WEBAPI_WEBAPIREPORTCACHE_H_
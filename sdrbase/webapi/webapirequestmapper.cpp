@@ -20,6 +20,9 @@
 #include <QDirIterator>
 #include <QJsonDocument>
 #include <QJsonArray>
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+#include <QCborValue>
+#endif
 
 #include <boost/lexical_cast.hpp>
 
@@ -30,6 +33,7 @@
 #include "SWGInstanceChannelsResponse.h"
 #include "SWGAudioDevices.h"
 #include "SWGLocationInformation.h"
+#include "SWGStartupTimings.h"
 #include "SWGDVSerialDevices.h"
 #include "SWGAMBEDevices.h"
 #include "SWGPresets.h"
@@ -37,6 +41,7 @@
 #include "SWGPresetIdentifier.h"
 #include "SWGPresetImport.h"
 #include "SWGPresetExport.h"
+#include "SWGDeviceSetList.h"
 #include "SWGDeviceSettings.h"
 #include "SWGDeviceState.h"
 #include "SWGDeviceReport.h"
@@ -94,79 +99,104 @@ void WebAPIRequestMapper::service(qtwebapp::HttpRequest& request, qtwebapp::Http
             return;
         }
 
-        if (path == WebAPIAdapterInterface::instanceSummaryURL) {
+        std::string indexes[WebAPIRouter::m_maxIndexes];
+
+        switch (m_router.match(path.constData(), path.length(), indexes))
+        {
+        case WebAPIRouter::RouteInstanceSummary:
             instanceSummaryService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceDevicesURL) {
+            break;
+        case WebAPIRouter::RouteInstanceDevices:
             instanceDevicesService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceChannelsURL) {
+            break;
+        case WebAPIRouter::RouteInstanceChannels:
             instanceChannelsService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceLoggingURL) {
+            break;
+        case WebAPIRouter::RouteInstanceLogging:
             instanceLoggingService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioURL) {
+            break;
+        case WebAPIRouter::RouteInstanceStartup:
+            instanceStartupService(request, response);
+            break;
+        case WebAPIRouter::RouteInstanceAudio:
             instanceAudioService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioInputParametersURL) {
+            break;
+        case WebAPIRouter::RouteInstanceAudioInputParameters:
             instanceAudioInputParametersService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioOutputParametersURL) {
+            break;
+        case WebAPIRouter::RouteInstanceAudioOutputParameters:
             instanceAudioOutputParametersService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioInputCleanupURL) {
+            break;
+        case WebAPIRouter::RouteInstanceAudioInputCleanup:
             instanceAudioInputCleanupService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioOutputCleanupURL) {
+            break;
+        case WebAPIRouter::RouteInstanceAudioOutputCleanup:
             instanceAudioOutputCleanupService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceLocationURL) {
+            break;
+        case WebAPIRouter::RouteInstanceLocation:
             instanceLocationService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAMBESerialURL) {
+            break;
+        case WebAPIRouter::RouteInstanceAMBESerial:
             instanceAMBESerialService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAMBEDevicesURL) {
+            break;
+        case WebAPIRouter::RouteInstanceAMBEDevices:
             instanceAMBEDevicesService(request, response);
-        } else if (path == WebAPIAdapterInterface::instancePresetsURL) {
+            break;
+        case WebAPIRouter::RouteInstancePresets:
             instancePresetsService(request, response);
-        } else if (path == WebAPIAdapterInterface::instancePresetURL) {
+            break;
+        case WebAPIRouter::RouteInstancePreset:
             instancePresetService(request, response);
-        } else if (path == WebAPIAdapterInterface::instancePresetFileURL) {
+            break;
+        case WebAPIRouter::RouteInstancePresetFile:
             instancePresetFileService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceDeviceSetsURL) {
+            break;
+        case WebAPIRouter::RouteInstanceDeviceSets:
             instanceDeviceSetsService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceDeviceSetURL) {
+            break;
+        case WebAPIRouter::RouteInstanceDeviceSetsReport:
+            instanceDeviceSetsReportService(request, response);
+            break;
+        case WebAPIRouter::RouteInstanceDeviceSet:
             instanceDeviceSetService(request, response);
-        }
-        else
-        {
-            std::smatch desc_match;
-            std::string pathStr(path.constData(), path.length());
-
-            if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetURLRe)) {
-                devicesetService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceURLRe)) {
-                devicesetDeviceService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetFocusURLRe)) {
-                devicesetFocusService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceSettingsURLRe)) {
-                devicesetDeviceSettingsService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceRunURLRe)) {
-                devicesetDeviceRunService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceReportURLRe)) {
-                devicesetDeviceReportService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelsReportURLRe)) {
-                devicesetChannelsReportService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelURLRe)) {
-                devicesetChannelService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelIndexURLRe)) {
-                devicesetChannelIndexService(std::string(desc_match[1]), std::string(desc_match[2]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelSettingsURLRe)) {
-                devicesetChannelSettingsService(std::string(desc_match[1]), std::string(desc_match[2]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelReportURLRe)) {
-                devicesetChannelReportService(std::string(desc_match[1]), std::string(desc_match[2]), request, response);
-            }
-            else // serve static documentation pages
-            {
-                m_staticFileController->service(request, response);
-            }
-
-//            QDirIterator it(":", QDirIterator::Subdirectories);
-//            while (it.hasNext()) {
-//                qDebug() << "WebAPIRequestMapper::service: " << it.next();
-//            }
-
+            break;
+        case WebAPIRouter::RouteDeviceset:
+            devicesetService(indexes[0], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetFocus:
+            devicesetFocusService(indexes[0], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetDevice:
+            devicesetDeviceService(indexes[0], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetDeviceSettings:
+            devicesetDeviceSettingsService(indexes[0], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetDeviceRun:
+            devicesetDeviceRunService(indexes[0], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetDeviceReport:
+            devicesetDeviceReportService(indexes[0], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetChannelsReport:
+            devicesetChannelsReportService(indexes[0], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetChannel:
+            devicesetChannelService(indexes[0], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetChannelIndex:
+            devicesetChannelIndexService(indexes[0], indexes[1], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetChannelSettings:
+            devicesetChannelSettingsService(indexes[0], indexes[1], request, response);
+            break;
+        case WebAPIRouter::RouteDevicesetChannelReport:
+            devicesetChannelReportService(indexes[0], indexes[1], request, response);
+            break;
+        case WebAPIRouter::RouteNone:
+        default: // serve static documentation pages
+            m_staticFileController->service(request, response);
+            break;
         }
     }
 }
@@ -343,6 +373,34 @@ void WebAPIRequestMapper::instanceLoggingService(qtwebapp::HttpRequest& request,
     }
 }
 
+void WebAPIRequestMapper::instanceStartupService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    if (request.getMethod() == "GET")
+    {
+        SWGSDRangel::SWGStartupTimings normalResponse;
+
+        int status = m_adapter->instanceStartupGet(normalResponse, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else
+    {
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
 void WebAPIRequestMapper::instanceAudioService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
@@ -1035,6 +1093,59 @@ void WebAPIRequestMapper::instanceDeviceSetsService(qtwebapp::HttpRequest& reque
     }
 }
 
+void WebAPIRequestMapper::instanceDeviceSetsReportService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    if (request.getMethod() == "GET")
+    {
+        QByteArray sinceStr = request.getParameter("since");
+        qint64 since = 0;
+
+        if (sinceStr.length() != 0)
+        {
+            bool ok;
+            qint64 tmp = sinceStr.toLongLong(&ok);
+            if (ok) {
+                since = tmp;
+            }
+        }
+
+        QJsonObject report;
+
+        {
+            QMutexLocker mutexLocker(&m_reportCacheMutex);
+            report = deviceSetsReport(m_reportCache, since, false);
+        }
+
+        bool cbor = (request.getParameter("format") == "cbor") || request.getHeader("Accept").contains("application/cbor");
+        response.setStatus(200);
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+        if (cbor)
+        {
+            response.setHeader("Content-Type", "application/cbor");
+            response.write(QCborValue::fromJsonValue(report).toCbor());
+            return;
+        }
+#else
+        (void) cbor; // CBOR needs Qt 5.12: always reply in JSON
+#endif
+
+        response.setHeader("Content-Type", "application/json");
+        response.write(QJsonDocument(report).toJson(QJsonDocument::Compact));
+    }
+    else
+    {
+        response.setHeader("Content-Type", "application/json");
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
 void WebAPIRequestMapper::instanceDeviceSetService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
@@ -2701,6 +2812,21 @@ bool WebAPIRequestMapper::validateAudioOutputDevice(
         audioOutputDevice.setUdpPort(jsonObject["udpPort"].toInt());
         audioOutputDeviceKeys.append("udpPort");
     }
+    if (jsonObject.contains("lowLatency"))
+    {
+        audioOutputDevice.setLowLatency(jsonObject["lowLatency"].toInt() == 0 ? 0 : 1);
+        audioOutputDeviceKeys.append("lowLatency");
+    }
+    if (jsonObject.contains("udpBlockSize"))
+    {
+        audioOutputDevice.setUdpBlockSize(jsonObject["udpBlockSize"].toInt());
+        audioOutputDeviceKeys.append("udpBlockSize");
+    }
+    if (jsonObject.contains("udpOpusFrameDuration"))
+    {
+        audioOutputDevice.setUdpOpusFrameDuration(jsonObject["udpOpusFrameDuration"].toInt());
+        audioOutputDeviceKeys.append("udpOpusFrameDuration");
+    }
     return true;
 }
 
@@ -2879,3 +3005,114 @@ void WebAPIRequestMapper::resetAudioOutputDevice(SWGSDRangel::SWGAudioOutputDevi
     audioOutputDevice.setName(0);
     audioOutputDevice.setUdpAddress(0);
 }
+
+QJsonObject WebAPIRequestMapper::deviceSetsReport(WebAPIReportCache& cache, qint64 since, bool withSettings)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    SWGSDRangel::SWGDeviceSetList deviceSetList;
+    qint64 token = cache.startGeneration();
+    bool delta = cache.isKnownToken(since);
+    QJsonArray deviceSetsArray;
+
+    if (m_adapter->instanceDeviceSetsGet(deviceSetList, errorResponse)/100 == 2)
+    {
+        QList<SWGSDRangel::SWGDeviceSet*> *deviceSets = deviceSetList.getDeviceSets();
+
+        for (int deviceSetIndex = 0; deviceSets && (deviceSetIndex < deviceSets->size()); deviceSetIndex++)
+        {
+            QJsonObject deviceSetObject;
+            QJsonArray channelsArray;
+            QString deviceKey = QString::number(deviceSetIndex);
+            SWGSDRangel::SWGDeviceReport deviceReport;
+            resetDeviceReport(deviceReport);
+
+            if (m_adapter->devicesetDeviceReportGet(deviceSetIndex, deviceReport, errorResponse)/100 == 2) {
+                insertChanges(deviceSetObject, "deviceReport", cache, deviceKey, deviceReport, since);
+            }
+
+            if (withSettings)
+            {
+                SWGSDRangel::SWGDeviceSettings deviceSettings;
+                SWGSDRangel::SWGDeviceState deviceState;
+                resetDeviceSettings(deviceSettings);
+
+                if (m_adapter->devicesetDeviceSettingsGet(deviceSetIndex, deviceSettings, errorResponse)/100 == 2) {
+                    insertChanges(deviceSetObject, "deviceSettings", cache, deviceKey + "/settings", deviceSettings, since);
+                }
+
+                if (m_adapter->devicesetDeviceRunGet(deviceSetIndex, deviceState, errorResponse)/100 == 2) {
+                    insertChanges(deviceSetObject, "deviceState", cache, deviceKey + "/state", deviceState, since);
+                }
+            }
+
+            int nbChannels = deviceSets->at(deviceSetIndex)->getChannelcount();
+
+            for (int channelIndex = 0; channelIndex < nbChannels; channelIndex++)
+            {
+                QJsonObject channelObject;
+                QString channelKey = QString("%1:%2").arg(deviceSetIndex).arg(channelIndex);
+                SWGSDRangel::SWGChannelReport channelReport;
+                resetChannelReport(channelReport);
+
+                if (m_adapter->devicesetChannelReportGet(deviceSetIndex, channelIndex, channelReport, errorResponse)/100 == 2) {
+                    insertChanges(channelObject, "report", cache, channelKey, channelReport, since);
+                }
+
+                if (withSettings)
+                {
+                    SWGSDRangel::SWGChannelSettings channelSettings;
+                    resetChannelSettings(channelSettings);
+
+                    if (m_adapter->devicesetChannelSettingsGet(deviceSetIndex, channelIndex, channelSettings, errorResponse)/100 == 2) {
+                        insertChanges(channelObject, "settings", cache, channelKey + "/settings", channelSettings, since);
+                    }
+                }
+
+                if (!channelObject.isEmpty())
+                {
+                    channelObject.insert("index", channelIndex);
+                    channelsArray.append(channelObject);
+                }
+            }
+
+            if (!channelsArray.isEmpty()) {
+                deviceSetObject.insert("channels", channelsArray);
+            }
+
+            if (!delta || !deviceSetObject.isEmpty())
+            {
+                deviceSetObject.insert("index", deviceSetIndex);
+                deviceSetsArray.append(deviceSetObject);
+            }
+        }
+    }
+
+    QStringList removed = cache.endGeneration(since);
+    QJsonObject report;
+    report.insert("token", token);
+    report.insert("delta", delta);
+    report.insert("deviceSets", deviceSetsArray);
+
+    if (delta) {
+        report.insert("removed", QJsonArray::fromStringList(removed));
+    }
+
+    return report;
+}
+
+void WebAPIRequestMapper::insertChanges(
+        QJsonObject& parent,
+        const QString& name,
+        WebAPIReportCache& cache,
+        const QString& key,
+        SWGSDRangel::SWGObject& swgObject,
+        qint64 since)
+{
+    QJsonObject *jsonObject = swgObject.asJsonObject();
+    QJsonObject changes = cache.update(key, *jsonObject, since);
+    delete jsonObject;
+
+    if (!changes.isEmpty()) {
+        parent.insert(name, changes);
+    }
+}
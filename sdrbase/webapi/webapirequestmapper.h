@@ -21,17 +21,21 @@
 #define SDRBASE_WEBAPI_WEBAPIREQUESTMAPPER_H_
 
 #include <QJsonParseError>
+#include <QMutex>
 
 #include "httprequesthandler.h"
 #include "httprequest.h"
 #include "httpresponse.h"
 #include "staticfilecontroller.h"
 #include "webapiadapterinterface.h"
+#include "webapireportcache.h"
+#include "webapirouter.h"
 
 #include "export.h"
 
 namespace SWGSDRangel
 {
+    class SWGObject;
     class SWGPresetTransfer;
     class SWGPresetIdentifier;
 }
@@ -43,15 +47,24 @@ public:
     ~WebAPIRequestMapper();
     void service(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void setAdapter(WebAPIAdapterInterface *adapter) { m_adapter = adapter; }
+    /**
+     * Reports of all devices and channels and optionally their settings and the devices state.
+     * Only the changes since the token are kept if the cache knows it. The caller serializes calls on the same cache.
+     */
+    QJsonObject deviceSetsReport(WebAPIReportCache& cache, qint64 since, bool withSettings);
 
 private:
     WebAPIAdapterInterface *m_adapter;
     qtwebapp::StaticFileController *m_staticFileController;
+    WebAPIRouter m_router;
+    WebAPIReportCache m_reportCache;  //!< last bulk reports for delta responses
+    QMutex m_reportCacheMutex;
 
     void instanceSummaryService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void instanceDevicesService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void instanceChannelsService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void instanceLoggingService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void instanceStartupService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void instanceAudioService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void instanceAudioInputParametersService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void instanceAudioOutputParametersService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
@@ -65,6 +78,7 @@ private:
     void instancePresetService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void instancePresetFileService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void instanceDeviceSetsService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void instanceDeviceSetsReportService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void instanceDeviceSetService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
 
     void devicesetService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
@@ -108,6 +122,14 @@ private:
     void resetChannelReport(SWGSDRangel::SWGChannelReport& deviceSettings);
     void resetAudioInputDevice(SWGSDRangel::SWGAudioInputDevice& audioInputDevice);
     void resetAudioOutputDevice(SWGSDRangel::SWGAudioOutputDevice& audioOutputDevice);
+
+    void insertChanges(
+            QJsonObject& parent,
+            const QString& name,
+            WebAPIReportCache& cache,
+            const QString& key,
+            SWGSDRangel::SWGObject& swgObject,
+            qint64 since);
 };
 
 #endif /* SDRBASE_WEBAPI_WEBAPIREQUESTMAPPER_H_ */
@@ -0,0 +1,182 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+
+#include <QDebug>
+
+#include "webapiadapterinterface.h"
+#include "webapirouter.h"
+
+WebAPIRouter::WebAPIRouter()
+{
+    m_nodes.push_back(Node()); // root
+
+    addRoute(WebAPIAdapterInterface::instanceSummaryURL.toStdString(), RouteInstanceSummary);
+    addRoute(WebAPIAdapterInterface::instanceDevicesURL.toStdString(), RouteInstanceDevices);
+    addRoute(WebAPIAdapterInterface::instanceChannelsURL.toStdString(), RouteInstanceChannels);
+    addRoute(WebAPIAdapterInterface::instanceLoggingURL.toStdString(), RouteInstanceLogging);
+    addRoute(WebAPIAdapterInterface::instanceStartupURL.toStdString(), RouteInstanceStartup);
+    addRoute(WebAPIAdapterInterface::instanceAudioURL.toStdString(), RouteInstanceAudio);
+    addRoute(WebAPIAdapterInterface::instanceAudioInputParametersURL.toStdString(), RouteInstanceAudioInputParameters);
+    addRoute(WebAPIAdapterInterface::instanceAudioOutputParametersURL.toStdString(), RouteInstanceAudioOutputParameters);
+    addRoute(WebAPIAdapterInterface::instanceAudioInputCleanupURL.toStdString(), RouteInstanceAudioInputCleanup);
+    addRoute(WebAPIAdapterInterface::instanceAudioOutputCleanupURL.toStdString(), RouteInstanceAudioOutputCleanup);
+    addRoute(WebAPIAdapterInterface::instanceLocationURL.toStdString(), RouteInstanceLocation);
+    addRoute(WebAPIAdapterInterface::instanceAMBESerialURL.toStdString(), RouteInstanceAMBESerial);
+    addRoute(WebAPIAdapterInterface::instanceAMBEDevicesURL.toStdString(), RouteInstanceAMBEDevices);
+    addRoute(WebAPIAdapterInterface::instancePresetsURL.toStdString(), RouteInstancePresets);
+    addRoute(WebAPIAdapterInterface::instancePresetURL.toStdString(), RouteInstancePreset);
+    addRoute(WebAPIAdapterInterface::instancePresetFileURL.toStdString(), RouteInstancePresetFile);
+    addRoute(WebAPIAdapterInterface::instanceDeviceSetsURL.toStdString(), RouteInstanceDeviceSets);
+    addRoute(WebAPIAdapterInterface::instanceDeviceSetsReportURL.toStdString(), RouteInstanceDeviceSetsReport);
+    addRoute(WebAPIAdapterInterface::instanceDeviceSetURL.toStdString(), RouteInstanceDeviceSet);
+    addRoute("/sdrangel/deviceset/{index}", RouteDeviceset);
+    addRoute("/sdrangel/deviceset/{index}/focus", RouteDevicesetFocus);
+    addRoute("/sdrangel/deviceset/{index}/device", RouteDevicesetDevice);
+    addRoute("/sdrangel/deviceset/{index}/device/settings", RouteDevicesetDeviceSettings);
+    addRoute("/sdrangel/deviceset/{index}/device/run", RouteDevicesetDeviceRun);
+    addRoute("/sdrangel/deviceset/{index}/device/report", RouteDevicesetDeviceReport);
+    addRoute("/sdrangel/deviceset/{index}/channels/report", RouteDevicesetChannelsReport);
+    addRoute("/sdrangel/deviceset/{index}/channel", RouteDevicesetChannel);
+    addRoute("/sdrangel/deviceset/{index}/channel/{index}", RouteDevicesetChannelIndex);
+    addRoute("/sdrangel/deviceset/{index}/channel/{index}/settings", RouteDevicesetChannelSettings);
+    addRoute("/sdrangel/deviceset/{index}/channel/{index}/report", RouteDevicesetChannelReport);
+}
+
+WebAPIRouter::~WebAPIRouter()
+{}
+
+void WebAPIRouter::addRoute(const std::string& pattern, Route route)
+{
+    int node = 0;
+    int nbIndexes = 0;
+    std::size_t start = pattern.size() > 0 && pattern[0] == '/' ? 1 : 0;
+
+    while (start <= pattern.size())
+    {
+        std::size_t stop = pattern.find('/', start);
+
+        if (stop == std::string::npos) {
+            stop = pattern.size();
+        }
+
+        std::string segment = pattern.substr(start, stop - start);
+        int next;
+
+        if (segment == "{index}")
+        {
+            if (++nbIndexes > m_maxIndexes)
+            {
+                qWarning("WebAPIRouter::addRoute: too many indexes in %s", pattern.c_str());
+                return;
+            }
+
+            next = m_nodes[node].m_indexChild;
+
+            if (next < 0)
+            {
+                next = m_nodes.size();
+                m_nodes[node].m_indexChild = next;
+                m_nodes.push_back(Node());
+            }
+        }
+        else
+        {
+            next = -1;
+
+            for (const auto& child : m_nodes[node].m_children)
+            {
+                if (child.first == segment)
+                {
+                    next = child.second;
+                    break;
+                }
+            }
+
+            if (next < 0)
+            {
+                next = m_nodes.size();
+                m_nodes[node].m_children.push_back(std::pair<std::string, int>(segment, next));
+                m_nodes.push_back(Node());
+            }
+        }
+
+        node = next;
+        start = stop + 1;
+    }
+
+    if (m_nodes[node].m_route != RouteNone) {
+        qWarning("WebAPIRouter::addRoute: %s replaces route %d", pattern.c_str(), (int) m_nodes[node].m_route);
+    }
+
+    m_nodes[node].m_route = route;
+}
+
+WebAPIRouter::Route WebAPIRouter::match(const char *path, int length, std::string indexes[m_maxIndexes]) const
+{
+    int node = 0;
+    int nbIndexes = 0;
+    int start = 1;
+
+    if ((length <= start) || (path[0] != '/')) { // empty or relative path
+        return RouteNone;
+    }
+
+    while (start <= length)
+    {
+        const char *end = (const char *) memchr(path + start, '/', length - start);
+        int stop = end ? end - path : length;
+        int segmentLength = stop - start;
+        const Node& current = m_nodes[node];
+        int next = -1;
+
+        for (const auto& child : current.m_children)
+        {
+            if (((int) child.first.size() == segmentLength) && (memcmp(child.first.data(), path + start, segmentLength) == 0))
+            {
+                next = child.second;
+                break;
+            }
+        }
+
+        if ((next < 0) && (current.m_indexChild >= 0) && (segmentLength > 0) && (segmentLength <= 2))
+        {
+            bool digits = true;
+
+            for (int i = start; i < stop; i++) {
+                digits = digits && (path[i] >= '0') && (path[i] <= '9');
+            }
+
+            if (digits)
+            {
+                indexes[nbIndexes++].assign(path + start, segmentLength);
+                next = current.m_indexChild;
+            }
+        }
+
+        if (next < 0) {
+            return RouteNone;
+        }
+
+        node = next;
+        start = stop + 1;
+    }
+
+    return m_nodes[node].m_route;
+}
@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_WEBAPI_WEBAPIROUTER_H_
+#define SDRBASE_WEBAPI_WEBAPIROUTER_H_
+
+#include <string>
+#include <vector>
+
+#include "export.h"
+
+/**
+ * Maps a request path to a route with a tree of path segments built once.
+ * A path is walked one segment at a time: a segment either matches a literal
+ * child of the current node or the index child of the node. Index segments are
+ * 1 or 2 decimal digits and are returned to the caller in path order.
+ */
+class SDRBASE_API WebAPIRouter
+{
+public:
+    enum Route
+    {
+        RouteNone,
+        RouteInstanceSummary,
+        RouteInstanceDevices,
+        RouteInstanceChannels,
+        RouteInstanceLogging,
+        RouteInstanceStartup,
+        RouteInstanceAudio,
+        RouteInstanceAudioInputParameters,
+        RouteInstanceAudioOutputParameters,
+        RouteInstanceAudioInputCleanup,
+        RouteInstanceAudioOutputCleanup,
+        RouteInstanceLocation,
+        RouteInstanceAMBESerial,
+        RouteInstanceAMBEDevices,
+        RouteInstancePresets,
+        RouteInstancePreset,
+        RouteInstancePresetFile,
+        RouteInstanceDeviceSets,
+        RouteInstanceDeviceSetsReport,
+        RouteInstanceDeviceSet,
+        RouteDeviceset,
+        RouteDevicesetFocus,
+        RouteDevicesetDevice,
+        RouteDevicesetDeviceSettings,
+        RouteDevicesetDeviceRun,
+        RouteDevicesetDeviceReport,
+        RouteDevicesetChannelsReport,
+        RouteDevicesetChannel,
+        RouteDevicesetChannelIndex,
+        RouteDevicesetChannelSettings,
+        RouteDevicesetChannelReport
+    };
+
+    static const int m_maxIndexes = 2;
+
+    WebAPIRouter(); //!< builds the tree of all API routes
+    ~WebAPIRouter();
+
+    /** Add a route. Pattern segments are separated by '/' and "{index}" stands for an index segment */
+    void addRoute(const std::string& pattern, Route route);
+    /** Route of the path or RouteNone. The index segments are stored in indexes. */
+    Route match(const char *path, int length, std::string indexes[m_maxIndexes]) const;
+
+private:
+    struct Node
+    {
+        std::vector<std::pair<std::string, int>> m_children; //!< literal segment and node index
+        int m_indexChild; //!< node index of the index segment child or -1
+        Route m_route;
+
+        Node() : m_indexChild(-1), m_route(RouteNone) {}
+    };
+
+    std::vector<Node> m_nodes; //!< root is the first node
+};
+
+#endif // SDRBASE_WEBAPI_WEBAPIROUTER_H_
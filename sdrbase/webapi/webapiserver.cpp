@@ -21,19 +21,26 @@
 
 #include "httplistener.h"
 #include "webapirequestmapper.h"
+#include "webapieventstream.h"
 #include "webapiserver.h"
 
 WebAPIServer::WebAPIServer(const QString& host, uint16_t port, WebAPIRequestMapper *requestMapper) :
     m_requestMapper(requestMapper),
-    m_listener(0)
+    m_listener(0),
+    m_eventsPort(0)
 {
     m_settings.host = host;
     m_settings.port = port;
+    // API clients are served by a few threads whatever their number
+    m_settings.eventDriven = true;
+    m_settings.workerThreads = 2;
+    m_eventStream = new WebAPIEventStream(requestMapper);
 }
 
 WebAPIServer::~WebAPIServer()
 {
     if (m_listener) { delete m_listener; }
+    delete m_eventStream;
 }
 
 void WebAPIServer::start()
@@ -43,6 +50,10 @@ void WebAPIServer::start()
         m_listener = new qtwebapp::HttpListener(m_settings, m_requestMapper, qApp);
         qInfo("WebAPIServer::start: starting web API server at http://%s:%d", qPrintable(m_settings.host), m_settings.port);
     }
+
+    if (m_eventsPort != 0) {
+        m_eventStream->start(m_settings.host, m_eventsPort);
+    }
 }
 
 void WebAPIServer::stop()
@@ -53,6 +64,8 @@ void WebAPIServer::stop()
         m_listener = 0;
         qInfo("WebAPIServer::stop: stopped web API server at http://%s:%d", qPrintable(m_settings.host), m_settings.port);
     }
+
+    m_eventStream->stop();
 }
 
 void WebAPIServer::setHostAndPort(const QString& host, uint16_t port)
@@ -61,4 +74,14 @@ void WebAPIServer::setHostAndPort(const QString& host, uint16_t port)
     m_settings.host = host;
     m_settings.port = port;
     m_listener = new qtwebapp::HttpListener(m_settings, m_requestMapper, qApp);
+
+    if (m_eventsPort != 0) {
+        m_eventStream->start(m_settings.host, m_eventsPort);
+    }
+}
+
+void WebAPIServer::setEvents(uint16_t port, int periodMs)
+{
+    m_eventsPort = port;
+    m_eventStream->setPeriod(periodMs);
 }
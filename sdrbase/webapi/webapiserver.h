@@ -29,6 +29,7 @@ namespace qtwebapp
 }
 
 class WebAPIRequestMapper;
+class WebAPIEventStream;
 
 class SDRBASE_API WebAPIServer
 {
@@ -42,11 +43,16 @@ public:
     void setHostAndPort(const QString& host, uint16_t port);
     const QString& getHost() const { return m_settings.host; }
     int getPort() const { return m_settings.port; }
+    /** WebSocket events port (0 to disable) and period. Effective at next start. */
+    void setEvents(uint16_t port, int periodMs);
+    uint16_t getEventsPort() const { return m_eventsPort; }
 
 private:
     WebAPIRequestMapper *m_requestMapper;
     qtwebapp::HttpListener *m_listener;
     qtwebapp::HttpListenerSettings m_settings;
+    WebAPIEventStream *m_eventStream;
+    uint16_t m_eventsPort;
 };
 
 
@@ -17,13 +17,219 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
 #include <QDebug>
 #include <QElapsedTimer>
+#include <QThread>
+#include <QEventLoop>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QMutex>
 
 #include "ambe/ambeengine.h"
+#include "dsp/dspcommands.h"
+#include "dsp/pfbchannelizer.h"
+#include "dsp/threadedbasebandsamplesink.h"
+#include "leansdr/framework.h"
+#include "leansdr/generic.h"
+#include "leansdr/dvb.h"
+#include "leansdr/dvbs2.h"
+#include "webapi/webapiadapterinterface.h"
+#include "webapi/webapirouter.h"
+#include "httplistener.h"
+#include "httprequesthandler.h"
+#include "httpresponse.h"
 
 #include "mainbench.h"
 
+/** Minimal request handler to measure the HTTP server alone */
+class HttpBenchRequestHandler : public qtwebapp::HttpRequestHandler
+{
+public:
+    virtual void service(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+    {
+        (void) request;
+        response.setHeader("Content-Type", "application/json");
+        response.write("{\"status\":\"ok\"}", true);
+    }
+};
+
+/** HTTP client thread sending requests in pipelined batches on a persistent connection */
+class HttpBenchClient : public QThread
+{
+public:
+    HttpBenchClient(quint16 port, int nbRequests, int batchSize) :
+        m_port(port),
+        m_nbRequests(nbRequests),
+        m_batchSize(batchSize),
+        m_nbServed(0),
+        m_nbRejected(0),
+        m_nbFailed(0),
+        m_nbBatches(0),
+        m_nsecs(0)
+    {}
+
+    int getNbServed() const { return m_nbServed; }
+    int getNbRejected() const { return m_nbRejected; }
+    int getNbFailed() const { return m_nbFailed; }
+    int getNbBatches() const { return m_nbBatches; }
+    qint64 getNsecs() const { return m_nsecs; }
+
+protected:
+    void run()
+    {
+        QTcpSocket socket;
+        socket.connectToHost(QHostAddress::LocalHost, m_port);
+
+        if (!socket.waitForConnected(5000))
+        {
+            m_nbFailed = m_nbRequests;
+            return;
+        }
+
+        QByteArray request("GET /bench HTTP/1.1\r\nHost: localhost\r\n\r\n");
+        QByteArray buffer;
+        QElapsedTimer timer;
+
+        for (int sent = 0; sent < m_nbRequests;)
+        {
+            int batchSize = m_batchSize < m_nbRequests - sent ? m_batchSize : m_nbRequests - sent;
+            timer.start();
+
+            for (int i = 0; i < batchSize; i++) {
+                socket.write(request);
+            }
+
+            sent += batchSize;
+
+            for (int received = 0; received < batchSize; received++)
+            {
+                int status = readResponse(socket, buffer);
+
+                if (status != 200) // the server closes the connection on errors
+                {
+                    if (status == 503) {
+                        m_nbRejected = m_nbRequests - m_nbServed;
+                    } else {
+                        m_nbFailed = m_nbRequests - m_nbServed;
+                    }
+
+                    return;
+                }
+
+                m_nbServed++;
+            }
+
+            m_nsecs += timer.nsecsElapsed();
+            m_nbBatches++;
+        }
+
+        socket.disconnectFromHost();
+    }
+
+private:
+    /** Status of the next response in buffer completed from the socket or -1 on timeout */
+    static int readResponse(QTcpSocket& socket, QByteArray& buffer)
+    {
+        while (true)
+        {
+            int headerEnd = buffer.indexOf("\r\n\r\n");
+
+            if (headerEnd >= 0)
+            {
+                int status = buffer.mid(9, 3).toInt();
+                int pos = buffer.indexOf("Content-Length: ");
+
+                if ((pos < 0) || (pos > headerEnd)) { // no length: body ends with the connection
+                    return status;
+                }
+
+                int contentLength = buffer.mid(pos + 16, buffer.indexOf("\r\n", pos) - pos - 16).toInt();
+
+                if (buffer.size() >= headerEnd + 4 + contentLength)
+                {
+                    buffer.remove(0, headerEnd + 4 + contentLength);
+                    return status;
+                }
+            }
+
+            if (!socket.waitForReadyRead(5000)) {
+                return -1;
+            }
+
+            buffer.append(socket.readAll());
+        }
+    }
+
+    quint16 m_port;
+    int m_nbRequests;
+    int m_batchSize;
+    int m_nbServed;
+    int m_nbRejected;
+    int m_nbFailed;
+    int m_nbBatches;
+    qint64 m_nsecs;
+};
+
+/** Channel sink storing the samples it receives and the last signal notification */
+class PFBBenchSink : public BasebandSampleSink
+{
+public:
+    PFBBenchSink() :
+        m_sampleRate(0),
+        m_centerFrequency(0)
+    {}
+
+    virtual void start() {}
+    virtual void stop() {}
+
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly)
+    {
+        (void) positiveOnly;
+        QMutexLocker mutexLocker(&m_mutex);
+        m_samples.insert(m_samples.end(), begin, end);
+    }
+
+    virtual bool handleMessage(const Message& cmd)
+    {
+        if (DSPSignalNotification::match(cmd))
+        {
+            const DSPSignalNotification& notif = (const DSPSignalNotification&) cmd;
+            m_sampleRate = notif.getSampleRate();
+            m_centerFrequency = notif.getCenterFrequency();
+            return true;
+        }
+
+        return false;
+    }
+
+    int getNbSamples()
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+        return m_samples.size();
+    }
+
+    SampleVector takeSamples()
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+        SampleVector samples;
+        samples.swap(m_samples);
+        return samples;
+    }
+
+    int getSampleRate() const { return m_sampleRate; }
+    qint64 getCenterFrequency() const { return m_centerFrequency; }
+
+private:
+    QMutex m_mutex;
+    SampleVector m_samples;
+    int m_sampleRate;
+    qint64 m_centerFrequency;
+};
+
 MainBench *MainBench::m_instance = 0;
 
 MainBench::MainBench(qtwebapp::LoggerWithFile *logger, const ParserBench& parser, QObject *parent) :
@@ -64,6 +270,16 @@ void MainBench::run()
         testDecimateFF();
     } else if (m_parser.getTestType() == ParserBench::TestAMBE) {
         testAMBE();
+    } else if (m_parser.getTestType() == ParserBench::TestLDPC) {
+        testLDPC();
+    } else if (m_parser.getTestType() == ParserBench::TestViterbi) {
+        testViterbi();
+    } else if (m_parser.getTestType() == ParserBench::TestWebAPIRouter) {
+        testWebAPIRouter();
+    } else if (m_parser.getTestType() == ParserBench::TestHttpServer) {
+        testHttpServer();
+    } else if (m_parser.getTestType() == ParserBench::TestPFBChannelizer) {
+        testPFBChannelizer();
     } else {
         qDebug() << "MainBench::run: unknown test type: " << m_parser.getTestType();
     }
@@ -207,6 +423,608 @@ void MainBench::testAMBE()
     }
 }
 
+void MainBench::testLDPC()
+{
+    // DVB-S2 soft decision LDPC decoder throughput for each QPSK MODCOD (all code rates)
+    // in normal and short frames. Codewords are sent through an AWGN channel at 1 dB above
+    // the MODCOD threshold and LLRs are scaled as in the leansdr demodulator.
+    // Each repetition decodes a batch of 16 frames.
+    static const int nbBatchFrames = 16;
+    int nbThreads = QThread::idealThreadCount() < 1 ? 1 : QThread::idealThreadCount();
+    int nbFrames = nbBatchFrames * m_parser.getRepetition();
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    leansdr::ldpc_minsum_pool<uint16_t> pool(nbThreads);
+    leansdr::ldpc_minsum_pool<uint16_t>::job jobs[nbBatchFrames];
+    std::vector<leansdr::llr_t> frames(nbBatchFrames * 64800);
+    std::vector<leansdr::llr_t> llrs(nbBatchFrames * 64800);
+    std::vector<leansdr::hard_sb> codewords(nbBatchFrames * 64800/8);
+
+    qDebug("MainBench::testLDPC: %d frames per MODCOD on %d threads", nbFrames, nbThreads);
+
+    for (int modcod = 1; modcod <= 11; modcod++)
+    {
+        const leansdr::modcod_info *mcinfo = &leansdr::modcod_infos[modcod];
+
+        for (int sf = 0; sf <= 1; sf++)
+        {
+            const leansdr::fec_info *fi = &leansdr::fec_infos[sf][mcinfo->rate];
+
+            if (!fi->ldpc) {
+                continue;
+            }
+
+            int n = sf ? 64800/4 : 64800;
+            leansdr::s2_ldpc_engine encoder(fi->ldpc, fi->kldpc, n);
+            leansdr::ldpc_minsum_decoder<uint16_t> decoder(fi->ldpc, fi->kldpc, n);
+            float sigma2 = 1.0f / powf(10.0f, (mcinfo->esn0_nf + 1.0f) / 10.0f); // QPSK: per dimension noise over per bit energy
+            float sigma = sqrtf(sigma2);
+            auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+
+            for (int f = 0; f < nbBatchFrames; f++)
+            {
+                leansdr::hard_sb *codeword = &codewords[f*n/8];
+
+                for (int i = 0; i < fi->kldpc/8; i++) {
+                    codeword[i] = my_rand();
+                }
+
+                encoder.encode(fi->ldpc, codeword, fi->kldpc, n, codeword + fi->kldpc/8);
+
+                for (int i = 0; i < n; i++)
+                {
+                    int bit = (codeword[i/8] >> (7 - (i%8))) & 1;
+                    float y = (bit ? -1.0f : 1.0f) + sigma * noise(m_generator);
+                    float llr = (2.0f * y / sigma2) * 5.0f;
+                    frames[f*n + i] = llr < -127.0f ? -127 : llr > 127.0f ? 127 : (leansdr::llr_t) llr;
+                }
+            }
+
+            QElapsedTimer timer;
+            qint64 nsecs = 0;
+            int nbIterations = 0;
+            int nbFailed = 0;
+            qint64 nbBitErrors = 0;
+
+            for (uint32_t r = 0; r < m_parser.getRepetition(); r++)
+            {
+                std::copy(frames.begin(), frames.begin() + nbBatchFrames*n, llrs.begin());
+
+                for (int f = 0; f < nbBatchFrames; f++)
+                {
+                    jobs[f].decoder = &decoder;
+                    jobs[f].llrs = &llrs[f*n];
+                }
+
+                timer.start();
+                pool.decode(jobs, nbBatchFrames, 25);
+                nsecs += timer.nsecsElapsed();
+
+                for (int f = 0; f < nbBatchFrames; f++)
+                {
+                    if (jobs[f].result < 0) {
+                        nbFailed++;
+                    } else {
+                        nbIterations += jobs[f].result;
+                    }
+
+                    // decoded posteriors are negative for 1 bits
+                    for (int i = 0; i < n; i++)
+                    {
+                        int bit = (codewords[(f*n + i)/8] >> (7 - (i%8))) & 1;
+
+                        if ((llrs[f*n + i] < 0) != (bit == 1)) {
+                            nbBitErrors++;
+                        }
+                    }
+                }
+            }
+
+            double framesPerSecond = (nbFrames / (double) nsecs) * 1e9;
+            QDebug info = qInfo();
+            info.noquote();
+            info << tr("MainBench::testLDPC: MODCOD %1 %2 (%3 dB): %L4 frames/s %5 Mb/s avg iterations: %6 failed: %7 bit errors: %8 (BER %9)")
+                .arg(modcod, 2)
+                .arg(sf ? "short " : "normal")
+                .arg(mcinfo->esn0_nf + 1.0f)
+                .arg(framesPerSecond, 0, 'f', 0)
+                .arg((framesPerSecond * fi->Kbch) / 1e6, 0, 'f', 1)
+                .arg(nbFrames > nbFailed ? nbIterations / (double) (nbFrames - nbFailed) : 0.0, 0, 'f', 1)
+                .arg(nbFailed)
+                .arg(nbBitErrors)
+                .arg(nbBitErrors / ((double) nbFrames * n), 0, 'e', 2);
+        }
+    }
+}
+
+void MainBench::testViterbi()
+{
+    // DVB-S Viterbi decoder throughput for each code rate. Coded bits are flipped
+    // with a 1% probability and all symbols have the same cost.
+    // Each repetition decodes nsamples uncoded bits.
+    static const leansdr::code_rate rates[] = {
+        leansdr::FEC12, leansdr::FEC23, leansdr::FEC34, leansdr::FEC56, leansdr::FEC78
+    };
+    typedef leansdr::viterbi_dec_k7<uint8_t, uint8_t, int32_t, int32_t> Decoder;
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+
+    for (unsigned int r = 0; r < sizeof(rates)/sizeof(rates[0]); r++)
+    {
+        const leansdr::fec_spec *fec = &leansdr::fec_specs[rates[r]];
+        int nbBlocks = m_parser.getNbSamples() / fec->bits_in;
+        std::vector<uint8_t> uncoded(nbBlocks);
+        std::vector<uint8_t> coded(nbBlocks);
+        int state = 0;
+
+        for (int b = 0; b < nbBlocks; b++)
+        {
+            uint8_t us = 0;
+            int x[8], y[8];
+
+            for (int t = 0; t < fec->bits_in; t++)
+            {
+                int bit = m_generator() & 1;
+                int reg = state | (bit << 6);
+                x[t] = leansdr::parity((uint8_t) (reg & leansdr::DVBS_G1));
+                y[t] = leansdr::parity((uint8_t) (reg & leansdr::DVBS_G2));
+                state = reg >> 1;
+                us = (us << 1) | bit;
+            }
+
+            uint8_t cs = 0;
+
+            for (int p = 0; p < fec->bits_out; p++)
+            {
+                int bit = 0;
+
+                for (int t = 0; t < fec->bits_in; t++)
+                {
+                    if (fec->polys[p] == (leansdr::DVBS_G1 << t)) {
+                        bit = x[t];
+                    } else if (fec->polys[p] == (leansdr::DVBS_G2 << t)) {
+                        bit = y[t];
+                    }
+                }
+
+                cs = (cs << 1) | (bit ^ (uniform(m_generator) < 0.01f));
+            }
+
+            uncoded[b] = us;
+            coded[b] = cs;
+        }
+
+        QElapsedTimer timer;
+        qint64 nsecs = 0;
+        long nbErrors = 0;
+        long nbBits = 0;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            Decoder *decoder = new Decoder(fec->bits_in, fec->bits_out, fec->polys, leansdr::DVBS_G1, leansdr::DVBS_G2);
+            std::vector<uint8_t> decoded(nbBlocks);
+
+            timer.start();
+
+            for (int b = 0; b < nbBlocks; b++) {
+                decoded[b] = decoder->update(coded[b], -4096);
+            }
+
+            nsecs += timer.nsecsElapsed();
+
+            for (int b = decoder->delay; b < nbBlocks; b++)
+            {
+                nbErrors += leansdr::hamming_weight((uint8_t) (decoded[b] ^ uncoded[b - decoder->delay]));
+                nbBits += fec->bits_in;
+            }
+
+            delete decoder;
+        }
+
+        QDebug info = qInfo();
+        info.noquote();
+        info << tr("MainBench::testViterbi: rate %1/%2: %3 Mb/s BER: %4")
+            .arg(fec->bits_in)
+            .arg(fec->bits_out)
+            .arg((nbBlocks * fec->bits_in * (double) m_parser.getRepetition() * 1e3) / nsecs, 0, 'f', 1)
+            .arg(nbBits ? nbErrors / (double) nbBits : 0.0, 0, 'e', 2);
+    }
+}
+
+void MainBench::testWebAPIRouter()
+{
+    // Request paths routing rate with the segment tree against the former string and regex chain.
+    // Paths are mostly channel reports as when polling all channels of several device sets.
+    // Each repetition routes nsamples paths.
+    QList<QByteArray> paths;
+
+    for (int deviceSetIndex = 0; deviceSetIndex < 4; deviceSetIndex++)
+    {
+        paths.append(QString("/sdrangel/deviceset/%1/device/report").arg(deviceSetIndex).toLatin1());
+        paths.append(QString("/sdrangel/deviceset/%1/channels/report").arg(deviceSetIndex).toLatin1());
+
+        for (int channelIndex = 0; channelIndex < 32; channelIndex++) {
+            paths.append(QString("/sdrangel/deviceset/%1/channel/%2/report").arg(deviceSetIndex).arg(channelIndex).toLatin1());
+        }
+    }
+
+    paths.append(WebAPIAdapterInterface::instanceSummaryURL.toLatin1());
+    paths.append(WebAPIAdapterInterface::instanceDeviceSetsURL.toLatin1());
+    paths.append("/sdrangel/deviceset/0/channel/0/settings");
+    paths.append("/doc/swagger/index.html"); // static page
+
+    WebAPIRouter router;
+    QElapsedTimer timer;
+    qint64 nsecsRegex = 0;
+    qint64 nsecsRouter = 0;
+    int nbMismatches = 0;
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        std::string indexes[WebAPIRouter::m_maxIndexes];
+        std::string regexIndexes[WebAPIRouter::m_maxIndexes];
+
+        timer.start();
+
+        for (uint32_t k = 0; k < m_parser.getNbSamples(); k++)
+        {
+            const QByteArray& path = paths[k % paths.size()];
+            routeRegex(path, regexIndexes);
+        }
+
+        nsecsRegex += timer.nsecsElapsed();
+        timer.start();
+
+        for (uint32_t k = 0; k < m_parser.getNbSamples(); k++)
+        {
+            const QByteArray& path = paths[k % paths.size()];
+            router.match(path.constData(), path.length(), indexes);
+        }
+
+        nsecsRouter += timer.nsecsElapsed();
+    }
+
+    for (const QByteArray& path : paths)
+    {
+        std::string indexes[WebAPIRouter::m_maxIndexes];
+        std::string regexIndexes[WebAPIRouter::m_maxIndexes];
+
+        if ((router.match(path.constData(), path.length(), indexes) != routeRegex(path, regexIndexes))
+            || (indexes[0] != regexIndexes[0]) || (indexes[1] != regexIndexes[1]))
+        {
+            qWarning() << "MainBench::testWebAPIRouter: mismatch on" << path;
+            nbMismatches++;
+        }
+    }
+
+    double nbRequests = m_parser.getNbSamples() * (double) m_parser.getRepetition();
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testWebAPIRouter: regex: %1 k req/s router: %2 k req/s mismatches: %3")
+        .arg((nbRequests * 1e6) / nsecsRegex, 0, 'f', 1)
+        .arg((nbRequests * 1e6) / nsecsRouter, 0, 'f', 1)
+        .arg(nbMismatches);
+}
+
+void MainBench::testHttpServer()
+{
+    // HTTP server request rate with a thread per connection and event driven using local clients.
+    // Clients send requests in pipelined batches of 8 on a persistent connection. The last runs have
+    // more clients than the 100 threads limit of the thread per connection mode.
+    // Each client sends repet x 64 requests.
+    int nbRequests = 64 * (m_parser.getRepetition() < 1 ? 1 : m_parser.getRepetition());
+    testHttpServer(false, 50, nbRequests);
+    testHttpServer(true, 50, nbRequests);
+    testHttpServer(false, 200, nbRequests);
+    testHttpServer(true, 200, nbRequests);
+}
+
+void MainBench::testHttpServer(bool eventDriven, int nbClients, int nbRequests)
+{
+    qtwebapp::HttpListenerSettings settings;
+    settings.host = "127.0.0.1";
+    settings.port = 0; // any free port
+    settings.eventDriven = eventDriven;
+    HttpBenchRequestHandler requestHandler;
+    qtwebapp::HttpListener listener(settings, &requestHandler);
+
+    if (!listener.isListening())
+    {
+        qWarning("MainBench::testHttpServer: cannot listen: %s", qPrintable(listener.errorString()));
+        return;
+    }
+
+    // the listener dispatches connections from this thread so wait in an event loop
+    QList<HttpBenchClient*> clients;
+    QEventLoop loop;
+    QElapsedTimer timer;
+    int nbFinished = 0;
+    timer.start();
+
+    for (int i = 0; i < nbClients; i++)
+    {
+        HttpBenchClient *client = new HttpBenchClient(listener.serverPort(), nbRequests, 8);
+        connect(client, &QThread::finished, &loop, [&]() {
+            if (++nbFinished == nbClients) {
+                loop.quit();
+            }
+        });
+        clients.append(client);
+        client->start();
+    }
+
+    loop.exec();
+    qint64 nsecs = timer.nsecsElapsed();
+    int nbServed = 0, nbRejected = 0, nbFailed = 0, nbBatches = 0;
+    qint64 batchNsecs = 0;
+
+    for (HttpBenchClient *client : clients)
+    {
+        client->wait();
+        nbServed += client->getNbServed();
+        nbRejected += client->getNbRejected();
+        nbFailed += client->getNbFailed();
+        nbBatches += client->getNbBatches();
+        batchNsecs += client->getNsecs();
+    }
+
+    qDeleteAll(clients);
+
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testHttpServer: %1 %2 clients: %3 k req/s batch latency: %4 us served: %5 rejected: %6 failed: %7")
+        .arg(eventDriven ? "event driven " : "thread per connection")
+        .arg(nbClients, 3)
+        .arg((nbServed * 1e6) / nsecs, 0, 'f', 1)
+        .arg(nbBatches ? (batchNsecs / 1e3) / nbBatches : 0.0, 0, 'f', 0)
+        .arg(nbServed)
+        .arg(nbRejected)
+        .arg(nbFailed);
+}
+
+void MainBench::testPFBChannelizer()
+{
+    // PFB channelizer with 2^log2f channels critically sampled then 2x oversampled.
+    // A tone is placed in each channel in turn at 1/8 of the channel spacing from its center.
+    // Each channel output must carry the tone at unity gain and at the right frequency offset
+    // (this checks the (-1)^m phase correction of the oversampled mode) while the other channels
+    // must be at least 30 dB below. Each tone run feeds up to nsamples samples.
+    bool criticalOk = testPFBChannelizer(false);
+    bool oversampledOk = testPFBChannelizer(true);
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testPFBChannelizer: %1").arg(criticalOk && oversampledOk ? "PASS" : "FAIL");
+}
+
+bool MainBench::testPFBChannelizer(bool oversampled)
+{
+    PFBChannelizer channelizer(m_parser.getLog2Factor(), 12, oversampled);
+    const unsigned int nbChannels = channelizer.getNbChannels();
+    const unsigned int decimation = oversampled ? nbChannels / 2 : nbChannels;
+    const int sampleRate = nbChannels * 48000;
+    const qint64 centerFrequency = 100000000;
+    const double toneOffset = sampleRate / (8.0 * nbChannels);
+    const double amplitude = SDR_RX_SCALEF / 4.0;
+    const unsigned int chunkSize = nbChannels * 256;
+    const unsigned int skip = (2 * 12 * nbChannels) / decimation; // filter transient in output samples
+    // whole chunks and no more than 32k outputs per channel to stay well within the sink FIFOs
+    unsigned int nbSamples = std::min<uint32_t>(m_parser.getNbSamples(), decimation * 32768U);
+    nbSamples = (nbSamples / chunkSize) * chunkSize;
+    nbSamples = nbSamples < 4 * chunkSize ? 4 * chunkSize : nbSamples;
+    const int nbOutputs = nbSamples / decimation;
+
+    std::vector<PFBBenchSink*> sinks(nbChannels);
+    std::vector<ThreadedBasebandSampleSink*> threadedSinks(nbChannels);
+
+    for (unsigned int i = 0; i < nbChannels; i++)
+    {
+        sinks[i] = new PFBBenchSink();
+        threadedSinks[i] = new ThreadedBasebandSampleSink(sinks[i]);
+        channelizer.addChannelSink(i, threadedSinks[i]);
+    }
+
+    DSPSignalNotification notif(sampleRate, centerFrequency);
+    channelizer.handleMessage(notif);
+    channelizer.start();
+
+    bool ok = true;
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    SampleVector chunk(chunkSize);
+
+    for (unsigned int i = 0; i < nbChannels; i++)
+    {
+        if ((sinks[i]->getSampleRate() != channelizer.getChannelSampleRate())
+         || (sinks[i]->getCenterFrequency() != centerFrequency + channelizer.getChannelFrequencyOffset(i)))
+        {
+            qWarning("MainBench::testPFBChannelizer: channel %u notified %d S/s at %lld Hz", i,
+                sinks[i]->getSampleRate(), (long long) sinks[i]->getCenterFrequency());
+            ok = false;
+        }
+    }
+
+    for (unsigned int tone = 0; tone < nbChannels; tone++)
+    {
+        double frequency = (channelizer.getChannelFrequencyOffset(tone) + toneOffset) / sampleRate;
+
+        for (unsigned int n = 0; n < nbSamples; n += chunkSize)
+        {
+            for (unsigned int k = 0; k < chunkSize; k++)
+            {
+                double phase = 2.0 * M_PI * std::fmod(frequency * (n + k), 1.0);
+                chunk[k].setReal((FixReal) (amplitude * std::cos(phase)));
+                chunk[k].setImag((FixReal) (amplitude * std::sin(phase)));
+            }
+
+            timer.start();
+            channelizer.feed(chunk.begin(), chunk.end(), false);
+            nsecs += timer.nsecsElapsed();
+        }
+
+        // wait for the sink threads to drain their FIFOs
+        for (int t = 0; t < 500; t++)
+        {
+            bool complete = true;
+
+            for (unsigned int i = 0; i < nbChannels; i++) {
+                complete = complete && (sinks[i]->getNbSamples() >= nbOutputs);
+            }
+
+            if (complete) {
+                break;
+            }
+
+            QThread::msleep(10);
+        }
+
+        double ownGain = 0.0;
+        double ownFrequency = 0.0;
+        double maxLeak = -300.0;
+        unsigned int maxLeakChannel = 0;
+
+        for (unsigned int i = 0; i < nbChannels; i++)
+        {
+            SampleVector samples = sinks[i]->takeSamples();
+
+            if ((int) samples.size() < nbOutputs)
+            {
+                qWarning("MainBench::testPFBChannelizer: tone %u: channel %u got %d of %d samples",
+                    tone, i, (int) samples.size(), nbOutputs);
+                ok = false;
+                continue;
+            }
+
+            double power = 0.0;
+            std::complex<double> correlation(0.0, 0.0);
+
+            for (int k = skip; k < nbOutputs; k++)
+            {
+                std::complex<double> y(samples[k].real(), samples[k].imag());
+                power += std::norm(y);
+
+                if (k > (int) skip) {
+                    correlation += y * std::conj(std::complex<double>(samples[k-1].real(), samples[k-1].imag()));
+                }
+            }
+
+            double gain = 10.0 * std::log10(power / ((nbOutputs - skip) * amplitude * amplitude) + 1e-30);
+
+            if (i == tone)
+            {
+                ownGain = gain;
+                ownFrequency = (std::arg(correlation) * channelizer.getChannelSampleRate()) / (2.0 * M_PI);
+            }
+            else if (gain > maxLeak)
+            {
+                maxLeak = gain;
+                maxLeakChannel = i;
+            }
+        }
+
+        bool toneOk = (std::fabs(ownGain) < 1.0) && (std::fabs(ownFrequency - toneOffset) < channelizer.getChannelSampleRate() * 1e-4) && (maxLeak < -30.0);
+        ok = ok && toneOk;
+
+        if (!toneOk)
+        {
+            qWarning("MainBench::testPFBChannelizer: tone %u: gain: %.2f dB frequency: %.2f Hz (expected %.2f Hz) worst leak: %.1f dB in channel %u",
+                tone, ownGain, ownFrequency, toneOffset, maxLeak, maxLeakChannel);
+        }
+    }
+
+    for (unsigned int i = 0; i < nbChannels; i++)
+    {
+        channelizer.removeChannelSink(threadedSinks[i]); // stops the sink
+        delete threadedSinks[i];
+        delete sinks[i];
+    }
+
+    channelizer.stop();
+
+    double ratekSs = ((double) nbSamples * nbChannels / (double) nsecs) * 1e6;
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testPFBChannelizer: %1 channels %2: %3 - %L4 ns sample rate: %5 kS/s")
+        .arg(nbChannels)
+        .arg(oversampled ? "oversampled" : "critical")
+        .arg(ok ? "PASS" : "FAIL")
+        .arg(nsecs)
+        .arg(ratekSs);
+
+    return ok;
+}
+
+WebAPIRouter::Route MainBench::routeRegex(const QByteArray& path, std::string indexes[])
+{
+    // String comparisons and regex chain formerly in WebAPIRequestMapper::service
+    if (path == WebAPIAdapterInterface::instanceSummaryURL) {
+        return WebAPIRouter::RouteInstanceSummary;
+    } else if (path == WebAPIAdapterInterface::instanceDevicesURL) {
+        return WebAPIRouter::RouteInstanceDevices;
+    } else if (path == WebAPIAdapterInterface::instanceChannelsURL) {
+        return WebAPIRouter::RouteInstanceChannels;
+    } else if (path == WebAPIAdapterInterface::instanceLoggingURL) {
+        return WebAPIRouter::RouteInstanceLogging;
+    } else if (path == WebAPIAdapterInterface::instanceAudioURL) {
+        return WebAPIRouter::RouteInstanceAudio;
+    } else if (path == WebAPIAdapterInterface::instanceAudioInputParametersURL) {
+        return WebAPIRouter::RouteInstanceAudioInputParameters;
+    } else if (path == WebAPIAdapterInterface::instanceAudioOutputParametersURL) {
+        return WebAPIRouter::RouteInstanceAudioOutputParameters;
+    } else if (path == WebAPIAdapterInterface::instanceAudioInputCleanupURL) {
+        return WebAPIRouter::RouteInstanceAudioInputCleanup;
+    } else if (path == WebAPIAdapterInterface::instanceAudioOutputCleanupURL) {
+        return WebAPIRouter::RouteInstanceAudioOutputCleanup;
+    } else if (path == WebAPIAdapterInterface::instanceLocationURL) {
+        return WebAPIRouter::RouteInstanceLocation;
+    } else if (path == WebAPIAdapterInterface::instanceAMBESerialURL) {
+        return WebAPIRouter::RouteInstanceAMBESerial;
+    } else if (path == WebAPIAdapterInterface::instanceAMBEDevicesURL) {
+        return WebAPIRouter::RouteInstanceAMBEDevices;
+    } else if (path == WebAPIAdapterInterface::instancePresetsURL) {
+        return WebAPIRouter::RouteInstancePresets;
+    } else if (path == WebAPIAdapterInterface::instancePresetURL) {
+        return WebAPIRouter::RouteInstancePreset;
+    } else if (path == WebAPIAdapterInterface::instancePresetFileURL) {
+        return WebAPIRouter::RouteInstancePresetFile;
+    } else if (path == WebAPIAdapterInterface::instanceDeviceSetsURL) {
+        return WebAPIRouter::RouteInstanceDeviceSets;
+    } else if (path == WebAPIAdapterInterface::instanceDeviceSetURL) {
+        return WebAPIRouter::RouteInstanceDeviceSet;
+    }
+
+    std::smatch desc_match;
+    std::string pathStr(path.constData(), path.length());
+    WebAPIRouter::Route route = WebAPIRouter::RouteNone;
+
+    if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetURLRe)) {
+        route = WebAPIRouter::RouteDeviceset;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceURLRe)) {
+        route = WebAPIRouter::RouteDevicesetDevice;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetFocusURLRe)) {
+        route = WebAPIRouter::RouteDevicesetFocus;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceSettingsURLRe)) {
+        route = WebAPIRouter::RouteDevicesetDeviceSettings;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceRunURLRe)) {
+        route = WebAPIRouter::RouteDevicesetDeviceRun;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceReportURLRe)) {
+        route = WebAPIRouter::RouteDevicesetDeviceReport;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelsReportURLRe)) {
+        route = WebAPIRouter::RouteDevicesetChannelsReport;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelURLRe)) {
+        route = WebAPIRouter::RouteDevicesetChannel;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelIndexURLRe)) {
+        route = WebAPIRouter::RouteDevicesetChannelIndex;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelSettingsURLRe)) {
+        route = WebAPIRouter::RouteDevicesetChannelSettings;
+    } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelReportURLRe)) {
+        route = WebAPIRouter::RouteDevicesetChannelReport;
+    }
+
+    for (std::size_t i = 1; (i < desc_match.size()) && (i <= (std::size_t) WebAPIRouter::m_maxIndexes); i++) {
+        indexes[i-1] = std::string(desc_match[i]);
+    }
+
+    return route;
+}
+
 void MainBench::decimateII(const qint16* buf, int len)
 {
     SampleVector::iterator it = m_convertBuffer.begin();
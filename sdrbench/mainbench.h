@@ -29,6 +29,7 @@
 #include "dsp/decimatorsfi.h"
 #include "dsp/decimatorsff.h"
 #include "parserbench.h"
+#include "webapi/webapirouter.h"
 
 namespace qtwebapp {
     class LoggerWithFile;
@@ -53,6 +54,13 @@ private:
     void testDecimateFI();
     void testDecimateFF();
     void testAMBE();
+    void testLDPC();
+    void testViterbi();
+    void testWebAPIRouter();
+    void testHttpServer();
+    void testHttpServer(bool eventDriven, int nbClients, int nbRequests);
+    void testPFBChannelizer();
+    bool testPFBChannelizer(bool oversampled);
     void decimateII(const qint16 *buf, int len);
     void decimateInfII(const qint16 *buf, int len);
     void decimateSupII(const qint16 *buf, int len);
@@ -60,6 +68,7 @@ private:
     void decimateFI(const float *buf, int len);
     void decimateFF(const float *buf, int len);
     void printResults(const QString& prefix, qint64 nsecs);
+    static WebAPIRouter::Route routeRegex(const QByteArray& path, std::string indexes[]);
 
     static MainBench *m_instance;
     qtwebapp::LoggerWithFile *m_logger;
@@ -24,7 +24,7 @@
 
 ParserBench::ParserBench() :
     m_testOption(QStringList() << "t" << "test",
-        "Test type: decimateii, decimatefi, decimateff, decimateif, decimateinfii, decimatesupii, ambe",
+        "Test type: decimateii, decimatefi, decimateff, decimateif, decimateinfii, decimatesupii, ambe, ldpc, viterbi, webapirouter, httpserver, pfbchannelizer",
         "test",
         "decimateii"),
     m_nbSamplesOption(QStringList() << "n" << "nb-samples",
@@ -127,6 +127,16 @@ ParserBench::TestType ParserBench::getTestType() const
         return TestDecimatorsSupII;
     } else if (m_testStr == "ambe") {
         return TestAMBE;
+    } else if (m_testStr == "ldpc") {
+        return TestLDPC;
+    } else if (m_testStr == "viterbi") {
+        return TestViterbi;
+    } else if (m_testStr == "webapirouter") {
+        return TestWebAPIRouter;
+    } else if (m_testStr == "httpserver") {
+        return TestHttpServer;
+    } else if (m_testStr == "pfbchannelizer") {
+        return TestPFBChannelizer;
     } else {
         return TestDecimatorsII;
     }
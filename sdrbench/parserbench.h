@@ -33,7 +33,12 @@ public:
         TestDecimatorsFF,
         TestDecimatorsInfII,
         TestDecimatorsSupII,
-        TestAMBE
+        TestAMBE,
+        TestLDPC,
+        TestViterbi,
+        TestWebAPIRouter,
+        TestHttpServer,
+        TestPFBChannelizer
     } TestType;
 
     ParserBench();
@@ -199,11 +199,15 @@ void DeviceUISet::loadRxChannelSettings(const Preset *preset, PluginAPI *pluginA
                     qDebug("DeviceUISet::loadRxChannelSettings: creating new channel [%s] from config [%s]",
                             qPrintable((*channelRegistrations)[i].m_channelIdURI),
                             qPrintable(channelConfig.m_channelIdURI));
-                    BasebandSampleSink *rxChannel =
-                            (*channelRegistrations)[i].m_plugin->createRxChannelBS(m_deviceAPI);
-                    PluginInstanceGUI *rxChannelGUI =
-                            (*channelRegistrations)[i].m_plugin->createRxChannelGUI(this, rxChannel);
-                    reg = ChannelInstanceRegistration(channelConfig.m_channelIdURI, rxChannelGUI);
+                    PluginInterface *pluginInterface = (*channelRegistrations)[i].m_plugin; // unregistered if it cannot be loaded
+                    BasebandSampleSink *rxChannel = pluginInterface->createRxChannelBS(m_deviceAPI);
+
+                    if (rxChannel)
+                    {
+                        PluginInstanceGUI *rxChannelGUI = pluginInterface->createRxChannelGUI(this, rxChannel);
+                        reg = ChannelInstanceRegistration(channelConfig.m_channelIdURI, rxChannelGUI);
+                    }
+
                     break;
                 }
             }
@@ -280,11 +284,15 @@ void DeviceUISet::loadTxChannelSettings(const Preset *preset, PluginAPI *pluginA
                     qDebug("DeviceUISet::loadTxChannelSettings: creating new channel [%s] from config [%s]",
                             qPrintable((*channelRegistrations)[i].m_channelIdURI),
                             qPrintable(channelConfig.m_channelIdURI));
-                    BasebandSampleSource *txChannel =
-                            (*channelRegistrations)[i].m_plugin->createTxChannelBS(m_deviceAPI);
-                    PluginInstanceGUI *txChannelGUI =
-                            (*channelRegistrations)[i].m_plugin->createTxChannelGUI(this, txChannel);
-                    reg = ChannelInstanceRegistration(channelConfig.m_channelIdURI, txChannelGUI);
+                    PluginInterface *pluginInterface = (*channelRegistrations)[i].m_plugin; // unregistered if it cannot be loaded
+                    BasebandSampleSource *txChannel = pluginInterface->createTxChannelBS(m_deviceAPI);
+
+                    if (txChannel)
+                    {
+                        PluginInstanceGUI *txChannelGUI = pluginInterface->createTxChannelGUI(this, txChannel);
+                        reg = ChannelInstanceRegistration(channelConfig.m_channelIdURI, txChannelGUI);
+                    }
+
                     break;
                 }
             }
@@ -16,6 +16,10 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
+
 #include <QDebug>
 #include <QMutexLocker>
 
@@ -68,9 +72,12 @@ ScopeVis::ScopeVis(GLScope* glScope) :
     setObjectName("ScopeVis");
     m_traceDiscreteMemory.resize(m_traceChunkSize); // arbitrary
     m_glScope->setTraces(&m_traces.m_tracesData, &m_traces.m_traces[0]);
+
     for (int i = 0; i < (int) Projector::nbProjectionTypes; i++) {
-        m_projectorCache[i] = 0.0;
+        m_projections[i].resize(m_projectionBlockSize);
     }
+
+    m_triggerProjection.resize(m_projectionBlockSize);
 }
 
 ScopeVis::~ScopeVis()
@@ -356,30 +363,46 @@ void ScopeVis::processTrace(const SampleVector::const_iterator& cbegin, const Sa
                 }
             }
 
-            if (m_triggerComparator.triggered(*begin, *triggerCondition)) // matched the current trigger
+            // look for the trigger over a block of samples
+            int nbSamples = std::min((int) (end - begin), (int) m_projectionBlockSize);
+            triggerCondition->m_projector.runBlock(&(*begin), m_triggerProjection.data(), nbSamples);
+            int triggerIndex = m_triggerComparator.triggered(m_triggerProjection.data(), nbSamples, *triggerCondition);
+
+            if (triggerIndex < 0) // no trigger in this block
             {
-                if (triggerCondition->m_triggerData.m_triggerDelay > 0)
-                {
-                    triggerCondition->m_triggerDelayCount = triggerCondition->m_triggerData.m_triggerDelay; // initialize delayed samples counter
-                    m_triggerState = TriggerDelay;
-                    ++begin;
-                    continue;
-                }
+                begin += nbSamples;
+                continue;
+            }
 
-                if (nextTrigger()) // move to next trigger and keep going
-                {
-                    m_triggerComparator.reset();
-                    m_triggerState = TriggerUntriggered;
-                }
-                else // this was the last trigger then start trace
-                {
-                    m_traceStart = true; // start of trace processing
-                    m_nbSamples = m_traceSize + m_maxTraceDelay;
-                    m_triggerComparator.reset();
-                    m_triggerState = TriggerTriggered;
-                    triggerPointToEnd = end - begin;
-                    break;
-                }
+            begin += triggerIndex;
+
+            if (triggerCondition->m_projector.getProjectionType() == Projector::ProjectionDPhase) {
+                triggerCondition->m_projector.setPrevSample(*begin); // the rest of the block will be projected again
+            }
+
+            // matched the current trigger
+
+            if (triggerCondition->m_triggerData.m_triggerDelay > 0)
+            {
+                triggerCondition->m_triggerDelayCount = triggerCondition->m_triggerData.m_triggerDelay; // initialize delayed samples counter
+                m_triggerState = TriggerDelay;
+                ++begin;
+                continue;
+            }
+
+            if (nextTrigger()) // move to next trigger and keep going
+            {
+                m_triggerComparator.reset();
+                m_triggerState = TriggerUntriggered;
+            }
+            else // this was the last trigger then start trace
+            {
+                m_traceStart = true; // start of trace processing
+                m_nbSamples = m_traceSize + m_maxTraceDelay;
+                m_triggerComparator.reset();
+                m_triggerState = TriggerTriggered;
+                triggerPointToEnd = end - begin;
+                break;
             }
 
             ++begin;
@@ -492,122 +515,172 @@ int ScopeVis::processTraces(const SampleVector::const_iterator& cbegin, const Sa
     SampleVector::const_iterator begin(cbegin);
     uint32_t shift = (m_timeOfsProMill / 1000.0) * m_traceSize;
     uint32_t length = m_traceSize / m_timeBase;
+    uint32_t visibleEnd = std::min(shift + length, m_traceSize); // power overlay is computed on the displayed points only
+    uint32_t bufferIndex = m_traces.currentBufferIndex();
+    int nbTraces = m_traces.size();
+    int traceStart[m_maxNbTraces];   // first sample of the block for each trace
+    int traceCounts[m_maxNbTraces];  // number of samples of the block taken by each trace
+    int visibleStart[m_maxNbTraces]; // displayed samples of the block for each trace
+    int visibleStop[m_maxNbTraces];
 
     while ((begin < end) && (m_nbSamples > 0))
     {
-        std::vector<TraceControl*>::iterator itCtl = m_traces.m_tracesControl.begin();
-        std::vector<TraceData>::iterator itData = m_traces.m_tracesData.begin();
-        std::vector<float *>::iterator itTrace = m_traces.m_traces[m_traces.currentBufferIndex()].begin();
-
-        for (; itCtl != m_traces.m_tracesControl.end(); ++itCtl, ++itData, ++itTrace)
+        int nbSamples = std::min((int) (end - begin), std::min(m_nbSamples, (int) m_projectionBlockSize));
+        bool lastBlock = nbSamples == m_nbSamples; // block contains the last sample of the complex trace
+        const Sample *samples = &(*begin);
+        int projectionStart[(int) Projector::nbProjectionTypes];
+        int projectionStop[(int) Projector::nbProjectionTypes];
+        Projector *projectors[(int) Projector::nbProjectionTypes];
+
+        for (int type = 0; type < (int) Projector::nbProjectionTypes; type++)
         {
-            if (traceBack && ((end - begin) > itData->m_traceDelay)) { // before start of trace
-                continue;
-            }
+            projectionStart[type] = nbSamples;
+            projectionStop[type] = 0;
+            projectors[type] = nullptr;
+        }
 
-            Projector::ProjectionType projectionType = itData->m_projectionType;
+        // find which samples are taken by each trace. All trace points are projected so that a frozen
+        // or one shot trace remains complete when the time base or offset changes.
 
-            if ((*itCtl)->m_traceCount[m_traces.currentBufferIndex()] < m_traceSize)
+        for (int i = 0; i < nbTraces; i++)
+        {
+            TraceControl *traceControl = m_traces.m_tracesControl[i];
+            const TraceData& traceData = m_traces.m_tracesData[i];
+            int traceCount = traceControl->m_traceCount[bufferIndex];
+            int start = traceBack ? std::max((int) (end - begin) - traceData.m_traceDelay, 0) : 0; // before start of trace in trace back
+
+            traceStart[i] = start;
+            traceCounts[i] = ((uint32_t) traceCount < m_traceSize) && (start < nbSamples) ?
+                std::min(nbSamples - start, (int) m_traceSize - traceCount) : 0;
+            visibleStart[i] = start + std::max((int) shift - traceCount, 0);
+            visibleStop[i] = start + std::min((int) visibleEnd - traceCount, traceCounts[i]);
+
+            if (traceCounts[i] > 0)
             {
-                uint32_t& traceCount = (*itCtl)->m_traceCount[m_traces.currentBufferIndex()]; // reference for code clarity
-                float v;
+                int type = (int) traceData.m_projectionType;
+                projectionStart[type] = std::min(projectionStart[type], start);
+                projectionStop[type] = std::max(projectionStop[type], start + traceCounts[i]);
 
-                if (projectionType == Projector::ProjectionMagLin)
-                {
-                    v = ((*itCtl)->m_projector.run(*begin) - itData->m_ofs)*itData->m_amp - 1.0f;
+                if (!projectors[type]) {
+                    projectors[type] = &traceControl->m_projector; // first trace of this type holds the projection state
                 }
-                else if (projectionType == Projector::ProjectionMagSq)
+
+                if (traceData.m_projectionType == Projector::ProjectionMagDB) // needs squared magnitude for power overlay and dB
                 {
-                    Real magsq = (*itCtl)->m_projector.run(*begin);
-                    v = (magsq - itData->m_ofs)*itData->m_amp - 1.0f;
+                    projectionStart[Projector::ProjectionMagSq] = std::min(projectionStart[Projector::ProjectionMagSq], start);
+                    projectionStop[Projector::ProjectionMagSq] = std::max(projectionStop[Projector::ProjectionMagSq], start + traceCounts[i]);
+                }
+            }
+        }
 
-                    if ((traceCount >= shift) && (traceCount < shift+length)) // power display overlay values construction
-                    {
-                        if (traceCount == shift)
-                        {
-                            (*itCtl)->m_maxPow = 0.0f;
-                            (*itCtl)->m_sumPow = 0.0f;
-                            (*itCtl)->m_nbPow = 1;
-                        }
+        // project once for all traces of the same type. Squared magnitude comes before dB.
 
-                        if (magsq > 0.0f)
-                        {
-                            if (magsq > (*itCtl)->m_maxPow)
-                            {
-                                (*itCtl)->m_maxPow = magsq;
-                            }
+        for (int type = 0; type < (int) Projector::nbProjectionTypes; type++)
+        {
+            int start = projectionStart[type];
+            int n = projectionStop[type] - start;
 
-                            (*itCtl)->m_sumPow += magsq;
-                            (*itCtl)->m_nbPow++;
-                        }
-                    }
+            if (n <= 0) {
+                continue;
+            }
 
-                    if ((m_nbSamples == 1) && ((*itCtl)->m_nbPow > 0)) // on last sample create power display overlay
-                    {
-                        double avgPow = (*itCtl)->m_sumPow / (*itCtl)->m_nbPow;
-                        itData->m_textOverlay = QString("%1  %2").arg((*itCtl)->m_maxPow, 0, 'e', 2).arg(avgPow, 0, 'e', 2);
-                        (*itCtl)->m_nbPow = 0;
-                    }
+            if (type == (int) Projector::ProjectionMagSq)
+            {
+                Projector::magSqBlock(&samples[start], &m_projections[type][start], n);
+            }
+            else if (type == (int) Projector::ProjectionMagDB)
+            {
+                Projector::powerDBBlock(&m_projections[Projector::ProjectionMagSq][start], &m_projections[type][start], n);
+            }
+            else
+            {
+                if ((type == (int) Projector::ProjectionDPhase) && (start > 0)) {
+                    projectors[type]->setPrevSample(samples[start - 1]);
                 }
-                else if (projectionType == Projector::ProjectionMagDB)
+
+                projectors[type]->runBlock(&samples[start], &m_projections[type][start], n);
+            }
+        }
+
+        // scale to display and power overlay
+
+        for (int i = 0; i < nbTraces; i++)
+        {
+            if (traceCounts[i] <= 0) {
+                continue;
+            }
+
+            TraceControl *traceControl = m_traces.m_tracesControl[i];
+            TraceData& traceData = m_traces.m_tracesData[i];
+            uint32_t& traceCount = traceControl->m_traceCount[bufferIndex]; // reference for code clarity
+            Projector::ProjectionType projectionType = traceData.m_projectionType;
+
+            const Real *projection = &m_projections[(int) projectionType][traceStart[i]];
+            float *trace = m_traces.m_traces[bufferIndex][i];
+
+            if ((projectionType == Projector::ProjectionMagLin) || (projectionType == Projector::ProjectionMagSq)) {
+                projectionToTrace(projection, trace, traceCounts[i], traceCount, shift, traceData.m_amp, -traceData.m_ofs*traceData.m_amp - 1.0f);
+            } else if (projectionType == Projector::ProjectionMagDB) { // ((pdB - 100*ofs)/50 + 2)*amp - 1
+                projectionToTrace(projection, trace, traceCounts[i], traceCount, shift, traceData.m_amp / 50.0f, (2.0f - 2.0f*traceData.m_ofs)*traceData.m_amp - 1.0f);
+            } else {
+                projectionToTrace(projection, trace, traceCounts[i], traceCount, shift, traceData.m_amp, -traceData.m_ofs*traceData.m_amp);
+            }
+
+            if (visibleStart[i] < visibleStop[i])
+            {
+                int n = visibleStop[i] - visibleStart[i];
+                uint32_t x0 = traceCount + (visibleStart[i] - traceStart[i]);
+
+                if ((projectionType == Projector::ProjectionMagSq) || (projectionType == Projector::ProjectionMagDB)) // power display overlay values construction
                 {
-                    Real re = begin->m_real / SDR_RX_SCALEF;
-                    Real im = begin->m_imag / SDR_RX_SCALEF;
-                    double magsq = re*re + im*im;
-                    float pdB = log10f(magsq) * 10.0f;
-                    float p = pdB - (100.0f * itData->m_ofs);
-                    v = ((p/50.0f) + 2.0f)*itData->m_amp - 1.0f;
-
-                    if ((traceCount >= shift) && (traceCount < shift+length)) // power display overlay values construction
+                    const Real *magsq = &m_projections[(int) Projector::ProjectionMagSq][visibleStart[i]];
+
+                    if (x0 == shift)
                     {
-                        if (traceCount == shift)
-                        {
-                            (*itCtl)->m_maxPow = 0.0f;
-                            (*itCtl)->m_sumPow = 0.0f;
-                            (*itCtl)->m_nbPow = 1;
-                        }
+                        traceControl->m_maxPow = 0.0f;
+                        traceControl->m_sumPow = 0.0f;
+                        traceControl->m_nbPow = 1;
+                    }
 
-                        if (magsq > 0.0f)
+                    for (int k = 0; k < n; k++)
+                    {
+                        if (magsq[k] > 0.0f)
                         {
-                            if (magsq > (*itCtl)->m_maxPow)
-                            {
-                                (*itCtl)->m_maxPow = magsq;
+                            if (magsq[k] > traceControl->m_maxPow) {
+                                traceControl->m_maxPow = magsq[k];
                             }
 
-                            (*itCtl)->m_sumPow += magsq;
-                            (*itCtl)->m_nbPow++;
+                            traceControl->m_sumPow += magsq[k];
+                            traceControl->m_nbPow++;
                         }
                     }
-
-                    if ((m_nbSamples == 1) && ((*itCtl)->m_nbPow > 0)) // on last sample create power display overlay
-                    {
-                        double avgPow = log10f((*itCtl)->m_sumPow / (*itCtl)->m_nbPow)*10.0;
-                        double peakPow = log10f((*itCtl)->m_maxPow)*10.0;
-                        double peakToAvgPow = peakPow - avgPow;
-                        itData->m_textOverlay = QString("%1  %2  %3").arg(peakPow, 0, 'f', 1).arg(avgPow, 0, 'f', 1).arg(peakToAvgPow, 4, 'f', 1, ' ');
-                        (*itCtl)->m_nbPow = 0;
-                    }
                 }
-                else
+            }
+
+            // on last sample create power display overlay
+            if (lastBlock && (traceStart[i] + traceCounts[i] == nbSamples) && (traceControl->m_nbPow > 0))
+            {
+                if (projectionType == Projector::ProjectionMagSq)
                 {
-                    v = ((*itCtl)->m_projector.run(*begin) - itData->m_ofs) * itData->m_amp;
+                    double avgPow = traceControl->m_sumPow / traceControl->m_nbPow;
+                    traceData.m_textOverlay = QString("%1  %2").arg(traceControl->m_maxPow, 0, 'e', 2).arg(avgPow, 0, 'e', 2);
+                    traceControl->m_nbPow = 0;
                 }
-
-                if(v > 1.0f) {
-                    v = 1.0f;
-                } else if (v < -1.0f) {
-                    v = -1.0f;
+                else if (projectionType == Projector::ProjectionMagDB)
+                {
+                    double avgPow = log10f(traceControl->m_sumPow / traceControl->m_nbPow)*10.0;
+                    double peakPow = log10f(traceControl->m_maxPow)*10.0;
+                    double peakToAvgPow = peakPow - avgPow;
+                    traceData.m_textOverlay = QString("%1  %2  %3").arg(peakPow, 0, 'f', 1).arg(avgPow, 0, 'f', 1).arg(peakToAvgPow, 4, 'f', 1, ' ');
+                    traceControl->m_nbPow = 0;
                 }
-
-                (*itTrace)[2*traceCount]
-                           = traceCount - shift;   // display x
-                (*itTrace)[2*traceCount + 1] = v;  // display y
-                traceCount++;
             }
+
+            traceCount += traceCounts[i];
         }
 
-        ++begin;
-        m_nbSamples--;
+        begin += nbSamples;
+        m_nbSamples -= nbSamples;
     }
 
     float traceTime = ((float) m_traceSize) / m_sampleRate;
@@ -647,6 +720,153 @@ void ScopeVis::stop()
 {
 }
 
+void ScopeVis::projectionToTrace(const Real *projection, float *trace, int n, uint32_t x0, uint32_t shift, float amp, float ofs)
+{
+    int i = 0;
+    float x = (float) x0 - (float) shift; // display x
+
+#if defined(USE_SSE2)
+    const __m128 amp4 = _mm_set1_ps(amp);
+    const __m128 ofs4 = _mm_set1_ps(ofs);
+    const __m128 min4 = _mm_set1_ps(-1.0f);
+    const __m128 max4 = _mm_set1_ps(1.0f);
+    __m128 x4 = _mm_add_ps(_mm_set1_ps(x), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+    float *out = &trace[2*x0];
+
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 y4 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&projection[i]), amp4), ofs4);
+        y4 = _mm_min_ps(_mm_max_ps(y4, min4), max4);
+        _mm_storeu_ps(&out[2*i], _mm_unpacklo_ps(x4, y4));
+        _mm_storeu_ps(&out[2*i + 4], _mm_unpackhi_ps(x4, y4));
+        x4 = _mm_add_ps(x4, _mm_set1_ps(4.0f));
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        float v = projection[i] * amp + ofs;
+
+        if (v > 1.0f) {
+            v = 1.0f;
+        } else if (v < -1.0f) {
+            v = -1.0f;
+        }
+
+        trace[2*(x0 + i)] = x + i;
+        trace[2*(x0 + i) + 1] = v;
+    }
+}
+
+int ScopeVis::findCrossing(const Real *values, int start, int n, Real level, bool above)
+{
+    int i = start;
+
+#if defined(USE_SSE2)
+    const __m128 level4 = _mm_set1_ps(level);
+    const int steady = above ? 0xF : 0x0;
+
+    for (; i + 4 <= n; i += 4)
+    {
+        if (_mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(&values[i]), level4)) != steady) {
+            break;
+        }
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        if ((values[i] > level) != above) {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+int ScopeVis::TriggerComparator::triggered(const Real *values, int n, TriggerCondition& triggerCondition)
+{
+    if (triggerCondition.m_triggerData.m_triggerLevel != m_level)
+    {
+        m_level = triggerCondition.m_triggerData.m_triggerLevel;
+        computeLevels();
+    }
+
+    Real level;
+    uint32_t holdoff = triggerCondition.m_triggerData.m_triggerHoldoff;
+
+    if (triggerCondition.m_projector.getProjectionType() == Projector::ProjectionMagDB) {
+        level = m_levelPowerDB;
+    } else if (triggerCondition.m_projector.getProjectionType() == Projector::ProjectionMagLin) {
+        level = m_levelPowerLin;
+    } else {
+        level = m_level;
+    }
+
+    int i = 0;
+
+    while (i < n)
+    {
+        bool condition = values[i] > level;
+
+        // condition and holdoff counters are settled: nothing happens until the level is crossed
+        if (!m_reset && (condition == triggerCondition.m_prevCondition)
+            && (condition ? (triggerCondition.m_trues >= holdoff) && (triggerCondition.m_falses == 0)
+                          : (triggerCondition.m_falses >= holdoff) && (triggerCondition.m_trues == 0)))
+        {
+            i = findCrossing(values, i + 1, n, level, condition);
+            continue;
+        }
+
+        bool trigger;
+
+        if (condition)
+        {
+            if (triggerCondition.m_trues < holdoff) {
+                condition = false;
+                triggerCondition.m_trues++;
+            } else {
+                triggerCondition.m_falses = 0;
+            }
+        }
+        else
+        {
+            if (triggerCondition.m_falses < holdoff) {
+                condition = true;
+                triggerCondition.m_falses++;
+            } else {
+                triggerCondition.m_trues = 0;
+            }
+        }
+
+        if (m_reset)
+        {
+            triggerCondition.m_prevCondition = condition;
+            m_reset = false;
+            i++;
+            continue;
+        }
+
+        if (triggerCondition.m_triggerData.m_triggerBothEdges) {
+            trigger = triggerCondition.m_prevCondition ? !condition : condition; // This is a XOR between bools
+        } else if (triggerCondition.m_triggerData.m_triggerPositiveEdge) {
+            trigger = !triggerCondition.m_prevCondition && condition;
+        } else {
+            trigger = triggerCondition.m_prevCondition && !condition;
+        }
+
+        triggerCondition.m_prevCondition = condition;
+
+        if (trigger) {
+            return i;
+        }
+
+        i++;
+    }
+
+    return -1;
+}
+
 bool ScopeVis::handleMessage(const Message& message)
 {
     if (DSPSignalNotification::match(message))
@@ -912,13 +1132,9 @@ bool ScopeVis::handleMessage(const Message& message)
 void ScopeVis::updateMaxTraceDelay()
 {
     int maxTraceDelay = 0;
-    bool allocateCache = false;
-    uint32_t projectorCounts[(int) Projector::nbProjectionTypes];
-    memset(projectorCounts, 0, ((int) Projector::nbProjectionTypes)*sizeof(uint32_t));
     std::vector<TraceData>::iterator itData = m_traces.m_tracesData.begin();
-    std::vector<TraceControl*>::iterator itCtrl = m_traces.m_tracesControl.begin();
 
-    for (; itData != m_traces.m_tracesData.end(); ++itData, ++itCtrl)
+    for (; itData != m_traces.m_tracesData.end(); ++itData)
     {
         if (itData->m_traceDelay > maxTraceDelay)
         {
@@ -928,29 +1144,6 @@ void ScopeVis::updateMaxTraceDelay()
         if (itData->m_projectionType < 0) {
             itData->m_projectionType = Projector::ProjectionReal;
         }
-
-        if (projectorCounts[(int) itData->m_projectionType] > 0)
-        {
-            allocateCache = true;
-            (*itCtrl)->m_projector.setCacheMaster(false);
-        }
-        else
-        {
-            (*itCtrl)->m_projector.setCacheMaster(true);
-        }
-
-        projectorCounts[(int) itData->m_projectionType]++;
-    }
-
-    itCtrl = m_traces.m_tracesControl.begin();
-
-    for (; itCtrl != m_traces.m_tracesControl.end(); ++itCtrl)
-    {
-        if (allocateCache) {
-            (*itCtrl)->m_projector.setCache(m_projectorCache);
-        } else {
-            (*itCtrl)->m_projector.setCache(0);
-        }
     }
 
     m_maxTraceDelay = maxTraceDelay;
@@ -151,6 +151,7 @@ public:
     static const uint32_t m_maxNbTriggers = 10;
     static const uint32_t m_maxNbTraces = 10;
     static const uint32_t m_nbTraceMemories = 50;
+    static const uint32_t m_projectionBlockSize = 1024; //!< Samples projected at once
 
     ScopeVis(GLScope* glScope = 0);
     virtual ~ScopeVis();
@@ -1036,69 +1037,11 @@ private:
             computeLevels();
         }
 
-        bool triggered(const Sample& s, TriggerCondition& triggerCondition)
-        {
-            if (triggerCondition.m_triggerData.m_triggerLevel != m_level)
-            {
-                m_level = triggerCondition.m_triggerData.m_triggerLevel;
-                computeLevels();
-            }
-
-            bool condition, trigger;
-
-            if (triggerCondition.m_projector.getProjectionType() == Projector::ProjectionMagDB) {
-                condition = triggerCondition.m_projector.run(s) > m_levelPowerDB;
-            } else if (triggerCondition.m_projector.getProjectionType() == Projector::ProjectionMagLin) {
-                condition = triggerCondition.m_projector.run(s) > m_levelPowerLin;
-            } else {
-                condition = triggerCondition.m_projector.run(s) > m_level;
-            }
-
-            if (condition)
-            {
-                if (triggerCondition.m_trues < triggerCondition.m_triggerData.m_triggerHoldoff) {
-                    condition = false;
-                    triggerCondition.m_trues++;
-                } else {
-                    triggerCondition.m_falses = 0;
-                }
-            }
-            else
-            {
-                if (triggerCondition.m_falses < triggerCondition.m_triggerData.m_triggerHoldoff) {
-                    condition = true;
-                    triggerCondition.m_falses++;
-                } else {
-                    triggerCondition.m_trues = 0;
-                }
-            }
-
-            if (m_reset)
-            {
-                triggerCondition.m_prevCondition = condition;
-                m_reset = false;
-                return false;
-            }
-
-            if (triggerCondition.m_triggerData.m_triggerBothEdges) {
-                trigger = triggerCondition.m_prevCondition ? !condition : condition; // This is a XOR between bools
-            } else if (triggerCondition.m_triggerData.m_triggerPositiveEdge) {
-                trigger = !triggerCondition.m_prevCondition && condition;
-            } else {
-                trigger = triggerCondition.m_prevCondition && !condition;
-            }
-
-//            if (trigger) {
-//                qDebug("ScopeVis::triggered: %s/%s %f/%f",
-//                        triggerCondition.m_prevCondition ? "T" : "F",
-//                        condition ? "T" : "F",
-//                        triggerCondition.m_projector->run(s),
-//                        triggerCondition.m_triggerData.m_triggerLevel);
-//            }
-
-            triggerCondition.m_prevCondition = condition;
-            return trigger;
-        }
+        /**
+         * Run the trigger condition over a block of projected samples. Returns the index
+         * of the sample that triggers or -1 if the whole block was processed without trigger.
+         */
+        int triggered(const Real *values, int n, TriggerCondition& triggerCondition);
 
         void reset()
         {
@@ -1142,7 +1085,8 @@ private:
     int m_maxTraceDelay;                           //!< Maximum trace delay
     TriggerComparator m_triggerComparator;         //!< Compares sample level to trigger level
     QMutex m_mutex;
-    Real m_projectorCache[(int) Projector::nbProjectionTypes];
+    std::vector<Real> m_projections[(int) Projector::nbProjectionTypes]; //!< Block of projected samples for each projection type shared by traces
+    std::vector<Real> m_triggerProjection;         //!< Block of projected samples for the trigger condition
     bool m_triggerOneShot;                         //!< True when one shot mode is active
     bool m_triggerWaitForReset;                    //!< In one shot mode suspended until reset by UI
     uint32_t m_currentTraceMemoryIndex;            //!< The current index of trace in memory (0: current)
@@ -1171,6 +1115,19 @@ private:
      */
     int processTraces(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool traceBack = false);
 
+    /**
+     * Scale projected values to display and store them with their display x in trace
+     * - from trace point index x0 for n points
+     * - y = clamp(projection * amp + ofs) in [-1..1]
+     */
+    static void projectionToTrace(const Real *projection, float *trace, int n, uint32_t x0, uint32_t shift, float amp, float ofs);
+
+    /**
+     * Index of the first value from start that is not above (or not below when above is false)
+     * level or n if none
+     */
+    static int findCrossing(const Real *values, int start, int n, Real level, bool above);
+
     /**
      * Get maximum trace delay
      */
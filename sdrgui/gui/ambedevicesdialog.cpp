@@ -52,15 +52,23 @@ void AMBEDevicesDialog::populateSerialList()
 
 void AMBEDevicesDialog::refreshInUseList()
 {
-    std::vector<QString> inUseDevices;
-    m_ambeEngine->getDeviceRefs(inUseDevices);
+    std::vector<AMBEEngine::DeviceStats> deviceStats;
+    m_ambeEngine->getDeviceStats(deviceStats);
     ui->ambeDeviceRefs->clear();
-    std::vector<QString>::const_iterator it = inUseDevices.begin();
+    std::vector<AMBEEngine::DeviceStats>::const_iterator it = deviceStats.begin();
 
-    for (; it != inUseDevices.end(); ++it)
+    for (; it != deviceStats.end(); ++it)
     {
-        qDebug("AMBEDevicesDialog::refreshInUseList: %s", qPrintable(*it));
-        ui->ambeDeviceRefs->addItem(*it);
+        QString deviceRef = QString(it->device.c_str());
+        qDebug("AMBEDevicesDialog::refreshInUseList: %s", qPrintable(deviceRef));
+        ui->ambeDeviceRefs->addItem(deviceRef);
+        ui->ambeDeviceRefs->item(ui->ambeDeviceRefs->count() - 1)->setToolTip(
+            tr("Queue: %1 frames\nStreams: %2\nDecoded: %3 frames\nDropped: %4 frames\nLatency: %5 ms")
+                .arg(it->queueDepth)
+                .arg(it->nbStreams)
+                .arg(it->nbFramesDecoded)
+                .arg(it->nbFramesDropped)
+                .arg(it->latencyMs, 0, 'f', 1));
     }
 }
 
@@ -271,6 +271,9 @@ void AudioDialogX::updateOutputDisplay()
     ui->outputUDPPort->setText(tr("%1").arg(m_outputDeviceInfo.udpPort));
     ui->outputUDPCopy->setChecked(m_outputDeviceInfo.copyToUDP);
     ui->outputUDPUseRTP->setChecked(m_outputDeviceInfo.udpUseRTP);
+    ui->outputLowLatency->setChecked(m_outputDeviceInfo.lowLatency);
+    ui->outputUDPBlockSize->setValue(m_outputDeviceInfo.udpBlockSize);
+    ui->outputUDPOpusFrameDuration->setCurrentIndex(m_outputDeviceInfo.udpOpusFrameDuration <= 5 ? 0 : m_outputDeviceInfo.udpOpusFrameDuration <= 10 ? 1 : 2);
     ui->outputUDPChannelMode->setCurrentIndex((int) m_outputDeviceInfo.udpChannelMode);
     ui->outputUDPChannelCodec->setCurrentIndex((int) m_outputDeviceInfo.udpChannelCodec);
     ui->decimationFactor->setCurrentIndex(m_outputDeviceInfo.udpDecimationFactor == 0 ? 0 : m_outputDeviceInfo.udpDecimationFactor - 1);
@@ -290,6 +293,9 @@ void AudioDialogX::updateOutputDeviceInfo()
     m_outputDeviceInfo.udpPort = m_outputUDPPort;
     m_outputDeviceInfo.copyToUDP = ui->outputUDPCopy->isChecked();
     m_outputDeviceInfo.udpUseRTP = ui->outputUDPUseRTP->isChecked();
+    m_outputDeviceInfo.lowLatency = ui->outputLowLatency->isChecked();
+    m_outputDeviceInfo.udpBlockSize = ui->outputUDPBlockSize->value();
+    m_outputDeviceInfo.udpOpusFrameDuration = 5 << ui->outputUDPOpusFrameDuration->currentIndex(); // 5, 10 or 20 ms
     m_outputDeviceInfo.udpChannelMode = (AudioOutput::UDPChannelMode) ui->outputUDPChannelMode->currentIndex();
     m_outputDeviceInfo.udpChannelCodec = (AudioOutput::UDPChannelCodec) ui->outputUDPChannelCodec->currentIndex();
     m_outputDeviceInfo.udpDecimationFactor = ui->decimationFactor->currentIndex() + 1;
@@ -32,16 +32,25 @@ DeviceUserArgsDialog::DeviceUserArgsDialog(
 {
 	ui->setupUi(this);
 
-	for (int i = 0; i < m_deviceEnumerator->getNbRxSamplingDevices(); i++) {
-		pushHWDeviceReference(m_deviceEnumerator->getRxSamplingDevice(i));
+	for (int i = 0; i < m_deviceEnumerator->getNbRxSamplingDevices(); i++)
+	{
+		if (m_deviceEnumerator->isRxSamplingDevicePresent(i)) {
+			pushHWDeviceReference(m_deviceEnumerator->getRxSamplingDevice(i));
+		}
 	}
 
-	for (int i = 0; i < m_deviceEnumerator->getNbTxSamplingDevices(); i++) {
-		pushHWDeviceReference(m_deviceEnumerator->getTxSamplingDevice(i));
+	for (int i = 0; i < m_deviceEnumerator->getNbTxSamplingDevices(); i++)
+	{
+		if (m_deviceEnumerator->isTxSamplingDevicePresent(i)) {
+			pushHWDeviceReference(m_deviceEnumerator->getTxSamplingDevice(i));
+		}
 	}
 
-	for (int i = 0; i < m_deviceEnumerator->getNbMIMOSamplingDevices(); i++) {
-		pushHWDeviceReference(m_deviceEnumerator->getMIMOSamplingDevice(i));
+	for (int i = 0; i < m_deviceEnumerator->getNbMIMOSamplingDevices(); i++)
+	{
+		if (m_deviceEnumerator->isMIMOSamplingDevicePresent(i)) {
+			pushHWDeviceReference(m_deviceEnumerator->getMIMOSamplingDevice(i));
+		}
 	}
 
 	for (auto& hwItem : m_availableHWDevices)
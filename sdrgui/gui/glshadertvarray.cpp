@@ -17,6 +17,7 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <gui/glshadertvarray.h>
+#include <algorithm>
 
 const QString GLShaderTVArray::m_strVertexShaderSourceArray = QString(
         "uniform highp mat4 uMatrix;\n"
@@ -312,6 +313,24 @@ bool GLShaderTVArray::SelectRow(int intLine)
     return blnRslt;
 }
 
+bool GLShaderTVArray::SetDataLine(int intRow, int intColStart, const unsigned char *grays, int nbPixels)
+{
+    if (!m_blnInitialized || (intRow < 0) || (intRow >= m_intRows)) {
+        return false;
+    }
+
+    QRgb *row = (QRgb *) m_objImage->scanLine(intRow);
+    int intColEnd = std::min(intColStart + nbPixels, m_intCols);
+
+    for (int intCol = std::max(intColStart, 0); intCol < intColEnd; intCol++)
+    {
+        unsigned char gray = grays[intCol - intColStart];
+        row[intCol] = qRgb(gray, gray, gray);
+    }
+
+    return true;
+}
+
 bool GLShaderTVArray::SetDataColor(int intCol, QRgb objColor)
 {
     bool blnRslt = false;
@@ -55,6 +55,7 @@ public:
 
     bool SelectRow(int intLine);
     bool SetDataColor(int intCol,QRgb objColor);
+    bool SetDataLine(int intRow, int intColStart, const unsigned char *grays, int nbPixels);
 
 
 protected:
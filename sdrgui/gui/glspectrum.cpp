@@ -16,8 +16,10 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#if 0 //def USE_SSE2
+#if defined(USE_SSE2)
 #include <emmintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
 #endif
 
 #include <QMouseEvent>
@@ -50,7 +52,6 @@ GLSpectrum::GLSpectrum(QWidget* parent) :
 	m_displayTraceIntensity(50),
 	m_invertedWaterfall(false),
 	m_displayMaxHold(false),
-	m_currentSpectrum(0),
 	m_displayCurrent(false),
     m_leftMargin(0),
 	m_waterfallBuffer(0),
@@ -63,12 +64,13 @@ GLSpectrum::GLSpectrum(QWidget* parent) :
     m_histogramBuffer(0),
     m_histogram(0),
     m_displayHistogram(true),
-    m_displayChanged(false),
     m_displaySourceOrSink(true),
     m_displayStreamIndex(0),
     m_matrixLoc(0),
     m_colorLoc(0),
-    m_messageQueueToGUI(0)
+    m_messageQueueToGUI(0),
+    m_mailboxWrite(0),
+    m_mailboxRead(0)
 {
 	setAutoFillBackground(false);
 	setAttribute(Qt::WA_OpaquePaintEvent, true);
@@ -342,155 +344,214 @@ void GLSpectrum::removeChannelMarker(ChannelMarker* channelMarker)
 
 void GLSpectrum::newSpectrum(const std::vector<Real>& spectrum, int fftSize)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	quint32 write = m_mailboxWrite.load();
+
+	if (write - m_mailboxRead.loadAcquire() >= m_mailboxSize) { // GUI is late: drop this line
+		return;
+	}
 
-	m_displayChanged = true;
+	SpectrumLine& line = m_mailbox[write & (m_mailboxSize - 1)];
+	line.m_spectrum.assign(spectrum.begin(), spectrum.begin() + fftSize);
+	line.m_fftSize = fftSize;
+	m_mailboxWrite.storeRelease(write + 1);
+}
 
-	if(m_changesPending) {
-		m_fftSize = fftSize;
+void GLSpectrum::processMailbox()
+{
+	quint32 read = m_mailboxRead.load();
+	quint32 write = m_mailboxWrite.loadAcquire();
+
+	if (read == write) {
 		return;
 	}
 
-	if(fftSize != m_fftSize) {
+	// follow the FFT size of the most recent line. Older lines of another size are dropped.
+	int fftSize = m_mailbox[(write - 1) & (m_mailboxSize - 1)].m_fftSize;
+
+	if (fftSize != m_fftSize)
+	{
 		m_fftSize = fftSize;
-		m_changesPending = true;
-		return;
+		applyChanges();
+	}
+
+	if (m_fftSize > 0)
+	{
+		int nbLines = 0;
+
+		for (quint32 i = read; i != write; i++)
+		{
+			if (m_mailbox[i & (m_mailboxSize - 1)].m_fftSize == m_fftSize) {
+				nbLines++;
+			}
+		}
+
+		decayHistogram(nbLines); // once for all lines
+
+		for (quint32 i = read; i != write; i++)
+		{
+			const SpectrumLine& line = m_mailbox[i & (m_mailboxSize - 1)];
+
+			if (line.m_fftSize == m_fftSize)
+			{
+				updateWaterfall(line.m_spectrum);
+				updateHistogram(line.m_spectrum);
+			}
+		}
+
+		// Store spectrum for current spectrum line display
+		const std::vector<Real>& lastSpectrum = m_mailbox[(write - 1) & (m_mailboxSize - 1)].m_spectrum;
+		m_currentSpectrum.assign(lastSpectrum.begin(), lastSpectrum.end());
 	}
 
-	updateWaterfall(spectrum);
-	updateHistogram(spectrum);
+	m_mailboxRead.storeRelease(write);
 }
 
 void GLSpectrum::updateWaterfall(const std::vector<Real>& spectrum)
 {
-	if(m_waterfallBufferPos < m_waterfallBuffer->height()) {
+	if (m_waterfallBufferPos < m_waterfallBuffer->height())
+	{
 		quint32* pix = (quint32*)m_waterfallBuffer->scanLine(m_waterfallBufferPos);
+		// palette index is (spectrum - reference level) * 240 / power range + 240 limited to [0..239]
+		const float scale = 240.0f / m_powerRange;
+		const float offset = 240.0f - m_referenceLevel * scale;
+		int i = 0;
+
+#if defined(USE_SSE2)
+		const __m128 scale4 = _mm_set1_ps(scale);
+		const __m128 offset4 = _mm_set1_ps(offset);
+		const __m128 min4 = _mm_setzero_ps();
+		const __m128 max4 = _mm_set1_ps(239.0f);
+		qint32 index[4];
+
+		for (; i + 4 <= m_fftSize; i += 4)
+		{
+			__m128 v = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&spectrum[i]), scale4), offset4);
+			v = _mm_min_ps(_mm_max_ps(v, min4), max4); // NaN gives 0
+			_mm_storeu_si128((__m128i*) index, _mm_cvttps_epi32(v));
+			pix[i]   = m_waterfallPalette[index[0]];
+			pix[i+1] = m_waterfallPalette[index[1]];
+			pix[i+2] = m_waterfallPalette[index[2]];
+			pix[i+3] = m_waterfallPalette[index[3]];
+		}
+#elif defined(USE_NEON)
+		const float32x4_t scale4 = vdupq_n_f32(scale);
+		const float32x4_t offset4 = vdupq_n_f32(offset);
+		const float32x4_t min4 = vdupq_n_f32(0.0f);
+		const float32x4_t max4 = vdupq_n_f32(239.0f);
+		qint32 index[4];
+
+		for (; i + 4 <= m_fftSize; i += 4)
+		{
+			float32x4_t v = vmlaq_f32(offset4, vld1q_f32(&spectrum[i]), scale4);
+			v = vminq_f32(vmaxq_f32(v, min4), max4);
+			vst1q_s32(index, vcvtq_s32_f32(v));
+			pix[i]   = m_waterfallPalette[index[0]];
+			pix[i+1] = m_waterfallPalette[index[1]];
+			pix[i+2] = m_waterfallPalette[index[2]];
+			pix[i+3] = m_waterfallPalette[index[3]];
+		}
+#endif
 
-		for(int i = 0; i < m_fftSize; i++) {
-			int v = (int)((spectrum[i] - m_referenceLevel) * 2.4 * 100.0 / m_powerRange + 240.0);
-			if(v > 239)
-				v = 239;
-			else if(v < 0)
-				v = 0;
-
-			*pix++ = m_waterfallPalette[(int)v];
+		for (; i < m_fftSize; i++)
+		{
+			float v = spectrum[i] * scale + offset;
+			pix[i] = m_waterfallPalette[v > 0.0f ? v < 239.0f ? (int) v : 239 : 0];
 		}
 
 		m_waterfallBufferPos++;
 	}
 }
 
-void GLSpectrum::updateHistogram(const std::vector<Real>& spectrum)
+void GLSpectrum::decayHistogram(int nbLines)
 {
-	quint8* b = m_histogram;
-	int fftMulSize = 100 * m_fftSize;
+	if (!(m_displayHistogram || m_displayMaxHold) || (m_decay == 0)) {
+		return;
+	}
+
+	int decay = 0;
 
-	if ((m_displayHistogram || m_displayMaxHold) && (m_decay != 0))
+	for (int i = 0; i < nbLines; i++)
 	{
 		m_decayDivisorCount--;
 
 		if ((m_decay > 1) || (m_decayDivisorCount <= 0))
 		{
-			for (int i = 0; i < fftMulSize; i++)
-			{
-				if (*b > m_decay) {
-					*b = *b - m_decay;
-				} else {
-				    *b = 0;
-				}
-
-				b++;
-			}
-
+			decay += m_decay;
 			m_decayDivisorCount = m_decayDivisor;
 		}
 	}
 
-	m_currentSpectrum = &spectrum; // Store spectrum for current spectrum line display
-
-#if 0 //def USE_SSE2
-    if(m_decay >= 0) { // normal
-        const __m128 refl = {m_referenceLevel, m_referenceLevel, m_referenceLevel, m_referenceLevel};
-        const __m128 power = {m_powerRange, m_powerRange, m_powerRange, m_powerRange};
-        const __m128 mul = {100.0f, 100.0f, 100.0f, 100.0f};
-
-        for(int i = 0; i < m_fftSize; i += 4) {
-            __m128 abc = _mm_loadu_ps (&spectrum[i]);
-            abc = _mm_sub_ps(abc, refl);
-            abc = _mm_mul_ps(abc, mul);
-            abc = _mm_div_ps(abc, power);
-            abc =  _mm_add_ps(abc, mul);
-            __m128i result = _mm_cvtps_epi32(abc);
-
-            for(int j = 0; j < 4; j++) {
-                int v = ((int*)&result)[j];
-                if((v >= 0) && (v <= 99)) {
-                    b = m_histogram + (i + j) * 100 + v;
-                    if(*b < 220)
-                        *b += m_histogramStroke; // was 4
-                    else if(*b < 239)
-                        *b += 1;
-                }
-            }
-        }
-    } else { // draw double pixels
-        int add = -m_decay * 4;
-        const __m128 refl = {m_referenceLevel, m_referenceLevel, m_referenceLevel, m_referenceLevel};
-        const __m128 power = {m_powerRange, m_powerRange, m_powerRange, m_powerRange};
-        const __m128 mul = {100.0f, 100.0f, 100.0f, 100.0f};
-
-        for(int i = 0; i < m_fftSize; i += 4) {
-            __m128 abc = _mm_loadu_ps (&spectrum[i]);
-            abc = _mm_sub_ps(abc, refl);
-            abc = _mm_mul_ps(abc, mul);
-            abc = _mm_div_ps(abc, power);
-            abc =  _mm_add_ps(abc, mul);
-            __m128i result = _mm_cvtps_epi32(abc);
-
-            for(int j = 0; j < 4; j++) {
-                int v = ((int*)&result)[j];
-                if((v >= 1) && (v <= 98)) {
-                    b = m_histogram + (i + j) * 100 + v;
-                    if(b[-1] < 220)
-                        b[-1] += add;
-                    else if(b[-1] < 239)
-                        b[-1] += 1;
-                    if(b[0] < 220)
-                        b[0] += add;
-                    else if(b[0] < 239)
-                        b[0] += 1;
-                    if(b[1] < 220)
-                        b[1] += add;
-                    else if(b[1] < 239)
-                        b[1] += 1;
-                } else if((v >= 0) && (v <= 99)) {
-                    b = m_histogram + (i + j) * 100 + v;
-                    if(*b < 220)
-                        *b += add;
-                    else if(*b < 239)
-                        *b += 1;
-                }
-            }
-        }
-    }
-#else
-    for (int i = 0; i < m_fftSize; i++)
-    {
-        int v = (int)((spectrum[i] - m_referenceLevel) * 100.0 / m_powerRange + 100.0);
+	if (decay == 0) {
+		return;
+	}
 
-        if ((v >= 0) && (v <= 99))
-        {
-            b = m_histogram + i * 100 + v;
+	quint8 d = decay > 255 ? 255 : decay;
+	quint8* b = m_histogram;
+	int fftMulSize = 100 * m_fftSize;
+	int i = 0;
 
-            // capping to 239 as palette values are [0..239]
-            if (*b + m_histogramStroke <= 239) {
-                *b += m_histogramStroke; // was 4
-            } else {
-                *b = 239;
-            }
-        }
-    }
+#if defined(USE_SSE2)
+	const __m128i d16 = _mm_set1_epi8((char) d);
+
+	for (; i + 16 <= fftMulSize; i += 16) {
+		_mm_storeu_si128((__m128i*) &b[i], _mm_subs_epu8(_mm_loadu_si128((__m128i*) &b[i]), d16));
+	}
+#elif defined(USE_NEON)
+	const uint8x16_t d16 = vdupq_n_u8(d);
+
+	for (; i + 16 <= fftMulSize; i += 16) {
+		vst1q_u8(&b[i], vqsubq_u8(vld1q_u8(&b[i]), d16));
+	}
 #endif
+
+	for (; i < fftMulSize; i++) {
+		b[i] = b[i] > d ? b[i] - d : 0;
+	}
+}
+
+void GLSpectrum::updateHistogram(const std::vector<Real>& spectrum)
+{
+	// histogram row is (spectrum - reference level) * 100 / power range + 100 in [0..99]
+	const float scale = 100.0f / m_powerRange;
+	const float offset = 100.0f - m_referenceLevel * scale;
+	int i = 0;
+
+#if defined(USE_SSE2) || defined(USE_NEON)
+	qint32 row[4];
+
+	for (; i + 4 <= m_fftSize; i += 4)
+	{
+#if defined(USE_SSE2)
+		__m128 v = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&spectrum[i]), _mm_set1_ps(scale)), _mm_set1_ps(offset));
+		v = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(-1.0f)), _mm_set1_ps(100.0f)); // out of range and NaN are discarded below
+		_mm_storeu_si128((__m128i*) row, _mm_cvttps_epi32(v));
+#else
+		float32x4_t v = vmlaq_f32(vdupq_n_f32(offset), vld1q_f32(&spectrum[i]), vdupq_n_f32(scale));
+		v = vminq_f32(vmaxq_f32(v, vdupq_n_f32(-1.0f)), vdupq_n_f32(100.0f));
+		vst1q_s32(row, vcvtq_s32_f32(v));
+#endif
+		for (int j = 0; j < 4; j++)
+		{
+			if ((row[j] >= 0) && (row[j] <= 99))
+			{
+				quint8* b = m_histogram + (i + j) * 100 + row[j];
+				*b = *b + m_histogramStroke <= 239 ? *b + m_histogramStroke : 239; // palette values are [0..239]
+			}
+		}
+	}
+#endif
+
+	for (; i < m_fftSize; i++)
+	{
+		float v = spectrum[i] * scale + offset;
+
+		if ((v > -1.0f) && (v < 100.0f)) // truncated to [0..99]
+		{
+			quint8* b = m_histogram + i * 100 + (int) v;
+			// capping to 239 as palette values are [0..239]
+			*b = *b + m_histogramStroke <= 239 ? *b + m_histogramStroke : 239;
+		}
+	}
 }
 
 void GLSpectrum::initializeGL()
@@ -551,6 +612,8 @@ void GLSpectrum::paintGL()
 	if(m_changesPending)
 		applyChanges();
 
+	processMailbox();
+
 	if(m_fftSize <= 0) {
 		m_mutex.unlock();
 		return;
@@ -866,7 +929,7 @@ void GLSpectrum::paintGL()
 	}
 
 	// paint current spectrum line on top of histogram
-	if ((m_displayCurrent) && m_currentSpectrum)
+	if ((m_displayCurrent) && (m_currentSpectrum.size() == (unsigned int) m_fftSize))
 	{
 		{
 			Real bottom = -m_powerRange;
@@ -874,7 +937,7 @@ void GLSpectrum::paintGL()
 
 			for(int i = 0; i < m_fftSize; i++)
 			{
-				Real v = (*m_currentSpectrum)[i] - m_referenceLevel;
+				Real v = m_currentSpectrum[i] - m_referenceLevel;
 
 				if(v > 0) {
 				    v = 0;
@@ -1833,8 +1896,7 @@ void GLSpectrum::leaveEvent(QEvent* event)
 
 void GLSpectrum::tick()
 {
-	if(m_displayChanged) {
-		m_displayChanged = false;
+	if (m_mailboxWrite.loadAcquire() != m_mailboxRead.load()) {
 		update();
 	}
 }
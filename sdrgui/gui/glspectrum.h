@@ -24,6 +24,7 @@
 
 #include <QTimer>
 #include <QMutex>
+#include <QAtomicInteger>
 #include <QOpenGLBuffer>
 #include <QOpenGLVertexArrayObject>
 #include <QMatrix4x4>
@@ -89,7 +90,7 @@ public:
 	void removeChannelMarker(ChannelMarker* channelMarker);
 	void setMessageQueueToGUI(MessageQueue* messageQueue) { m_messageQueueToGUI = messageQueue; }
 
-	void newSpectrum(const std::vector<Real>& spectrum, int fftSize);
+	void newSpectrum(const std::vector<Real>& spectrum, int fftSize); //!< From the DSP thread. Does not block: the line is dropped if the GUI is late.
 	void clearSpectrumHistogram();
 
 	Real getWaterfallShare() const { return m_waterfallShare; }
@@ -152,7 +153,7 @@ private:
 
 	std::vector<Real> m_maxHold;
 	bool m_displayMaxHold;
-	const std::vector<Real> *m_currentSpectrum;
+	std::vector<Real> m_currentSpectrum; //!< last spectrum line taken from the mailbox
 	bool m_displayCurrent;
 
 	Real m_waterfallShare;
@@ -186,7 +187,6 @@ private:
 	QMatrix4x4 m_glHistogramSpectrumMatrix;
 	QMatrix4x4 m_glHistogramBoxMatrix;
 	bool m_displayHistogram;
-	bool m_displayChanged;
     bool m_displaySourceOrSink;
     int m_displayStreamIndex;
 
@@ -204,9 +204,23 @@ private:
 
 	MessageQueue *m_messageQueueToGUI;
 
+	struct SpectrumLine {
+		std::vector<Real> m_spectrum;
+		int m_fftSize;
+
+		SpectrumLine() : m_fftSize(0) {}
+	};
+
 	static const int m_waterfallBufferHeight = 256;
+	static const quint32 m_mailboxSize = 32; //!< spectrum lines in transit from the DSP thread (power of 2)
+
+	SpectrumLine m_mailbox[m_mailboxSize];  //!< single producer (DSP thread) single consumer (GUI thread) ring
+	QAtomicInteger<quint32> m_mailboxWrite; //!< lines written. Only the DSP thread updates it
+	QAtomicInteger<quint32> m_mailboxRead;  //!< lines read. Only the GUI thread updates it
 
+	void processMailbox();
 	void updateWaterfall(const std::vector<Real>& spectrum);
+	void decayHistogram(int nbLines);
 	void updateHistogram(const std::vector<Real>& spectrum);
 
 	void initializeGL();
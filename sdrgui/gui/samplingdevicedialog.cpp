@@ -34,6 +34,7 @@ SamplingDeviceDialog::SamplingDeviceDialog(int deviceType, int deviceTabIndex, Q
     ui->setupUi(this);
 
     QList<QString> deviceDisplayNames;
+    DeviceEnumerator::instance()->rescanDevices(); // pick up devices plugged in or out since the last enumeration
 
     if (m_deviceType == 0) { // Single Rx
         DeviceEnumerator::instance()->listRxDeviceNames(deviceDisplayNames, m_deviceIndexes);
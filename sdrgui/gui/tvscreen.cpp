@@ -244,3 +244,15 @@ bool TVScreen::setDataColor(int intCol, int intRed, int intGreen, int intBlue, i
         return false;
     }
 }
+
+bool TVScreen::setDataLine(int intRow, int intColStart, const unsigned char *grays, int nbPixels)
+{
+    if (m_blnGLContextInitialized)
+    {
+        return m_objGLShaderArray.SetDataLine(intRow, intColStart, grays, nbPixels);
+    }
+    else
+    {
+        return false;
+    }
+}
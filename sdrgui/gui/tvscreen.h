@@ -56,6 +56,7 @@ public:
     bool selectRow(int intLine);
     bool setDataColor(int intCol, int intRed, int intGreen, int intBlue);
     bool setDataColor(int intCol, int intRed, int intGreen, int intBlue, int intAlpha);
+    bool setDataLine(int intRow, int intColStart, const unsigned char *grays, int nbPixels); //!< gray levels of a row segment in one go
     void setAlphaBlend(bool blnAlphaBlend) { m_objGLShaderArray.setAlphaBlend(blnAlphaBlend); }
     void setAlphaReset() { m_objGLShaderArray.setAlphaReset(); }
 
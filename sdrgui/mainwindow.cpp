@@ -29,6 +29,7 @@
 #include <QKeyEvent>
 #include <QResource>
 #include <QFontDatabase>
+#include <QStandardItemModel>
 
 #include <plugin/plugininstancegui.h>
 #include <plugin/plugininstancegui.h>
@@ -62,6 +63,7 @@
 #include "dsp/dspdevicesinkengine.h"
 #include "dsp/dspdevicemimoengine.h"
 #include "plugin/pluginapi.h"
+#include "plugin/pluginproxy.h"
 #include "gui/glspectrum.h"
 #include "gui/glspectrumgui.h"
 #include "loggerwithfile.h"
@@ -190,6 +192,7 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
     qDebug() << "MainWindow::MainWindow: load plugins...";
 
     m_pluginManager = new PluginManager(this);
+    connect(m_pluginManager, SIGNAL(channelRegistrationsChanged()), this, SLOT(channelRegistrationsChanged()));
     m_pluginManager->loadPlugins(QString("plugins"));
 
     splash->showStatusMessage("load file input...", Qt::white);
@@ -233,6 +236,7 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
 	m_apiHost = parser.getServerAddress();
 	m_apiPort = parser.getServerPort();
 	m_apiServer = new WebAPIServer(m_apiHost, m_apiPort, m_requestMapper);
+	m_apiServer->setEvents(parser.getEventsPort(), parser.getEventsPeriod());
 	m_apiServer->start();
 
 	m_commandKeyReceiver = new CommandKeyReceiver();
@@ -289,6 +293,7 @@ void MainWindow::addSourceDevice(int deviceIndex)
     QStringList channelNamesList(channelNames);
     m_deviceUIs.back()->m_samplingDeviceControl->getChannelSelector()->addItems(channelNamesList);
     m_deviceUIs.back()->setNumberOfAvailableRxChannels(channelNamesList.size());
+    disableUnavailableChannels(m_deviceUIs.back());
 
     connect(m_deviceUIs.back()->m_samplingDeviceControl->getAddChannelButton(), SIGNAL(clicked(bool)), this, SLOT(channelAddClicked(bool)));
 
@@ -303,9 +308,8 @@ void MainWindow::addSourceDevice(int deviceIndex)
     ui->tabInputsSelect->setTabToolTip(deviceTabIndex, QString(uidCStr));
 
     // Create a file source instance by default if requested device was not enumerated (index = -1)
-    if (deviceIndex < 0) {
-        deviceIndex = DeviceEnumerator::instance()->getFileInputDeviceIndex();
-    }
+    // or if its plugin cannot be loaded
+    deviceIndex = DeviceEnumerator::instance()->getUsableRxDeviceIndex(deviceIndex);
 
     const PluginInterface::SamplingDevice *samplingDevice = DeviceEnumerator::instance()->getRxSamplingDevice(deviceIndex);
     m_deviceUIs.back()->m_deviceAPI->setSamplingDeviceSequence(samplingDevice->sequence);
@@ -370,6 +374,7 @@ void MainWindow::addSinkDevice()
     QStringList channelNamesList(channelNames);
     m_deviceUIs.back()->m_samplingDeviceControl->getChannelSelector()->addItems(channelNamesList);
     m_deviceUIs.back()->setNumberOfAvailableTxChannels(channelNamesList.size());
+    disableUnavailableChannels(m_deviceUIs.back());
 
     connect(m_deviceUIs.back()->m_samplingDeviceControl->getAddChannelButton(), SIGNAL(clicked(bool)), this, SLOT(channelAddClicked(bool)));
 
@@ -457,6 +462,7 @@ void MainWindow::addMIMODevice()
     QStringList txChannelNamesList(txChannelNames);
     channelSelector->addItems(txChannelNamesList);
     m_deviceUIs.back()->setNumberOfAvailableTxChannels(txChannelNamesList.size());
+    disableUnavailableChannels(m_deviceUIs.back());
     // TODO: add MIMO channels
 
     connect(m_deviceUIs.back()->m_samplingDeviceControl->getAddChannelButton(), SIGNAL(clicked(bool)), this, SLOT(channelAddClicked(bool)));
@@ -1671,6 +1677,10 @@ void MainWindow::sampleSourceChanged()
                 deviceUI->m_deviceAPI->getSampleSource());
         deviceUI->m_deviceAPI->clearBuddiesLists(); // clear old API buddies lists
 
+        // default device if the plugin of the selected device cannot be loaded
+        deviceUI->m_samplingDeviceControl->setSelectedDeviceIndex(
+            DeviceEnumerator::instance()->getUsableRxDeviceIndex(deviceUI->m_samplingDeviceControl->getSelectedDeviceIndex()));
+
         const PluginInterface::SamplingDevice *samplingDevice = DeviceEnumerator::instance()->getRxSamplingDevice(
             deviceUI->m_samplingDeviceControl->getSelectedDeviceIndex());
         deviceUI->m_deviceAPI->setSamplingDeviceSequence(samplingDevice->sequence);
@@ -1767,6 +1777,10 @@ void MainWindow::sampleSinkChanged()
                 deviceUI->m_deviceAPI->getSampleSink());
         deviceUI->m_deviceAPI->clearBuddiesLists(); // clear old API buddies lists
 
+        // default device if the plugin of the selected device cannot be loaded
+        deviceUI->m_samplingDeviceControl->setSelectedDeviceIndex(
+            DeviceEnumerator::instance()->getUsableTxDeviceIndex(deviceUI->m_samplingDeviceControl->getSelectedDeviceIndex()));
+
         const PluginInterface::SamplingDevice *samplingDevice = DeviceEnumerator::instance()->getTxSamplingDevice(deviceUI->m_samplingDeviceControl->getSelectedDeviceIndex());
         deviceUI->m_deviceAPI->setSamplingDeviceSequence(samplingDevice->sequence);
         deviceUI->m_deviceAPI->setDeviceNbItems(samplingDevice->deviceNbItems);
@@ -1855,6 +1869,10 @@ void MainWindow::sampleMIMOChanged()
         deviceUI->m_deviceAPI->getPluginInterface()->deleteSampleMIMOPluginInstanceMIMO(
                 deviceUI->m_deviceAPI->getSampleMIMO());
 
+        // default device if the plugin of the selected device cannot be loaded
+        deviceUI->m_samplingDeviceControl->setSelectedDeviceIndex(
+            DeviceEnumerator::instance()->getUsableMIMODeviceIndex(deviceUI->m_samplingDeviceControl->getSelectedDeviceIndex()));
+
         const PluginInterface::SamplingDevice *samplingDevice = DeviceEnumerator::instance()->getMIMOSamplingDevice(
             deviceUI->m_samplingDeviceControl->getSelectedDeviceIndex());
         deviceUI->m_deviceAPI->setSamplingDeviceSequence(samplingDevice->sequence);
@@ -1930,6 +1948,43 @@ void MainWindow::channelAddClicked(bool checked)
     }
 }
 
+void MainWindow::channelRegistrationsChanged()
+{
+    for (std::vector<DeviceUISet*>::iterator it = m_deviceUIs.begin(); it != m_deviceUIs.end(); ++it) {
+        disableUnavailableChannels(*it);
+    }
+}
+
+void MainWindow::disableUnavailableChannels(DeviceUISet *deviceUISet)
+{
+    // channels of plugins that cannot be loaded stay listed so that selector indexes match the registrations
+    QStandardItemModel *model = qobject_cast<QStandardItemModel*>(deviceUISet->m_samplingDeviceControl->getChannelSelector()->model());
+
+    if (!model) {
+        return;
+    }
+
+    int row = 0;
+
+    if (deviceUISet->m_deviceSourceEngine || deviceUISet->m_deviceMIMOEngine)
+    {
+        PluginAPI::ChannelRegistrations *channelRegistrations = m_pluginManager->getRxChannelRegistrations();
+
+        for (int i = 0; (i < channelRegistrations->size()) && (row < model->rowCount()); i++, row++) {
+            model->item(row)->setEnabled(!PluginProxy::isUnavailable((*channelRegistrations)[i].m_plugin));
+        }
+    }
+
+    if (deviceUISet->m_deviceSinkEngine || deviceUISet->m_deviceMIMOEngine)
+    {
+        PluginAPI::ChannelRegistrations *channelRegistrations = m_pluginManager->getTxChannelRegistrations();
+
+        for (int i = 0; (i < channelRegistrations->size()) && (row < model->rowCount()); i++, row++) {
+            model->item(row)->setEnabled(!PluginProxy::isUnavailable((*channelRegistrations)[i].m_plugin));
+        }
+    }
+}
+
 void MainWindow::on_action_About_triggered()
 {
 	AboutDialog dlg(m_apiHost, m_apiPort, m_settings, this);
@@ -352,6 +352,7 @@ private:
     void addMIMODevice();
     void removeLastDevice();
     void deleteChannel(int deviceSetIndex, int channelIndex);
+    void disableUnavailableChannels(DeviceUISet *deviceUISet);
 
     void setLoggingOptions();
 
@@ -388,6 +389,7 @@ private slots:
 	void sampleSinkChanged();
 	void sampleMIMOChanged();
     void channelAddClicked(bool checked);
+    void channelRegistrationsChanged();
 	void on_action_Loaded_Plugins_triggered();
 	void on_action_About_triggered();
 	void on_action_addSourceDevice_triggered();
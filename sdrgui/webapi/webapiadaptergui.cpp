@@ -132,18 +132,17 @@ int WebAPIAdapterGUI::instanceDevices(
         nbSamplingDevices = 0;
     }
 
-    response.setDevicecount(nbSamplingDevices);
     QList<SWGSDRangel::SWGDeviceListItem*> *devices = response.getDevices();
 
     for (int i = 0; i < nbSamplingDevices; i++)
     {
         const PluginInterface::SamplingDevice *samplingDevice = nullptr;
 
-        if (direction == 0) {
+        if ((direction == 0) && DeviceEnumerator::instance()->isRxSamplingDevicePresent(i)) {
             samplingDevice = DeviceEnumerator::instance()->getRxSamplingDevice(i);
-        } else if (direction == 1) {
+        } else if ((direction == 1) && DeviceEnumerator::instance()->isTxSamplingDevicePresent(i)) {
             samplingDevice = DeviceEnumerator::instance()->getTxSamplingDevice(i);
-        } else {
+        } else { // not supported or gone
             continue;
         }
 
@@ -159,6 +158,8 @@ int WebAPIAdapterGUI::instanceDevices(
         devices->back()->setIndex(i);
     }
 
+    response.setDevicecount(devices->size());
+
     return 200;
 }
 
@@ -188,14 +189,18 @@ int WebAPIAdapterGUI::instanceChannels(
         nbChannelDevices = 0;
     }
 
-    response.setChannelcount(nbChannelDevices);
     QList<SWGSDRangel::SWGChannelListItem*> *channels = response.getChannels();
 
     for (int i = 0; i < nbChannelDevices; i++)
     {
+        PluginInterface *channelInterface = channelRegistrations->at(i).m_plugin;
+
+        if (PluginProxy::isUnavailable(channelInterface)) { // plugin cannot be loaded: index is kept for the others
+            continue;
+        }
+
         channels->append(new SWGSDRangel::SWGChannelListItem);
         channels->back()->init();
-        PluginInterface *channelInterface = channelRegistrations->at(i).m_plugin;
         const PluginDescriptor& pluginDescriptor = channelInterface->getPluginDescriptor();
         *channels->back()->getVersion() = pluginDescriptor.version;
         *channels->back()->getName() = pluginDescriptor.displayedName;
@@ -205,6 +210,8 @@ int WebAPIAdapterGUI::instanceChannels(
         channels->back()->setIndex(i);
     }
 
+    response.setChannelcount(channels->size());
+
     return 200;
 }
 
@@ -325,6 +332,10 @@ int WebAPIAdapterGUI::instanceAudioGet(
     outputDevices->back()->setUdpDecimationFactor((int) outputDeviceInfo.udpDecimationFactor);
     *outputDevices->back()->getUdpAddress() = outputDeviceInfo.udpAddress;
     outputDevices->back()->setUdpPort(outputDeviceInfo.udpPort);
+    outputDevices->back()->setLowLatency(outputDeviceInfo.lowLatency ? 1 : 0);
+    outputDevices->back()->setUdpBlockSize(outputDeviceInfo.udpBlockSize);
+    outputDevices->back()->setUdpOpusFrameDuration(outputDeviceInfo.udpOpusFrameDuration);
+    outputDevices->back()->setUdpDroppedSamples(m_mainWindow.m_dspEngine->getAudioDeviceManager()->getOutputUdpNbDroppedSamples(-1));
 
     // real output devices
     for (int i = 0; i < nbOutputDevices; i++)
@@ -345,6 +356,10 @@ int WebAPIAdapterGUI::instanceAudioGet(
         outputDevices->back()->setUdpDecimationFactor((int) outputDeviceInfo.udpDecimationFactor);
         *outputDevices->back()->getUdpAddress() = outputDeviceInfo.udpAddress;
         outputDevices->back()->setUdpPort(outputDeviceInfo.udpPort);
+        outputDevices->back()->setLowLatency(outputDeviceInfo.lowLatency ? 1 : 0);
+        outputDevices->back()->setUdpBlockSize(outputDeviceInfo.udpBlockSize);
+        outputDevices->back()->setUdpOpusFrameDuration(outputDeviceInfo.udpOpusFrameDuration);
+        outputDevices->back()->setUdpDroppedSamples(m_mainWindow.m_dspEngine->getAudioDeviceManager()->getOutputUdpNbDroppedSamples(i));
     }
 
     return 200;
@@ -427,6 +442,15 @@ int WebAPIAdapterGUI::instanceAudioOutputPatch(
     if (audioOutputKeys.contains("udpPort")) {
         outputDeviceInfo.udpPort = response.getUdpPort() % (1<<16);
     }
+    if (audioOutputKeys.contains("lowLatency")) {
+        outputDeviceInfo.lowLatency = response.getLowLatency() != 0;
+    }
+    if (audioOutputKeys.contains("udpBlockSize")) {
+        outputDeviceInfo.udpBlockSize = response.getUdpBlockSize();
+    }
+    if (audioOutputKeys.contains("udpOpusFrameDuration")) {
+        outputDeviceInfo.udpOpusFrameDuration = response.getUdpOpusFrameDuration();
+    }
 
     m_mainWindow.m_dspEngine->getAudioDeviceManager()->setOutputDeviceInfo(deviceIndex, outputDeviceInfo);
     m_mainWindow.m_dspEngine->getAudioDeviceManager()->getOutputDeviceInfo(deviceName, outputDeviceInfo);
@@ -445,6 +469,9 @@ int WebAPIAdapterGUI::instanceAudioOutputPatch(
     }
 
     response.setUdpPort(outputDeviceInfo.udpPort % (1<<16));
+    response.setLowLatency(outputDeviceInfo.lowLatency ? 1 : 0);
+    response.setUdpBlockSize(outputDeviceInfo.udpBlockSize);
+    response.setUdpOpusFrameDuration(outputDeviceInfo.udpOpusFrameDuration);
 
     return 200;
 }
@@ -505,6 +532,9 @@ int WebAPIAdapterGUI::instanceAudioOutputDelete(
     }
 
     response.setUdpPort(outputDeviceInfo.udpPort % (1<<16));
+    response.setLowLatency(outputDeviceInfo.lowLatency ? 1 : 0);
+    response.setUdpBlockSize(outputDeviceInfo.udpBlockSize);
+    response.setUdpOpusFrameDuration(outputDeviceInfo.udpOpusFrameDuration);
 
     return 200;
 }
@@ -1140,6 +1170,11 @@ int WebAPIAdapterGUI::devicesetDevicePut(
                 continue; // TODO: any device (2) not supported yet
             }
 
+            if ((query.getDirection() == 0) ? !DeviceEnumerator::instance()->isRxSamplingDevicePresent(i)
+                : !DeviceEnumerator::instance()->isTxSamplingDevicePresent(i)) {
+                continue; // gone since its enumeration
+            }
+
             if (query.getDisplayedName() && (*query.getDisplayedName() != samplingDevice->displayedName)) {
                 continue;
             }
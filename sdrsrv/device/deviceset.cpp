@@ -143,6 +143,13 @@ void DeviceSet::addRxChannel(int selectedChannelIndex, PluginAPI *pluginAPI)
 {
     PluginAPI::ChannelRegistrations *channelRegistrations = pluginAPI->getRxChannelRegistrations(); // Available channel plugins
     ChannelAPI *rxChannel =(*channelRegistrations)[selectedChannelIndex].m_plugin->createRxChannelCS(m_deviceAPI);
+
+    if (!rxChannel) // plugin library cannot be loaded
+    {
+        qWarning("DeviceSet::addRxChannel: cannot create channel %d", selectedChannelIndex);
+        return;
+    }
+
     ChannelInstanceRegistration reg = ChannelInstanceRegistration(rxChannel->getName(), rxChannel);
     m_rxChannelInstanceRegistrations.append(reg);
     qDebug("DeviceSet::addRxChannel: %s", qPrintable(rxChannel->getName()));
@@ -152,6 +159,13 @@ void DeviceSet::addTxChannel(int selectedChannelIndex, PluginAPI *pluginAPI)
 {
     PluginAPI::ChannelRegistrations *channelRegistrations = pluginAPI->getTxChannelRegistrations(); // Available channel plugins
     ChannelAPI *txChannel = (*channelRegistrations)[selectedChannelIndex].m_plugin->createTxChannelCS(m_deviceAPI);
+
+    if (!txChannel) // plugin library cannot be loaded
+    {
+        qWarning("DeviceSet::addTxChannel: cannot create channel %d", selectedChannelIndex);
+        return;
+    }
+
     ChannelInstanceRegistration reg = ChannelInstanceRegistration(txChannel->getName(), txChannel);
     m_txChannelInstanceRegistrations.append(reg);
     qDebug("DeviceSet::addTxChannel: %s", qPrintable(txChannel->getName()));
@@ -206,8 +220,13 @@ void DeviceSet::loadRxChannelSettings(const Preset *preset, PluginAPI *pluginAPI
                                 qPrintable((*channelRegistrations)[i].m_channelIdURI),
                                 qPrintable(channelConfig.m_channelIdURI));
                         ChannelAPI *rxChannel = (*channelRegistrations)[i].m_plugin->createRxChannelCS(m_deviceAPI);
-                        reg = ChannelInstanceRegistration(channelConfig.m_channelIdURI, rxChannel);
-                        m_rxChannelInstanceRegistrations.append(reg);
+
+                        if (rxChannel) // null if the plugin library cannot be loaded
+                        {
+                            reg = ChannelInstanceRegistration(channelConfig.m_channelIdURI, rxChannel);
+                            m_rxChannelInstanceRegistrations.append(reg);
+                        }
+
                         break;
                     }
                 }
@@ -302,8 +321,13 @@ void DeviceSet::loadTxChannelSettings(const Preset *preset, PluginAPI *pluginAPI
                     {
                         qDebug("DeviceSet::loadChannelSettings: creating new channel [%s]", qPrintable(channelConfig.m_channelIdURI));
                         ChannelAPI *txChannel = (*channelRegistrations)[i].m_plugin->createTxChannelCS(m_deviceAPI);
-                        reg = ChannelInstanceRegistration(channelConfig.m_channelIdURI, txChannel);
-                        m_txChannelInstanceRegistrations.append(reg);
+
+                        if (txChannel) // null if the plugin library cannot be loaded
+                        {
+                            reg = ChannelInstanceRegistration(channelConfig.m_channelIdURI, txChannel);
+                            m_txChannelInstanceRegistrations.append(reg);
+                        }
+
                         break;
                     }
                 }
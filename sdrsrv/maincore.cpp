@@ -20,6 +20,9 @@
 #include <QDebug>
 #include <QSysInfo>
 #include <QResource>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QMap>
 
 #include "dsp/dspengine.h"
 #include "dsp/dspdevicesourceengine.h"
@@ -47,6 +50,45 @@ MESSAGE_CLASS_DEFINITION(MainCore::MsgDeleteChannel, Message)
 
 MainCore *MainCore::m_instance = 0;
 
+/**
+ * Starts the streaming of device sets one after the other in its own thread.
+ * Device sets sharing the same hardware are started by the same starter.
+ */
+class DeviceSetsStarter : public QThread
+{
+public:
+    void addDeviceSet(int deviceSetIndex, DeviceAPI *deviceAPI)
+    {
+        m_deviceSetIndexes.push_back(deviceSetIndex);
+        m_deviceAPIs.push_back(deviceAPI);
+    }
+
+    const std::vector<int>& getDeviceSetIndexes() const { return m_deviceSetIndexes; }
+    const std::vector<qint64>& getStartTimes() const { return m_startTimes; }
+
+protected:
+    virtual void run()
+    {
+        QElapsedTimer timer;
+
+        for (unsigned int i = 0; i < m_deviceAPIs.size(); i++)
+        {
+            timer.start();
+
+            if (!m_deviceAPIs[i]->startDeviceEngine()) {
+                qWarning("DeviceSetsStarter::run: cannot start device set %d", m_deviceSetIndexes[i]);
+            }
+
+            m_startTimes.push_back(timer.elapsed());
+        }
+    }
+
+private:
+    std::vector<int> m_deviceSetIndexes;
+    std::vector<DeviceAPI*> m_deviceAPIs;
+    std::vector<qint64> m_startTimes;
+};
+
 MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, QObject *parent) :
     QObject(parent),
     m_settings(),
@@ -56,6 +98,9 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
     m_logger(logger)
 {
     qDebug() << "MainCore::MainCore: start";
+    QElapsedTimer startupTimer, stepTimer;
+    startupTimer.start();
+    stepTimer.start();
 
     m_instance = this;
     m_settings.setAudioDeviceManager(m_dspEngine->getAudioDeviceManager());
@@ -63,11 +108,17 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
 
     m_pluginManager = new PluginManager(this);
     m_pluginManager->loadPlugins(QString("pluginssrv"));
+    m_startupTimings.m_plugins = stepTimer.restart();
 
     connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleMessages()), Qt::QueuedConnection);
     m_masterTimer.start(50);
 
 	loadSettings();
+    m_startupTimings.m_settings = stepTimer.restart();
+
+    m_dspEngine->setMIMOSupport(parser.getMIMOSupport());
+    addStartupDeviceSets(parser.getDeviceSets(), parser.getDeviceSetsStart());
+    stepTimer.restart();
 
     QString applicationDirPath = QCoreApplication::instance()->applicationDirPath();
 
@@ -75,9 +126,20 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
     m_requestMapper = new WebAPIRequestMapper(this);
     m_requestMapper->setAdapter(m_apiAdapter);
     m_apiServer = new WebAPIServer(parser.getServerAddress(), parser.getServerPort(), m_requestMapper);
+    m_apiServer->setEvents(parser.getEventsPort(), parser.getEventsPeriod());
     m_apiServer->start();
-
-    m_dspEngine->setMIMOSupport(parser.getMIMOSupport());
+    m_startupTimings.m_webAPI = stepTimer.elapsed();
+    m_startupTimings.m_total = startupTimer.elapsed();
+
+    qInfo("MainCore::MainCore: started in %lld ms: plugins: %lld ms settings: %lld ms device sets (%u): %lld ms start (%d groups): %lld ms web API: %lld ms",
+        m_startupTimings.m_total,
+        m_startupTimings.m_plugins,
+        m_startupTimings.m_settings,
+        (unsigned int) m_startupTimings.m_deviceSetSetup.size(),
+        m_startupTimings.m_deviceSets,
+        m_startupTimings.m_nbStartGroups,
+        m_startupTimings.m_engines,
+        m_startupTimings.m_webAPI);
 
     qDebug() << "MainCore::MainCore: end";
 }
@@ -206,6 +268,132 @@ void MainCore::loadSettings()
     setLoggingOptions();
 }
 
+void MainCore::addStartupDeviceSets(const QList<MainParser::DeviceSetSpec>& deviceSets, bool start)
+{
+    int firstDeviceSetIndex = m_deviceSets.size();
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < deviceSets.size(); i++)
+    {
+        const MainParser::DeviceSetSpec& deviceSetSpec = deviceSets[i];
+        DeviceEnumerator *deviceEnumerator = DeviceEnumerator::instance();
+        int nbSamplingDevices = deviceSetSpec.m_tx ? deviceEnumerator->getNbTxSamplingDevices() : deviceEnumerator->getNbRxSamplingDevices();
+        int deviceIndex = -1;
+
+        for (int di = 0; di < nbSamplingDevices; di++)
+        {
+            const PluginInterface::SamplingDevice *samplingDevice = deviceSetSpec.m_tx ?
+                deviceEnumerator->getTxSamplingDevice(di) : deviceEnumerator->getRxSamplingDevice(di);
+
+            bool present = deviceSetSpec.m_tx ? deviceEnumerator->isTxSamplingDevicePresent(di) : deviceEnumerator->isRxSamplingDevicePresent(di);
+
+            if (present && (samplingDevice->hardwareId == deviceSetSpec.m_hwType) && (samplingDevice->sequence == deviceSetSpec.m_sequence))
+            {
+                deviceIndex = di;
+                break;
+            }
+        }
+
+        if (deviceIndex < 0)
+        {
+            qWarning("MainCore::addStartupDeviceSets: %s device %s sequence %d not found",
+                deviceSetSpec.m_tx ? "Tx" : "Rx", qPrintable(deviceSetSpec.m_hwType), deviceSetSpec.m_sequence);
+            timer.restart();
+            continue;
+        }
+
+        const Preset *preset = 0;
+
+        if (!deviceSetSpec.m_presetGroup.isEmpty())
+        {
+            for (int pi = 0; pi < m_settings.getPresetCount(); pi++)
+            {
+                const Preset *candidate = m_settings.getPreset(pi);
+
+                if ((candidate->getGroup() == deviceSetSpec.m_presetGroup)
+                    && (candidate->getDescription() == deviceSetSpec.m_presetDescription)
+                    && (candidate->isSourcePreset() != deviceSetSpec.m_tx))
+                {
+                    preset = candidate;
+                    break;
+                }
+            }
+
+            if (!preset)
+            {
+                qWarning("MainCore::addStartupDeviceSets: preset [%s | %s] not found",
+                    qPrintable(deviceSetSpec.m_presetGroup), qPrintable(deviceSetSpec.m_presetDescription));
+            }
+        }
+
+        if (deviceSetSpec.m_tx)
+        {
+            addSinkDevice();
+            changeSampleSink(m_deviceSets.size() - 1, deviceIndex);
+        }
+        else
+        {
+            addSourceDevice();
+            changeSampleSource(m_deviceSets.size() - 1, deviceIndex);
+        }
+
+        if (preset) {
+            loadPresetSettings(preset, m_deviceSets.size() - 1);
+        }
+
+        m_startupTimings.m_deviceSetSetup.push_back(timer.restart());
+        m_startupTimings.m_deviceSets += m_startupTimings.m_deviceSetSetup.back();
+    }
+
+    m_startupTimings.m_deviceSetStart.assign(m_deviceSets.size() - firstDeviceSetIndex, -1);
+
+    if (start && ((int) m_deviceSets.size() > firstDeviceSetIndex))
+    {
+        timer.restart();
+        startDeviceSets(firstDeviceSetIndex);
+        m_startupTimings.m_engines = timer.elapsed();
+    }
+}
+
+void MainCore::startDeviceSets(int firstDeviceSetIndex)
+{
+    // device sets of different hardware are started in parallel. Buddies share the same
+    // hardware (same hardware id and serial) and are started sequentially in creation order.
+    QMap<QString, DeviceSetsStarter*> starters;
+
+    for (unsigned int i = firstDeviceSetIndex; i < m_deviceSets.size(); i++)
+    {
+        DeviceAPI *deviceAPI = m_deviceSets[i]->m_deviceAPI;
+        QString hardwareKey = deviceAPI->getHardwareId() + ":" + deviceAPI->getSamplingDeviceSerial();
+
+        if (!starters.contains(hardwareKey)) {
+            starters.insert(hardwareKey, new DeviceSetsStarter());
+        }
+
+        starters[hardwareKey]->addDeviceSet(i, deviceAPI);
+    }
+
+    foreach (DeviceSetsStarter *starter, starters) {
+        starter->start();
+    }
+
+    foreach (DeviceSetsStarter *starter, starters)
+    {
+        while (!starter->wait(10)) { // the devices may post messages to the main thread while starting
+            QCoreApplication::processEvents();
+        }
+
+        for (unsigned int i = 0; i < starter->getDeviceSetIndexes().size(); i++) {
+            m_startupTimings.m_deviceSetStart[starter->getDeviceSetIndexes()[i] - firstDeviceSetIndex] = starter->getStartTimes()[i];
+        }
+
+        delete starter;
+    }
+
+    m_startupTimings.m_nbStartGroups = starters.size();
+}
+
 void MainCore::setLoggingOptions()
 {
     m_logger->setConsoleMinMessageLevel(m_settings.getConsoleMinLogLevel());
@@ -396,6 +584,7 @@ void MainCore::changeSampleSource(int deviceSetIndex, int selectedDeviceIndex)
     if (deviceSetIndex >= 0)
     {
         qDebug("MainCore::changeSampleSource: deviceSet at %d", deviceSetIndex);
+        selectedDeviceIndex = DeviceEnumerator::instance()->getUsableRxDeviceIndex(selectedDeviceIndex); // default device if its plugin cannot be loaded
         DeviceSet *deviceSet = m_deviceSets[deviceSetIndex];
         deviceSet->m_deviceAPI->saveSamplingDeviceSettings(m_settings.getWorkingPreset()); // save old API settings
         deviceSet->m_deviceAPI->stopDeviceEngine();
@@ -464,6 +653,7 @@ void MainCore::changeSampleSink(int deviceSetIndex, int selectedDeviceIndex)
     if (deviceSetIndex >= 0)
     {
         qDebug("MainCore::changeSampleSink: device set at %d", deviceSetIndex);
+        selectedDeviceIndex = DeviceEnumerator::instance()->getUsableTxDeviceIndex(selectedDeviceIndex); // default device if its plugin cannot be loaded
         DeviceSet *deviceSet = m_deviceSets[deviceSetIndex];
         deviceSet->m_deviceAPI->saveSamplingDeviceSettings(m_settings.getWorkingPreset()); // save old API settings
         deviceSet->m_deviceAPI->stopDeviceEngine();
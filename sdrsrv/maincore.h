@@ -23,6 +23,8 @@
 #include <QObject>
 #include <QTimer>
 
+#include <vector>
+
 #include "settings/mainsettings.h"
 #include "util/message.h"
 #include "util/messagequeue.h"
@@ -49,6 +51,29 @@ class SDRSRV_API MainCore : public QObject {
     Q_OBJECT
 
 public:
+    struct StartupTimings //!< durations of the startup steps in ms
+    {
+        qint64 m_plugins;    //!< plugins load and devices enumeration
+        qint64 m_settings;   //!< settings and presets index load
+        qint64 m_deviceSets; //!< startup device sets creation and presets load
+        qint64 m_engines;    //!< startup device sets streaming start
+        qint64 m_webAPI;     //!< web API server start
+        qint64 m_total;
+        std::vector<qint64> m_deviceSetSetup; //!< creation and preset load of each startup device set
+        std::vector<qint64> m_deviceSetStart; //!< streaming start of each startup device set (-1: not started)
+        int m_nbStartGroups;                  //!< groups of device sets started in parallel
+
+        StartupTimings() :
+            m_plugins(0),
+            m_settings(0),
+            m_deviceSets(0),
+            m_engines(0),
+            m_webAPI(0),
+            m_total(0),
+            m_nbStartGroups(0)
+        {}
+    };
+
     explicit MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, QObject *parent = 0);
     ~MainCore();
     static MainCore *getInstance() { return m_instance; } // Main Core is de facto a singleton so this just returns its reference
@@ -57,6 +82,7 @@ public:
 
     const QTimer& getMasterTimer() const { return m_masterTimer; }
     const MainSettings& getMainSettings() const { return m_settings; }
+    const StartupTimings& getStartupTimings() const { return m_startupTimings; }
 
     void addSourceDevice();
     void addSinkDevice();
@@ -284,8 +310,11 @@ private:
     WebAPIRequestMapper *m_requestMapper;
     WebAPIServer *m_apiServer;
     WebAPIAdapterSrv *m_apiAdapter;
+    StartupTimings m_startupTimings;
 
 	void loadSettings();
+    void addStartupDeviceSets(const QList<MainParser::DeviceSetSpec>& deviceSets, bool start);
+    void startDeviceSets(int firstDeviceSetIndex);
 	void loadPresetSettings(const Preset* preset, int tabIndex);
 	void savePresetSettings(Preset* preset, int tabIndex);
     void setLoggingOptions();
@@ -26,6 +26,7 @@
 #include "SWGInstanceDevicesResponse.h"
 #include "SWGInstanceChannelsResponse.h"
 #include "SWGLoggingInfo.h"
+#include "SWGStartupTimings.h"
 #include "SWGAudioDevices.h"
 #include "SWGLocationInformation.h"
 #include "SWGDVSerialDevices.h"
@@ -131,18 +132,17 @@ int WebAPIAdapterSrv::instanceDevices(
     }
 
 
-    response.setDevicecount(nbSamplingDevices);
     QList<SWGSDRangel::SWGDeviceListItem*> *devices = response.getDevices();
 
     for (int i = 0; i < nbSamplingDevices; i++)
     {
         const PluginInterface::SamplingDevice *samplingDevice = nullptr;
 
-        if (direction == 0) {
+        if ((direction == 0) && DeviceEnumerator::instance()->isRxSamplingDevicePresent(i)) {
             samplingDevice = DeviceEnumerator::instance()->getRxSamplingDevice(i);
-        } else if (direction == 1) {
+        } else if ((direction == 1) && DeviceEnumerator::instance()->isTxSamplingDevicePresent(i)) {
             samplingDevice = DeviceEnumerator::instance()->getTxSamplingDevice(i);
-        } else {
+        } else { // not supported or gone
             continue;
         }
 
@@ -158,6 +158,8 @@ int WebAPIAdapterSrv::instanceDevices(
         devices->back()->setIndex(i);
     }
 
+    response.setDevicecount(devices->size());
+
     return 200;
 }
 
@@ -186,14 +188,18 @@ int WebAPIAdapterSrv::instanceChannels(
         nbChannelDevices = 0;
     }
 
-    response.setChannelcount(nbChannelDevices);
     QList<SWGSDRangel::SWGChannelListItem*> *channels = response.getChannels();
 
     for (int i = 0; i < nbChannelDevices; i++)
     {
+        PluginInterface *channelInterface = channelRegistrations->at(i).m_plugin;
+
+        if (PluginProxy::isUnavailable(channelInterface)) { // plugin cannot be loaded: index is kept for the others
+            continue;
+        }
+
         channels->append(new SWGSDRangel::SWGChannelListItem);
         channels->back()->init();
-        PluginInterface *channelInterface = channelRegistrations->at(i).m_plugin;
         const PluginDescriptor& pluginDescriptor = channelInterface->getPluginDescriptor();
         *channels->back()->getVersion() = pluginDescriptor.version;
         *channels->back()->getName() = pluginDescriptor.displayedName;
@@ -203,6 +209,8 @@ int WebAPIAdapterSrv::instanceChannels(
         channels->back()->setIndex(i);
     }
 
+    response.setChannelcount(channels->size());
+
     return 200;
 }
 
@@ -223,6 +231,33 @@ int WebAPIAdapterSrv::instanceLoggingGet(
     return 200;
 }
 
+int WebAPIAdapterSrv::instanceStartupGet(
+        SWGSDRangel::SWGStartupTimings& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    (void) error;
+    const MainCore::StartupTimings& startupTimings = m_mainCore.getStartupTimings();
+    response.init();
+    response.setTotalMs(startupTimings.m_total);
+    response.setPluginsMs(startupTimings.m_plugins);
+    response.setSettingsMs(startupTimings.m_settings);
+    response.setDeviceSetsMs(startupTimings.m_deviceSets);
+    response.setStartMs(startupTimings.m_engines);
+    response.setStartGroups(startupTimings.m_nbStartGroups);
+    response.setWebApiMs(startupTimings.m_webAPI);
+    QList<SWGSDRangel::SWGDeviceSetStartupTimings*> *deviceSets = response.getDeviceSets();
+
+    for (unsigned int i = 0; i < startupTimings.m_deviceSetSetup.size(); i++)
+    {
+        deviceSets->append(new SWGSDRangel::SWGDeviceSetStartupTimings);
+        deviceSets->back()->init();
+        deviceSets->back()->setSetupMs(startupTimings.m_deviceSetSetup[i]);
+        deviceSets->back()->setStartMs(startupTimings.m_deviceSetStart[i]);
+    }
+
+    return 200;
+}
+
 int WebAPIAdapterSrv::instanceLoggingPut(
         SWGSDRangel::SWGLoggingInfo& query,
         SWGSDRangel::SWGLoggingInfo& response,
@@ -320,6 +355,10 @@ int WebAPIAdapterSrv::instanceAudioGet(
     outputDevices->back()->setUdpDecimationFactor(outputDeviceInfo.udpDecimationFactor);
     *outputDevices->back()->getUdpAddress() = outputDeviceInfo.udpAddress;
     outputDevices->back()->setUdpPort(outputDeviceInfo.udpPort);
+    outputDevices->back()->setLowLatency(outputDeviceInfo.lowLatency ? 1 : 0);
+    outputDevices->back()->setUdpBlockSize(outputDeviceInfo.udpBlockSize);
+    outputDevices->back()->setUdpOpusFrameDuration(outputDeviceInfo.udpOpusFrameDuration);
+    outputDevices->back()->setUdpDroppedSamples(m_mainCore.m_dspEngine->getAudioDeviceManager()->getOutputUdpNbDroppedSamples(-1));
 
     // real output devices
     for (int i = 0; i < nbOutputDevices; i++)
@@ -340,6 +379,10 @@ int WebAPIAdapterSrv::instanceAudioGet(
         outputDevices->back()->setUdpDecimationFactor(outputDeviceInfo.udpDecimationFactor);
         *outputDevices->back()->getUdpAddress() = outputDeviceInfo.udpAddress;
         outputDevices->back()->setUdpPort(outputDeviceInfo.udpPort);
+        outputDevices->back()->setLowLatency(outputDeviceInfo.lowLatency ? 1 : 0);
+        outputDevices->back()->setUdpBlockSize(outputDeviceInfo.udpBlockSize);
+        outputDevices->back()->setUdpOpusFrameDuration(outputDeviceInfo.udpOpusFrameDuration);
+        outputDevices->back()->setUdpDroppedSamples(m_mainCore.m_dspEngine->getAudioDeviceManager()->getOutputUdpNbDroppedSamples(i));
     }
 
     return 200;
@@ -416,6 +459,15 @@ int WebAPIAdapterSrv::instanceAudioOutputPatch(
     if (audioOutputKeys.contains("udpPort")) {
         outputDeviceInfo.udpPort = response.getUdpPort() % (1<<16);
     }
+    if (audioOutputKeys.contains("lowLatency")) {
+        outputDeviceInfo.lowLatency = response.getLowLatency() != 0;
+    }
+    if (audioOutputKeys.contains("udpBlockSize")) {
+        outputDeviceInfo.udpBlockSize = response.getUdpBlockSize();
+    }
+    if (audioOutputKeys.contains("udpOpusFrameDuration")) {
+        outputDeviceInfo.udpOpusFrameDuration = response.getUdpOpusFrameDuration();
+    }
 
     m_mainCore.m_dspEngine->getAudioDeviceManager()->setOutputDeviceInfo(deviceIndex, outputDeviceInfo);
     m_mainCore.m_dspEngine->getAudioDeviceManager()->getOutputDeviceInfo(deviceName, outputDeviceInfo);
@@ -434,6 +486,9 @@ int WebAPIAdapterSrv::instanceAudioOutputPatch(
     }
 
     response.setUdpPort(outputDeviceInfo.udpPort % (1<<16));
+    response.setLowLatency(outputDeviceInfo.lowLatency ? 1 : 0);
+    response.setUdpBlockSize(outputDeviceInfo.udpBlockSize);
+    response.setUdpOpusFrameDuration(outputDeviceInfo.udpOpusFrameDuration);
 
     return 200;
 }
@@ -494,6 +549,9 @@ int WebAPIAdapterSrv::instanceAudioOutputDelete(
     }
 
     response.setUdpPort(outputDeviceInfo.udpPort % (1<<16));
+    response.setLowLatency(outputDeviceInfo.lowLatency ? 1 : 0);
+    response.setUdpBlockSize(outputDeviceInfo.udpBlockSize);
+    response.setUdpOpusFrameDuration(outputDeviceInfo.udpOpusFrameDuration);
 
     return 200;
 }
@@ -1225,6 +1283,11 @@ int WebAPIAdapterSrv::devicesetDevicePut(
                 continue; // TODO: any device (2) not supported yet
             }
 
+            if ((query.getDirection() == 0) ? !DeviceEnumerator::instance()->isRxSamplingDevicePresent(i)
+                : !DeviceEnumerator::instance()->isTxSamplingDevicePresent(i)) {
+                continue; // gone since its enumeration
+            }
+
             if (query.getDisplayedName() && (*query.getDisplayedName() != samplingDevice->displayedName)) {
                 continue;
             }
@@ -55,6 +55,10 @@ public:
             SWGSDRangel::SWGLoggingInfo& response,
             SWGSDRangel::SWGErrorResponse& error);
 
+    virtual int instanceStartupGet(
+            SWGSDRangel::SWGStartupTimings& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
     virtual int instanceLoggingPut(
             SWGSDRangel::SWGLoggingInfo& query,
             SWGSDRangel::SWGLoggingInfo& response,
@@ -52,6 +52,14 @@ SWGAudioOutputDevice::SWGAudioOutputDevice() {
     m_udp_address_isSet = false;
     udp_port = 0;
     m_udp_port_isSet = false;
+    low_latency = 0;
+    m_low_latency_isSet = false;
+    udp_block_size = 0;
+    m_udp_block_size_isSet = false;
+    udp_opus_frame_duration = 0;
+    m_udp_opus_frame_duration_isSet = false;
+    udp_dropped_samples = 0;
+    m_udp_dropped_samples_isSet = false;
 }
 
 SWGAudioOutputDevice::~SWGAudioOutputDevice() {
@@ -84,6 +92,14 @@ SWGAudioOutputDevice::init() {
     m_udp_address_isSet = false;
     udp_port = 0;
     m_udp_port_isSet = false;
+    low_latency = 0;
+    m_low_latency_isSet = false;
+    udp_block_size = 0;
+    m_udp_block_size_isSet = false;
+    udp_opus_frame_duration = 0;
+    m_udp_opus_frame_duration_isSet = false;
+    udp_dropped_samples = 0;
+    m_udp_dropped_samples_isSet = false;
 }
 
 void
@@ -141,6 +157,14 @@ SWGAudioOutputDevice::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&udp_port, pJson["udpPort"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&low_latency, pJson["lowLatency"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&udp_block_size, pJson["udpBlockSize"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&udp_opus_frame_duration, pJson["udpOpusFrameDuration"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&udp_dropped_samples, pJson["udpDroppedSamples"], "qint32", "");
+    
 }
 
 QString
@@ -193,6 +217,18 @@ SWGAudioOutputDevice::asJsonObject() {
     if(m_udp_port_isSet){
         obj->insert("udpPort", QJsonValue(udp_port));
     }
+    if(m_low_latency_isSet){
+        obj->insert("lowLatency", QJsonValue(low_latency));
+    }
+    if(m_udp_block_size_isSet){
+        obj->insert("udpBlockSize", QJsonValue(udp_block_size));
+    }
+    if(m_udp_opus_frame_duration_isSet){
+        obj->insert("udpOpusFrameDuration", QJsonValue(udp_opus_frame_duration));
+    }
+    if(m_udp_dropped_samples_isSet){
+        obj->insert("udpDroppedSamples", QJsonValue(udp_dropped_samples));
+    }
 
     return obj;
 }
@@ -317,6 +353,46 @@ SWGAudioOutputDevice::setUdpPort(qint32 udp_port) {
     this->m_udp_port_isSet = true;
 }
 
+qint32
+SWGAudioOutputDevice::getLowLatency() {
+    return low_latency;
+}
+void
+SWGAudioOutputDevice::setLowLatency(qint32 low_latency) {
+    this->low_latency = low_latency;
+    this->m_low_latency_isSet = true;
+}
+
+qint32
+SWGAudioOutputDevice::getUdpBlockSize() {
+    return udp_block_size;
+}
+void
+SWGAudioOutputDevice::setUdpBlockSize(qint32 udp_block_size) {
+    this->udp_block_size = udp_block_size;
+    this->m_udp_block_size_isSet = true;
+}
+
+qint32
+SWGAudioOutputDevice::getUdpOpusFrameDuration() {
+    return udp_opus_frame_duration;
+}
+void
+SWGAudioOutputDevice::setUdpOpusFrameDuration(qint32 udp_opus_frame_duration) {
+    this->udp_opus_frame_duration = udp_opus_frame_duration;
+    this->m_udp_opus_frame_duration_isSet = true;
+}
+
+qint32
+SWGAudioOutputDevice::getUdpDroppedSamples() {
+    return udp_dropped_samples;
+}
+void
+SWGAudioOutputDevice::setUdpDroppedSamples(qint32 udp_dropped_samples) {
+    this->udp_dropped_samples = udp_dropped_samples;
+    this->m_udp_dropped_samples_isSet = true;
+}
+
 
 bool
 SWGAudioOutputDevice::isSet(){
@@ -334,6 +410,10 @@ SWGAudioOutputDevice::isSet(){
         if(m_udp_decimation_factor_isSet){ isObjectUpdated = true; break;}
         if(udp_address != nullptr && *udp_address != QString("")){ isObjectUpdated = true; break;}
         if(m_udp_port_isSet){ isObjectUpdated = true; break;}
+        if(m_low_latency_isSet){ isObjectUpdated = true; break;}
+        if(m_udp_block_size_isSet){ isObjectUpdated = true; break;}
+        if(m_udp_opus_frame_duration_isSet){ isObjectUpdated = true; break;}
+        if(m_udp_dropped_samples_isSet){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
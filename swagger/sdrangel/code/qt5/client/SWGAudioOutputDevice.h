@@ -78,6 +78,18 @@ public:
     qint32 getUdpPort();
     void setUdpPort(qint32 udp_port);
 
+    qint32 getLowLatency();
+    void setLowLatency(qint32 low_latency);
+
+    qint32 getUdpBlockSize();
+    void setUdpBlockSize(qint32 udp_block_size);
+
+    qint32 getUdpOpusFrameDuration();
+    void setUdpOpusFrameDuration(qint32 udp_opus_frame_duration);
+
+    qint32 getUdpDroppedSamples();
+    void setUdpDroppedSamples(qint32 udp_dropped_samples);
+
 
     virtual bool isSet() override;
 
@@ -118,6 +130,18 @@ private:
     qint32 udp_port;
     bool m_udp_port_isSet;
 
+    qint32 low_latency;
+    bool m_low_latency_isSet;
+
+    qint32 udp_block_size;
+    bool m_udp_block_size_isSet;
+
+    qint32 udp_opus_frame_duration;
+    bool m_udp_opus_frame_duration_isSet;
+
+    qint32 udp_dropped_samples;
+    bool m_udp_dropped_samples_isSet;
+
 };
 
 }
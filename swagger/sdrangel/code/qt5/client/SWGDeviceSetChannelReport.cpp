@@ -0,0 +1,129 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.3
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGDeviceSetChannelReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGDeviceSetChannelReport::SWGDeviceSetChannelReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGDeviceSetChannelReport::SWGDeviceSetChannelReport() {
+    index = 0;
+    m_index_isSet = false;
+    report = nullptr;
+    m_report_isSet = false;
+}
+
+SWGDeviceSetChannelReport::~SWGDeviceSetChannelReport() {
+    this->cleanup();
+}
+
+void
+SWGDeviceSetChannelReport::init() {
+    index = 0;
+    m_index_isSet = false;
+    report = new SWGChannelReport();
+    m_report_isSet = false;
+}
+
+void
+SWGDeviceSetChannelReport::cleanup() {
+
+    if(report != nullptr) { 
+        delete report;
+    }
+}
+
+SWGDeviceSetChannelReport*
+SWGDeviceSetChannelReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGDeviceSetChannelReport::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&index, pJson["index"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&report, pJson["report"], "SWGChannelReport", "SWGChannelReport");
+    
+}
+
+QString
+SWGDeviceSetChannelReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGDeviceSetChannelReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_index_isSet){
+        obj->insert("index", QJsonValue(index));
+    }
+    if((report != nullptr) && (report->isSet())){
+        toJsonValue(QString("report"), report, obj, QString("SWGChannelReport"));
+    }
+
+    return obj;
+}
+
+qint32
+SWGDeviceSetChannelReport::getIndex() {
+    return index;
+}
+void
+SWGDeviceSetChannelReport::setIndex(qint32 index) {
+    this->index = index;
+    this->m_index_isSet = true;
+}
+
+SWGChannelReport*
+SWGDeviceSetChannelReport::getReport() {
+    return report;
+}
+void
+SWGDeviceSetChannelReport::setReport(SWGChannelReport* report) {
+    this->report = report;
+    this->m_report_isSet = true;
+}
+
+
+bool
+SWGDeviceSetChannelReport::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_index_isSet){ isObjectUpdated = true; break;}
+        if(report != nullptr && report->isSet()){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,127 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.3
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGDeviceSetStartupTimings.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGDeviceSetStartupTimings::SWGDeviceSetStartupTimings(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGDeviceSetStartupTimings::SWGDeviceSetStartupTimings() {
+    setup_ms = 0;
+    m_setup_ms_isSet = false;
+    start_ms = 0;
+    m_start_ms_isSet = false;
+}
+
+SWGDeviceSetStartupTimings::~SWGDeviceSetStartupTimings() {
+    this->cleanup();
+}
+
+void
+SWGDeviceSetStartupTimings::init() {
+    setup_ms = 0;
+    m_setup_ms_isSet = false;
+    start_ms = 0;
+    m_start_ms_isSet = false;
+}
+
+void
+SWGDeviceSetStartupTimings::cleanup() {
+
+
+}
+
+SWGDeviceSetStartupTimings*
+SWGDeviceSetStartupTimings::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGDeviceSetStartupTimings::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&setup_ms, pJson["setupMs"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&start_ms, pJson["startMs"], "qint64", "");
+    
+}
+
+QString
+SWGDeviceSetStartupTimings::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGDeviceSetStartupTimings::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_setup_ms_isSet){
+        obj->insert("setupMs", QJsonValue(setup_ms));
+    }
+    if(m_start_ms_isSet){
+        obj->insert("startMs", QJsonValue(start_ms));
+    }
+
+    return obj;
+}
+
+qint64
+SWGDeviceSetStartupTimings::getSetupMs() {
+    return setup_ms;
+}
+void
+SWGDeviceSetStartupTimings::setSetupMs(qint64 setup_ms) {
+    this->setup_ms = setup_ms;
+    this->m_setup_ms_isSet = true;
+}
+
+qint64
+SWGDeviceSetStartupTimings::getStartMs() {
+    return start_ms;
+}
+void
+SWGDeviceSetStartupTimings::setStartMs(qint64 start_ms) {
+    this->start_ms = start_ms;
+    this->m_start_ms_isSet = true;
+}
+
+
+bool
+SWGDeviceSetStartupTimings::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_setup_ms_isSet){ isObjectUpdated = true; break;}
+        if(m_start_ms_isSet){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,181 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.3
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGDeviceSetsReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGDeviceSetsReport::SWGDeviceSetsReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGDeviceSetsReport::SWGDeviceSetsReport() {
+    token = 0;
+    m_token_isSet = false;
+    delta = false;
+    m_delta_isSet = false;
+    device_sets = nullptr;
+    m_device_sets_isSet = false;
+    removed = nullptr;
+    m_removed_isSet = false;
+}
+
+SWGDeviceSetsReport::~SWGDeviceSetsReport() {
+    this->cleanup();
+}
+
+void
+SWGDeviceSetsReport::init() {
+    token = 0;
+    m_token_isSet = false;
+    delta = false;
+    m_delta_isSet = false;
+    device_sets = new QList<SWGDeviceSetReport*>();
+    m_device_sets_isSet = false;
+    removed = new QList<QString*>();
+    m_removed_isSet = false;
+}
+
+void
+SWGDeviceSetsReport::cleanup() {
+
+
+    if(device_sets != nullptr) { 
+        auto arr = device_sets;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete device_sets;
+    }
+    if(removed != nullptr) { 
+        auto arr = removed;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete removed;
+    }
+}
+
+SWGDeviceSetsReport*
+SWGDeviceSetsReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGDeviceSetsReport::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&token, pJson["token"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&delta, pJson["delta"], "bool", "");
+    
+    
+    ::SWGSDRangel::setValue(&device_sets, pJson["deviceSets"], "QList", "SWGDeviceSetReport");
+    
+    ::SWGSDRangel::setValue(&removed, pJson["removed"], "QList", "QString");
+}
+
+QString
+SWGDeviceSetsReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGDeviceSetsReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_token_isSet){
+        obj->insert("token", QJsonValue(token));
+    }
+    if(m_delta_isSet){
+        obj->insert("delta", QJsonValue(delta));
+    }
+    if(device_sets->size() > 0){
+        toJsonArray((QList<void*>*)device_sets, obj, "deviceSets", "SWGDeviceSetReport");
+    }
+    if(removed->size() > 0){
+        toJsonArray((QList<void*>*)removed, obj, "removed", "QString");
+    }
+
+    return obj;
+}
+
+qint64
+SWGDeviceSetsReport::getToken() {
+    return token;
+}
+void
+SWGDeviceSetsReport::setToken(qint64 token) {
+    this->token = token;
+    this->m_token_isSet = true;
+}
+
+bool
+SWGDeviceSetsReport::getDelta() {
+    return delta;
+}
+void
+SWGDeviceSetsReport::setDelta(bool delta) {
+    this->delta = delta;
+    this->m_delta_isSet = true;
+}
+
+QList<SWGDeviceSetReport*>*
+SWGDeviceSetsReport::getDeviceSets() {
+    return device_sets;
+}
+void
+SWGDeviceSetsReport::setDeviceSets(QList<SWGDeviceSetReport*>* device_sets) {
+    this->device_sets = device_sets;
+    this->m_device_sets_isSet = true;
+}
+
+QList<QString*>*
+SWGDeviceSetsReport::getRemoved() {
+    return removed;
+}
+void
+SWGDeviceSetsReport::setRemoved(QList<QString*>* removed) {
+    this->removed = removed;
+    this->m_removed_isSet = true;
+}
+
+
+bool
+SWGDeviceSetsReport::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_token_isSet){ isObjectUpdated = true; break;}
+        if(m_delta_isSet){ isObjectUpdated = true; break;}
+        if(device_sets->size() > 0){ isObjectUpdated = true; break;}
+        if(removed->size() > 0){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
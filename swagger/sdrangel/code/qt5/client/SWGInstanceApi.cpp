@@ -834,6 +834,74 @@ SWGInstanceApi::instanceDeviceSetsGetCallback(SWGHttpRequestWorker * worker) {
     }
 }
 
+void
+SWGInstanceApi::instanceDeviceSetsReportGet(qint64 since, QString* format) {
+    QString fullPath;
+    fullPath.append(this->host).append(this->basePath).append("/sdrangel/devicesets/report");
+
+
+    if (fullPath.indexOf("?") > 0)
+      fullPath.append("&");
+    else
+      fullPath.append("?");
+    fullPath.append(QUrl::toPercentEncoding("since"))
+        .append("=")
+        .append(QUrl::toPercentEncoding(stringValue(since)));
+
+    if (fullPath.indexOf("?") > 0)
+      fullPath.append("&");
+    else
+      fullPath.append("?");
+    fullPath.append(QUrl::toPercentEncoding("format"))
+        .append("=")
+        .append(QUrl::toPercentEncoding(stringValue(format)));
+
+
+    SWGHttpRequestWorker *worker = new SWGHttpRequestWorker();
+    SWGHttpRequestInput input(fullPath, "GET");
+
+
+
+
+
+    foreach(QString key, this->defaultHeaders.keys()) {
+        input.headers.insert(key, this->defaultHeaders.value(key));
+    }
+
+    connect(worker,
+            &SWGHttpRequestWorker::on_execution_finished,
+            this,
+            &SWGInstanceApi::instanceDeviceSetsReportGetCallback);
+
+    worker->execute(&input);
+}
+
+void
+SWGInstanceApi::instanceDeviceSetsReportGetCallback(SWGHttpRequestWorker * worker) {
+    QString msg;
+    QString error_str = worker->error_str;
+    QNetworkReply::NetworkError error_type = worker->error_type;
+
+    if (worker->error_type == QNetworkReply::NoError) {
+        msg = QString("Success! %1 bytes").arg(worker->response.length());
+    }
+    else {
+        msg = "Error: " + worker->error_str;
+    }
+
+
+    QString json(worker->response);
+    SWGDeviceSetsReport* output = static_cast<SWGDeviceSetsReport*>(create(json, QString("SWGDeviceSetsReport")));
+    worker->deleteLater();
+
+    if (worker->error_type == QNetworkReply::NoError) {
+        emit instanceDeviceSetsReportGetSignal(output);
+    } else {
+        emit instanceDeviceSetsReportGetSignalE(output, error_type, error_str);
+        emit instanceDeviceSetsReportGetSignalEFull(worker, error_type, error_str);
+    }
+}
+
 void
 SWGInstanceApi::instanceDevices(qint32 direction) {
     QString fullPath;
@@ -1490,6 +1558,58 @@ SWGInstanceApi::instancePresetPutCallback(SWGHttpRequestWorker * worker) {
     }
 }
 
+void
+SWGInstanceApi::instanceStartupGet() {
+    QString fullPath;
+    fullPath.append(this->host).append(this->basePath).append("/sdrangel/startup");
+
+
+
+    SWGHttpRequestWorker *worker = new SWGHttpRequestWorker();
+    SWGHttpRequestInput input(fullPath, "GET");
+
+
+
+
+
+    foreach(QString key, this->defaultHeaders.keys()) {
+        input.headers.insert(key, this->defaultHeaders.value(key));
+    }
+
+    connect(worker,
+            &SWGHttpRequestWorker::on_execution_finished,
+            this,
+            &SWGInstanceApi::instanceStartupGetCallback);
+
+    worker->execute(&input);
+}
+
+void
+SWGInstanceApi::instanceStartupGetCallback(SWGHttpRequestWorker * worker) {
+    QString msg;
+    QString error_str = worker->error_str;
+    QNetworkReply::NetworkError error_type = worker->error_type;
+
+    if (worker->error_type == QNetworkReply::NoError) {
+        msg = QString("Success! %1 bytes").arg(worker->response.length());
+    }
+    else {
+        msg = "Error: " + worker->error_str;
+    }
+
+
+    QString json(worker->response);
+    SWGStartupTimings* output = static_cast<SWGStartupTimings*>(create(json, QString("SWGStartupTimings")));
+    worker->deleteLater();
+
+    if (worker->error_type == QNetworkReply::NoError) {
+        emit instanceStartupGetSignal(output);
+    } else {
+        emit instanceStartupGetSignalE(output, error_type, error_str);
+        emit instanceStartupGetSignalEFull(worker, error_type, error_str);
+    }
+}
+
 void
 SWGInstanceApi::instanceSummary() {
     QString fullPath;
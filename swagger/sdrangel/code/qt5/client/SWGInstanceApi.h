@@ -21,6 +21,7 @@
 #include "SWGAudioOutputDevice.h"
 #include "SWGDVSerialDevices.h"
 #include "SWGDeviceSetList.h"
+#include "SWGDeviceSetsReport.h"
 #include "SWGErrorResponse.h"
 #include "SWGInstanceChannelsResponse.h"
 #include "SWGInstanceDevicesResponse.h"
@@ -32,6 +33,7 @@
 #include "SWGPresetImport.h"
 #include "SWGPresetTransfer.h"
 #include "SWGPresets.h"
+#include "SWGStartupTimings.h"
 #include "SWGSuccessResponse.h"
 
 #include <QObject>
@@ -65,6 +67,7 @@ public:
     void instanceChannels(qint32 direction);
     void instanceDelete();
     void instanceDeviceSetsGet();
+    void instanceDeviceSetsReportGet(qint64 since, QString* format);
     void instanceDevices(qint32 direction);
     void instanceLocationGet();
     void instanceLocationPut(SWGLocationInformation& body);
@@ -77,6 +80,7 @@ public:
     void instancePresetPatch(SWGPresetTransfer& body);
     void instancePresetPost(SWGPresetTransfer& body);
     void instancePresetPut(SWGPresetTransfer& body);
+    void instanceStartupGet();
     void instanceSummary();
     
 private:
@@ -95,6 +99,7 @@ private:
     void instanceChannelsCallback (SWGHttpRequestWorker * worker);
     void instanceDeleteCallback (SWGHttpRequestWorker * worker);
     void instanceDeviceSetsGetCallback (SWGHttpRequestWorker * worker);
+    void instanceDeviceSetsReportGetCallback (SWGHttpRequestWorker * worker);
     void instanceDevicesCallback (SWGHttpRequestWorker * worker);
     void instanceLocationGetCallback (SWGHttpRequestWorker * worker);
     void instanceLocationPutCallback (SWGHttpRequestWorker * worker);
@@ -107,6 +112,7 @@ private:
     void instancePresetPatchCallback (SWGHttpRequestWorker * worker);
     void instancePresetPostCallback (SWGHttpRequestWorker * worker);
     void instancePresetPutCallback (SWGHttpRequestWorker * worker);
+    void instanceStartupGetCallback (SWGHttpRequestWorker * worker);
     void instanceSummaryCallback (SWGHttpRequestWorker * worker);
     
 signals:
@@ -125,6 +131,7 @@ signals:
     void instanceChannelsSignal(SWGInstanceChannelsResponse* summary);
     void instanceDeleteSignal(SWGInstanceSummaryResponse* summary);
     void instanceDeviceSetsGetSignal(SWGDeviceSetList* summary);
+    void instanceDeviceSetsReportGetSignal(SWGDeviceSetsReport* summary);
     void instanceDevicesSignal(SWGInstanceDevicesResponse* summary);
     void instanceLocationGetSignal(SWGLocationInformation* summary);
     void instanceLocationPutSignal(SWGLocationInformation* summary);
@@ -137,6 +144,7 @@ signals:
     void instancePresetPatchSignal(SWGPresetIdentifier* summary);
     void instancePresetPostSignal(SWGPresetIdentifier* summary);
     void instancePresetPutSignal(SWGPresetIdentifier* summary);
+    void instanceStartupGetSignal(SWGStartupTimings* summary);
     void instanceSummarySignal(SWGInstanceSummaryResponse* summary);
     
     void instanceAMBEDevicesDeleteSignalE(SWGSuccessResponse* summary, QNetworkReply::NetworkError error_type, QString& error_str);
@@ -154,6 +162,7 @@ signals:
     void instanceChannelsSignalE(SWGInstanceChannelsResponse* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     void instanceDeleteSignalE(SWGInstanceSummaryResponse* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     void instanceDeviceSetsGetSignalE(SWGDeviceSetList* summary, QNetworkReply::NetworkError error_type, QString& error_str);
+    void instanceDeviceSetsReportGetSignalE(SWGDeviceSetsReport* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     void instanceDevicesSignalE(SWGInstanceDevicesResponse* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     void instanceLocationGetSignalE(SWGLocationInformation* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     void instanceLocationPutSignalE(SWGLocationInformation* summary, QNetworkReply::NetworkError error_type, QString& error_str);
@@ -166,6 +175,7 @@ signals:
     void instancePresetPatchSignalE(SWGPresetIdentifier* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     void instancePresetPostSignalE(SWGPresetIdentifier* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     void instancePresetPutSignalE(SWGPresetIdentifier* summary, QNetworkReply::NetworkError error_type, QString& error_str);
+    void instanceStartupGetSignalE(SWGStartupTimings* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     void instanceSummarySignalE(SWGInstanceSummaryResponse* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     
     void instanceAMBEDevicesDeleteSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
@@ -183,6 +193,7 @@ signals:
     void instanceChannelsSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     void instanceDeleteSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     void instanceDeviceSetsGetSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
+    void instanceDeviceSetsReportGetSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     void instanceDevicesSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     void instanceLocationGetSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     void instanceLocationPutSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
@@ -195,6 +206,7 @@ signals:
     void instancePresetPatchSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     void instancePresetPostSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     void instancePresetPutSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
+    void instanceStartupGetSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     void instanceSummarySignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     
 };
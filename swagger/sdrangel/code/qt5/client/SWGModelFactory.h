@@ -54,7 +54,11 @@
 #include "SWGDeviceListItem.h"
 #include "SWGDeviceReport.h"
 #include "SWGDeviceSet.h"
+#include "SWGDeviceSetChannelReport.h"
 #include "SWGDeviceSetList.h"
+#include "SWGDeviceSetReport.h"
+#include "SWGDeviceSetStartupTimings.h"
+#include "SWGDeviceSetsReport.h"
 #include "SWGDeviceSettings.h"
 #include "SWGDeviceState.h"
 #include "SWGErrorResponse.h"
@@ -137,6 +141,7 @@
 #include "SWGSoapySDRInputSettings.h"
 #include "SWGSoapySDROutputSettings.h"
 #include "SWGSoapySDRReport.h"
+#include "SWGStartupTimings.h"
 #include "SWGSuccessResponse.h"
 #include "SWGTestMISettings.h"
 #include "SWGTestMiStreamSettings.h"
@@ -277,9 +282,21 @@ namespace SWGSDRangel {
     if(QString("SWGDeviceSet").compare(type) == 0) {
       return new SWGDeviceSet();
     }
+    if(QString("SWGDeviceSetChannelReport").compare(type) == 0) {
+      return new SWGDeviceSetChannelReport();
+    }
     if(QString("SWGDeviceSetList").compare(type) == 0) {
       return new SWGDeviceSetList();
     }
+    if(QString("SWGDeviceSetReport").compare(type) == 0) {
+      return new SWGDeviceSetReport();
+    }
+    if(QString("SWGDeviceSetStartupTimings").compare(type) == 0) {
+      return new SWGDeviceSetStartupTimings();
+    }
+    if(QString("SWGDeviceSetsReport").compare(type) == 0) {
+      return new SWGDeviceSetsReport();
+    }
     if(QString("SWGDeviceSettings").compare(type) == 0) {
       return new SWGDeviceSettings();
     }
@@ -526,6 +543,9 @@ namespace SWGSDRangel {
     if(QString("SWGSoapySDRReport").compare(type) == 0) {
       return new SWGSoapySDRReport();
     }
+    if(QString("SWGStartupTimings").compare(type) == 0) {
+      return new SWGStartupTimings();
+    }
     if(QString("SWGSuccessResponse").compare(type) == 0) {
       return new SWGSuccessResponse();
     }
@@ -36,6 +36,14 @@ SWGSSBDemodReport::SWGSSBDemodReport() {
     m_audio_sample_rate_isSet = false;
     channel_sample_rate = 0;
     m_channel_sample_rate_isSet = false;
+    audio_fifo_fill_min = 0;
+    m_audio_fifo_fill_min_isSet = false;
+    audio_fifo_fill_max = 0;
+    m_audio_fifo_fill_max_isSet = false;
+    audio_fifo_underruns = 0;
+    m_audio_fifo_underruns_isSet = false;
+    audio_fifo_overruns = 0;
+    m_audio_fifo_overruns_isSet = false;
 }
 
 SWGSSBDemodReport::~SWGSSBDemodReport() {
@@ -52,6 +60,14 @@ SWGSSBDemodReport::init() {
     m_audio_sample_rate_isSet = false;
     channel_sample_rate = 0;
     m_channel_sample_rate_isSet = false;
+    audio_fifo_fill_min = 0;
+    m_audio_fifo_fill_min_isSet = false;
+    audio_fifo_fill_max = 0;
+    m_audio_fifo_fill_max_isSet = false;
+    audio_fifo_underruns = 0;
+    m_audio_fifo_underruns_isSet = false;
+    audio_fifo_overruns = 0;
+    m_audio_fifo_overruns_isSet = false;
 }
 
 void
@@ -60,6 +76,10 @@ SWGSSBDemodReport::cleanup() {
 
 
 
+
+
+
+
 }
 
 SWGSSBDemodReport*
@@ -81,6 +101,14 @@ SWGSSBDemodReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&channel_sample_rate, pJson["channelSampleRate"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&audio_fifo_fill_min, pJson["audioFifoFillMin"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&audio_fifo_fill_max, pJson["audioFifoFillMax"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&audio_fifo_underruns, pJson["audioFifoUnderruns"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&audio_fifo_overruns, pJson["audioFifoOverruns"], "qint32", "");
+    
 }
 
 QString
@@ -109,6 +137,18 @@ SWGSSBDemodReport::asJsonObject() {
     if(m_channel_sample_rate_isSet){
         obj->insert("channelSampleRate", QJsonValue(channel_sample_rate));
     }
+    if(m_audio_fifo_fill_min_isSet){
+        obj->insert("audioFifoFillMin", QJsonValue(audio_fifo_fill_min));
+    }
+    if(m_audio_fifo_fill_max_isSet){
+        obj->insert("audioFifoFillMax", QJsonValue(audio_fifo_fill_max));
+    }
+    if(m_audio_fifo_underruns_isSet){
+        obj->insert("audioFifoUnderruns", QJsonValue(audio_fifo_underruns));
+    }
+    if(m_audio_fifo_overruns_isSet){
+        obj->insert("audioFifoOverruns", QJsonValue(audio_fifo_overruns));
+    }
 
     return obj;
 }
@@ -153,6 +193,46 @@ SWGSSBDemodReport::setChannelSampleRate(qint32 channel_sample_rate) {
     this->m_channel_sample_rate_isSet = true;
 }
 
+qint32
+SWGSSBDemodReport::getAudioFifoFillMin() {
+    return audio_fifo_fill_min;
+}
+void
+SWGSSBDemodReport::setAudioFifoFillMin(qint32 audio_fifo_fill_min) {
+    this->audio_fifo_fill_min = audio_fifo_fill_min;
+    this->m_audio_fifo_fill_min_isSet = true;
+}
+
+qint32
+SWGSSBDemodReport::getAudioFifoFillMax() {
+    return audio_fifo_fill_max;
+}
+void
+SWGSSBDemodReport::setAudioFifoFillMax(qint32 audio_fifo_fill_max) {
+    this->audio_fifo_fill_max = audio_fifo_fill_max;
+    this->m_audio_fifo_fill_max_isSet = true;
+}
+
+qint32
+SWGSSBDemodReport::getAudioFifoUnderruns() {
+    return audio_fifo_underruns;
+}
+void
+SWGSSBDemodReport::setAudioFifoUnderruns(qint32 audio_fifo_underruns) {
+    this->audio_fifo_underruns = audio_fifo_underruns;
+    this->m_audio_fifo_underruns_isSet = true;
+}
+
+qint32
+SWGSSBDemodReport::getAudioFifoOverruns() {
+    return audio_fifo_overruns;
+}
+void
+SWGSSBDemodReport::setAudioFifoOverruns(qint32 audio_fifo_overruns) {
+    this->audio_fifo_overruns = audio_fifo_overruns;
+    this->m_audio_fifo_overruns_isSet = true;
+}
+
 
 bool
 SWGSSBDemodReport::isSet(){
@@ -162,6 +242,10 @@ SWGSSBDemodReport::isSet(){
         if(m_squelch_isSet){ isObjectUpdated = true; break;}
         if(m_audio_sample_rate_isSet){ isObjectUpdated = true; break;}
         if(m_channel_sample_rate_isSet){ isObjectUpdated = true; break;}
+        if(m_audio_fifo_fill_min_isSet){ isObjectUpdated = true; break;}
+        if(m_audio_fifo_fill_max_isSet){ isObjectUpdated = true; break;}
+        if(m_audio_fifo_underruns_isSet){ isObjectUpdated = true; break;}
+        if(m_audio_fifo_overruns_isSet){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
@@ -0,0 +1,259 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.3
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGStartupTimings.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGStartupTimings::SWGStartupTimings(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGStartupTimings::SWGStartupTimings() {
+    total_ms = 0;
+    m_total_ms_isSet = false;
+    plugins_ms = 0;
+    m_plugins_ms_isSet = false;
+    settings_ms = 0;
+    m_settings_ms_isSet = false;
+    device_sets_ms = 0;
+    m_device_sets_ms_isSet = false;
+    start_ms = 0;
+    m_start_ms_isSet = false;
+    start_groups = 0;
+    m_start_groups_isSet = false;
+    web_api_ms = 0;
+    m_web_api_ms_isSet = false;
+    device_sets = nullptr;
+    m_device_sets_isSet = false;
+}
+
+SWGStartupTimings::~SWGStartupTimings() {
+    this->cleanup();
+}
+
+void
+SWGStartupTimings::init() {
+    total_ms = 0;
+    m_total_ms_isSet = false;
+    plugins_ms = 0;
+    m_plugins_ms_isSet = false;
+    settings_ms = 0;
+    m_settings_ms_isSet = false;
+    device_sets_ms = 0;
+    m_device_sets_ms_isSet = false;
+    start_ms = 0;
+    m_start_ms_isSet = false;
+    start_groups = 0;
+    m_start_groups_isSet = false;
+    web_api_ms = 0;
+    m_web_api_ms_isSet = false;
+    device_sets = new QList<SWGDeviceSetStartupTimings*>();
+    m_device_sets_isSet = false;
+}
+
+void
+SWGStartupTimings::cleanup() {
+
+
+
+
+
+
+
+    if(device_sets != nullptr) { 
+        auto arr = device_sets;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete device_sets;
+    }
+}
+
+SWGStartupTimings*
+SWGStartupTimings::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGStartupTimings::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&total_ms, pJson["totalMs"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&plugins_ms, pJson["pluginsMs"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&settings_ms, pJson["settingsMs"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&device_sets_ms, pJson["deviceSetsMs"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&start_ms, pJson["startMs"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&start_groups, pJson["startGroups"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&web_api_ms, pJson["webAPIMs"], "qint64", "");
+    
+    
+    ::SWGSDRangel::setValue(&device_sets, pJson["deviceSets"], "QList", "SWGDeviceSetStartupTimings");
+}
+
+QString
+SWGStartupTimings::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGStartupTimings::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_total_ms_isSet){
+        obj->insert("totalMs", QJsonValue(total_ms));
+    }
+    if(m_plugins_ms_isSet){
+        obj->insert("pluginsMs", QJsonValue(plugins_ms));
+    }
+    if(m_settings_ms_isSet){
+        obj->insert("settingsMs", QJsonValue(settings_ms));
+    }
+    if(m_device_sets_ms_isSet){
+        obj->insert("deviceSetsMs", QJsonValue(device_sets_ms));
+    }
+    if(m_start_ms_isSet){
+        obj->insert("startMs", QJsonValue(start_ms));
+    }
+    if(m_start_groups_isSet){
+        obj->insert("startGroups", QJsonValue(start_groups));
+    }
+    if(m_web_api_ms_isSet){
+        obj->insert("webAPIMs", QJsonValue(web_api_ms));
+    }
+    if(device_sets->size() > 0){
+        toJsonArray((QList<void*>*)device_sets, obj, "deviceSets", "SWGDeviceSetStartupTimings");
+    }
+
+    return obj;
+}
+
+qint64
+SWGStartupTimings::getTotalMs() {
+    return total_ms;
+}
+void
+SWGStartupTimings::setTotalMs(qint64 total_ms) {
+    this->total_ms = total_ms;
+    this->m_total_ms_isSet = true;
+}
+
+qint64
+SWGStartupTimings::getPluginsMs() {
+    return plugins_ms;
+}
+void
+SWGStartupTimings::setPluginsMs(qint64 plugins_ms) {
+    this->plugins_ms = plugins_ms;
+    this->m_plugins_ms_isSet = true;
+}
+
+qint64
+SWGStartupTimings::getSettingsMs() {
+    return settings_ms;
+}
+void
+SWGStartupTimings::setSettingsMs(qint64 settings_ms) {
+    this->settings_ms = settings_ms;
+    this->m_settings_ms_isSet = true;
+}
+
+qint64
+SWGStartupTimings::getDeviceSetsMs() {
+    return device_sets_ms;
+}
+void
+SWGStartupTimings::setDeviceSetsMs(qint64 device_sets_ms) {
+    this->device_sets_ms = device_sets_ms;
+    this->m_device_sets_ms_isSet = true;
+}
+
+qint64
+SWGStartupTimings::getStartMs() {
+    return start_ms;
+}
+void
+SWGStartupTimings::setStartMs(qint64 start_ms) {
+    this->start_ms = start_ms;
+    this->m_start_ms_isSet = true;
+}
+
+qint32
+SWGStartupTimings::getStartGroups() {
+    return start_groups;
+}
+void
+SWGStartupTimings::setStartGroups(qint32 start_groups) {
+    this->start_groups = start_groups;
+    this->m_start_groups_isSet = true;
+}
+
+qint64
+SWGStartupTimings::getWebApiMs() {
+    return web_api_ms;
+}
+void
+SWGStartupTimings::setWebApiMs(qint64 web_api_ms) {
+    this->web_api_ms = web_api_ms;
+    this->m_web_api_ms_isSet = true;
+}
+
+QList<SWGDeviceSetStartupTimings*>*
+SWGStartupTimings::getDeviceSets() {
+    return device_sets;
+}
+void
+SWGStartupTimings::setDeviceSets(QList<SWGDeviceSetStartupTimings*>* device_sets) {
+    this->device_sets = device_sets;
+    this->m_device_sets_isSet = true;
+}
+
+
+bool
+SWGStartupTimings::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_total_ms_isSet){ isObjectUpdated = true; break;}
+        if(m_plugins_ms_isSet){ isObjectUpdated = true; break;}
+        if(m_settings_ms_isSet){ isObjectUpdated = true; break;}
+        if(m_device_sets_ms_isSet){ isObjectUpdated = true; break;}
+        if(m_start_ms_isSet){ isObjectUpdated = true; break;}
+        if(m_start_groups_isSet){ isObjectUpdated = true; break;}
+        if(m_web_api_ms_isSet){ isObjectUpdated = true; break;}
+        if(device_sets->size() > 0){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
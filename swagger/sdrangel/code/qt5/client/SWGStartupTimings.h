@@ -0,0 +1,102 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.3
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGStartupTimings.h
+ *
+ * Durations of the startup steps in milliseconds
+ */
+
+#ifndef SWGStartupTimings_H_
+#define SWGStartupTimings_H_
+
+#include <QJsonObject>
+
+
+#include "SWGDeviceSetStartupTimings.h"
+#include <QList>
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGStartupTimings: public SWGObject {
+public:
+    SWGStartupTimings();
+    SWGStartupTimings(QString* json);
+    virtual ~SWGStartupTimings();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGStartupTimings* fromJson(QString &jsonString) override;
+
+    qint64 getTotalMs();
+    void setTotalMs(qint64 total_ms);
+
+    qint64 getPluginsMs();
+    void setPluginsMs(qint64 plugins_ms);
+
+    qint64 getSettingsMs();
+    void setSettingsMs(qint64 settings_ms);
+
+    qint64 getDeviceSetsMs();
+    void setDeviceSetsMs(qint64 device_sets_ms);
+
+    qint64 getStartMs();
+    void setStartMs(qint64 start_ms);
+
+    qint32 getStartGroups();
+    void setStartGroups(qint32 start_groups);
+
+    qint64 getWebApiMs();
+    void setWebApiMs(qint64 web_api_ms);
+
+    QList<SWGDeviceSetStartupTimings*>* getDeviceSets();
+    void setDeviceSets(QList<SWGDeviceSetStartupTimings*>* device_sets);
+
+
+    virtual bool isSet() override;
+
+private:
+    qint64 total_ms;
+    bool m_total_ms_isSet;
+
+    qint64 plugins_ms;
+    bool m_plugins_ms_isSet;
+
+    qint64 settings_ms;
+    bool m_settings_ms_isSet;
+
+    qint64 device_sets_ms;
+    bool m_device_sets_ms_isSet;
+
+    qint64 start_ms;
+    bool m_start_ms_isSet;
+
+    qint32 start_groups;
+    bool m_start_groups_isSet;
+
+    qint64 web_api_ms;
+    bool m_web_api_ms_isSet;
+
+    QList<SWGDeviceSetStartupTimings*>* device_sets;
+    bool m_device_sets_isSet;
+
+};
+
+}
+
+#endif /* SWGStartupTimings_H_ */
@@ -53,6 +53,18 @@ public:
     qint32 getChannelSampleRate();
     void setChannelSampleRate(qint32 channel_sample_rate);
 
+    qint32 getAudioFifoFillMin();
+    void setAudioFifoFillMin(qint32 audio_fifo_fill_min);
+
+    qint32 getAudioFifoFillMax();
+    void setAudioFifoFillMax(qint32 audio_fifo_fill_max);
+
+    qint32 getAudioFifoUnderruns();
+    void setAudioFifoUnderruns(qint32 audio_fifo_underruns);
+
+    qint32 getAudioFifoOverruns();
+    void setAudioFifoOverruns(qint32 audio_fifo_overruns);
+
 
     virtual bool isSet() override;
 
@@ -69,6 +81,18 @@ private:
     qint32 channel_sample_rate;
     bool m_channel_sample_rate_isSet;
 
+    qint32 audio_fifo_fill_min;
+    bool m_audio_fifo_fill_min_isSet;
+
+    qint32 audio_fifo_fill_max;
+    bool m_audio_fifo_fill_max_isSet;
+
+    qint32 audio_fifo_underruns;
+    bool m_audio_fifo_underruns_isSet;
+
+    qint32 audio_fifo_overruns;
+    bool m_audio_fifo_overruns_isSet;
+
 };
 
 }